@@ -3,18 +3,451 @@
 #include <vector>
 #include <math.h>
 #include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <thread>
 
 #include "../MocapNETLib/tools.h"
 #include "../MocapNETLib/jsonCocoSkeleton.h"
 #include "../MocapNETLib/jsonMocapNETHelpers.hpp"
+#include "../MocapNETLib/keypointArchive.h"
 #include "../MocapNETLib/bvh.hpp"
 #include "../MocapNETLib/visualization.hpp"
+#include "../MocapNETLib/temporalFilter.hpp"
+#include "../MocapNETLib/instrumentation.hpp"
+
+#define NORMAL   "\033[0m"
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+
+//Exit code of a self test that cannot run in this build, CTest reports it as skipped
+#define SELF_TEST_SKIPPED 77
+
+//Every how many frames the capture of the self test has a frame without people
+#define TEST_EMPTY_FRAME_INTERVAL 3
+
+/**
+ * @brief Each worker of the sharded mode gets one of these, it describes a contiguous range of frames [startFrame,endFrame)
+ * and the worker writes its results straight to the slots of the shared bvhFrames vector that correspond to its frames.
+ * Since every worker owns a different range of slots there is no need for locking.
+ */
+struct MocapNETShard
+{
+    unsigned int workerID;
+    unsigned int startFrame;
+    unsigned int endFrame;
+    unsigned int width;
+    unsigned int height;
+    unsigned int useCPUOnly;
+    const char * path;
+    const char * label;
+    const char * formatString;
+    const struct keypointArchive * archive;
+    std::vector<std::vector<float> > * bvhFrames;
+    //Set for frames without people, the merge gives them the output of the previous frame
+    std::vector<unsigned char> * repeatsPrevious;
+    //Output of the worker
+    unsigned int loaded;
+    unsigned int processedFrames;
+    unsigned int firstFailedFrame;
+    float totalTime;
+};
+
+
+/**
+ * @brief Count the number of consecutive JSON files in a directory starting from frame 0, this is needed
+ * to split the sequence in shards before any worker starts.
+ * @retval Number of consecutive frames found
+ */
+unsigned int countJSONFrames(const char * formatString,const char * path,const char * label,unsigned int frameLimit)
+{
+    char filePathOfJSONFile[1024]= {0};
+    unsigned int frameID=0;
+    while (frameID<frameLimit)
+        {
+            snprintf(filePathOfJSONFile,1024,formatString,path,label,frameID);
+            if (access(filePathOfJSONFile,R_OK)!=0)
+                {
+                    break;
+                }
+            ++frameID;
+        }
+    return frameID;
+}
+
+
+/**
+ * @brief Retrieve the skeleton of a frame either from a packed keypoint archive ( if one is given ) or by parsing its JSON file.
+ * The first person found replaces the skeleton, a frame without people leaves it untouched.
+ * @param Output, number of people in the frame
+ * @retval 1=Success/0=Failure
+ */
+int getSkeletonOfFrame(const struct keypointArchive * archive,const char * formatString,const char * path,const char * label,unsigned int frameID,struct skeletonCOCO * skeleton,unsigned int * numberOfPeople)
+{
+    if (archive!=0)
+        {
+            *numberOfPeople=getKeypointArchiveNumberOfPeople(archive,frameID);
+            if (*numberOfPeople==0)
+                {
+                    return (frameID<getKeypointArchiveNumberOfFrames(archive));
+                }
+            memset(skeleton,0,sizeof(struct skeletonCOCO));
+            return readKeypointArchiveSkeleton(archive,frameID,0,skeleton);
+        }
+
+    char filePathOfJSONFile[1024]= {0};
+    snprintf(filePathOfJSONFile,1024,formatString,path,label,frameID);
+    return parseJsonCOCOSkeletons(filePathOfJSONFile,skeleton,1,numberOfPeople);
+}
+
+
+/**
+ * @brief Print the stage timings collected during the run and write them to the statistics file if one was requested
+ */
+void finishStageStatistics(const char * statisticsPath)
+{
+    printStageStatistics(stderr);
+    if (statisticsPath!=0)
+        {
+            dumpStageStatistics(statisticsPath);
+        }
+}
+
+
+/**
+ * @brief Worker thread of the sharded mode, it loads its own MocapNET context and processes the frames of its shard.
+ * There is no temporal state in the MocapNET pipeline, the only thing carried from frame to frame is the skeleton of the last
+ * frame with people, which frames without people are processed with. That skeleton may belong to another shard, so these frames
+ * are only marked and the merge gives them the output of the previous frame, which is what the single threaded run computes.
+ */
+void processMocapNETShard(struct MocapNETShard * shard)
+{
+    shard->loaded=0;
+    shard->processedFrames=0;
+    shard->firstFailedFrame=shard->endFrame;
+    shard->totalTime=0.0;
+
+    struct MocapNET mnet= {0};
+    if ( loadMocapNET(&mnet,"test",shard->useCPUOnly) )
+        {
+            shard->loaded=1;
+            struct skeletonCOCO skeleton= {0};
+
+            for (unsigned int frameID=shard->startFrame; frameID<shard->endFrame; frameID++)
+                {
+                    unsigned int numberOfPeople=0;
+                    unsigned long readStart = startStageTimer();
+                    if (getSkeletonOfFrame(shard->archive,shard->formatString,shard->path,shard->label,frameID,&skeleton,&numberOfPeople))
+                        {
+                            stopStageTimer(MOCAPNET_STAGE_CAPTURE,readStart);
+                            if ( (numberOfPeople==0) && (frameID>0) )
+                                {
+                                    (*shard->repeatsPrevious)[frameID]=1;
+                                    ++shard->processedFrames;
+                                    continue;
+                                }
+                            unsigned long flattenStart = startStageTimer();
+                            std::vector<float> inputValues = flattenskeletonCOCOToVector(&skeleton,shard->width,shard->height);
+                            stopStageTimer(MOCAPNET_STAGE_PREPROCESS,flattenStart);
+                            if (inputValues.size()==0)
+                                {
+                                    fprintf(stderr,"Failed to read from JSON file..\n");
+                                }
+
+                            long startTime = GetTickCountMicrosecondsMN();
+                            //--------------------------------------------------------
+                            (*shard->bvhFrames)[frameID] = runMocapNET(&mnet,inputValues);
+                            //--------------------------------------------------------
+                            long endTime = GetTickCountMicrosecondsMN();
+
+                            shard->totalTime+=(float) (endTime-startTime)/1000;
+                            ++shard->processedFrames;
+                            dumpStageStatisticsIfDue();
+                        }
+                    else
+                        {
+                            //The file disappeared after we counted it, the single threaded run would stop here..
+                            shard->firstFailedFrame=frameID;
+                            break;
+                        }
+                }
+            unloadMocapNET(&mnet);
+        }
+    else
+        {
+            fprintf(stderr,"Worker %u was not able to load MocapNET..\n",shard->workerID);
+        }
+}
+
+
+/**
+ * @brief Split the frame range in as many shards as our threads, run them in parallel and merge the results back in frame order.
+ * @retval Number of frames in bvhFrames, 0 means failure
+ */
+unsigned int runShardedMocapNET(
+    std::vector<std::vector<float> > &bvhFrames,
+    const char * formatString,
+    const char * path,
+    const char * label,
+    const struct keypointArchive * archive,
+    unsigned int frameLimit,
+    unsigned int width,
+    unsigned int height,
+    unsigned int useCPUOnly,
+    unsigned int numberOfThreads
+)
+{
+    unsigned int numberOfFrames = 0;
+    if (archive!=0)
+        {
+            numberOfFrames = getKeypointArchiveNumberOfFrames(archive);
+            if (numberOfFrames>frameLimit)
+                {
+                    numberOfFrames=frameLimit;
+                }
+        }
+    else
+        {
+            numberOfFrames = countJSONFrames(formatString,path,label,frameLimit);
+        }
+    if (numberOfFrames==0)
+        {
+            fprintf(stderr,"Could not find any JSON files to process..\n");
+            return 0;
+        }
+    if (numberOfThreads>numberOfFrames)
+        {
+            numberOfThreads=numberOfFrames;
+        }
+
+    fprintf(stderr,"Splitting %u frames in %u shards..\n",numberOfFrames,numberOfThreads);
+    bvhFrames.clear();
+    bvhFrames.resize(numberOfFrames);
+    std::vector<unsigned char> repeatsPrevious(numberOfFrames,0);
+
+    std::vector<struct MocapNETShard> shards(numberOfThreads);
+    std::vector<std::thread> workers;
+
+    unsigned int framesPerShard = numberOfFrames / numberOfThreads;
+    unsigned int remainingFrames = numberOfFrames % numberOfThreads;
+    unsigned int frameID=0;
+
+    long startTime = GetTickCountMicrosecondsMN();
+    for (unsigned int i=0; i<numberOfThreads; i++)
+        {
+            shards[i].workerID=i;
+            shards[i].startFrame=frameID;
+            frameID+=framesPerShard + (i<remainingFrames);
+            shards[i].endFrame=frameID;
+            shards[i].width=width;
+            shards[i].height=height;
+            shards[i].useCPUOnly=useCPUOnly;
+            shards[i].path=path;
+            shards[i].label=label;
+            shards[i].formatString=formatString;
+            shards[i].archive=archive;
+            shards[i].bvhFrames=&bvhFrames;
+            shards[i].repeatsPrevious=&repeatsPrevious;
+            workers.push_back(std::thread(processMocapNETShard,&shards[i]));
+        }
+
+    for (unsigned int i=0; i<numberOfThreads; i++)
+        {
+            workers[i].join();
+        }
+    long endTime = GetTickCountMicrosecondsMN();
+
+    //Merge, the single threaded run stops on the first frame that fails so we do the same
+    unsigned int validFrames=numberOfFrames;
+    float totalTime=0.0;
+    for (unsigned int i=0; i<numberOfThreads; i++)
+        {
+            if (!shards[i].loaded)
+                {
+                    return 0;
+                }
+            //A shard that did not fail reports its end, which is the start of the next shard and not a failure
+            if ( (shards[i].firstFailedFrame<shards[i].endFrame) && (shards[i].firstFailedFrame<validFrames) )
+                {
+                    validFrames=shards[i].firstFailedFrame;
+                }
+            totalTime+=shards[i].totalTime;
+            fprintf(stderr,"Worker %u : frames %u-%u , %u processed , %0.2f ms\n",i,shards[i].startFrame,shards[i].endFrame,shards[i].processedFrames,shards[i].totalTime);
+        }
+    bvhFrames.resize(validFrames);
+    for (unsigned int frameID=1; frameID<validFrames; frameID++)
+        {
+            if (repeatsPrevious[frameID])
+                {
+                    bvhFrames[frameID]=bvhFrames[frameID-1];
+                }
+        }
+
+    float wallTime = (float) (endTime-startTime)/1000;
+    if (wallTime==0.0)
+        {
+            wallTime=1.0;    //Take care of division by null..
+        }
+    fprintf(stderr,"\nThreads %u - Total %0.2f ms of MocapNET time for %u samples - Wall time %0.2f ms - %0.2f fps\n",numberOfThreads,totalTime,validFrames,wallTime,(float) 1000*validFrames/wallTime);
+
+    return validFrames;
+}
+
+
+/**
+ * @brief A BODY25 pose in 1920x1080 ( x,y,confidence triplets ) the capture of the self test moves around
+ */
+static const float testPose[25*3] =
+{
+    789.3,185.9,0.88, 736.2,294.8,0.85, 645.1,297.9,0.78, 562.7,409.6,0.80, 600.9,503.9,0.87,
+    821.7,291.9,0.78, 892.3,406.6,0.77, 983.6,436.2,0.82, 742.2,577.3,0.64, 692.1,577.4,0.59,
+    692.2,786.4,0.71, 698.1,986.5,0.67, 792.3,574.5,0.61, 789.4,789.3,0.68, 777.5,986.5,0.68,
+    768.6,174.1,0.90, 789.4,174.0,0.66, 712.7,183.0,0.87, 0,0,0, 786.4,1010.1,0.22,
+    804.0,1007.1,0.28, 762.9,1004.1,0.58, 703.9,1018.9,0.58, 689.2,1013.0,0.55, 709.9,998.3,0.55
+};
+
+
+/**
+ * @brief Write the synthetic capture of the self test, the pose sways from side to side and every TEST_EMPTY_FRAME_INTERVAL frames,
+ * starting with the first one, there is a frame with an empty people array
+ * @retval 1=Success/0=Failure
+ */
+int writeTestCapture(const char * formatString,const char * directory,const char * label,unsigned int numberOfFrames)
+{
+    char filePathOfJSONFile[1024]= {0};
+    for (unsigned int frameID=0; frameID<numberOfFrames; frameID++)
+        {
+            snprintf(filePathOfJSONFile,1024,formatString,directory,label,frameID);
+            FILE * fp = fopen(filePathOfJSONFile,"w");
+            if (fp==0)
+                {
+                    return 0;
+                }
+            fprintf(fp,"{\"version\":1.2,\"people\":[");
+            if (frameID%TEST_EMPTY_FRAME_INTERVAL!=0)
+                {
+                    float sway = 40.0 * sin(frameID*0.1);
+                    fprintf(fp,"{\"pose_keypoints_2d\":[");
+                    for (unsigned int i=0; i<25; i++)
+                        {
+                            float confidence = testPose[i*3+2];
+                            fprintf(fp,"%s%0.3f,%0.3f,%0.3f",(i==0) ? "" : ",",(confidence>0.0) ? testPose[i*3+0]+sway : 0.0,testPose[i*3+1],confidence);
+                        }
+                    fprintf(fp,"]}");
+                }
+            fprintf(fp,"]}\n");
+            fclose(fp);
+        }
+    return 1;
+}
+
+
+/**
+ * @brief Read a whole file in a string
+ * @retval 1=Success/0=Failure
+ */
+int readTestFile(const char * filename,std::string &content)
+{
+    FILE * fp = fopen(filename,"r");
+    if (fp==0)
+        {
+            return 0;
+        }
+    char buffer[4096];
+    size_t length;
+    content.clear();
+    while ( (length=fread(buffer,1,4096,fp))>0 )
+        {
+            content.append(buffer,length);
+        }
+    fclose(fp);
+    return 1;
+}
+
+
+/**
+ * @brief Self test, run a synthetic capture with frames without people through one and through many workers and check that
+ * both give the same BVH file
+ * @param Number of workers of the multi threaded run
+ * @retval 1=Success/0=Failure/-1=MocapNET could not be loaded
+ */
+int testShardedMocapNET(unsigned int numberOfThreads,unsigned int useCPUOnly)
+{
+    //Check that the networks are there before starting any worker
+    struct MocapNET mnet= {0};
+    if (!loadMocapNET(&mnet,"test",useCPUOnly))
+        {
+            fprintf(stderr,"MocapNET could not be loaded, cannot test the sharded mode..\n");
+            return -1;
+        }
+    unloadMocapNET(&mnet);
+
+    //A few frames per worker so that shards start on frames with and without people
+    unsigned int numberOfFrames = numberOfThreads * 10 + 1;
+    const char * label = "colorFrame_0";
+    const char * formatString = "%s/%s_%05u_keypoints.json";
+    char directory[256];
+    char singleThreadedPath[512];
+    char multiThreadedPath[512];
+    snprintf(directory,256,"/tmp/mocapnetJSONTestXXXXXX");
+    if (mkdtemp(directory)==0)
+        {
+            fprintf(stderr,RED "Could not create a temporary directory for the test capture\n" NORMAL);
+            return 0;
+        }
+    snprintf(singleThreadedPath,512,"%s/singleThreaded.bvh",directory);
+    snprintf(multiThreadedPath,512,"%s/multiThreaded.bvh",directory);
+
+    int success=0;
+    std::vector<std::vector<float> > bvhFrames;
+    std::string singleThreaded,multiThreaded;
+    if (
+         (writeTestCapture(formatString,directory,label,numberOfFrames)) &&
+         (runShardedMocapNET(bvhFrames,formatString,directory,label,0,numberOfFrames,1920,1080,useCPUOnly,1)==numberOfFrames) &&
+         (writeBVHFile(singleThreadedPath,0,bvhFrames)) &&
+         (runShardedMocapNET(bvhFrames,formatString,directory,label,0,numberOfFrames,1920,1080,useCPUOnly,numberOfThreads)==numberOfFrames) &&
+         (writeBVHFile(multiThreadedPath,0,bvhFrames)) &&
+         (readTestFile(singleThreadedPath,singleThreaded)) &&
+         (readTestFile(multiThreadedPath,multiThreaded))
+       )
+        {
+            success=(singleThreaded==multiThreaded);
+            if (!success)
+                {
+                    fprintf(stderr,RED "1 and %u workers gave different BVH files\n" NORMAL,numberOfThreads);
+                }
+        }
+    else
+        {
+            fprintf(stderr,RED "Could not run the test capture\n" NORMAL);
+        }
+
+    char filePathOfJSONFile[1024]= {0};
+    for (unsigned int frameID=0; frameID<numberOfFrames; frameID++)
+        {
+            snprintf(filePathOfJSONFile,1024,formatString,directory,label,frameID);
+            unlink(filePathOfJSONFile);
+        }
+    unlink(singleThreadedPath);
+    unlink(multiThreadedPath);
+    rmdir(directory);
+    return success;
+}
+
 
 int main(int argc, char *argv[])
 {
-    unsigned int width=1920 , height=1080 , frameLimit=10000 , visualize = 0, useCPUOnly=1 , serialLength=5;
+    unsigned int width=1920 , height=1080 , frameLimit=10000 , visualize = 0, useCPUOnly=1 , serialLength=5 , numberOfThreads=1;
     const char * path=0;
     const char * label=0;
+    const char * archivePath=0;
+    //Optional temporal smoothing of the output
+    unsigned int filterType=MOCAPNET_FILTER_NONE;
+    float framerate=30.0,minCutoff=1.0,beta=0.01,smoothTime=0.1;
+    //Per stage timing statistics, .json files get a snapshot and .csv files a row per stage every interval
+    const char * statisticsPath=0;
+    unsigned int statisticsInterval=1000;
+    unsigned int testThreads=0;
 
     if (initializeBVHConverter())
         {
@@ -59,6 +492,75 @@ int main(int argc, char *argv[])
                         width = atoi(argv[i+1]);
                         height = atoi(argv[i+2]);
                     }
+                else if (strcmp(argv[i],"--archive")==0)
+                    {
+                        archivePath = argv[i+1];
+                    }
+                else if (strcmp(argv[i],"--oneeuro")==0)
+                    {
+                        filterType=MOCAPNET_FILTER_ONE_EURO;
+                        minCutoff = atof(argv[i+1]);
+                        beta = atof(argv[i+2]);
+                    }
+                else if (strcmp(argv[i],"--damped")==0)
+                    {
+                        filterType=MOCAPNET_FILTER_CRITICALLY_DAMPED;
+                        smoothTime = atof(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--fps")==0)
+                    {
+                        framerate = atof(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--stats")==0)
+                    {
+                        statisticsPath = argv[i+1];
+                    }
+                else if (strcmp(argv[i],"--statsinterval")==0)
+                    {
+                        statisticsInterval = atoi(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--threads")==0)
+                    {
+                        numberOfThreads = atoi(argv[i+1]);
+                        if (numberOfThreads==0)
+                            {
+                                numberOfThreads = std::thread::hardware_concurrency();
+                            }
+                    }
+                else if (strcmp(argv[i],"--testThreads")==0)
+                    {
+                        //Instead of processing a capture check that the sharded mode gives the same result with 1 and N workers
+                        testThreads = ( (i+1<argc) && (argv[i+1][0]!='-') ) ? atoi(argv[i+1]) : 4;
+                        if (testThreads<2)
+                            {
+                                testThreads=2;
+                            }
+                    }
+        }
+
+    if (testThreads>0)
+        {
+            GetTickCountMicrosecondsMN();
+            int result = testShardedMocapNET(testThreads,useCPUOnly);
+            if (result<0)
+                {
+                    return SELF_TEST_SKIPPED;
+                }
+            fprintf(stderr,"%s\n",(result) ? GREEN "1 and many workers give the same BVH file" NORMAL : RED "1 and many workers give different BVH files" NORMAL);
+            return (result) ? 0 : 1;
+        }
+
+    //The stage statistics are printed when we finish
+    enableStageTimers(1);
+    if (statisticsPath!=0)
+        {
+            setStageStatisticsDump(statisticsPath,statisticsInterval);
+        }
+
+    if ( (numberOfThreads>1) && (visualize) )
+        {
+            fprintf(stderr,"Visualization is not available when using more than one thread, disabling it..\n");
+            visualize=0;
         }
 
     if (path==0)
@@ -69,24 +571,81 @@ int main(int argc, char *argv[])
 
     if (label==0)
         {
-            label="colorFrame_0_";
+            label="colorFrame_0";
         }
 
 
+    char filePathOfJSONFile[1024]= {0};
+    snprintf(filePathOfJSONFile,1024,"%s/colorFrame_0_00000.jpg",path);
 
+    if ( getImageWidthHeight(filePathOfJSONFile,&width,&height) )
+        {
+            fprintf(stderr,"Image dimensions changed from default to %ux%u",width,height);
+        }
 
-    struct MocapNET mnet= {0};
-    if ( loadMocapNET(&mnet,"test",useCPUOnly) )
+    char formatString[128]= {0};
+    snprintf(formatString,128,"%%s/%%s_%%0%uu_keypoints.json",serialLength);
+
+    //Instead of parsing one JSON file per frame we can read all of them from a packed keypoint archive
+    struct keypointArchive archiveStorage;
+    struct keypointArchive * archive=0;
+    if (archivePath!=0)
+        {
+            if (!openKeypointArchive(&archiveStorage,archivePath))
+                {
+                    return 1;
+                }
+            archive=&archiveStorage;
+        }
+
+    struct MocapNETFilterBank filter;
+    if (filterType==MOCAPNET_FILTER_ONE_EURO)
         {
-            char filePathOfJSONFile[1024]= {0};
-            snprintf(filePathOfJSONFile,1024,"%s/colorFrame_0_00000.jpg",path);
+            initializeOneEuroFilterBank(&filter,MOCAPNET_OUTPUT_NUMBER,MOCAPNET_OUTPUT_HIP_ZROTATION,framerate,minCutoff,beta);
+        }
+    else if (filterType==MOCAPNET_FILTER_CRITICALLY_DAMPED)
+        {
+            initializeCriticallyDampedFilterBank(&filter,MOCAPNET_OUTPUT_NUMBER,MOCAPNET_OUTPUT_HIP_ZROTATION,framerate,smoothTime);
+        }
 
-            if ( getImageWidthHeight(filePathOfJSONFile,&width,&height) )
+    if (numberOfThreads>1)
+        {
+            //Make sure the tick base is initialized before any of the workers asks for it
+            GetTickCountMicrosecondsMN();
+
+            std::vector<std::vector<float> > bvhFrames;
+            if ( runShardedMocapNET(bvhFrames,formatString,path,label,archive,frameLimit,width,height,useCPUOnly,numberOfThreads) )
+                {
+                    //Smoothing needs the frames in order so it runs after the shards are merged
+                    if (filterType!=MOCAPNET_FILTER_NONE)
+                        {
+                            for (unsigned int frameID=0; frameID<bvhFrames.size(); frameID++)
+                                {
+                                    filterBankUpdateVector(&filter,bvhFrames[frameID],0.0);
+                                }
+                        }
+                    char * bvhHeaderToWrite=0;
+                    if ( writeBVHFile("out.bvh",bvhHeaderToWrite, bvhFrames) )
+                        {
+                            fprintf(stderr,"Successfully wrote %lu frames to bvh file.. \n",bvhFrames.size());
+                        }
+                    else
+                        {
+                            fprintf(stderr,"Failed to write %lu frames to bvh file.. \n",bvhFrames.size());
+                        }
+                }
+            if (archive!=0)
                 {
-                    fprintf(stderr,"Image dimensions changed from default to %ux%u",width,height);
+                    closeKeypointArchive(archive);
                 }
+            finishStageStatistics(statisticsPath);
+            return 0;
+        }
 
-            
+
+    struct MocapNET mnet= {0};
+    if ( loadMocapNET(&mnet,"test",useCPUOnly) )
+        {
            std::vector<std::vector<float> >  empty2DPointsInput; 
 
             float totalTime=0.0;
@@ -96,19 +655,18 @@ int main(int argc, char *argv[])
             struct skeletonCOCO skeleton= {0};
 
 
-            char formatString[128]= {0};
-            snprintf(formatString,128,"%%s/%%s_%%0%u_keypoints.json",serialLength);
-
-
             unsigned int frameID=0;
             while (frameID<frameLimit)
                 {
-
-                    snprintf(filePathOfJSONFile,1024,formatString,path,frameID);
-
-                    if (parseJsonCOCOSkeleton(filePathOfJSONFile,&skeleton))
+                    //A frame without people leaves the skeleton of the last frame with people in place
+                    unsigned int numberOfPeople=0;
+                    unsigned long readStart = startStageTimer();
+                    if (getSkeletonOfFrame(archive,formatString,path,label,frameID,&skeleton,&numberOfPeople))
                         {
+                            stopStageTimer(MOCAPNET_STAGE_CAPTURE,readStart);
+                            unsigned long flattenStart = startStageTimer();
                             std::vector<float> inputValues = flattenskeletonCOCOToVector(&skeleton,width,height);
+                            stopStageTimer(MOCAPNET_STAGE_PREPROCESS,flattenStart);
                             if (inputValues.size()==0)
                                 {
                                     fprintf(stderr,"Failed to read from JSON file..\n");
@@ -117,6 +675,10 @@ int main(int argc, char *argv[])
                             long startTime = GetTickCountMicrosecondsMN();
                             //--------------------------------------------------------
                             std::vector<float>  result = runMocapNET(&mnet,inputValues);
+                            if (filterType!=MOCAPNET_FILTER_NONE)
+                                {
+                                    filterBankUpdateVector(&filter,result,0.0);
+                                }
                             bvhFrames.push_back(result);
                             //--------------------------------------------------------
                             long endTime = GetTickCountMicrosecondsMN();
@@ -141,6 +703,7 @@ int main(int argc, char *argv[])
 
                             totalTime+=sampleTime;
                             ++totalSamples;
+                            dumpStageStatisticsIfDue();
 
                         }
                     else
@@ -175,4 +738,10 @@ int main(int argc, char *argv[])
 
             unloadMocapNET(&mnet);
         }
+
+    if (archive!=0)
+        {
+            closeKeypointArchive(archive);
+        }
+    finishStageStatistics(statisticsPath);
 }
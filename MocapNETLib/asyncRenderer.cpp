@@ -0,0 +1,278 @@
+#include "asyncRenderer.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <thread>
+#include "boundedQueue.hpp"
+
+#if USE_OPENCV
+#include "opencv2/opencv.hpp"
+#include "visualization.hpp"
+#endif
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+
+struct MocapNETAsyncRenderer
+{
+    int sinkType;
+    char output[512];
+    unsigned int width;
+    unsigned int height;
+    float videoFramerate;
+
+    //Records waiting to be drawn, when the worker falls behind the oldest ones are skipped
+    BoundedQueue<struct MocapNETRenderRecord> records;
+#if USE_OPENCV
+    //Frames drawn for a window sink, HighGUI is not thread safe so they are shown by presentAsyncRendererFrame on the caller's thread
+    BoundedQueue<cv::Mat> composed;
+#endif
+    std::atomic<unsigned int> framesRendered;
+
+    std::thread worker;
+
+    MocapNETAsyncRenderer(unsigned int queueSize) :
+        records(queueSize,1)
+#if USE_OPENCV
+        ,composed(1,1)
+#endif
+    {
+    }
+};
+
+
+int getRenderSinkTypeFromPath(const char * path)
+{
+    const char * extension = strrchr(path,'.');
+    if (extension!=0)
+        {
+            if ( (strcasecmp(extension,".avi")==0) || (strcasecmp(extension,".mp4")==0) || (strcasecmp(extension,".mkv")==0) )
+                {
+                    return MNET_RENDER_SINK_VIDEO;
+                }
+        }
+    return MNET_RENDER_SINK_IMAGES;
+}
+
+
+#if USE_OPENCV
+static int renderRecord(struct MocapNETAsyncRenderer * renderer,struct MocapNETRenderRecord * record,struct MocapNETVisualizer * vis,cv::VideoWriter &video)
+{
+    if (
+        !visualizerDrawFrame(
+            vis,
+            record->frameNumber,
+            record->skippedFrames,
+            record->totalNumberOfFrames,
+            record->numberOfFramesToGrab,
+            record->drawFloor,
+            record->drawNSDM,
+            record->fpsTotal,
+            record->fpsAcquisition,
+            record->joint2DEstimator,
+            record->fpsMocapNET,
+            record->mocapNETInput,
+            record->mocapNETOutput,
+            record->mocapNETOutputWithGUIForcedView,
+            record->points2DOutputGUIForcedView,
+            0,
+            0
+        )
+    )
+        {
+            return 0;
+        }
+    const cv::Mat &img = *getVisualizerCanvas(vis);
+
+    switch (renderer->sinkType)
+        {
+        case MNET_RENDER_SINK_WINDOW :
+        {
+            //Only the latest composed frame is kept, the canvas is reused by the next frame so a copy is handed over
+            cv::Mat frame = img.clone();
+            return renderer->composed.push(frame);
+        }
+
+        case MNET_RENDER_SINK_IMAGES :
+        {
+            char filename[1024];
+            snprintf(filename,1024,"%s/frame_%05u.png",renderer->output,record->frameNumber);
+            if (!cv::imwrite(filename,img))
+                {
+                    fprintf(stderr,RED "Could not write %s\n" NORMAL,filename);
+                    return 0;
+                }
+            return 1;
+        }
+
+        case MNET_RENDER_SINK_VIDEO :
+            if (!video.isOpened())
+                {
+                    const char * extension = strrchr(renderer->output,'.');
+                    int fourcc = cv::VideoWriter::fourcc('M','J','P','G');
+                    if ( (extension!=0) && (strcasecmp(extension,".mp4")==0) )
+                        {
+                            fourcc = cv::VideoWriter::fourcc('m','p','4','v');
+                        }
+                    if (!video.open(renderer->output,fourcc,renderer->videoFramerate,cv::Size(renderer->width,renderer->height),true))
+                        {
+                            fprintf(stderr,RED "Could not open video file %s for writing\n" NORMAL,renderer->output);
+                            return 0;
+                        }
+                }
+            video.write(img);
+            return 1;
+        }
+    return 0;
+}
+#endif
+
+
+static void renderWorker(struct MocapNETAsyncRenderer * renderer)
+{
+#if USE_OPENCV
+    //The worker owns its visualizer so canvas and background are reused for every frame it renders
+    struct MocapNETVisualizer * vis = createVisualizer(renderer->output,renderer->width,renderer->height);
+    cv::VideoWriter video;
+    struct MocapNETRenderRecord record;
+
+    //pop fails once the queue has been closed and everything in it has been rendered
+    while (renderer->records.pop(record))
+        {
+            if (renderRecord(renderer,&record,vis,video))
+                {
+                    ++renderer->framesRendered;
+                }
+        }
+    renderer->composed.close();
+
+    if (video.isOpened())
+        {
+            video.release();
+        }
+    destroyVisualizer(vis);
+#endif
+}
+
+
+struct MocapNETAsyncRenderer * createAsyncRenderer(
+    int sinkType,
+    const char * output,
+    unsigned int width,
+    unsigned int height,
+    unsigned int queueSize,
+    float videoFramerate
+)
+{
+#if USE_OPENCV
+    if ( (output==0) || (width==0) || (height==0) )
+        {
+            fprintf(stderr,RED "createAsyncRenderer: incorrect parameters\n" NORMAL);
+            return 0;
+        }
+
+    struct MocapNETAsyncRenderer * renderer = new struct MocapNETAsyncRenderer(queueSize);
+    renderer->sinkType=sinkType;
+    snprintf(renderer->output,512,"%s",output);
+    renderer->width=width;
+    renderer->height=height;
+    renderer->videoFramerate=(videoFramerate>0.0) ? videoFramerate : 30.0;
+    renderer->framesRendered=0;
+    if (sinkType==MNET_RENDER_SINK_IMAGES)
+        {
+            //It is fine if the directory already exists
+            mkdir(output,0755);
+        }
+    renderer->worker = std::thread(renderWorker,renderer);
+    return renderer;
+#else
+    fprintf(stderr,"OpenCV code not present in this build, cannot render..\n");
+    return 0;
+#endif
+}
+
+
+int submitFrameToAsyncRenderer(struct MocapNETAsyncRenderer * renderer,struct MocapNETRenderRecord * record)
+{
+    if ( (renderer==0) || (record==0) )
+        {
+            return 0;
+        }
+
+    //Latency matters more than completeness, if the worker falls behind the oldest frames are skipped
+    return renderer->records.push(*record);
+}
+
+
+int presentAsyncRendererFrame(struct MocapNETAsyncRenderer * renderer)
+{
+#if USE_OPENCV
+    if ( (renderer==0) || (renderer->sinkType!=MNET_RENDER_SINK_WINDOW) )
+        {
+            return 0;
+        }
+    cv::Mat frame;
+    if (!renderer->composed.tryPop(frame))
+        {
+            return 0;
+        }
+    cv::imshow(renderer->output,frame);
+    cv::waitKey(1);
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+
+int getAsyncRendererStatistics(struct MocapNETAsyncRenderer * renderer,unsigned int * framesRendered,unsigned int * framesDropped)
+{
+    if (renderer==0)
+        {
+            return 0;
+        }
+    if (framesRendered!=0)
+        {
+            *framesRendered=renderer->framesRendered;
+        }
+    if (framesDropped!=0)
+        {
+            //Frames composed for a window but replaced by a newer one before they were shown are also dropped
+            *framesDropped=renderer->records.getDropped();
+#if USE_OPENCV
+            *framesDropped+=renderer->composed.getDropped();
+#endif
+        }
+    return 1;
+}
+
+
+int destroyAsyncRenderer(struct MocapNETAsyncRenderer * renderer)
+{
+    if (renderer==0)
+        {
+            return 0;
+        }
+
+    //The worker renders what is still queued and then stops
+    renderer->records.close();
+    if (renderer->worker.joinable())
+        {
+            renderer->worker.join();
+        }
+    //The last frame composed for a window is shown before it goes away
+    presentAsyncRendererFrame(renderer);
+
+    unsigned int framesRendered=0,framesDropped=0;
+    getAsyncRendererStatistics(renderer,&framesRendered,&framesDropped);
+    fprintf(stderr,GREEN "Renderer finished, %u frames rendered, %u frames dropped\n" NORMAL,framesRendered,framesDropped);
+    delete renderer;
+    return 1;
+}
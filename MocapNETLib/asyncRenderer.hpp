@@ -0,0 +1,119 @@
+#pragma once
+/** @file asyncRenderer.hpp
+ *  @brief A render worker that draws MocapNET output on its own thread so that visualization does not add to the latency of the
+ *  capture/inference loop. Frames are handed over as compact records through a BoundedQueue ( boundedQueue.hpp ), when the worker cannot
+ *  keep up the oldest queued frames are dropped. Rendered frames can be written to a PNG sequence or a video file, so review renders can also
+ *  be produced on machines without a display, or shown on a window. Since HighGUI is not thread safe the worker only composes frames for a
+ *  window, they are shown by presentAsyncRendererFrame on the thread that owns the other windows.
+ *  If OpenCV is not available ( no USE_OPENCV compilation flag ) creating a renderer will always fail.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include <iostream>
+#include <vector>
+
+
+/**
+ * @brief Where rendered frames end up
+ */
+enum MocapNETRenderSinkType
+{
+    MNET_RENDER_SINK_WINDOW=0,
+    MNET_RENDER_SINK_IMAGES,
+    MNET_RENDER_SINK_VIDEO
+};
+
+
+/**
+ * @brief Everything needed to draw one frame, this is the same data visualizePoints receives
+ */
+struct MocapNETRenderRecord
+{
+    unsigned int frameNumber;
+    unsigned int skippedFrames;
+    signed int totalNumberOfFrames;
+    unsigned int numberOfFramesToGrab;
+    int drawFloor;
+    int drawNSDM;
+    float fpsTotal;
+    float fpsAcquisition;
+    float joint2DEstimator;
+    float fpsMocapNET;
+    std::vector<float> mocapNETInput;
+    std::vector<float> mocapNETOutput;
+    std::vector<float> mocapNETOutputWithGUIForcedView;
+    std::vector<std::vector<float> > points2DInput;
+    std::vector<std::vector<float> > points2DOutput;
+    std::vector<std::vector<float> > points2DOutputGUIForcedView;
+};
+
+
+/**
+ * @brief Opaque handle of a render worker
+ */
+struct MocapNETAsyncRenderer;
+
+
+/**
+ * @brief Pick a sink type based on a path, paths ending in .avi/.mp4/.mkv are videos, anything else is a directory for a PNG sequence
+ * @param Path of the output
+ * @retval MNET_RENDER_SINK_IMAGES or MNET_RENDER_SINK_VIDEO
+ */
+int getRenderSinkTypeFromPath(const char * path);
+
+
+/**
+ * @brief Start a render worker thread
+ * @param Type of the sink ( see enum MocapNETRenderSinkType )
+ * @param Window name for MNET_RENDER_SINK_WINDOW ( see presentAsyncRendererFrame ), output directory for MNET_RENDER_SINK_IMAGES ( frames are written as frame_00000.png .. ) or video file for MNET_RENDER_SINK_VIDEO
+ * @param Width of rendered frames
+ * @param Height of rendered frames
+ * @param Maximum number of frames waiting to be rendered, when it is reached the oldest waiting frame is dropped
+ * @param Framerate stored in video files
+ * @retval Pointer to a renderer, 0 = Failure
+ */
+struct MocapNETAsyncRenderer * createAsyncRenderer(
+    int sinkType,
+    const char * output,
+    unsigned int width,
+    unsigned int height,
+    unsigned int queueSize,
+    float videoFramerate
+);
+
+
+/**
+ * @brief Queue a frame for rendering, this never blocks on drawing. The vectors of the record are moved to the queue
+ * so the record will be left empty and can be reused for the next frame.
+ * @param Pointer to a renderer
+ * @param Pointer to the record of the frame
+ * @retval 1 = Queued , 0 = Failure
+ */
+int submitFrameToAsyncRenderer(struct MocapNETAsyncRenderer * renderer,struct MocapNETRenderRecord * record);
+
+
+/**
+ * @brief Show the latest frame composed for a MNET_RENDER_SINK_WINDOW renderer and handle window events, call it from the thread
+ * that owns the rest of the windows ( normally the main thread ) once per frame. Other sinks are written by the worker so this does nothing for them.
+ * @param Pointer to a renderer
+ * @retval 1 = A frame was shown , 0 = Nothing new to show
+ */
+int presentAsyncRendererFrame(struct MocapNETAsyncRenderer * renderer);
+
+
+/**
+ * @brief Get counters of a renderer
+ * @param Pointer to a renderer
+ * @param Pointer to an unsigned int that will receive the number of frames rendered so far, can be null
+ * @param Pointer to an unsigned int that will receive the number of frames dropped because the queue was full, can be null
+ * @retval 1 = Success , 0 = Failure
+ */
+int getAsyncRendererStatistics(struct MocapNETAsyncRenderer * renderer,unsigned int * framesRendered,unsigned int * framesDropped);
+
+
+/**
+ * @brief Render everything still queued, stop the worker thread, close the sink and free the renderer
+ * @param Pointer to a renderer
+ * @retval 1 = Success , 0 = Failure
+ */
+int destroyAsyncRenderer(struct MocapNETAsyncRenderer * renderer);
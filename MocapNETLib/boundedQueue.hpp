@@ -0,0 +1,141 @@
+#pragma once
+/** @file boundedQueue.hpp
+ *  @brief A small thread safe FIFO with a fixed capacity used to hand work between the threads of a pipeline.
+ *  When the queue is full a producer either waits for room or, if the queue was created with dropOldest set, throws away
+ *  the oldest waiting item so that consumers always get the most recent data ( latest-frame-wins ).
+ *  Closing a queue wakes everyone up, consumers still receive what is left in it and then get a failure.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+
+template<typename T>
+class BoundedQueue
+{
+public:
+    /**
+     * @brief Create a queue
+     * @param Maximum number of waiting items, 0 is treated as 1
+     * @param If set, push never blocks and the oldest waiting item is dropped when the queue is full
+     */
+    BoundedQueue(unsigned int capacity,int dropOldest) :
+        capacity( (capacity>0) ? capacity : 1 ),
+        dropOldest(dropOldest),
+        closed(0),
+        dropped(0)
+    {
+    }
+
+    /**
+     * @brief Add an item, the item is moved in to the queue
+     * @param Item to add
+     * @retval 1 = Queued , 0 = The queue has been closed
+     */
+    int push(T &item)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (dropOldest)
+                {
+                    while ( (!closed) && (queue.size()>=capacity) )
+                        {
+                            queue.pop_front();
+                            ++dropped;
+                        }
+                }
+            else
+                {
+                    while ( (!closed) && (queue.size()>=capacity) )
+                        {
+                            haveRoom.wait(guard);
+                        }
+                }
+            if (closed)
+                {
+                    return 0;
+                }
+            queue.push_back(std::move(item));
+        }
+        haveItems.notify_one();
+        return 1;
+    }
+
+    /**
+     * @brief Take the oldest item out of the queue, waits until there is one
+     * @param Item that will receive the data
+     * @retval 1 = Got an item , 0 = The queue has been closed and is empty
+     */
+    int pop(T &item)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while ( (!closed) && (queue.empty()) )
+                {
+                    haveItems.wait(guard);
+                }
+            if (queue.empty())
+                {
+                    return 0;
+                }
+            item = std::move(queue.front());
+            queue.pop_front();
+        }
+        haveRoom.notify_one();
+        return 1;
+    }
+
+    /**
+     * @brief Take the oldest item out of the queue if there is one, this never waits
+     * @param Item that will receive the data
+     * @retval 1 = Got an item , 0 = The queue is empty
+     */
+    int tryPop(T &item)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (queue.empty())
+                {
+                    return 0;
+                }
+            item = std::move(queue.front());
+            queue.pop_front();
+        }
+        haveRoom.notify_one();
+        return 1;
+    }
+
+    /**
+     * @brief Stop accepting items and wake up every waiting thread
+     */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closed=1;
+        }
+        haveItems.notify_all();
+        haveRoom.notify_all();
+    }
+
+    /**
+     * @brief Number of items dropped so far because the queue was full
+     */
+    unsigned int getDropped()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return dropped;
+    }
+
+private:
+    unsigned int capacity;
+    int dropOldest;
+    int closed;
+    unsigned int dropped;
+    std::deque<T> queue;
+    std::mutex lock;
+    std::condition_variable haveItems;
+    std::condition_variable haveRoom;
+};
@@ -1,5 +1,7 @@
 #include "bvh.hpp"
+#include <stdlib.h>
 #include <string.h>
+#include <mutex>
 
 #if USE_BVH
 #include "../RGBDAcquisition/tools/AmMatrix/matrix4x4Tools.h"
@@ -8,13 +10,24 @@
 #include "../RGBDAcquisition/opengl_acquisition_shared_library/opengl_depth_and_color_renderer/src/Library/MotionCaptureLoader/bvh_transform.h"
 struct BVH_MotionCapture bvhMotion= {0};
 struct BVH_Transform bvhTransform= {0};
-int haveBVHInit=0;
 #else
-#warning "BVH code not included.."
+#warning "BVH code not included, using native forward kinematics.."
 #endif // USE_BVH
+#include "mocapnetRegistry.hpp"
+#include "instrumentation.hpp"
+//The native forward kinematics skeleton is always loaded since incremental projection uses it even when the BVH code is present
+struct MocapNETFKSkeleton fkSkeleton= {0};
+int haveBVHInit=0;
+std::mutex bvhInitLock;
 
 int initializeBVHConverter()
 {
+    //The native forward kinematics use the hierarchy embedded in mocapnet.hpp
+    if (!mocapnetFKLoadSkeleton(&fkSkeleton,bvhHeader))
+        {
+            fprintf(stderr,"initializeBVHConverter: Failed to parse embedded BVH header..\n");
+            return 0;
+        }
 #if USE_BVH
     if ( bvh_loadBVH("dataset/headerAndOneMotion.bvh",&bvhMotion,1.0) )
         {
@@ -25,10 +38,11 @@ int initializeBVHConverter()
         {
             fprintf(stderr,"initializeBVHConverter: Failed to bvh_loadBVH(header.bvh)..\n");
         }
+    return 0;
 #else
-    fprintf(stderr,"initializeBVHConverter:  BVH code not compiled in..\n");
+    haveBVHInit=1;
+    return 1;
 #endif // USE_BVH
-    return 0;
 }
 
 float * mallocVector(std::vector<float> bvhFrame)
@@ -36,7 +50,7 @@ float * mallocVector(std::vector<float> bvhFrame)
     float * newVector = (float*) malloc(sizeof(float) * bvhFrame.size());
     if (newVector!=0)
         {
-            for (int i=0; i<bvhFrame.size(); i++)
+            for (unsigned int i=0; i<bvhFrame.size(); i++)
                 {
                     newVector[i]=bvhFrame[i];
                 }
@@ -49,6 +63,11 @@ unsigned int getBVHParentJoint(unsigned int currentJoint)
 {
 #if USE_BVH
     return bhv_getJointParent(&bvhMotion,currentJoint);
+#else
+    if (fkSkeleton.numberOfJoints>currentJoint)
+        {
+            return fkSkeleton.parent[currentJoint];
+        }
 #endif
     return 0;
 }
@@ -61,6 +80,11 @@ const char * getBVHJointName(unsigned int currentJoint)
         {
             return bvhMotion.jointHierarchy[currentJoint].jointName;
         }
+#else
+    if (fkSkeleton.numberOfJoints>currentJoint)
+        {
+            return fkSkeleton.jointName[currentJoint];
+        }
 #endif
     return 0;
 }
@@ -71,6 +95,14 @@ const char * getBVHJointName(unsigned int currentJoint)
 
 unsigned int getBVHJointIDFromJointName(const char * jointName)
 {
+    //The MocapNET skeleton is known at compile time so this is a perfect hash lookup, loaded hierarchies are only scanned
+    //for names that are not part of it
+    unsigned int registryJointID=0;
+    if (mocapnetRegistryGetBVHJointID(jointName,&registryJointID))
+        {
+            return registryJointID;
+        }
+
 #if USE_BVH
     int i=0;
     for (i=0; i<bvhMotion.jointHierarchySize; i++)
@@ -80,14 +112,84 @@ unsigned int getBVHJointIDFromJointName(const char * jointName)
           return  i;
         }
     }  
+#else
+    unsigned int jointID=0;
+    if (mocapnetFKGetJointID(&fkSkeleton,jointName,&jointID))
+        {
+            return jointID;
+        }
 #endif
     return 0;
 }
 
 
-std::vector<std::vector<float> > convertBVHFrameTo2DPoints(std::vector<float> bvhFrame,unsigned int width, unsigned int height)
+int createBVHProjectionContext(struct BVHProjectionContext * ctx,unsigned int width,unsigned int height)
 {
-    
+    memset(ctx,0,sizeof(struct BVHProjectionContext));
+    {
+        //Contexts may be created from different threads, the shared hierarchy must only be loaded once
+        std::lock_guard<std::mutex> lock(bvhInitLock);
+        if (!haveBVHInit)
+            {
+                initializeBVHConverter();
+            }
+    }
+    if (!haveBVHInit)
+        {
+            fprintf(stderr,"Could not initialize BVH subsystem..\n");
+            return 0;
+        }
+
+#if USE_BVH
+    ctx->renderer  = (struct simpleRenderer *) calloc(1,sizeof(struct simpleRenderer));
+    ctx->transform = (struct BVH_Transform *)  calloc(1,sizeof(struct BVH_Transform));
+    ctx->numberOfJoints = bvhMotion.jointHierarchySize;
+    ctx->points2D  = (float *) calloc(ctx->numberOfJoints * 2,sizeof(float));
+    ctx->motionBufferSize = bvhMotion.numberOfValuesPerFrame;
+    ctx->motionBuffer = (float *) calloc(ctx->motionBufferSize,sizeof(float));
+    ctx->fkState = (struct MocapNETFKState *) calloc(1,sizeof(struct MocapNETFKState));
+
+    if ( (ctx->renderer==0) || (ctx->transform==0) || (ctx->points2D==0) || (ctx->motionBuffer==0) || (ctx->fkState==0) )
+        {
+            fprintf(stderr,"Could not allocate enough memory..\n");
+            destroyBVHProjectionContext(ctx);
+            return 0;
+        }
+
+    return setBVHProjectionContextSize(ctx,width,height);
+#else
+    ctx->fkState = (struct MocapNETFKState *) calloc(1,sizeof(struct MocapNETFKState));
+    ctx->numberOfJoints = fkSkeleton.numberOfJoints;
+    ctx->points2D  = (float *) calloc(ctx->numberOfJoints * 2,sizeof(float));
+
+    if ( (ctx->fkState==0) || (ctx->points2D==0) )
+        {
+            fprintf(stderr,"Could not allocate enough memory..\n");
+            destroyBVHProjectionContext(ctx);
+            return 0;
+        }
+
+    return setBVHProjectionContextSize(ctx,width,height);
+#endif // USE_BVH
+}
+
+
+int setBVHProjectionContextSize(struct BVHProjectionContext * ctx,unsigned int width,unsigned int height)
+{
+#if USE_BVH
+    if (ctx->renderer==0)
+        {
+            return 0;
+        }
+    if ( (ctx->width==width) && (ctx->height==height) )
+        {
+            return 1;
+        }
+    if (ctx->fkState!=0)
+        {
+            mocapnetFKDefaultCamera(&ctx->fkCamera,width,height);
+        }
+
     /*
         renderingConfiguration.width=1920;
     renderingConfiguration.height=1080;
@@ -96,86 +198,250 @@ std::vector<std::vector<float> > convertBVHFrameTo2DPoints(std::vector<float> bv
     renderingConfiguration.fX=582.18394;
     renderingConfiguration.fY=582.52915;
     */
-    
-    std::vector<std::vector<float> > result;
-#if USE_BVH
-    struct simpleRenderer renderer= {0};
+    memset(ctx->renderer,0,sizeof(struct simpleRenderer));
     simpleRendererDefaults(
-        &renderer,
+        ctx->renderer,
         width,
         height,
         582.18394, //570.0
         582.52915  //570.0
     );
-    simpleRendererInitialize(&renderer);
-    if (!haveBVHInit)
+    simpleRendererInitialize(ctx->renderer);
+    ctx->width=width;
+    ctx->height=height;
+    return 1;
+#else
+    if (ctx->fkState==0)
         {
-            initializeBVHConverter();
+            return 0;
         }
+    mocapnetFKDefaultCamera(&ctx->fkCamera,width,height);
+    ctx->width=width;
+    ctx->height=height;
+    return 1;
+#endif // USE_BVH
+}
 
 
-    if (haveBVHInit)
+unsigned int projectBVHFrameTo2DPoints(struct BVHProjectionContext * ctx,const float * bvhFrame,unsigned int bvhFrameSize)
+{
+#if USE_BVH
+    if ( (ctx->renderer==0) || (bvhFrame==0) )
         {
-            float * motionBuffer= mallocVector(bvhFrame);
+            return 0;
+        }
 
-            if (motionBuffer!=0)
+    //The BVH loader wants a mutable buffer so we keep our own copy instead of allocating one on every call
+    if (bvhFrameSize>ctx->motionBufferSize)
+        {
+            float * newBuffer = (float *) realloc(ctx->motionBuffer,sizeof(float) * bvhFrameSize);
+            if (newBuffer==0)
                 {
-                    if (
-                        bvh_loadTransformForMotionBuffer(
-                            &bvhMotion,
-                            motionBuffer,
-                            &bvhTransform
-                        )
-                    )
-                        {
-                            //-----------------
-                            if (
-                                bvh_projectTo2D(
-                                    &bvhMotion,
-                                    &bvhTransform,
-                                    &renderer,
-                                    0,
-                                    0
-                                )
-                            )
-                                {
-                                    //-----------------
-                                    for (unsigned int jID=0; jID<bvhMotion.jointHierarchySize; jID++)
-                                        {
-                                            std::vector<float> point;
-                                            point.clear();
-                                            point.push_back((float) bvhTransform.joint[jID].pos2D[0]);
-                                            point.push_back((float) bvhTransform.joint[jID].pos2D[1]);
-                                            result.push_back(point);
-                                        }
-                                } //-----------------
-                        } //-----------------
-                    else
+                    fprintf(stderr,"Could not allocate enough memory..\n");
+                    return 0;
+                }
+            ctx->motionBuffer=newBuffer;
+            ctx->motionBufferSize=bvhFrameSize;
+        }
+    memcpy(ctx->motionBuffer,bvhFrame,sizeof(float) * bvhFrameSize);
+
+    if (
+        bvh_loadTransformForMotionBuffer(
+            &bvhMotion,
+            ctx->motionBuffer,
+            ctx->transform
+        )
+    )
+        {
+            if (
+                bvh_projectTo2D(
+                    &bvhMotion,
+                    ctx->transform,
+                    ctx->renderer,
+                    0,
+                    0
+                )
+            )
+                {
+                    for (unsigned int jID=0; jID<ctx->numberOfJoints; jID++)
                         {
-                            fprintf(stderr,"bvh_loadTransformForMotionBuffer failed..\n");
+                            ctx->points2D[jID*2+0]=(float) ctx->transform->joint[jID].pos2D[0];
+                            ctx->points2D[jID*2+1]=(float) ctx->transform->joint[jID].pos2D[1];
                         }
-                    free(motionBuffer);
+                    return ctx->numberOfJoints;
                 }
-            else
+        }
+    else
+        {
+            fprintf(stderr,"bvh_loadTransformForMotionBuffer failed..\n");
+        }
+#else
+    if ( (ctx->fkState==0) || (bvhFrame==0) )
+        {
+            return 0;
+        }
+
+    if ( mocapnetFKEvaluate(&fkSkeleton,ctx->fkState,bvhFrame,bvhFrameSize) )
+        {
+            mocapnetFKProject(&fkSkeleton,ctx->fkState,&ctx->fkCamera);
+            for (unsigned int jID=0; jID<ctx->numberOfJoints; jID++)
                 {
-                    fprintf(stderr,"Could not allocate enough memory..\n");
+                    ctx->points2D[jID*2+0]=ctx->fkState->pos2DX[jID];
+                    ctx->points2D[jID*2+1]=ctx->fkState->pos2DY[jID];
                 }
+            return ctx->numberOfJoints;
         }
     else
         {
-            fprintf(stderr,"Could not initialize BVH subsystem..\n");
+            fprintf(stderr,"mocapnetFKEvaluate failed..\n");
         }
+#endif // USE_BVH
+    return 0;
+}
 
 
-#else
-    fprintf(stderr,"BVH code is not compiled in this version of MocapNET\n");
+unsigned int projectBVHFrameTo2DPointsIncremental(struct BVHProjectionContext * ctx,const float * bvhFrame,unsigned int bvhFrameSize)
+{
+    if ( (ctx->fkState==0) || (bvhFrame==0) )
+        {
+            return 0;
+        }
+    if (fkSkeleton.numberOfJoints!=ctx->numberOfJoints)
+        {
+            fprintf(stderr,"projectBVHFrameTo2DPointsIncremental: BVH hierarchy does not match the native one..\n");
+            return 0;
+        }
 
-#endif // USE_BVH
+    if ( mocapnetFKEvaluateIncremental(&fkSkeleton,ctx->fkState,bvhFrame,bvhFrameSize)>=0 )
+        {
+            //Projection depends on the camera so it is always redone, it is cheap compared to the transforms
+            mocapnetFKProject(&fkSkeleton,ctx->fkState,&ctx->fkCamera);
+            for (unsigned int jID=0; jID<ctx->numberOfJoints; jID++)
+                {
+                    ctx->points2D[jID*2+0]=ctx->fkState->pos2DX[jID];
+                    ctx->points2D[jID*2+1]=ctx->fkState->pos2DY[jID];
+                }
+            return ctx->numberOfJoints;
+        }
+    else
+        {
+            fprintf(stderr,"mocapnetFKEvaluateIncremental failed..\n");
+        }
+    return 0;
+}
+
+
+unsigned int projectBVHFramesTo2DPoints(struct BVHProjectionContext * ctx,const float * bvhFrames,unsigned int numberOfFrames,unsigned int bvhFrameSize,float * output)
+{
+    unsigned int framesProjected=0;
+    unsigned int pointsPerFrame = ctx->numberOfJoints * 2;
+
+    for (unsigned int frameID=0; frameID<numberOfFrames; frameID++)
+        {
+            float * frameOutput = output + frameID * pointsPerFrame;
+            if ( projectBVHFrameTo2DPoints(ctx,bvhFrames + frameID * bvhFrameSize,bvhFrameSize) )
+                {
+                    memcpy(frameOutput,ctx->points2D,sizeof(float) * pointsPerFrame);
+                    ++framesProjected;
+                }
+            else
+                {
+                    memset(frameOutput,0,sizeof(float) * pointsPerFrame);
+                }
+        }
+
+    return framesProjected;
+}
+
+
+int destroyBVHProjectionContext(struct BVHProjectionContext * ctx)
+{
+    if (ctx->renderer!=0)
+        {
+            free(ctx->renderer);
+        }
+    if (ctx->transform!=0)
+        {
+            free(ctx->transform);
+        }
+    if (ctx->fkState!=0)
+        {
+            free(ctx->fkState);
+        }
+    if (ctx->motionBuffer!=0)
+        {
+            free(ctx->motionBuffer);
+        }
+    if (ctx->points2D!=0)
+        {
+            free(ctx->points2D);
+        }
+    memset(ctx,0,sizeof(struct BVHProjectionContext));
+    return 1;
+}
+
+
+std::vector<std::vector<float> > convertBVHFrameTo2DPoints(std::vector<float> bvhFrame,unsigned int width, unsigned int height)
+{
+    std::vector<std::vector<float> > result;
+    //Every thread that uses this call gets its own context that is reused across calls
+    static thread_local struct BVHProjectionContext ctx= {0};
+    if (ctx.points2D==0)
+        {
+            if (!createBVHProjectionContext(&ctx,width,height))
+                {
+                    return result;
+                }
+        }
+    setBVHProjectionContextSize(&ctx,width,height);
+
+    unsigned long startTime = startStageTimer();
+    unsigned int numberOfJoints = projectBVHFrameTo2DPoints(&ctx,bvhFrame.data(),bvhFrame.size());
+    stopStageTimer(MOCAPNET_STAGE_FORWARD_KINEMATICS,startTime);
+    for (unsigned int jID=0; jID<numberOfJoints; jID++)
+        {
+            std::vector<float> point;
+            point.push_back(ctx.points2D[jID*2+0]);
+            point.push_back(ctx.points2D[jID*2+1]);
+            result.push_back(point);
+        }
     return result;
 }
 
 
 
+std::vector<std::vector<float> > convertBVHFrameTo2DPointsIncremental(std::vector<float> bvhFrame,unsigned int width, unsigned int height)
+{
+    std::vector<std::vector<float> > result;
+    //Kept apart from the context of convertBVHFrameTo2DPoints so that the two do not invalidate each other's cache
+    static thread_local struct BVHProjectionContext ctx= {0};
+    if (ctx.points2D==0)
+        {
+            if (!createBVHProjectionContext(&ctx,width,height))
+                {
+                    return result;
+                }
+        }
+    //Only the camera is needed here, switching sizes between calls should not reinitialize the renderer of the BVH code
+    if ( (ctx.fkCamera.width!=(float) width) || (ctx.fkCamera.height!=(float) height) )
+        {
+            mocapnetFKDefaultCamera(&ctx.fkCamera,width,height);
+        }
+
+    unsigned long startTime = startStageTimer();
+    unsigned int numberOfJoints = projectBVHFrameTo2DPointsIncremental(&ctx,bvhFrame.data(),bvhFrame.size());
+    stopStageTimer(MOCAPNET_STAGE_FORWARD_KINEMATICS,startTime);
+    for (unsigned int jID=0; jID<numberOfJoints; jID++)
+        {
+            std::vector<float> point;
+            point.push_back(ctx.points2D[jID*2+0]);
+            point.push_back(ctx.points2D[jID*2+1]);
+            result.push_back(point);
+        }
+    return result;
+}
+
+
 
 std::vector<std::vector<float> > convert3DGridTo2DPoints(float roll,float pitch,float yaw,unsigned int width, unsigned int height,unsigned int dimensions)
 {
@@ -1,12 +1,17 @@
 #pragma once
 /** @file bvh.hpp
  *  @brief This is an interface to the BVH code. The BVH code ( https://github.com/AmmarkoV/RGBDAcquisition/tree/master/opengl_acquisition_shared_library/opengl_depth_and_color_renderer/src/Library/MotionCaptureLoader )
- *  might not be available. If this is the case then CMake will not declare the USE_BVH compilation flag and the whole code will not be included.
+ *  might not be available. If this is the case then CMake will not declare the USE_BVH compilation flag and the native forward kinematics
+ *  code of forwardKinematics.hpp will be used instead.
  *  @author Ammar Qammaz (AmmarkoV)
  */
 
 #include <iostream>
 #include <vector>
+#include "forwardKinematics.hpp"
+
+struct simpleRenderer;
+struct BVH_Transform;
 
 
 /**
@@ -54,6 +59,105 @@ std::vector<std::vector<float> > convertBVHFrameTo2DPoints(
     unsigned int height
 );
 
+/**
+ * @brief Same as convertBVHFrameTo2DPoints but always uses the native forward kinematics and caches the transforms of the body
+ * relative to the root between calls. Consecutive frames that only differ in their root position/rotation ( like a pose and its forced view )
+ * only recompute the root transform. Every thread gets its own cache.
+ * @param  A float corresponding to a BVH frame
+ * @param  The width of the 2D frame that will hold the 2D Points
+ * @param  The height of the 2D frame that will hold the 2D Points
+ * @retval Vector of 2D points
+ */
+std::vector<std::vector<float> > convertBVHFrameTo2DPointsIncremental(
+    std::vector<float> bvhFrame,
+    unsigned int width,
+    unsigned int height
+);
+
+
+/**
+ * @brief A projection context owns everything needed to project BVH frames to 2D ( renderer, transform scratch space,
+ * a copy of the motion buffer and the output ) so that converting frames does not touch any global state.
+ * Every thread that needs to project frames should create its own context, after that contexts can be used concurrently.
+ */
+struct BVHProjectionContext
+{
+    struct simpleRenderer * renderer;
+    struct BVH_Transform * transform;
+    //Used instead of the renderer/transform when the BVH code is not compiled in and always by incremental projection
+    struct MocapNETFKState * fkState;
+    struct MocapNETFKCamera fkCamera;
+    float * motionBuffer;
+    unsigned int motionBufferSize;
+    unsigned int width;
+    unsigned int height;
+    //Output of the last projection, numberOfJoints pairs of x,y
+    unsigned int numberOfJoints;
+    float * points2D;
+};
+
+
+/**
+ * @brief Allocate a projection context, this will also initialize the BVH code if it has not been initialized yet
+ * @param Pointer to a struct BVHProjectionContext that will be populated
+ * @param The width of the 2D frame that will hold the 2D Points
+ * @param The height of the 2D frame that will hold the 2D Points
+ * @retval 1=Success/0=Failure
+ */
+int createBVHProjectionContext(struct BVHProjectionContext * ctx,unsigned int width,unsigned int height);
+
+
+/**
+ * @brief Change the size of the 2D frame of a projection context, this only reconfigures the renderer when the size actually changes
+ * @param Pointer to a struct BVHProjectionContext
+ * @param The width of the 2D frame that will hold the 2D Points
+ * @param The height of the 2D frame that will hold the 2D Points
+ * @retval 1=Success/0=Failure
+ */
+int setBVHProjectionContextSize(struct BVHProjectionContext * ctx,unsigned int width,unsigned int height);
+
+
+/**
+ * @brief Project a BVH frame to 2D, the result is stored in ctx->points2D as ctx->numberOfJoints x,y pairs
+ * and remains valid until the next call with the same context
+ * @param Pointer to a struct BVHProjectionContext
+ * @param Pointer to the values of a BVH frame
+ * @param Number of values of the BVH frame
+ * @retval Number of joints projected, 0=Failure
+ */
+unsigned int projectBVHFrameTo2DPoints(struct BVHProjectionContext * ctx,const float * bvhFrame,unsigned int bvhFrameSize);
+
+
+/**
+ * @brief Project a BVH frame to 2D using the native forward kinematics and the transforms cached in the context by the previous call,
+ * only joints whose channels ( or the channels of their non root ancestors ) changed are recomputed. The result is stored in ctx->points2D
+ * @param Pointer to a struct BVHProjectionContext
+ * @param Pointer to the values of a BVH frame
+ * @param Number of values of the BVH frame
+ * @retval Number of joints projected, 0=Failure
+ */
+unsigned int projectBVHFrameTo2DPointsIncremental(struct BVHProjectionContext * ctx,const float * bvhFrame,unsigned int bvhFrameSize);
+
+
+/**
+ * @brief Project many BVH frames to 2D in one go using the same context
+ * @param Pointer to a struct BVHProjectionContext
+ * @param Pointer to numberOfFrames consecutive BVH frames
+ * @param Number of frames
+ * @param Number of values of every BVH frame
+ * @param Output buffer that must have room for numberOfFrames * ctx->numberOfJoints * 2 floats, frames that fail to project are filled with zeros
+ * @retval Number of frames projected successfully
+ */
+unsigned int projectBVHFramesTo2DPoints(struct BVHProjectionContext * ctx,const float * bvhFrames,unsigned int numberOfFrames,unsigned int bvhFrameSize,float * output);
+
+
+/**
+ * @brief Free the memory held by a projection context
+ * @param Pointer to a struct BVHProjectionContext
+ * @retval 1=Success/0=Failure
+ */
+int destroyBVHProjectionContext(struct BVHProjectionContext * ctx);
+
 
 
 /**
@@ -1,79 +1,547 @@
+/** @file convertBody25JsonToCSV.cpp
+ *  @brief Converts the BODY25 JSON files of OpenPose ( or a packed keypoint archive ) to a CSV file with the uncompressed MocapNET input of every frame.
+ *  Parsing, flattening and formatting of the frames is spread over a pool of worker threads while the main thread writes the finished rows through a
+ *  single buffered stream in frame order. Frames without people repeat the last row that was written, this is done by the writer and not
+ *  by the workers so the output does not depend on the number of threads. --batch converts a list of capture directories in one go, --test
+ *  checks that one and many threads give the same file.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
 
 #include <iostream>
 #include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <math.h>
 #include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
 
-#include "../MocapNETLib/mocapnet.hpp"
+#include "../MocapNETLib/mocapnetRegistry.hpp"
 #include "../MocapNETLib/tools.h"
 #include "../MocapNETLib/jsonCocoSkeleton.h"
 #include "../MocapNETLib/jsonMocapNETHelpers.hpp"
+#include "../MocapNETLib/keypointArchive.h"
 
-int writeCSVHeader(const char * filename,struct skeletonCOCO * skeleton,unsigned int width,unsigned int height)
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Size of the buffer of the output stream
+#define CSV_OUTPUT_BUFFER_SIZE (1024*1024)
+
+//Rows that can be finished ahead of the writer, per worker
+#define CSV_ROWS_AHEAD_PER_WORKER 64
+
+//Every how many frames the capture of the self test has a frame without people
+#define CSV_TEST_EMPTY_FRAME_INTERVAL 3
+
+
+/**
+ * @brief A row of the CSV file, produced by a worker and consumed by the writer
+ */
+struct CSVRow
+{
+    unsigned int frameID;
+    //0 = empty, 1 = row is ready, 2 = frame could not be read, 3 = frame has no people
+    unsigned int state;
+    unsigned int numberOfValues;
+    std::string line;
+};
+
+
+/**
+ * @brief State shared between the writer and the workers converting one capture directory. Workers claim frames in order and put
+ * their rows in a ring of slots, a worker can't get more than the size of the ring ahead of the writer. The first frame found missing
+ * ends the sequence so no frame after it is claimed.
+ */
+struct CSVConversion
+{
+    const char * path;
+    const struct keypointArchive * archive;
+    unsigned int width;
+    unsigned int height;
+    unsigned int frameLimit;
+
+    std::mutex lock;
+    std::condition_variable rowReady;
+    std::condition_variable slotFree;
+    std::vector<struct CSVRow> rows;
+    unsigned int nextFrame;
+    unsigned int endFrame;
+    unsigned int writtenFrames;
+    unsigned int stop;
+};
+
+
+/**
+ * @brief Format a flattened frame as a CSV row, visibilities get one decimal and coordinates six
+ * @param Values of the frame
+ * @param Number of values
+ * @param Output, it is overwritten
+ */
+void formatCSVRow(const float * values,unsigned int numberOfValues,std::string &line)
 {
-    std::vector<float> inputValues = flattenskeletonCOCOToVector(skeleton,width,height);
+    char number[64];
+    line.clear();
+    for (unsigned int i=0; i<numberOfValues; i++)
+        {
+            int length = snprintf(number,64,(i%3==2) ? "%0.1f" : "%f",values[i]);
+            if (length>0)
+                {
+                    line.append(number,(length<64) ? length : 63);
+                }
+            line.push_back((i+1<numberOfValues) ? ',' : '\n');
+        }
+}
+
 
-    FILE * fp = fopen(filename,"w");
-    if (fp!=0)
+/**
+ * @brief Worker thread, it keeps claiming the next frame, reads its skeleton, flattens and formats it until there are no frames left
+ * or the writer tells it to stop. Every frame starts from a cleared skeleton, a frame without people is only marked as such since
+ * which row it repeats is up to the writer
+ */
+void convertCSVRows(struct CSVConversion * conversion)
+{
+    struct skeletonCOCO skeleton;
+    float values[MOCAPNET_UNCOMPRESSED_INPUT_SIZE];
+    char filePathOfJSONFile[2048];
+    std::string line;
+    unsigned int ringSize = conversion->rows.size();
+
+    std::unique_lock<std::mutex> guard(conversion->lock);
+    while (!conversion->stop)
         {
-            for (int i=0; i<inputValues.size(); i++)
+            unsigned int frameID = conversion->nextFrame;
+            if ( (frameID>=conversion->frameLimit) || (frameID>=conversion->endFrame) )
+                {
+                    break;
+                }
+            if (frameID>=conversion->writtenFrames+ringSize)
                 {
-                    fprintf(fp,"%s",MocapNETInputUncompressedArrayNames[i]);
-                    if (i<inputValues.size()-1)
+                    conversion->slotFree.wait(guard);
+                    continue;
+                }
+            ++conversion->nextFrame;
+            guard.unlock();
+
+            int haveSkeleton=0;
+            unsigned int numberOfPeople=0;
+            memset(&skeleton,0,sizeof(struct skeletonCOCO));
+            if (conversion->archive!=0)
+                {
+                    haveSkeleton=(frameID<getKeypointArchiveNumberOfFrames(conversion->archive));
+                    numberOfPeople=getKeypointArchiveNumberOfPeople(conversion->archive,frameID);
+                    if (numberOfPeople>0)
                         {
-                            fprintf(fp,",");
+                            haveSkeleton=readKeypointArchiveSkeleton(conversion->archive,frameID,0,&skeleton);
                         }
                 }
-            fprintf(fp,"\n");
-            fclose(fp);
-            return 1;
+            else
+                {
+                    snprintf(filePathOfJSONFile,2048,"%s/colorFrame_0_%05u_keypoints.json",conversion->path,frameID);
+                    //Workers that claimed frames past the end before it was found don't log them, the writer reports the end once
+                    if (access(filePathOfJSONFile,R_OK)==0)
+                        {
+                            haveSkeleton=parseJsonCOCOSkeletons(filePathOfJSONFile,&skeleton,1,&numberOfPeople);
+                        }
+                }
+
+            unsigned int numberOfValues=0;
+            if (haveSkeleton)
+                {
+                    numberOfValues = flattenskeletonCOCOToBuffer(&skeleton,conversion->width,conversion->height,values,MOCAPNET_UNCOMPRESSED_INPUT_SIZE);
+                    if (numberOfValues==0)
+                        {
+                            fprintf(stderr,"Failed to read from JSON file..\n");
+                        }
+                    formatCSVRow(values,numberOfValues,line);
+                }
+
+            guard.lock();
+            if ( (!haveSkeleton) && (frameID<conversion->endFrame) )
+                {
+                    //Workers waiting for a slot past the end don't need to wait for the writer any more
+                    conversion->endFrame=frameID;
+                    conversion->slotFree.notify_all();
+                }
+            struct CSVRow * row = &conversion->rows[frameID%ringSize];
+            row->frameID=frameID;
+            row->state=(!haveSkeleton) ? 2 : (numberOfPeople==0) ? 3 : 1;
+            row->numberOfValues=numberOfValues;
+            row->line.swap(line);
+            conversion->rowReady.notify_all();
+        }
+}
+
+
+/**
+ * @brief Write the CSV header, the number of columns is the one of the first row
+ * @retval 1=Success/0=Failure
+ */
+int writeCSVHeader(FILE * fp,unsigned int numberOfValues)
+{
+    for (unsigned int i=0; i<numberOfValues; i++)
+        {
+            fputs(MocapNETInputUncompressedArrayNames[i],fp);
+            fputc((i+1<numberOfValues) ? ',' : '\n',fp);
         }
-    return 0;
+    if (numberOfValues==0)
+        {
+            fputc('\n',fp);
+        }
+    return (ferror(fp)==0);
 }
 
-int writeCSVBody(const char * filename,struct skeletonCOCO * skeleton,unsigned int width,unsigned int height)
+
+/**
+ * @brief Convert the frames of a capture directory ( or keypoint archive ) to a CSV file, stopping at the first frame that can't be read
+ * @param Directory with the JSON files and the first image of the capture
+ * @param Keypoint archive to read the frames from instead of the JSON files, can be null
+ * @param Path of the CSV file
+ * @param Maximum number of frames
+ * @param Number of worker threads
+ * @retval Number of frames written, 0 = Failure
+ */
+unsigned int convertCaptureToCSV(
+                                  const char * path,
+                                  const struct keypointArchive * archive,
+                                  const char * outputPath,
+                                  unsigned int frameLimit,
+                                  unsigned int numberOfThreads
+                                )
 {
-    FILE * fp = fopen(filename,"a");
-    if (fp!=0)
+    unsigned int width=1920, height=1080;
+    char filePathOfImage[2048]= {0};
+    snprintf(filePathOfImage,2048,"%s/colorFrame_0_00000.jpg",path);
+    if ( getImageWidthHeight(filePathOfImage,&width,&height) )
+        {
+            fprintf(stderr,"Image dimensions changed from default to %ux%u\n",width,height);
+        }
+
+    if (archive!=0)
         {
-            std::vector<float> inputValues = flattenskeletonCOCOToVector(skeleton,width,height);
-            if (inputValues.size()==0)
+            if (getKeypointArchiveNumberOfFrames(archive)<frameLimit)
                 {
-                    fprintf(stderr,"Failed to read from JSON file..\n");
+                    frameLimit=getKeypointArchiveNumberOfFrames(archive);
                 }
+        }
+
+    //The output is created when the first row is ready so that a capture without frames leaves no empty file behind
+    FILE * fp = 0;
+    std::vector<char> outputBuffer(CSV_OUTPUT_BUFFER_SIZE);
+
+    struct CSVConversion conversion;
+    conversion.path=path;
+    conversion.archive=archive;
+    conversion.width=width;
+    conversion.height=height;
+    conversion.frameLimit=frameLimit;
+    conversion.rows.resize(numberOfThreads*CSV_ROWS_AHEAD_PER_WORKER);
+    for (unsigned int i=0; i<conversion.rows.size(); i++)
+        {
+            conversion.rows[i].state=0;
+        }
+    conversion.nextFrame=0;
+    conversion.endFrame=frameLimit;
+    conversion.writtenFrames=0;
+    conversion.stop=0;
+
+    unsigned long startTime = GetTickCountMicrosecondsMN();
+    std::vector<std::thread> workers;
+    for (unsigned int i=0; i<numberOfThreads; i++)
+        {
+            workers.push_back(std::thread(convertCSVRows,&conversion));
+        }
 
-            for (int i=0; i<inputValues.size(); i++)
+    //The rows are written in frame order as they become ready, everything else happens in the workers
+    int success=1;
+    std::string line;
+    unsigned int frameID=0;
+    while (frameID<frameLimit)
+        {
+            std::unique_lock<std::mutex> guard(conversion.lock);
+            struct CSVRow * row = &conversion.rows[frameID%conversion.rows.size()];
+            while ( (row->state==0) || (row->frameID!=frameID) )
+                {
+                    conversion.rowReady.wait(guard);
+                }
+            if (row->state==2)
+                {
+                    //Like before, the first frame that is missing ends the sequence
+                    fprintf(stderr,"Could not read frame %u of %s, stopping there\n",frameID,path);
+                    conversion.stop=1;
+                    conversion.slotFree.notify_all();
+                    break;
+                }
+            unsigned int numberOfValues = row->numberOfValues;
+            //A frame without people writes the previous row again, as a single threaded run always did, except for the first frame
+            //which gets the row of a cleared skeleton
+            if ( (row->state==1) || (frameID==0) )
                 {
-                    if (i%3==2)
+                    line.swap(row->line);
+                }
+            row->state=0;
+            conversion.writtenFrames=frameID+1;
+            conversion.slotFree.notify_all();
+            guard.unlock();
+
+            if (frameID==0)
+                {
+                    fp = fopen(outputPath,"w");
+                    if (fp!=0)
                         {
-                            fprintf(fp,"%0.1f",inputValues[i]);
+                            setvbuf(fp,outputBuffer.data(),_IOFBF,outputBuffer.size());
+                            success = writeCSVHeader(fp,numberOfValues);
                         }
                     else
                         {
-                            fprintf(fp,"%f",inputValues[i]);
+                            success = 0;
                         }
+                }
+            if ( (!success) || (fwrite(line.data(),1,line.size(),fp)!=line.size()) )
+                {
+                    fprintf(stderr,RED "Failed writing to %s\n" NORMAL,outputPath);
+                    success=0;
+                    guard.lock();
+                    conversion.stop=1;
+                    conversion.slotFree.notify_all();
+                    break;
+                }
+            ++frameID;
+        }
+
+    for (unsigned int i=0; i<workers.size(); i++)
+        {
+            workers[i].join();
+        }
+    if ( (fp!=0) && (fclose(fp)!=0) )
+        {
+            success=0;
+        }
+    unsigned long endTime = GetTickCountMicrosecondsMN();
+
+    float seconds = (float) (endTime-startTime)/1000000;
+    fprintf(stderr,"Done processing %u frames of %s in %0.2f seconds ( %0.2f fps , %u threads )..\n",frameID,path,seconds,(seconds>0.0) ? frameID/seconds : 0.0,numberOfThreads);
+    return (success) ? frameID : 0;
+}
+
+
+/**
+ * @brief Get the path of the CSV file of a capture directory, it goes in the directory itself unless an output directory is given
+ */
+void getCSVOutputPath(char * output,unsigned int outputLength,const char * path,const char * outputDirectory,float version)
+{
+    snprintf(output,outputLength,"%s/2dJoints_v%0.1f.csv",(outputDirectory!=0) ? outputDirectory : path,version);
+}
+
+
+/**
+ * @brief Convert every capture directory listed in a text file, one per line, empty lines and lines starting with # are skipped
+ * @retval Number of directories that failed
+ */
+unsigned int convertCaptureBatch(const char * listPath,float version,unsigned int frameLimit,unsigned int numberOfThreads)
+{
+    FILE * list = (strcmp(listPath,"-")==0) ? stdin : fopen(listPath,"r");
+    if (list==0)
+        {
+            fprintf(stderr,RED "Could not open batch list %s\n" NORMAL,listPath);
+            return 1;
+        }
+
+    unsigned int directories=0,failures=0;
+    unsigned long totalFrames=0;
+    unsigned long startTime = GetTickCountMicrosecondsMN();
+
+    char path[2048];
+    char outputPathFull[2048];
+    while (fgets(path,2048,list)!=0)
+        {
+            unsigned int length = strlen(path);
+            while ( (length>0) && ( (path[length-1]=='\n') || (path[length-1]=='\r') || (path[length-1]==' ') || (path[length-1]=='/') ) )
+                {
+                    path[--length]=0;
+                }
+            if ( (length==0) || (path[0]=='#') )
+                {
+                    continue;
+                }
+
+            ++directories;
+            getCSVOutputPath(outputPathFull,2048,path,0,version);
+            unsigned int frames = convertCaptureToCSV(path,0,outputPathFull,frameLimit,numberOfThreads);
+            if (frames==0)
+                {
+                    fprintf(stderr,YELLOW "Nothing converted from %s\n" NORMAL,path);
+                    ++failures;
+                }
+            totalFrames+=frames;
+        }
+    if (list!=stdin)
+        {
+            fclose(list);
+        }
+
+    float seconds = (float) (GetTickCountMicrosecondsMN()-startTime)/1000000;
+    fprintf(stderr,"Batch done, %u directories ( %u failed ) , %lu frames in %0.2f seconds\n",directories,failures,totalFrames,seconds);
+    return failures;
+}
+
 
-                    if (i<inputValues.size()-1)
+/**
+ * @brief Write a synthetic capture for the self test, a person that moves a bit on every frame and a frame with an empty people array
+ * every CSV_TEST_EMPTY_FRAME_INTERVAL frames, starting with the first one
+ * @retval 1=Success/0=Failure
+ */
+int writeCSVTestCapture(const char * directory,unsigned int numberOfFrames)
+{
+    char filename[2048];
+    for (unsigned int frameID=0; frameID<numberOfFrames; frameID++)
+        {
+            snprintf(filename,2048,"%s/colorFrame_0_%05u_keypoints.json",directory,frameID);
+            FILE * fp = fopen(filename,"w");
+            if (fp==0)
+                {
+                    return 0;
+                }
+            fprintf(fp,"{\"version\":1.2,\"people\":[");
+            if (frameID%CSV_TEST_EMPTY_FRAME_INTERVAL!=0)
+                {
+                    fprintf(fp,"{\"pose_keypoints_2d\":[");
+                    //OpenPose does not output the background so there are BODY25_Bkg joints
+                    for (unsigned int i=0; i<BODY25_Bkg; i++)
                         {
-                            fprintf(fp,",");
+                            fprintf(fp,"%s%0.3f,%0.3f,%0.3f",(i==0) ? "" : ",",800.0+(i%5)*40.0+frameID*0.5,200.0+(i/5)*120.0+(frameID%7),0.5+(i%4)*0.1);
                         }
+                    fprintf(fp,"]}");
                 }
-            fprintf(fp,"\n");
+            fprintf(fp,"]}\n");
             fclose(fp);
-            return 1;
         }
-    return 0;
+    return 1;
 }
 
 
+/**
+ * @brief Read a whole file in a string
+ * @retval 1=Success/0=Failure
+ */
+int readCSVTestFile(const char * filename,std::string &content)
+{
+    FILE * fp = fopen(filename,"r");
+    if (fp==0)
+        {
+            return 0;
+        }
+    char buffer[4096];
+    size_t length;
+    content.clear();
+    while ( (length=fread(buffer,1,4096,fp))>0 )
+        {
+            content.append(buffer,length);
+        }
+    fclose(fp);
+    return 1;
+}
+
+
+/**
+ * @brief Self test, convert a capture with frames without people using one and many threads and check that the CSV files are
+ * the same and that every frame without people repeats the previous row
+ * @param Number of threads of the multi threaded run
+ * @retval 1=Success/0=Failure
+ */
+int testCSVConversion(unsigned int numberOfThreads)
+{
+    //Enough frames for the ring of rows to wrap around a few times
+    unsigned int numberOfFrames = 4 * numberOfThreads * CSV_ROWS_AHEAD_PER_WORKER + 1;
+    char directory[256];
+    char singleThreadedPath[512];
+    char multiThreadedPath[512];
+    snprintf(directory,256,"/tmp/mocapnetCSVTestXXXXXX");
+    if (mkdtemp(directory)==0)
+        {
+            fprintf(stderr,RED "Could not create a temporary directory for the test capture\n" NORMAL);
+            return 0;
+        }
+    snprintf(singleThreadedPath,512,"%s/singleThreaded.csv",directory);
+    snprintf(multiThreadedPath,512,"%s/multiThreaded.csv",directory);
+
+    int success=0;
+    std::string singleThreaded,multiThreaded;
+    if (
+         (writeCSVTestCapture(directory,numberOfFrames)) &&
+         (convertCaptureToCSV(directory,0,singleThreadedPath,numberOfFrames,1)==numberOfFrames) &&
+         (convertCaptureToCSV(directory,0,multiThreadedPath,numberOfFrames,numberOfThreads)==numberOfFrames) &&
+         (readCSVTestFile(singleThreadedPath,singleThreaded)) &&
+         (readCSVTestFile(multiThreadedPath,multiThreaded))
+       )
+        {
+            success=(singleThreaded==multiThreaded);
+            if (!success)
+                {
+                    fprintf(stderr,RED "1 and %u threads gave different CSV files\n" NORMAL,numberOfThreads);
+                }
+
+            //Split the rows, the first line is the header
+            std::vector<std::string> rows;
+            size_t start=singleThreaded.find('\n')+1;
+            while ( (start>0) && (start<singleThreaded.size()) )
+                {
+                    size_t end=singleThreaded.find('\n',start);
+                    if (end==std::string::npos)
+                        {
+                            break;
+                        }
+                    rows.push_back(singleThreaded.substr(start,end-start));
+                    start=end+1;
+                }
+            if (rows.size()!=numberOfFrames)
+                {
+                    fprintf(stderr,RED "Expected %u rows, got %lu\n" NORMAL,numberOfFrames,rows.size());
+                    success=0;
+                }
+            for (unsigned int frameID=CSV_TEST_EMPTY_FRAME_INTERVAL; (success) && (frameID<rows.size()); frameID+=CSV_TEST_EMPTY_FRAME_INTERVAL)
+                {
+                    if (rows[frameID]!=rows[frameID-1])
+                        {
+                            fprintf(stderr,RED "Frame %u has no people but does not repeat the previous row\n" NORMAL,frameID);
+                            success=0;
+                        }
+                }
+        }
+    else
+        {
+            fprintf(stderr,RED "Could not convert the test capture\n" NORMAL);
+        }
+
+    char filename[2048];
+    for (unsigned int frameID=0; frameID<numberOfFrames; frameID++)
+        {
+            snprintf(filename,2048,"%s/colorFrame_0_%05u_keypoints.json",directory,frameID);
+            unlink(filename);
+        }
+    unlink(singleThreadedPath);
+    unlink(multiThreadedPath);
+    rmdir(directory);
+    return success;
+}
+
 
 int main(int argc, char *argv[])
 {
-    unsigned int width=1920 , height=1080 , frameLimit=100000 , processed = 0;
+    unsigned int frameLimit=100000;
+    unsigned int numberOfThreads=std::thread::hardware_concurrency();
     const char * path=0;
     char outputPathFull[2048];
     const char * outputPath=0;
+    const char * archivePath=0;
+    const char * batchPath=0;
     float version=1.2;
+    int selfTest=0;
 
     for (int i=0; i<argc; i++)
         {
@@ -101,58 +569,68 @@ int main(int argc, char *argv[])
                 {
                     version = atof(argv[i+1]);
                 }
+            else if (strcmp(argv[i],"--archive")==0)
+                {
+                    archivePath = argv[i+1];
+                }
+            else if (strcmp(argv[i],"--batch")==0)
+                {
+                    batchPath = argv[i+1];
+                }
+            else if (strcmp(argv[i],"--threads")==0)
+                {
+                    numberOfThreads = atoi(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--test")==0)
+                {
+                    selfTest=1;
+                }
         }
-
-    if (path==0)
+    if (numberOfThreads==0)
         {
-            path="frames/dance.webm-data";
+            numberOfThreads=1;
         }
 
-    if (outputPath==0)
+    if (selfTest)
         {
-            snprintf(outputPathFull,2048,"%s/2dJoints_v%0.1f.csv",path,version);
+            //A single core machine still gets a multi threaded run to compare against
+            int result = testCSVConversion( (numberOfThreads>1) ? numberOfThreads : 4 );
+            fprintf(stderr,"%s\n",(result) ? GREEN "One and many threads give the same CSV file" NORMAL : RED "One and many threads give different CSV files" NORMAL);
+            return (result) ? 0 : 1;
         }
-    else
+
+    if (batchPath!=0)
         {
-            snprintf(outputPathFull,2048,"%s/2dJoints_v%0.1f.csv",outputPath,version);
+            if ( (outputPath!=0) || (archivePath!=0) )
+                {
+                    fprintf(stderr,YELLOW "--out and --archive are ignored in batch mode, every CSV file is written in its capture directory\n" NORMAL);
+                }
+            return (convertCaptureBatch(batchPath,version,frameLimit,numberOfThreads)==0) ? 0 : 1;
         }
 
-    char filePathOfJSONFile[2048]= {0};
-    snprintf(filePathOfJSONFile,2048,"%s/colorFrame_0_00000.jpg",path);
-
-    if ( getImageWidthHeight(filePathOfJSONFile,&width,&height) )
+    if (path==0)
         {
-            fprintf(stderr,"Image dimensions changed from default to %ux%u",width,height);
+            path="frames/dance.webm-data";
         }
+    getCSVOutputPath(outputPathFull,2048,path,outputPath,version);
 
-
-    float totalTime=0.0;
-    unsigned int totalSamples=0;
-
-    struct skeletonCOCO skeleton= {0};
-
-    unsigned int frameID=0;
-    while (frameID<frameLimit)
+    //A packed keypoint archive ( see convertJSONToKeypointArchive ) can be used instead of the JSON files
+    struct keypointArchive archiveStorage;
+    struct keypointArchive * archive=0;
+    if (archivePath!=0)
         {
-            snprintf(filePathOfJSONFile,1024,"%s/colorFrame_0_%05u_keypoints.json",path,frameID);
-            fprintf(stderr,"Processing %s \n",filePathOfJSONFile);
-
-            if (parseJsonCOCOSkeleton(filePathOfJSONFile,&skeleton))
+            if (!openKeypointArchive(&archiveStorage,archivePath))
                 {
-                    if (processed==0)
-                        {
-                            writeCSVHeader(outputPathFull,&skeleton,width,height);
-                        }
-
-                    writeCSVBody(outputPathFull,&skeleton,width,height);
-                    ++processed;
-                }
-            else
-                {
-                    fprintf(stderr,"Done processing %u frames..\n",frameID);
-                    break;
+                    return 1;
                 }
+            archive=&archiveStorage;
+        }
 
-            ++frameID;
+    unsigned int processed = convertCaptureToCSV(path,archive,outputPathFull,frameLimit,numberOfThreads);
+
+    if (archive!=0)
+        {
+            closeKeypointArchive(archive);
         }
+    return (processed>0) ? 0 : 1;
 }
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../MocapNETLib/tools.h"
+#include "../MocapNETLib/jsonCocoSkeleton.h"
+#include "../MocapNETLib/keypointArchive.h"
+
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+
+//People of a frame beyond this are not archived
+#define MAXIMUM_PEOPLE_PER_FRAME 64
+
+
+int main(int argc, char *argv[])
+{
+    unsigned int frameLimit=100000 , serialLength=5 , processed = 0;
+    const char * path=0;
+    const char * label="colorFrame_0";
+    const char * outputPath=0;
+    char outputPathFull[2048];
+
+    for (int i=0; i<argc; i++)
+        {
+            if (strcmp(argv[i],"--maxFrames")==0)
+                {
+                    frameLimit=atoi(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--from")==0)
+                {
+                    path = argv[i+1];
+                }
+            else if (strcmp(argv[i],"-i")==0)
+                {
+                    path = argv[i+1];
+                }
+            else if (strcmp(argv[i],"--label")==0)
+                {
+                    label = argv[i+1];
+                }
+            else if (strcmp(argv[i],"--seriallength")==0)
+                {
+                    serialLength = atoi(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--out")==0)
+                {
+                    outputPath = argv[i+1];
+                }
+            else if (strcmp(argv[i],"-o")==0)
+                {
+                    outputPath = argv[i+1];
+                }
+        }
+
+    if (path==0)
+        {
+            path="frames/dance.webm-data";
+        }
+
+    if (outputPath==0)
+        {
+            snprintf(outputPathFull,2048,"%s/2dJoints.mnka",path);
+        }
+    else
+        {
+            snprintf(outputPathFull,2048,"%s",outputPath);
+        }
+
+    char formatString[256]= {0};
+    snprintf(formatString,256,"%%s/%%s_%%0%uu_keypoints.json",serialLength);
+
+    struct keypointArchiveWriter writer;
+    if (!createKeypointArchive(&writer,outputPathFull))
+        {
+            return 1;
+        }
+
+    char filePathOfJSONFile[2048]= {0};
+    struct skeletonCOCO * people = (struct skeletonCOCO *) malloc(sizeof(struct skeletonCOCO) * MAXIMUM_PEOPLE_PER_FRAME);
+    if (people==0)
+        {
+            closeKeypointArchiveWriter(&writer);
+            return 1;
+        }
+
+    unsigned long startTime = GetTickCountMicrosecondsMN();
+
+    unsigned int frameID=0;
+    while (frameID<frameLimit)
+        {
+            snprintf(filePathOfJSONFile,2048,formatString,path,label,frameID);
+
+            //Every person of the frame gets a record, OpenPose writes an empty people array when nobody is visible
+            unsigned int numberOfPeople=0;
+            if (parseJsonCOCOSkeletons(filePathOfJSONFile,people,MAXIMUM_PEOPLE_PER_FRAME,&numberOfPeople))
+                {
+                    if (!appendKeypointArchiveFrame(&writer,people,numberOfPeople))
+                        {
+                            fprintf(stderr,RED "Failed writing frame %u to %s\n" NORMAL,frameID,outputPathFull);
+                            closeKeypointArchiveWriter(&writer);
+                            free(people);
+                            return 1;
+                        }
+                    ++processed;
+                }
+            else
+                {
+                    fprintf(stderr,"Done processing %u frames..\n",frameID);
+                    break;
+                }
+
+            ++frameID;
+        }
+
+    free(people);
+
+    if (!closeKeypointArchiveWriter(&writer))
+        {
+            fprintf(stderr,RED "Failed finalizing %s\n" NORMAL,outputPathFull);
+            return 1;
+        }
+
+    unsigned long endTime = GetTickCountMicrosecondsMN();
+    fprintf(stderr,GREEN "Packed %u frames in %s ( %0.2f seconds )\n" NORMAL,processed,outputPathFull,(float) (endTime-startTime)/1000000);
+    return 0;
+}
@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "detectionLog.h"
+
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Number of frame offsets moved at a time from the temporary index file to the log when it is closed
+#define DETECTION_LOG_INDEX_COPY_BLOCK 1024
+
+
+int createDetectionLog(
+    struct detectionLogWriter * writer,
+    const char * filename,
+    unsigned int valuesPerFrame,
+    unsigned int frameWidth,
+    unsigned int frameHeight,
+    unsigned int heatmapWidth,
+    unsigned int heatmapHeight
+)
+{
+    memset(writer,0,sizeof(struct detectionLogWriter));
+
+    writer->fp = fopen(filename,"wb");
+    if (writer->fp==0)
+        {
+            fprintf(stderr,RED "Could not create detection log %s\n" NORMAL,filename);
+            return 0;
+        }
+
+    memcpy(writer->header.magic,DETECTION_LOG_MAGIC,4);
+    writer->header.version        = DETECTION_LOG_VERSION;
+    writer->header.valuesPerFrame = valuesPerFrame;
+    writer->header.frameWidth     = frameWidth;
+    writer->header.frameHeight    = frameHeight;
+    writer->header.heatmapWidth   = heatmapWidth;
+    writer->header.heatmapHeight  = heatmapHeight;
+
+    //The offsets of the frames are kept on disk until the log is closed
+    writer->indexFile = tmpfile();
+    if (writer->indexFile==0)
+        {
+            fprintf(stderr,RED "Could not create the index of detection log %s\n" NORMAL,filename);
+            fclose(writer->fp);
+            writer->fp=0;
+            return 0;
+        }
+
+    //The header gets rewritten when the log is closed and we know the number of frames and the index position
+    if (fwrite(&writer->header,sizeof(struct detectionLogHeader),1,writer->fp)!=1)
+        {
+            fclose(writer->fp);
+            fclose(writer->indexFile);
+            writer->fp=0;
+            writer->indexFile=0;
+            return 0;
+        }
+    return 1;
+}
+
+
+int appendDetectionLogFrame(
+    struct detectionLogWriter * writer,
+    unsigned int frameNumber,
+    unsigned int flags,
+    unsigned long long captureTime,
+    unsigned int detectionTime,
+    const float * values,
+    unsigned int numberOfValues,
+    const float * heatmaps,
+    unsigned int numberOfHeatmapValues
+)
+{
+    if ( (writer->fp==0) || (writer->indexFile==0) || (values==0) )
+        {
+            return 0;
+        }
+    if (numberOfValues!=writer->header.valuesPerFrame)
+        {
+            fprintf(stderr,YELLOW "Detection log expects %u values per frame and got %u, frame %u is not logged\n" NORMAL,writer->header.valuesPerFrame,numberOfValues,frameNumber);
+            return 0;
+        }
+
+    unsigned int heatmapSize = writer->header.heatmapWidth * writer->header.heatmapHeight;
+    if ( (heatmaps==0) || (heatmapSize==0) || (numberOfHeatmapValues%heatmapSize!=0) )
+        {
+            numberOfHeatmapValues=0;
+        }
+
+    if (writer->header.numberOfFrames==0)
+        {
+            writer->firstTimestamp=captureTime;
+        }
+
+    struct detectionLogFrameRecord record;
+    record.frameNumber = frameNumber;
+    record.flags = flags & ~DETECTION_LOG_HAS_HEATMAPS;
+    if (numberOfHeatmapValues>0)
+        {
+            record.flags |= DETECTION_LOG_HAS_HEATMAPS;
+        }
+    record.timestamp = (captureTime>writer->firstTimestamp) ? captureTime-writer->firstTimestamp : 0;
+    record.detectionTime = detectionTime;
+    record.numberOfHeatmapValues = numberOfHeatmapValues;
+
+    unsigned long long offset = (unsigned long long) ftell(writer->fp);
+    if (
+        (fwrite(&record,sizeof(struct detectionLogFrameRecord),1,writer->fp)!=1) ||
+        (fwrite(values,sizeof(float),numberOfValues,writer->fp)!=numberOfValues) ||
+        ( (numberOfHeatmapValues>0) && (fwrite(heatmaps,sizeof(float),numberOfHeatmapValues,writer->fp)!=numberOfHeatmapValues) ) ||
+        (fwrite(&offset,sizeof(unsigned long long),1,writer->indexFile)!=1)
+    )
+        {
+            fprintf(stderr,RED "Failed writing frame %u to detection log\n" NORMAL,frameNumber);
+            return 0;
+        }
+
+    ++writer->header.numberOfFrames;
+    return 1;
+}
+
+
+/*
+ * Copy the offsets collected in the temporary index file after the frame records, a block at a time
+ */
+static int copyDetectionLogIndex(struct detectionLogWriter * writer)
+{
+    unsigned long long block[DETECTION_LOG_INDEX_COPY_BLOCK];
+    if (fseek(writer->indexFile,0,SEEK_SET)!=0)
+        {
+            return 0;
+        }
+
+    unsigned int remaining = writer->header.numberOfFrames;
+    while (remaining>0)
+        {
+            unsigned int count = (remaining<DETECTION_LOG_INDEX_COPY_BLOCK) ? remaining : DETECTION_LOG_INDEX_COPY_BLOCK;
+            if (
+                (fread(block,sizeof(unsigned long long),count,writer->indexFile)!=count) ||
+                (fwrite(block,sizeof(unsigned long long),count,writer->fp)!=count)
+            )
+                {
+                    return 0;
+                }
+            remaining-=count;
+        }
+    return 1;
+}
+
+
+int closeDetectionLogWriter(struct detectionLogWriter * writer)
+{
+    int success=0;
+    if (writer->fp!=0)
+        {
+            //The records are a multiple of 4 bytes so the index is padded to start at a multiple of 8 and be readable in place through mmap
+            static const char padding[sizeof(unsigned long long)]= {0};
+            unsigned long long end = (unsigned long long) ftell(writer->fp);
+            unsigned int paddingSize = (sizeof(unsigned long long) - end % sizeof(unsigned long long)) % sizeof(unsigned long long);
+            writer->header.indexOffset = end + paddingSize;
+
+            if (
+                (fwrite(padding,1,paddingSize,writer->fp)==paddingSize) &&
+                (writer->indexFile!=0) &&
+                (copyDetectionLogIndex(writer)) &&
+                (fseek(writer->fp,0,SEEK_SET)==0) &&
+                (fwrite(&writer->header,sizeof(struct detectionLogHeader),1,writer->fp)==1)
+            )
+                {
+                    success=1;
+                }
+            fclose(writer->fp);
+            writer->fp=0;
+        }
+
+    if (writer->indexFile!=0)
+        {
+            //The temporary file is removed as soon as it is closed
+            fclose(writer->indexFile);
+            writer->indexFile=0;
+        }
+    return success;
+}
+
+
+int openDetectionLog(struct detectionLog * log,const char * filename)
+{
+    memset(log,0,sizeof(struct detectionLog));
+    log->fd=-1;
+
+    int fd = open(filename,O_RDONLY);
+    if (fd<0)
+        {
+            fprintf(stderr,RED "Could not open detection log %s\n" NORMAL,filename);
+            return 0;
+        }
+
+    struct stat st;
+    if ( (fstat(fd,&st)!=0) || ((unsigned long long) st.st_size<sizeof(struct detectionLogHeader)) )
+        {
+            fprintf(stderr,RED "Detection log %s is too small\n" NORMAL,filename);
+            close(fd);
+            return 0;
+        }
+
+    void * data = mmap(0,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    if (data==MAP_FAILED)
+        {
+            fprintf(stderr,RED "Could not map detection log %s\n" NORMAL,filename);
+            close(fd);
+            return 0;
+        }
+    //Replays go through the frames in order
+    madvise(data,st.st_size,MADV_SEQUENTIAL);
+
+    const struct detectionLogHeader * header = (const struct detectionLogHeader *) data;
+    unsigned long long size = (unsigned long long) st.st_size;
+
+    if (
+        (memcmp(header->magic,DETECTION_LOG_MAGIC,4)!=0) ||
+        (header->version!=DETECTION_LOG_VERSION) ||
+        (header->valuesPerFrame==0) ||
+        (header->indexOffset>size) ||
+        (header->indexOffset % sizeof(unsigned long long)!=0) ||
+        (header->indexOffset + (unsigned long long) header->numberOfFrames * sizeof(unsigned long long) > size)
+    )
+        {
+            fprintf(stderr,RED "%s is not a compatible detection log\n" NORMAL,filename);
+            munmap(data,st.st_size);
+            close(fd);
+            return 0;
+        }
+
+    log->fd     = fd;
+    log->data   = data;
+    log->size   = size;
+    log->header = header;
+    log->index  = (const unsigned long long *) ((const char *) data + header->indexOffset);
+
+    fprintf(stderr,"Detection log %s has %u frames of %ux%u input\n",filename,header->numberOfFrames,header->frameWidth,header->frameHeight);
+    return 1;
+}
+
+
+unsigned int getDetectionLogNumberOfFrames(const struct detectionLog * log)
+{
+    if (log->header==0)
+        {
+            return 0;
+        }
+    return log->header->numberOfFrames;
+}
+
+
+int readDetectionLogFrame(const struct detectionLog * log,unsigned int frameID,struct detectionLogFrame * frame)
+{
+    if ( (log->header==0) || (frameID>=log->header->numberOfFrames) )
+        {
+            return 0;
+        }
+
+    unsigned long long offset = log->index[frameID];
+    if ( offset + sizeof(struct detectionLogFrameRecord) > log->header->indexOffset )
+        {
+            return 0;
+        }
+
+    //Every part of a record is a multiple of 4 bytes and the header a multiple of 8 so the floats are always aligned
+    const char * data = (const char *) log->data + offset;
+    struct detectionLogFrameRecord record;
+    memcpy(&record,data,sizeof(struct detectionLogFrameRecord));
+
+    unsigned long long payload = ( (unsigned long long) log->header->valuesPerFrame + record.numberOfHeatmapValues ) * sizeof(float);
+    if ( offset + sizeof(struct detectionLogFrameRecord) + payload > log->header->indexOffset )
+        {
+            fprintf(stderr,RED "Detection log frame %u is truncated\n" NORMAL,frameID);
+            return 0;
+        }
+
+    frame->frameNumber    = record.frameNumber;
+    frame->flags          = record.flags;
+    frame->timestamp      = record.timestamp;
+    frame->detectionTime  = record.detectionTime;
+    frame->values         = (const float *) (data + sizeof(struct detectionLogFrameRecord));
+    frame->numberOfValues = log->header->valuesPerFrame;
+    frame->numberOfHeatmapValues = record.numberOfHeatmapValues;
+    frame->heatmaps       = (record.numberOfHeatmapValues>0) ? frame->values + log->header->valuesPerFrame : 0;
+    return 1;
+}
+
+
+int closeDetectionLog(struct detectionLog * log)
+{
+    if (log->data!=0)
+        {
+            munmap(log->data,log->size);
+        }
+    if (log->fd>=0)
+        {
+            close(log->fd);
+        }
+    memset(log,0,sizeof(struct detectionLog));
+    log->fd=-1;
+    return 1;
+}
@@ -0,0 +1,216 @@
+#ifndef DETECTIONLOG_H_INCLUDED
+#define DETECTIONLOG_H_INCLUDED
+/** @file detectionLog.h
+ *  @brief A compact binary log of the 2D detections of a live session so that the 3D stage can be re-run on them later without a camera or a GPU.
+ *  Every frame record holds the frame number, the time it was captured, whether it came from the 2D joint estimator or the joint tracker, the
+ *  flattened and normalized MocapNET input ( x,y,visibility triplets ) and optionally the raw NHWC heatmaps of the 2D joint estimator.
+ *  Like the keypoint archive the file consists of a header, the frame records and an index with the offset of every frame record at its end ( padded to start at a multiple of 8 bytes ),
+ *  it is read through mmap. Values are stored in the native byte order of the machine that wrote the log.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdio.h>
+
+
+/**
+ * @brief The first four bytes of every detection log
+ */
+#define DETECTION_LOG_MAGIC "MNDL"
+
+/**
+ * @brief The version of the detection log format written by this code
+ */
+#define DETECTION_LOG_VERSION 1
+
+
+/**
+ * @brief Flags of a frame record
+ */
+enum detectionLogFrameFlags
+{
+    //The joints came from the 2D joint estimator and not from the joint tracker
+    DETECTION_LOG_KEYFRAME = 1,
+    //The record carries the heatmaps of the 2D joint estimator
+    DETECTION_LOG_HAS_HEATMAPS = 2
+};
+
+
+/**
+ * @brief Header found in the start of a detection log file
+ */
+struct detectionLogHeader
+{
+    char magic[4];
+    unsigned int version;
+    unsigned int numberOfFrames;
+    //Number of values of the MocapNET input of every frame
+    unsigned int valuesPerFrame;
+    //Resolution of the input frames, the 2D points were normalized with it
+    unsigned int frameWidth;
+    unsigned int frameHeight;
+    //Resolution of the heatmaps, 0 if the log has none
+    unsigned int heatmapWidth;
+    unsigned int heatmapHeight;
+    unsigned long long indexOffset;
+};
+
+
+/**
+ * @brief Fixed part of a frame record, it is followed by valuesPerFrame floats and numberOfHeatmapValues floats
+ */
+struct detectionLogFrameRecord
+{
+    unsigned int frameNumber;
+    unsigned int flags;
+    //Microseconds since the first frame of the log
+    unsigned long long timestamp;
+    //Time the 2D stage spent on this frame in microseconds
+    unsigned int detectionTime;
+    unsigned int numberOfHeatmapValues;
+};
+
+
+/**
+ * @brief A frame of a detection log as handed out by readDetectionLogFrame
+ */
+struct detectionLogFrame
+{
+    unsigned int frameNumber;
+    unsigned int flags;
+    unsigned long long timestamp;
+    unsigned int detectionTime;
+    //Points inside the mapping, they stay valid until the log is closed
+    const float * values;
+    unsigned int numberOfValues;
+    const float * heatmaps;
+    unsigned int numberOfHeatmapValues;
+};
+
+
+/**
+ * @brief A detection log that is being written, frames are appended one after the other and their offsets go to a temporary file
+ * that is copied after them as the index on close, so the writer needs the same memory no matter how long the log gets
+ */
+struct detectionLogWriter
+{
+    FILE * fp;
+    FILE * indexFile;
+    struct detectionLogHeader header;
+    unsigned long long firstTimestamp;
+};
+
+
+/**
+ * @brief A detection log that has been mapped in memory for reading
+ */
+struct detectionLog
+{
+    int fd;
+    void * data;
+    unsigned long long size;
+    const struct detectionLogHeader * header;
+    const unsigned long long * index;
+};
+
+
+/**
+ * @brief Create a new detection log on disk
+ * @param Pointer to a struct detectionLogWriter that will hold the state of the writer
+ * @param Path to the output file
+ * @param Number of values of the MocapNET input of every frame ( MOCAPNET_UNCOMPRESSED_INPUT_SIZE )
+ * @param Width of the input frames
+ * @param Height of the input frames
+ * @param Width of the heatmaps that will be stored, 0 if none will be
+ * @param Height of the heatmaps that will be stored, 0 if none will be
+ * @retval 1=Success/0=Failure
+ */
+int createDetectionLog(
+                        struct detectionLogWriter * writer,
+                        const char * filename,
+                        unsigned int valuesPerFrame,
+                        unsigned int frameWidth,
+                        unsigned int frameHeight,
+                        unsigned int heatmapWidth,
+                        unsigned int heatmapHeight
+                      );
+
+
+/**
+ * @brief Append a frame to a detection log that is being written
+ * @param Pointer to an open struct detectionLogWriter
+ * @param Frame number
+ * @param Flags, see enum detectionLogFrameFlags, DETECTION_LOG_HAS_HEATMAPS is set automatically
+ * @param Capture time of the frame in microseconds, any clock will do since the log keeps the time relative to the first frame
+ * @param Time the 2D stage spent on this frame in microseconds
+ * @param The MocapNET input of the frame
+ * @param Number of values, has to be the valuesPerFrame the log was created with
+ * @param NHWC heatmaps of the frame, can be null
+ * @param Number of heatmap values, a multiple of heatmapWidth*heatmapHeight
+ * @retval 1=Success/0=Failure
+ */
+int appendDetectionLogFrame(
+                             struct detectionLogWriter * writer,
+                             unsigned int frameNumber,
+                             unsigned int flags,
+                             unsigned long long captureTime,
+                             unsigned int detectionTime,
+                             const float * values,
+                             unsigned int numberOfValues,
+                             const float * heatmaps,
+                             unsigned int numberOfHeatmapValues
+                           );
+
+
+/**
+ * @brief Write the index and header of a detection log and close the file
+ * @param Pointer to an open struct detectionLogWriter
+ * @retval 1=Success/0=Failure
+ */
+int closeDetectionLogWriter(struct detectionLogWriter * writer);
+
+
+/**
+ * @brief Map an existing detection log in memory
+ * @param Pointer to a struct detectionLog that will hold the mapping
+ * @param Path to the log file
+ * @retval 1=Success/0=Failure
+ */
+int openDetectionLog(struct detectionLog * log,const char * filename);
+
+
+/**
+ * @brief Get the number of frames stored in a detection log
+ * @param Pointer to an open struct detectionLog
+ * @retval Number of frames
+ */
+unsigned int getDetectionLogNumberOfFrames(const struct detectionLog * log);
+
+
+/**
+ * @brief Retrieve a frame of a detection log, nothing is copied
+ * @param Pointer to an open struct detectionLog
+ * @param Frame number ( position in the log )
+ * @param Pointer to a struct detectionLogFrame that will point to the data of the frame
+ * @retval 1=Success/0=Failure ( frame does not exist or is truncated )
+ */
+int readDetectionLogFrame(const struct detectionLog * log,unsigned int frameID,struct detectionLogFrame * frame);
+
+
+/**
+ * @brief Unmap and close a detection log
+ * @param Pointer to an open struct detectionLog
+ * @retval 1=Success/0=Failure
+ */
+int closeDetectionLog(struct detectionLog * log);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DETECTIONLOG_H_INCLUDED
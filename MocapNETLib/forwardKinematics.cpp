@@ -0,0 +1,596 @@
+#include "forwardKinematics.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define MOCAPNET_FK_USE_SSE 1
+#endif
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+
+/*
+ * out = a * b , all matrices are row major, out must not alias a or b
+ */
+static inline void multiply4x4(float * out,const float * a,const float * b)
+{
+#if MOCAPNET_FK_USE_SSE
+    __m128 b0 = _mm_loadu_ps(b+0);
+    __m128 b1 = _mm_loadu_ps(b+4);
+    __m128 b2 = _mm_loadu_ps(b+8);
+    __m128 b3 = _mm_loadu_ps(b+12);
+    for (unsigned int row=0; row<4; row++)
+        {
+            const float * r = a + row*4;
+            __m128 result =               _mm_mul_ps(_mm_set1_ps(r[0]),b0);
+            result = _mm_add_ps(result,_mm_mul_ps(_mm_set1_ps(r[1]),b1));
+            result = _mm_add_ps(result,_mm_mul_ps(_mm_set1_ps(r[2]),b2));
+            result = _mm_add_ps(result,_mm_mul_ps(_mm_set1_ps(r[3]),b3));
+            _mm_storeu_ps(out + row*4,result);
+        }
+#else
+    for (unsigned int row=0; row<4; row++)
+        {
+            for (unsigned int col=0; col<4; col++)
+                {
+                    out[row*4+col] = a[row*4+0]*b[0*4+col] +
+                                     a[row*4+1]*b[1*4+col] +
+                                     a[row*4+2]*b[2*4+col] +
+                                     a[row*4+3]*b[3*4+col];
+                }
+        }
+#endif
+}
+
+
+static inline void setIdentity4x4(float * m)
+{
+    memset(m,0,sizeof(float)*16);
+    m[0]=1.0;
+    m[5]=1.0;
+    m[10]=1.0;
+    m[15]=1.0;
+}
+
+
+static inline void setRotation4x4(float * m,unsigned char channelType,float degrees)
+{
+    float radians = degrees * (M_PI / 180.0);
+    float c = cos(radians);
+    float s = sin(radians);
+    setIdentity4x4(m);
+    switch (channelType)
+        {
+        case MNET_FK_CHANNEL_XROTATION :
+            m[5]=c;
+            m[6]=-s;
+            m[9]=s;
+            m[10]=c;
+            break;
+        case MNET_FK_CHANNEL_YROTATION :
+            m[0]=c;
+            m[2]=s;
+            m[8]=-s;
+            m[10]=c;
+            break;
+        case MNET_FK_CHANNEL_ZROTATION :
+            m[0]=c;
+            m[1]=-s;
+            m[4]=s;
+            m[5]=c;
+            break;
+        }
+}
+
+
+static unsigned char getChannelType(const char * token)
+{
+    if (strcasecmp(token,"Xposition")==0)
+        {
+            return MNET_FK_CHANNEL_XPOSITION;
+        }
+    if (strcasecmp(token,"Yposition")==0)
+        {
+            return MNET_FK_CHANNEL_YPOSITION;
+        }
+    if (strcasecmp(token,"Zposition")==0)
+        {
+            return MNET_FK_CHANNEL_ZPOSITION;
+        }
+    if (strcasecmp(token,"Xrotation")==0)
+        {
+            return MNET_FK_CHANNEL_XROTATION;
+        }
+    if (strcasecmp(token,"Yrotation")==0)
+        {
+            return MNET_FK_CHANNEL_YROTATION;
+        }
+    if (strcasecmp(token,"Zrotation")==0)
+        {
+            return MNET_FK_CHANNEL_ZROTATION;
+        }
+    return MNET_FK_CHANNEL_NONE;
+}
+
+
+/*
+ * Copy the next whitespace separated token of text to token, returns a pointer right after it or null when there are no more tokens
+ */
+static const char * nextToken(const char * text,char * token,unsigned int tokenLength)
+{
+    while ( (*text!=0) && ( (*text==' ') || (*text=='\t') || (*text=='\n') || (*text=='\r') ) )
+        {
+            ++text;
+        }
+    if (*text==0)
+        {
+            return 0;
+        }
+
+    unsigned int i=0;
+    while ( (*text!=0) && (*text!=' ') && (*text!='\t') && (*text!='\n') && (*text!='\r') )
+        {
+            if (i+1<tokenLength)
+                {
+                    token[i++]=*text;
+                }
+            ++text;
+        }
+    token[i]=0;
+    return text;
+}
+
+
+int mocapnetFKLoadSkeleton(struct MocapNETFKSkeleton * skeleton,const char * bvhHeaderText)
+{
+    memset(skeleton,0,sizeof(struct MocapNETFKSkeleton));
+    if (bvhHeaderText==0)
+        {
+            return 0;
+        }
+
+    char token[MOCAPNET_FK_MAX_JOINT_NAME];
+    unsigned int stack[MOCAPNET_FK_MAX_JOINTS];
+    unsigned int stackSize=0;
+    unsigned int currentJoint=0;
+    int haveJoint=0;
+
+    const char * text = bvhHeaderText;
+    while ( (text=nextToken(text,token,MOCAPNET_FK_MAX_JOINT_NAME))!=0 )
+        {
+            if ( (strcmp(token,"ROOT")==0) || (strcmp(token,"JOINT")==0) || (strcmp(token,"End")==0) )
+                {
+                    if (skeleton->numberOfJoints>=MOCAPNET_FK_MAX_JOINTS)
+                        {
+                            fprintf(stderr,RED "mocapnetFKLoadSkeleton: too many joints\n" NORMAL);
+                            return 0;
+                        }
+                    int isEndSite = (strcmp(token,"End")==0);
+                    unsigned int jointID = skeleton->numberOfJoints;
+
+                    //The name of End Sites is derived from their parent to match the naming of the RGBDAcquisition BVH code
+                    text=nextToken(text,token,MOCAPNET_FK_MAX_JOINT_NAME);
+                    if (text==0)
+                        {
+                            return 0;
+                        }
+                    if (isEndSite)
+                        {
+                            if (stackSize==0)
+                                {
+                                    return 0;
+                                }
+                            char parentName[MOCAPNET_FK_MAX_JOINT_NAME-8]; //Room for the EndSite_ prefix
+                            snprintf(parentName,MOCAPNET_FK_MAX_JOINT_NAME-8,"%s",skeleton->jointName[stack[stackSize-1]]);
+                            snprintf(skeleton->jointName[jointID],MOCAPNET_FK_MAX_JOINT_NAME,"EndSite_%s",parentName);
+                        }
+                    else
+                        {
+                            snprintf(skeleton->jointName[jointID],MOCAPNET_FK_MAX_JOINT_NAME,"%s",token);
+                        }
+
+                    skeleton->isEndSite[jointID]=isEndSite;
+                    skeleton->parent[jointID] = (stackSize>0) ? stack[stackSize-1] : jointID;
+                    skeleton->firstChannel[jointID]=skeleton->numberOfValuesPerFrame;
+                    currentJoint=jointID;
+                    haveJoint=1;
+                    ++skeleton->numberOfJoints;
+                }
+            else if (strcmp(token,"{")==0)
+                {
+                    if ( (!haveJoint) || (stackSize>=MOCAPNET_FK_MAX_JOINTS) )
+                        {
+                            return 0;
+                        }
+                    stack[stackSize++]=currentJoint;
+                }
+            else if (strcmp(token,"}")==0)
+                {
+                    if (stackSize==0)
+                        {
+                            return 0;
+                        }
+                    --stackSize;
+                }
+            else if (strcmp(token,"OFFSET")==0)
+                {
+                    float offset[3];
+                    for (unsigned int i=0; i<3; i++)
+                        {
+                            text=nextToken(text,token,MOCAPNET_FK_MAX_JOINT_NAME);
+                            if (text==0)
+                                {
+                                    return 0;
+                                }
+                            offset[i]=atof(token);
+                        }
+                    skeleton->offsetX[currentJoint]=offset[0];
+                    skeleton->offsetY[currentJoint]=offset[1];
+                    skeleton->offsetZ[currentJoint]=offset[2];
+                }
+            else if (strcmp(token,"CHANNELS")==0)
+                {
+                    text=nextToken(text,token,MOCAPNET_FK_MAX_JOINT_NAME);
+                    if (text==0)
+                        {
+                            return 0;
+                        }
+                    unsigned int numberOfChannels = atoi(token);
+                    if (numberOfChannels>6)
+                        {
+                            fprintf(stderr,RED "mocapnetFKLoadSkeleton: joint %s has too many channels\n" NORMAL,skeleton->jointName[currentJoint]);
+                            return 0;
+                        }
+                    for (unsigned int i=0; i<numberOfChannels; i++)
+                        {
+                            text=nextToken(text,token,MOCAPNET_FK_MAX_JOINT_NAME);
+                            if (text==0)
+                                {
+                                    return 0;
+                                }
+                            skeleton->channelType[currentJoint][i]=getChannelType(token);
+                        }
+                    skeleton->numberOfChannels[currentJoint]=numberOfChannels;
+                    skeleton->firstChannel[currentJoint]=skeleton->numberOfValuesPerFrame;
+                    skeleton->numberOfValuesPerFrame+=numberOfChannels;
+                }
+            else if (strcmp(token,"MOTION")==0)
+                {
+                    break;
+                }
+        }
+
+    if ( (skeleton->numberOfJoints==0) || (stackSize!=0) )
+        {
+            fprintf(stderr,RED "mocapnetFKLoadSkeleton: malformed BVH hierarchy\n" NORMAL);
+            return 0;
+        }
+    return 1;
+}
+
+
+void mocapnetFKDefaultCamera(struct MocapNETFKCamera * camera,unsigned int width,unsigned int height)
+{
+    //Same intrinsics as convertBVHFrameTo2DPoints
+    camera->width=(float) width;
+    camera->height=(float) height;
+    camera->fX=582.18394;
+    camera->fY=582.52915;
+    camera->cX=(float) width/2;
+    camera->cY=(float) height/2;
+}
+
+
+int mocapnetFKGetJointID(const struct MocapNETFKSkeleton * skeleton,const char * jointName,unsigned int * jointID)
+{
+    for (unsigned int i=0; i<skeleton->numberOfJoints; i++)
+        {
+            if (strcasecmp(jointName,skeleton->jointName[i])==0)
+                {
+                    *jointID=i;
+                    return 1;
+                }
+        }
+    return 0;
+}
+
+
+/*
+ * Local transform of a joint, its offset and position channels followed by its rotations in the order they are declared in the CHANNELS line
+ */
+static inline void getLocalTransform(const struct MocapNETFKSkeleton * skeleton,unsigned int jointID,const float * bvhFrame,float * local)
+{
+    float rotation[16],temporary[16];
+
+    setIdentity4x4(local);
+    local[3]  = skeleton->offsetX[jointID];
+    local[7]  = skeleton->offsetY[jointID];
+    local[11] = skeleton->offsetZ[jointID];
+
+    const float * values = bvhFrame + skeleton->firstChannel[jointID];
+    for (unsigned int channel=0; channel<skeleton->numberOfChannels[jointID]; channel++)
+        {
+            unsigned char channelType = skeleton->channelType[jointID][channel];
+            switch (channelType)
+                {
+                case MNET_FK_CHANNEL_XPOSITION :
+                    local[3]+=values[channel];
+                    break;
+                case MNET_FK_CHANNEL_YPOSITION :
+                    local[7]+=values[channel];
+                    break;
+                case MNET_FK_CHANNEL_ZPOSITION :
+                    local[11]+=values[channel];
+                    break;
+                case MNET_FK_CHANNEL_XROTATION :
+                case MNET_FK_CHANNEL_YROTATION :
+                case MNET_FK_CHANNEL_ZROTATION :
+                    setRotation4x4(rotation,channelType,values[channel]);
+                    multiply4x4(temporary,local,rotation);
+                    memcpy(local,temporary,sizeof(float)*16);
+                    break;
+                }
+        }
+}
+
+
+static inline void storeWorldPosition(struct MocapNETFKState * state,unsigned int jointID)
+{
+    const float * world = state->worldTransform[jointID];
+    state->posX[jointID]=world[3];
+    state->posY[jointID]=world[7];
+    state->posZ[jointID]=world[11];
+}
+
+
+int mocapnetFKEvaluate(const struct MocapNETFKSkeleton * skeleton,struct MocapNETFKState * state,const float * bvhFrame,unsigned int bvhFrameSize)
+{
+    if ( (bvhFrame==0) || (bvhFrameSize<skeleton->numberOfValuesPerFrame) )
+        {
+            return 0;
+        }
+
+    //World transforms are about to be overwritten so whatever mocapnetFKEvaluateIncremental cached is no longer in sync
+    state->haveCache=0;
+
+    float local[16];
+
+    //Joints appear after their parents so a single pass is enough
+    for (unsigned int jointID=0; jointID<skeleton->numberOfJoints; jointID++)
+        {
+            getLocalTransform(skeleton,jointID,bvhFrame,local);
+
+            float * world = state->worldTransform[jointID];
+            unsigned int parentID = skeleton->parent[jointID];
+            if (parentID==jointID)
+                {
+                    memcpy(world,local,sizeof(float)*16);
+                }
+            else
+                {
+                    multiply4x4(world,state->worldTransform[parentID],local);
+                }
+            storeWorldPosition(state,jointID);
+        }
+    return 1;
+}
+
+
+void mocapnetFKInvalidateCache(struct MocapNETFKState * state)
+{
+    state->haveCache=0;
+}
+
+
+int mocapnetFKEvaluateIncremental(const struct MocapNETFKSkeleton * skeleton,struct MocapNETFKState * state,const float * bvhFrame,unsigned int bvhFrameSize)
+{
+    if ( (bvhFrame==0) || (bvhFrameSize<skeleton->numberOfValuesPerFrame) || (skeleton->numberOfValuesPerFrame>MOCAPNET_FK_MAX_VALUES) )
+        {
+            return -1;
+        }
+
+    //First pass, flag joints whose channels changed, the flag is inherited by the subtree but not through the root
+    //since body transforms are expressed relative to it
+    unsigned int rootID = 0;
+    int rootChanged = 0;
+    int bodyJointsChanged = 0;
+    for (unsigned int jointID=0; jointID<skeleton->numberOfJoints; jointID++)
+        {
+            unsigned int first = skeleton->firstChannel[jointID];
+            unsigned int size  = skeleton->numberOfChannels[jointID] * sizeof(float);
+            int changed = ( (!state->haveCache) || ( (size>0) && (memcmp(state->cachedValues+first,bvhFrame+first,size)!=0) ) );
+
+            unsigned int parentID = skeleton->parent[jointID];
+            if (parentID==jointID)
+                {
+                    rootID = jointID;
+                    rootChanged |= changed;
+                    state->dirty[jointID]=0;
+                }
+            else
+                {
+                    state->dirty[jointID] = changed || ( (parentID!=rootID) && (state->dirty[parentID]) );
+                    bodyJointsChanged += state->dirty[jointID];
+                }
+        }
+
+    if ( (!rootChanged) && (bodyJointsChanged==0) )
+        {
+            //Identical frame, everything is already in place
+            return 0;
+        }
+    memcpy(state->cachedValues,bvhFrame,sizeof(float) * skeleton->numberOfValuesPerFrame);
+    state->haveCache=1;
+
+    //Second pass, refresh dirty body transforms and compose them with the root
+    float local[16];
+    for (unsigned int jointID=0; jointID<skeleton->numberOfJoints; jointID++)
+        {
+            unsigned int parentID = skeleton->parent[jointID];
+            if (parentID==jointID)
+                {
+                    rootID = jointID;
+                    if (rootChanged)
+                        {
+                            getLocalTransform(skeleton,jointID,bvhFrame,state->worldTransform[jointID]);
+                            setIdentity4x4(state->bodyTransform[jointID]);
+                            storeWorldPosition(state,jointID);
+                        }
+                    continue;
+                }
+
+            if (state->dirty[jointID])
+                {
+                    if (parentID==rootID)
+                        {
+                            getLocalTransform(skeleton,jointID,bvhFrame,state->bodyTransform[jointID]);
+                        }
+                    else
+                        {
+                            getLocalTransform(skeleton,jointID,bvhFrame,local);
+                            multiply4x4(state->bodyTransform[jointID],state->bodyTransform[parentID],local);
+                        }
+                }
+
+            if ( (rootChanged) || (state->dirty[jointID]) )
+                {
+                    multiply4x4(state->worldTransform[jointID],state->worldTransform[rootID],state->bodyTransform[jointID]);
+                    storeWorldPosition(state,jointID);
+                }
+        }
+    return bodyJointsChanged;
+}
+
+
+unsigned int mocapnetFKProject(const struct MocapNETFKSkeleton * skeleton,struct MocapNETFKState * state,const struct MocapNETFKCamera * camera)
+{
+    for (unsigned int jointID=0; jointID<skeleton->numberOfJoints; jointID++)
+        {
+            float depth = -state->posZ[jointID];
+            if (depth>0.0)
+                {
+                    state->pos2DX[jointID] = camera->cX + camera->fX * state->posX[jointID] / depth;
+                    state->pos2DY[jointID] = camera->cY - camera->fY * state->posY[jointID] / depth;
+                }
+            else
+                {
+                    state->pos2DX[jointID] = 0.0;
+                    state->pos2DY[jointID] = 0.0;
+                }
+        }
+    return skeleton->numberOfJoints;
+}
+
+
+static void evaluateFrameRange(
+    const struct MocapNETFKSkeleton * skeleton,
+    const float * bvhFrames,
+    unsigned int startFrame,
+    unsigned int endFrame,
+    unsigned int bvhFrameSize,
+    const struct MocapNETFKCamera * camera,
+    float * output3D,
+    float * output2D,
+    unsigned int * framesEvaluated
+)
+{
+    struct MocapNETFKState * state = (struct MocapNETFKState *) malloc(sizeof(struct MocapNETFKState));
+    *framesEvaluated=0;
+    if (state==0)
+        {
+            return;
+        }
+
+    unsigned int numberOfJoints = skeleton->numberOfJoints;
+    for (unsigned int frameID=startFrame; frameID<endFrame; frameID++)
+        {
+            int success = mocapnetFKEvaluate(skeleton,state,bvhFrames + (unsigned long) frameID * bvhFrameSize,bvhFrameSize);
+            if ( (success) && (output2D!=0) )
+                {
+                    mocapnetFKProject(skeleton,state,camera);
+                }
+
+            if (output3D!=0)
+                {
+                    float * out = output3D + (unsigned long) frameID * numberOfJoints * 3;
+                    for (unsigned int jointID=0; jointID<numberOfJoints; jointID++)
+                        {
+                            out[jointID*3+0] = (success) ? state->posX[jointID] : 0.0;
+                            out[jointID*3+1] = (success) ? state->posY[jointID] : 0.0;
+                            out[jointID*3+2] = (success) ? state->posZ[jointID] : 0.0;
+                        }
+                }
+            if (output2D!=0)
+                {
+                    float * out = output2D + (unsigned long) frameID * numberOfJoints * 2;
+                    for (unsigned int jointID=0; jointID<numberOfJoints; jointID++)
+                        {
+                            out[jointID*2+0] = (success) ? state->pos2DX[jointID] : 0.0;
+                            out[jointID*2+1] = (success) ? state->pos2DY[jointID] : 0.0;
+                        }
+                }
+            *framesEvaluated+=success;
+        }
+    free(state);
+}
+
+
+unsigned int mocapnetFKEvaluateFrames(
+    const struct MocapNETFKSkeleton * skeleton,
+    const float * bvhFrames,
+    unsigned int numberOfFrames,
+    unsigned int bvhFrameSize,
+    const struct MocapNETFKCamera * camera,
+    float * output3D,
+    float * output2D,
+    unsigned int numberOfThreads
+)
+{
+    if ( (output2D!=0) && (camera==0) )
+        {
+            return 0;
+        }
+    if (numberOfThreads>numberOfFrames)
+        {
+            numberOfThreads=numberOfFrames;
+        }
+
+    if (numberOfThreads<=1)
+        {
+            unsigned int framesEvaluated=0;
+            evaluateFrameRange(skeleton,bvhFrames,0,numberOfFrames,bvhFrameSize,camera,output3D,output2D,&framesEvaluated);
+            return framesEvaluated;
+        }
+
+    //Contiguous ranges of frames, every thread writes to its own part of the output
+    std::vector<std::thread> workers;
+    std::vector<unsigned int> framesEvaluated(numberOfThreads,0);
+    unsigned int framesPerThread = numberOfFrames / numberOfThreads;
+    unsigned int remainingFrames = numberOfFrames % numberOfThreads;
+    unsigned int frameID=0;
+    for (unsigned int i=0; i<numberOfThreads; i++)
+        {
+            unsigned int startFrame=frameID;
+            frameID+=framesPerThread + (i<remainingFrames);
+            workers.push_back(std::thread(evaluateFrameRange,skeleton,bvhFrames,startFrame,frameID,bvhFrameSize,camera,output3D,output2D,&framesEvaluated[i]));
+        }
+
+    unsigned int totalFramesEvaluated=0;
+    for (unsigned int i=0; i<numberOfThreads; i++)
+        {
+            workers[i].join();
+            totalFramesEvaluated+=framesEvaluated[i];
+        }
+    return totalFramesEvaluated;
+}
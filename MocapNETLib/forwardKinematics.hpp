@@ -0,0 +1,184 @@
+#pragma once
+/** @file forwardKinematics.hpp
+ *  @brief A small self-contained forward kinematics engine for the MocapNET BVH skeleton. It does not depend on the optional
+ *  RGBDAcquisition BVH code so 3D/2D joint positions can be retrieved on every build. The hierarchy, offsets and channel order are
+ *  parsed once from a BVH header ( typically the bvhHeader found in mocapnet.hpp ), joint data is kept in a structure of arrays layout
+ *  and 4x4 transforms are composed using SSE when it is available.
+ *  The joint order is the order of appearance in the header including End Sites, which is also the order used by the RGBDAcquisition code.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+/**
+ * @brief Maximum number of joints ( including End Sites ) that the engine can handle
+ */
+#define MOCAPNET_FK_MAX_JOINTS 64
+
+/**
+ * @brief Maximum length of a joint name
+ */
+#define MOCAPNET_FK_MAX_JOINT_NAME 64
+
+/**
+ * @brief Maximum number of values of a BVH frame ( every joint can have up to 6 channels )
+ */
+#define MOCAPNET_FK_MAX_VALUES (MOCAPNET_FK_MAX_JOINTS*6)
+
+
+/**
+ * @brief The channel types that may appear in a BVH header
+ */
+enum MocapNETFKChannelType
+{
+    MNET_FK_CHANNEL_NONE=0,
+    MNET_FK_CHANNEL_XPOSITION,
+    MNET_FK_CHANNEL_YPOSITION,
+    MNET_FK_CHANNEL_ZPOSITION,
+    MNET_FK_CHANNEL_XROTATION,
+    MNET_FK_CHANNEL_YROTATION,
+    MNET_FK_CHANNEL_ZROTATION
+};
+
+
+/**
+ * @brief The static part of a skeleton, it is populated once and can then be shared ( read only ) by any number of threads.
+ * Per joint values are kept in separate arrays.
+ */
+struct MocapNETFKSkeleton
+{
+    unsigned int numberOfJoints;
+    unsigned int numberOfValuesPerFrame;
+    char jointName[MOCAPNET_FK_MAX_JOINTS][MOCAPNET_FK_MAX_JOINT_NAME];
+    unsigned int parent[MOCAPNET_FK_MAX_JOINTS];  //The root is its own parent
+    unsigned char isEndSite[MOCAPNET_FK_MAX_JOINTS];
+    float offsetX[MOCAPNET_FK_MAX_JOINTS];
+    float offsetY[MOCAPNET_FK_MAX_JOINTS];
+    float offsetZ[MOCAPNET_FK_MAX_JOINTS];
+    unsigned char numberOfChannels[MOCAPNET_FK_MAX_JOINTS];
+    unsigned int firstChannel[MOCAPNET_FK_MAX_JOINTS]; //Index of the first value of the joint in a frame
+    unsigned char channelType[MOCAPNET_FK_MAX_JOINTS][6];
+};
+
+
+/**
+ * @brief The per thread scratch space and output of the engine, nothing in here is shared.
+ * The body transforms, cached values and dirty flags are only used by mocapnetFKEvaluateIncremental.
+ */
+struct MocapNETFKState
+{
+    alignas(16) float worldTransform[MOCAPNET_FK_MAX_JOINTS][16]; //Row major 4x4 matrices
+    alignas(16) float bodyTransform[MOCAPNET_FK_MAX_JOINTS][16];  //Transform of every joint relative to the root
+    float cachedValues[MOCAPNET_FK_MAX_VALUES];                   //The BVH frame the body transforms were computed from
+    unsigned char dirty[MOCAPNET_FK_MAX_JOINTS];                  //Set when the body transform of a joint has to be recomputed
+    unsigned char haveCache;
+    float posX[MOCAPNET_FK_MAX_JOINTS];
+    float posY[MOCAPNET_FK_MAX_JOINTS];
+    float posZ[MOCAPNET_FK_MAX_JOINTS];
+    float pos2DX[MOCAPNET_FK_MAX_JOINTS];
+    float pos2DY[MOCAPNET_FK_MAX_JOINTS];
+};
+
+
+/**
+ * @brief Pinhole camera used to project the 3D joint positions, the camera sits at the origin looking towards -Z
+ */
+struct MocapNETFKCamera
+{
+    float width,height;
+    float fX,fY;
+    float cX,cY;
+};
+
+
+/**
+ * @brief Parse the hierarchy part of a BVH file
+ * @param Pointer to a struct MocapNETFKSkeleton that will be populated
+ * @param CString with the BVH header, parsing stops at the MOTION keyword
+ * @retval 1=Success/0=Failure
+ */
+int mocapnetFKLoadSkeleton(struct MocapNETFKSkeleton * skeleton,const char * bvhHeaderText);
+
+
+/**
+ * @brief Populate a camera with the default intrinsics used to visualize MocapNET output
+ * @param Pointer to a struct MocapNETFKCamera that will be populated
+ * @param Width of the 2D frame
+ * @param Height of the 2D frame
+ */
+void mocapnetFKDefaultCamera(struct MocapNETFKCamera * camera,unsigned int width,unsigned int height);
+
+
+/**
+ * @brief Get the joint ID of a joint using its name, the comparison is case insensitive
+ * @param Pointer to a populated struct MocapNETFKSkeleton
+ * @param CString with the name of the joint
+ * @param Pointer to an unsigned int that will receive the joint ID
+ * @retval 1=Found/0=Not Found
+ */
+int mocapnetFKGetJointID(const struct MocapNETFKSkeleton * skeleton,const char * jointName,unsigned int * jointID);
+
+
+/**
+ * @brief Compute the world transform and 3D position of every joint for a BVH frame
+ * @param Pointer to a populated struct MocapNETFKSkeleton
+ * @param Pointer to a struct MocapNETFKState that will receive the results
+ * @param Pointer to the values of a BVH frame
+ * @param Number of values of the BVH frame, it needs to be at least skeleton->numberOfValuesPerFrame
+ * @retval 1=Success/0=Failure
+ */
+int mocapnetFKEvaluate(const struct MocapNETFKSkeleton * skeleton,struct MocapNETFKState * state,const float * bvhFrame,unsigned int bvhFrameSize);
+
+
+/**
+ * @brief Compute the world transform and 3D position of every joint for a BVH frame reusing as much as possible from the
+ * previous call with the same state. Transforms of every joint relative to the root are cached, a joint is only recomputed when one of its
+ * channels or a channel of one of its ancestors ( excluding the root ) has changed. When only the root channels change ( for example when the
+ * same pose is shown from a different viewpoint ) only the root transform is recomputed and then composed with the cached body transforms.
+ * The results are the same as mocapnetFKEvaluate up to floating point rounding.
+ * @param Pointer to a populated struct MocapNETFKSkeleton
+ * @param Pointer to a struct MocapNETFKState that will receive the results, it should not be shared with calls for other skeletons
+ * @param Pointer to the values of a BVH frame
+ * @param Number of values of the BVH frame, it needs to be at least skeleton->numberOfValuesPerFrame
+ * @retval Number of joints whose body transform had to be recomputed, 0 when only the root changed/-1=Failure
+ */
+int mocapnetFKEvaluateIncremental(const struct MocapNETFKSkeleton * skeleton,struct MocapNETFKState * state,const float * bvhFrame,unsigned int bvhFrameSize);
+
+
+/**
+ * @brief Drop the cache used by mocapnetFKEvaluateIncremental so that the next call recomputes every joint
+ * @param Pointer to a struct MocapNETFKState
+ */
+void mocapnetFKInvalidateCache(struct MocapNETFKState * state);
+
+
+/**
+ * @brief Project the 3D positions computed by mocapnetFKEvaluate to 2D, joints behind the camera get 0,0 coordinates
+ * @param Pointer to a populated struct MocapNETFKSkeleton
+ * @param Pointer to a struct MocapNETFKState that has been through mocapnetFKEvaluate
+ * @param Pointer to the camera to use
+ * @retval Number of joints projected
+ */
+unsigned int mocapnetFKProject(const struct MocapNETFKSkeleton * skeleton,struct MocapNETFKState * state,const struct MocapNETFKCamera * camera);
+
+
+/**
+ * @brief Evaluate and project many frames splitting them across threads, every thread gets its own scratch space
+ * @param Pointer to a populated struct MocapNETFKSkeleton
+ * @param Pointer to numberOfFrames consecutive BVH frames
+ * @param Number of frames
+ * @param Number of values of every BVH frame
+ * @param Pointer to the camera to use
+ * @param Output of 3D positions, numberOfFrames * numberOfJoints * 3 floats ( x,y,z ), can be null
+ * @param Output of 2D positions, numberOfFrames * numberOfJoints * 2 floats ( x,y ), can be null
+ * @param Number of threads to use, 0 or 1 runs everything on the calling thread
+ * @retval Number of frames evaluated successfully
+ */
+unsigned int mocapnetFKEvaluateFrames(
+    const struct MocapNETFKSkeleton * skeleton,
+    const float * bvhFrames,
+    unsigned int numberOfFrames,
+    unsigned int bvhFrameSize,
+    const struct MocapNETFKCamera * camera,
+    float * output3D,
+    float * output2D,
+    unsigned int numberOfThreads
+);
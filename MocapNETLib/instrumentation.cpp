@@ -0,0 +1,430 @@
+#include "instrumentation.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <atomic>
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Every power of two is split in 32 sub buckets, values under 64 get a bucket each
+#define STAGE_HISTOGRAM_SUB_BUCKET_BITS 5
+#define STAGE_HISTOGRAM_SUB_BUCKETS (1<<STAGE_HISTOGRAM_SUB_BUCKET_BITS)
+//Values up to 2^32 microseconds ( more than an hour ), longer ones end up in the last bucket
+#define STAGE_HISTOGRAM_BUCKETS ((32-STAGE_HISTOGRAM_SUB_BUCKET_BITS+1)*STAGE_HISTOGRAM_SUB_BUCKETS)
+
+
+struct StageHistogram
+{
+    std::atomic<unsigned int> bucket[STAGE_HISTOGRAM_BUCKETS];
+    std::atomic<unsigned long> sum;
+    std::atomic<unsigned long> maximum;
+};
+
+struct StageTimers
+{
+    struct StageHistogram cumulative[MOCAPNET_STAGE_NUMBER];
+    //Emptied every time it is dumped
+    struct StageHistogram window[MOCAPNET_STAGE_NUMBER];
+
+    std::atomic<int> enabled;
+    std::atomic<int> dumping;
+    char dumpPath[1024];
+    unsigned int dumpInterval;
+    //Read by every thread that calls dumpStageStatisticsIfDue
+    std::atomic<unsigned long> lastDump;
+};
+
+//Zero initialized since it is static, atomics of integral types are fine with that
+static struct StageTimers timers;
+
+const char * const MocapNETInstrumentationStageNames[MOCAPNET_STAGE_NUMBER+1] =
+{
+    "capture",
+    "preprocess",
+    "2d_inference",
+    "peak_extraction",
+    "nsdm",
+    "classifier",
+    "ensemble",
+    "forward_kinematics",
+    "render",
+    //--------------------
+    "end"
+};
+
+
+static unsigned int bucketOfValue(unsigned long value)
+{
+    if (value>=0xFFFFFFFF)
+        {
+            return STAGE_HISTOGRAM_BUCKETS-1;
+        }
+    if (value<2*STAGE_HISTOGRAM_SUB_BUCKETS)
+        {
+            return (unsigned int) value;
+        }
+    unsigned int highestBit = 31 - __builtin_clz((unsigned int) value);
+    unsigned int shift = highestBit - STAGE_HISTOGRAM_SUB_BUCKET_BITS;
+    return (shift+1) * STAGE_HISTOGRAM_SUB_BUCKETS + (unsigned int) (value>>shift) - STAGE_HISTOGRAM_SUB_BUCKETS;
+}
+
+
+/*
+ * Largest value that falls in a bucket, percentiles are reported conservatively
+ */
+static unsigned long highestValueOfBucket(unsigned int bucket)
+{
+    if (bucket<2*STAGE_HISTOGRAM_SUB_BUCKETS)
+        {
+            return bucket;
+        }
+    unsigned int shift = bucket/STAGE_HISTOGRAM_SUB_BUCKETS - 1;
+    unsigned long lowest = (unsigned long) (bucket%STAGE_HISTOGRAM_SUB_BUCKETS + STAGE_HISTOGRAM_SUB_BUCKETS) << shift;
+    return lowest + (1ul<<shift) - 1;
+}
+
+
+static void recordInHistogram(struct StageHistogram * histogram,unsigned long microseconds)
+{
+    histogram->bucket[bucketOfValue(microseconds)].fetch_add(1,std::memory_order_relaxed);
+    histogram->sum.fetch_add(microseconds,std::memory_order_relaxed);
+
+    unsigned long maximum = histogram->maximum.load(std::memory_order_relaxed);
+    while ( (microseconds>maximum) && (!histogram->maximum.compare_exchange_weak(maximum,microseconds,std::memory_order_relaxed)) ) { }
+}
+
+
+/*
+ * Copy of a histogram, the window histograms are emptied at the same time so nothing recorded meanwhile is lost
+ */
+static void snapshotHistogram(struct StageHistogram * histogram,int empty,unsigned int * buckets,unsigned long * sum,unsigned long * maximum)
+{
+    for (unsigned int i=0; i<STAGE_HISTOGRAM_BUCKETS; i++)
+        {
+            buckets[i] = (empty) ? histogram->bucket[i].exchange(0,std::memory_order_relaxed) : histogram->bucket[i].load(std::memory_order_relaxed);
+        }
+    if (empty)
+        {
+            *sum=histogram->sum.exchange(0,std::memory_order_relaxed);
+            *maximum=histogram->maximum.exchange(0,std::memory_order_relaxed);
+        }
+    else
+        {
+            *sum=histogram->sum.load(std::memory_order_relaxed);
+            *maximum=histogram->maximum.load(std::memory_order_relaxed);
+        }
+}
+
+
+static void statisticsOfSnapshot(const unsigned int * buckets,unsigned long sum,unsigned long maximum,struct MocapNETStageStatistics * statistics)
+{
+    memset(statistics,0,sizeof(struct MocapNETStageStatistics));
+
+    //The samples are counted from the buckets so the percentiles always agree with them
+    unsigned long samples=0;
+    for (unsigned int i=0; i<STAGE_HISTOGRAM_BUCKETS; i++)
+        {
+            samples+=buckets[i];
+        }
+    if (samples==0)
+        {
+            return;
+        }
+    statistics->samples=samples;
+    statistics->average=(float) sum/samples;
+    statistics->maximum=maximum;
+
+    unsigned long p50Rank = (samples*50+99)/100;
+    unsigned long p90Rank = (samples*90+99)/100;
+    unsigned long p99Rank = (samples*99+99)/100;
+    unsigned long seen=0;
+    //Zero is a valid percentile ( sub-microsecond stages ) so it can not mark a percentile that was not found yet
+    int foundP50=0,foundP90=0;
+    for (unsigned int i=0; i<STAGE_HISTOGRAM_BUCKETS; i++)
+        {
+            if (buckets[i]==0)
+                {
+                    continue;
+                }
+            seen+=buckets[i];
+            unsigned long value = highestValueOfBucket(i);
+            //Never report more than what was actually seen
+            if (value>maximum)
+                {
+                    value=maximum;
+                }
+            if ( (!foundP50) && (seen>=p50Rank) )
+                {
+                    statistics->p50=value;
+                    foundP50=1;
+                }
+            if ( (!foundP90) && (seen>=p90Rank) )
+                {
+                    statistics->p90=value;
+                    foundP90=1;
+                }
+            if (seen>=p99Rank)
+                {
+                    statistics->p99=value;
+                    break;
+                }
+        }
+}
+
+
+void enableStageTimers(int enabled)
+{
+    timers.enabled.store(enabled!=0,std::memory_order_relaxed);
+}
+
+
+int stageTimersEnabled()
+{
+    return timers.enabled.load(std::memory_order_relaxed);
+}
+
+
+unsigned long getStageTimerTime()
+{
+    struct timespec ts;
+    if ( clock_gettime(CLOCK_MONOTONIC,&ts) != 0 )
+        {
+            return 0;
+        }
+    return (unsigned long) ts.tv_sec*1000000 + ts.tv_nsec/1000;
+}
+
+
+unsigned long startStageTimer()
+{
+    if (!stageTimersEnabled())
+        {
+            return 0;
+        }
+    return getStageTimerTime();
+}
+
+
+unsigned long stopStageTimer(unsigned int stage,unsigned long startTime)
+{
+    //A timer that was started while disabled has no start time
+    if ( (!stageTimersEnabled()) || (startTime==0) )
+        {
+            return 0;
+        }
+    unsigned long now = getStageTimerTime();
+    unsigned long elapsed = (now>startTime) ? now-startTime : 0;
+    recordStageTime(stage,elapsed);
+    return elapsed;
+}
+
+
+void recordStageTime(unsigned int stage,unsigned long microseconds)
+{
+    if ( (stage>=MOCAPNET_STAGE_NUMBER) || (!stageTimersEnabled()) )
+        {
+            return;
+        }
+    recordInHistogram(&timers.cumulative[stage],microseconds);
+    recordInHistogram(&timers.window[stage],microseconds);
+}
+
+
+int getStageStatistics(unsigned int stage,int cumulative,struct MocapNETStageStatistics * statistics)
+{
+    if ( (stage>=MOCAPNET_STAGE_NUMBER) || (statistics==0) )
+        {
+            return 0;
+        }
+    unsigned int buckets[STAGE_HISTOGRAM_BUCKETS];
+    unsigned long sum,maximum;
+    snapshotHistogram( (cumulative) ? &timers.cumulative[stage] : &timers.window[stage],0,buckets,&sum,&maximum);
+    statisticsOfSnapshot(buckets,sum,maximum,statistics);
+    return 1;
+}
+
+
+void resetStageStatistics()
+{
+    unsigned int buckets[STAGE_HISTOGRAM_BUCKETS];
+    unsigned long sum,maximum;
+    for (unsigned int stage=0; stage<MOCAPNET_STAGE_NUMBER; stage++)
+        {
+            snapshotHistogram(&timers.cumulative[stage],1,buckets,&sum,&maximum);
+            snapshotHistogram(&timers.window[stage],1,buckets,&sum,&maximum);
+        }
+}
+
+
+static int isCSVPath(const char * filename)
+{
+    unsigned int length = strlen(filename);
+    return ( (length>4) && (strcasecmp(filename+length-4,".csv")==0) );
+}
+
+
+static void writeStatisticsJSON(FILE * fp,const struct MocapNETStageStatistics * statistics)
+{
+    fprintf(fp,"{\"samples\":%lu,\"average\":%0.2f,\"p50\":%lu,\"p90\":%lu,\"p99\":%lu,\"max\":%lu}",
+            statistics->samples,statistics->average,statistics->p50,statistics->p90,statistics->p99,statistics->maximum);
+}
+
+
+int dumpStageStatistics(const char * filename)
+{
+    if (filename==0)
+        {
+            return 0;
+        }
+
+    struct MocapNETStageStatistics window[MOCAPNET_STAGE_NUMBER];
+    struct MocapNETStageStatistics cumulative[MOCAPNET_STAGE_NUMBER];
+    unsigned int buckets[STAGE_HISTOGRAM_BUCKETS];
+    unsigned long sum,maximum;
+    for (unsigned int stage=0; stage<MOCAPNET_STAGE_NUMBER; stage++)
+        {
+            snapshotHistogram(&timers.window[stage],1,buckets,&sum,&maximum);
+            statisticsOfSnapshot(buckets,sum,maximum,&window[stage]);
+            snapshotHistogram(&timers.cumulative[stage],0,buckets,&sum,&maximum);
+            statisticsOfSnapshot(buckets,sum,maximum,&cumulative[stage]);
+        }
+    unsigned long timestamp = getStageTimerTime();
+
+    if (isCSVPath(filename))
+        {
+            FILE * fp = fopen(filename,"a");
+            if (fp==0)
+                {
+                    fprintf(stderr,RED "Could not open %s to write stage statistics\n" NORMAL,filename);
+                    return 0;
+                }
+            if (ftell(fp)==0)
+                {
+                    fprintf(fp,"timestamp,stage,samples,average,p50,p90,p99,max,totalSamples,totalAverage,totalP50,totalP90,totalP99,totalMax\n");
+                }
+            for (unsigned int stage=0; stage<MOCAPNET_STAGE_NUMBER; stage++)
+                {
+                    fprintf(fp,"%lu,%s,%lu,%0.2f,%lu,%lu,%lu,%lu,%lu,%0.2f,%lu,%lu,%lu,%lu\n",
+                            timestamp,MocapNETInstrumentationStageNames[stage],
+                            window[stage].samples,window[stage].average,window[stage].p50,window[stage].p90,window[stage].p99,window[stage].maximum,
+                            cumulative[stage].samples,cumulative[stage].average,cumulative[stage].p50,cumulative[stage].p90,cumulative[stage].p99,cumulative[stage].maximum);
+                }
+            fclose(fp);
+            return 1;
+        }
+
+    //The snapshot is written next to the file and renamed over it so whoever watches it never reads half a file
+    char temporaryPath[1100];
+    snprintf(temporaryPath,1100,"%s.tmp",filename);
+    FILE * fp = fopen(temporaryPath,"w");
+    if (fp==0)
+        {
+            fprintf(stderr,RED "Could not open %s to write stage statistics\n" NORMAL,temporaryPath);
+            return 0;
+        }
+    fprintf(fp,"{\n\"timestamp\":%lu,\n\"unit\":\"microseconds\",\n\"stages\":{\n",timestamp);
+    for (unsigned int stage=0; stage<MOCAPNET_STAGE_NUMBER; stage++)
+        {
+            fprintf(fp," \"%s\":{\"window\":",MocapNETInstrumentationStageNames[stage]);
+            writeStatisticsJSON(fp,&window[stage]);
+            fprintf(fp,",\"total\":");
+            writeStatisticsJSON(fp,&cumulative[stage]);
+            fprintf(fp,"}%s\n",(stage+1<MOCAPNET_STAGE_NUMBER) ? "," : "");
+        }
+    fprintf(fp,"}\n}\n");
+    fclose(fp);
+
+    if (rename(temporaryPath,filename)!=0)
+        {
+            fprintf(stderr,RED "Could not replace %s with new stage statistics\n" NORMAL,filename);
+            return 0;
+        }
+    return 1;
+}
+
+
+int setStageStatisticsDump(const char * filename,unsigned int intervalMilliseconds)
+{
+    if (filename==0)
+        {
+            timers.dumpPath[0]=0;
+            return 1;
+        }
+    if (strlen(filename)>=1024)
+        {
+            fprintf(stderr,RED "Stage statistics path is too long\n" NORMAL);
+            return 0;
+        }
+    snprintf(timers.dumpPath,1024,"%s",filename);
+    timers.dumpInterval = intervalMilliseconds;
+    timers.lastDump.store(getStageTimerTime());
+    //CSV files collect rows over time, start with an empty one
+    if (isCSVPath(filename))
+        {
+            FILE * fp = fopen(filename,"w");
+            if (fp!=0)
+                {
+                    fclose(fp);
+                }
+        }
+    return 1;
+}
+
+
+int dumpStageStatisticsIfDue()
+{
+    if (timers.dumpPath[0]==0)
+        {
+            return 0;
+        }
+    unsigned long interval = (unsigned long) timers.dumpInterval*1000;
+    unsigned long now = getStageTimerTime();
+    unsigned long lastDump = timers.lastDump.load(std::memory_order_relaxed);
+    if ( (now<lastDump) || (now-lastDump<interval) )
+        {
+            return 0;
+        }
+    //Only one thread dumps at a time, the others just go on
+    if (timers.dumping.exchange(1))
+        {
+            return 0;
+        }
+    //Another thread may have dumped between the check above and getting here
+    lastDump = timers.lastDump.load();
+    if ( (now<lastDump) || (now-lastDump<interval) )
+        {
+            timers.dumping=0;
+            return 0;
+        }
+    timers.lastDump.store(now);
+    int success = dumpStageStatistics(timers.dumpPath);
+    timers.dumping=0;
+    return success;
+}
+
+
+void printStageStatistics(FILE * stream)
+{
+    fprintf(stream,"%-20s %10s %10s %10s %10s %10s %10s\n","Stage","Samples","Avg ms","p50 ms","p90 ms","p99 ms","Max ms");
+    for (unsigned int stage=0; stage<MOCAPNET_STAGE_NUMBER; stage++)
+        {
+            struct MocapNETStageStatistics statistics;
+            if ( (getStageStatistics(stage,1,&statistics)) && (statistics.samples>0) )
+                {
+                    fprintf(stream,"%-20s %10lu %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+                            MocapNETInstrumentationStageNames[stage],
+                            statistics.samples,
+                            statistics.average/1000,
+                            (float) statistics.p50/1000,
+                            (float) statistics.p90/1000,
+                            (float) statistics.p99/1000,
+                            (float) statistics.maximum/1000);
+                }
+        }
+}
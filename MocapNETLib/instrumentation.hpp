@@ -0,0 +1,142 @@
+#pragma once
+/** @file instrumentation.hpp
+ *  @brief Named timers for every stage of the MocapNET pipeline ( capture, preprocessing, 2D joint estimation, peak extraction, NSDM, direction classifier,
+ *  ensemble, forward kinematics/projection and rendering ). Every stage keeps an HDR-style histogram with log-linear buckets ( about 3% resolution from
+ *  a microsecond to over an hour ) so percentiles can be extracted without keeping the samples around. Recording a time is a couple of relaxed atomic
+ *  increments so any thread can record without taking a lock. Each stage has a cumulative histogram and a rolling one that is emptied every time it is
+ *  dumped, dumps are written as JSON ( a snapshot that is replaced ) or CSV ( a row per stage is appended ) depending on the extension of the file.
+ *  Timers are off until enableStageTimers is called, until then starting and stopping a timer does not even read the clock.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include <stdio.h>
+
+/**
+ * @brief The stages that are timed
+ */
+enum MocapNETInstrumentationStage
+{
+    MOCAPNET_STAGE_CAPTURE=0,
+    MOCAPNET_STAGE_PREPROCESS,
+    MOCAPNET_STAGE_2D_INFERENCE,
+    MOCAPNET_STAGE_PEAK_EXTRACTION,
+    MOCAPNET_STAGE_NSDM,
+    MOCAPNET_STAGE_CLASSIFIER,
+    MOCAPNET_STAGE_ENSEMBLE,
+    MOCAPNET_STAGE_FORWARD_KINEMATICS,
+    MOCAPNET_STAGE_RENDER,
+    //--------------------
+    MOCAPNET_STAGE_NUMBER
+};
+
+/**
+ * @brief Names of the stages as they appear in the dumps, defined in instrumentation.cpp
+ */
+extern const char * const MocapNETInstrumentationStageNames[MOCAPNET_STAGE_NUMBER+1];
+
+
+/**
+ * @brief Percentiles of a stage in microseconds, extracted from its histogram so they are accurate to about 3%
+ */
+struct MocapNETStageStatistics
+{
+    unsigned long samples;
+    float average;
+    unsigned long p50;
+    unsigned long p90;
+    unsigned long p99;
+    unsigned long maximum;
+};
+
+
+/**
+ * @brief Switch the stage timers on or off, they start off so that library users that do not look at the statistics do not pay for them
+ * @ingroup instrumentation
+ * @param 1 = Record stage times , 0 = Ignore them
+ */
+void enableStageTimers(int enabled);
+
+/**
+ * @brief Check if the stage timers are recording
+ * @ingroup instrumentation
+ * @retval 1 = Enabled , 0 = Disabled
+ */
+int stageTimersEnabled();
+
+/**
+ * @brief Get the time in microseconds from the clock the timers use
+ * @ingroup instrumentation
+ * @retval Microseconds since an arbitrary point in time
+ */
+unsigned long getStageTimerTime();
+
+/**
+ * @brief Start timing a stage
+ * @ingroup instrumentation
+ * @retval Start time to give to stopStageTimer, 0 when the timers are disabled
+ */
+unsigned long startStageTimer();
+
+/**
+ * @brief Record the time since startStageTimer was called for a stage
+ * @ingroup instrumentation
+ * @param Stage, see enum MocapNETInstrumentationStage
+ * @param Value returned by startStageTimer
+ * @retval Microseconds recorded, 0 when the timers are disabled
+ */
+unsigned long stopStageTimer(unsigned int stage,unsigned long startTime);
+
+/**
+ * @brief Record the duration of a stage that was measured elsewhere, safe to call from any thread, nothing is recorded when the timers are disabled
+ * @ingroup instrumentation
+ * @param Stage, see enum MocapNETInstrumentationStage
+ * @param Duration in microseconds
+ */
+void recordStageTime(unsigned int stage,unsigned long microseconds);
+
+/**
+ * @brief Get the statistics of a stage
+ * @ingroup instrumentation
+ * @param Stage, see enum MocapNETInstrumentationStage
+ * @param 1 = Everything recorded since the start , 0 = Only what was recorded since the last dump
+ * @param Pointer to a struct MocapNETStageStatistics that will receive them
+ * @retval 1 = Success , 0 = Failure
+ */
+int getStageStatistics(unsigned int stage,int cumulative,struct MocapNETStageStatistics * statistics);
+
+/**
+ * @brief Forget everything recorded so far
+ * @ingroup instrumentation
+ */
+void resetStageStatistics();
+
+/**
+ * @brief Write the statistics of all stages to a file and start a new rolling window
+ * @ingroup instrumentation
+ * @param Path to the file, files ending in .csv get a row appended per stage, anything else is replaced with a JSON snapshot
+ * @retval 1 = Success , 0 = Failure
+ */
+int dumpStageStatistics(const char * filename);
+
+/**
+ * @brief Set up periodic dumps, dumpStageStatisticsIfDue will then write to this file every time the interval passes
+ * @ingroup instrumentation
+ * @param Path to the file ( see dumpStageStatistics ), 0 disables periodic dumps
+ * @param Interval in milliseconds
+ * @retval 1 = Success , 0 = Failure
+ */
+int setStageStatisticsDump(const char * filename,unsigned int intervalMilliseconds);
+
+/**
+ * @brief Call this once per frame, it dumps the statistics if a dump was set up and its interval has passed
+ * @ingroup instrumentation
+ * @retval 1 = A dump was written , 0 = Nothing was done
+ */
+int dumpStageStatisticsIfDue();
+
+/**
+ * @brief Print a table with the cumulative statistics of every stage that recorded something
+ * @ingroup instrumentation
+ * @param Where to print, i.e. stderr
+ */
+void printStageStatistics(FILE * stream);
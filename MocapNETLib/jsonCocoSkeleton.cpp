@@ -43,6 +43,72 @@ float checkSkeletonDistance(struct skeletonCOCO * PreviousSkelA,struct skeletonC
     return score;
 }
 
+/*
+ * Fill a skeleton from the pose and hand keypoint arrays of one person, the arrays have already been cut at their closing bracket.
+ * Joints that are not in the arrays are not touched.
+ */
+static void parseJsonCOCOPerson(struct InputParserC * ipc,char * poseStart,char * handLeftStart,char * handRightStart,struct skeletonCOCO * skel)
+{
+    float value;
+    int numberOfJoints = InputParser_SeperateWords(ipc,poseStart,1)/3;
+    if (numberOfJoints>=BODY25_PARTS)
+        {
+            fprintf(stderr,RED "The number of joints found in JSON file (%u) is more than our COCO internal structure (%u)\n" NORMAL,numberOfJoints,COCO_PARTS);
+            exit(0);
+        }
+    for (int poseNum=0; poseNum<numberOfJoints; poseNum++)
+        {
+            skel->joint2D[poseNum].x = InputParser_GetWordFloat(ipc,poseNum*3+0);
+            //fprintf(stderr,"Pose%u x ( %u ) = %0.2f\n",poseNum,poseNum*3+0, skel->joint2D[poseNum].x  );
+
+            skel->joint2D[poseNum].y = InputParser_GetWordFloat(ipc,poseNum*3+1);
+            //fprintf(stderr,"Pose%u y ( %u ) = %0.2f\n",poseNum,poseNum*3+1,skel->joint2D[poseNum].y);
+
+            value = InputParser_GetWordFloat(ipc,poseNum*3+2);
+            if (value>1.0)
+                {
+                    fprintf(stderr,"Warning : Too large value for accuracy\n");
+                }
+            skel->jointAccuracy[poseNum] = value;
+            skel->active[poseNum] = (value>0.5);
+            //fprintf(stderr,"Pose%u A ( %u ) = %0.2f\n",poseNum,poseNum*3+2,value);
+        }
+
+
+    numberOfJoints = InputParser_SeperateWords(ipc,handLeftStart,1)/3;
+    skel->leftHand.isRight=0;
+    skel->leftHand.isLeft=1;
+    for (int poseNum=0; poseNum<numberOfJoints; poseNum++)
+        {
+            value = InputParser_GetWordFloat(ipc,poseNum*3+0);
+            skel->leftHand.joint2D[poseNum].x = value;
+
+            value = InputParser_GetWordFloat(ipc,poseNum*3+1);
+            skel->leftHand.joint2D[poseNum].y = value;
+
+            value = InputParser_GetWordFloat(ipc,poseNum*3+2);
+            skel->leftHand.jointAccuracy[poseNum] = value;
+            skel->leftHand.active[poseNum] = (value>0.5);
+        }
+
+    numberOfJoints = InputParser_SeperateWords(ipc,handRightStart,1)/3;
+    skel->rightHand.isRight=1;
+    skel->rightHand.isLeft=0;
+    for (int poseNum=0; poseNum<numberOfJoints; poseNum++)
+        {
+            value = InputParser_GetWordFloat(ipc,poseNum*3+0);
+            skel->rightHand.joint2D[poseNum].x = value;
+
+            value = InputParser_GetWordFloat(ipc,poseNum*3+1);
+            skel->rightHand.joint2D[poseNum].y = value;
+
+            value = InputParser_GetWordFloat(ipc,poseNum*3+2);
+            skel->rightHand.jointAccuracy[poseNum] = value;
+            skel->rightHand.active[poseNum] = (value>0.5);
+        }
+}
+
+
 int parseJsonCOCOSkeleton(const char * filename , struct skeletonCOCO * skel)
 {
     //memset(skel,0,sizeof(struct skeletonCOCO));
@@ -112,69 +178,91 @@ int parseJsonCOCOSkeleton(const char * filename , struct skeletonCOCO * skel)
                     //fprintf(stderr,"LHand : %s\n",handRightStart);
                     //fprintf(stderr,"Pose : %s\n",poseStart);
 
-                    float value;
-                    int numberOfJoints = InputParser_SeperateWords(ipc,poseStart,1)/3;
-                    if (numberOfJoints>=BODY25_PARTS)
-                        {
-                            fprintf(stderr,RED "The number of joints found in JSON file (%u) is more than our COCO internal structure (%u)\n" NORMAL,numberOfJoints,COCO_PARTS);
-                            exit(0);
-                        }
-                    for (int poseNum=0; poseNum<numberOfJoints; poseNum++)
-                        {
-                            skel->joint2D[poseNum].x = InputParser_GetWordFloat(ipc,poseNum*3+0);
-                            //fprintf(stderr,"Pose%u x ( %u ) = %0.2f\n",poseNum,poseNum*3+0, skel->joint2D[poseNum].x  );
-
-                            skel->joint2D[poseNum].y = InputParser_GetWordFloat(ipc,poseNum*3+1);
-                            //fprintf(stderr,"Pose%u y ( %u ) = %0.2f\n",poseNum,poseNum*3+1,skel->joint2D[poseNum].y);
-
-                            value = InputParser_GetWordFloat(ipc,poseNum*3+2);
-                            if (value>1.0)
-                                {
-                                    fprintf(stderr,"Warning : Too large value for accuracy\n");
-                                }
-                            skel->jointAccuracy[poseNum] = value;
-                            skel->active[poseNum] = (value>0.5);
-                            //fprintf(stderr,"Pose%u A ( %u ) = %0.2f\n",poseNum,poseNum*3+2,value);
-                        }
+                    parseJsonCOCOPerson(ipc,poseStart,handLeftStart,handRightStart,skel);
+                }
+            InputParser_Destroy(ipc);
+            fclose(fp);
+            return 1;
+        }
 
+    fprintf(stderr,"Could not find COCO 2D skeleton in %s \n",filename);
+    return 0;
+}
 
-                    numberOfJoints = InputParser_SeperateWords(ipc,handLeftStart,1)/3;
-                    skel->leftHand.isRight=0;
-                    skel->leftHand.isLeft=1;
-                    for (int poseNum=0; poseNum<numberOfJoints; poseNum++)
-                        {
-                            value = InputParser_GetWordFloat(ipc,poseNum*3+0);
-                            skel->leftHand.joint2D[poseNum].x = value;
 
-                            value = InputParser_GetWordFloat(ipc,poseNum*3+1);
-                            skel->leftHand.joint2D[poseNum].y = value;
+/*
+ * Find the keypoint array of a key that starts before limit ( 0 means no limit ), returns its first value and where it ends
+ */
+static char * findJsonCOCOArray(char * from,char * limit,const char * key,char ** end)
+{
+    *end=0;
+    char * start=strstr(from,key);
+    if ( (start==0) || ( (limit!=0) && (start>=limit) ) )
+        {
+            return 0;
+        }
+    start=strstr(start,"[")+1;
+    *end=strstr(start,"]");
+    return start;
+}
 
-                            value = InputParser_GetWordFloat(ipc,poseNum*3+2);
-                            skel->leftHand.jointAccuracy[poseNum] = value;
-                            skel->leftHand.active[poseNum] = (value>0.5);
-                        }
 
-                    numberOfJoints = InputParser_SeperateWords(ipc,handRightStart,1)/3;
-                    skel->rightHand.isRight=1;
-                    skel->rightHand.isLeft=0;
-                    for (int poseNum=0; poseNum<numberOfJoints; poseNum++)
-                        {
-                            value = InputParser_GetWordFloat(ipc,poseNum*3+0);
-                            skel->rightHand.joint2D[poseNum].x = value;
+int parseJsonCOCOSkeletons(const char * filename , struct skeletonCOCO * skeletons , unsigned int maxPeople , unsigned int * numberOfPeople)
+{
+    *numberOfPeople=0;
 
-                            value = InputParser_GetWordFloat(ipc,poseNum*3+1);
-                            skel->rightHand.joint2D[poseNum].y = value;
+    FILE * fp = fopen(filename,"r");
+    if (fp==0)
+        {
+            fprintf(stderr,"Could not find COCO 2D skeleton in %s \n",filename);
+            return 0;
+        }
 
-                            value = InputParser_GetWordFloat(ipc,poseNum*3+2);
-                            skel->rightHand.jointAccuracy[poseNum] = value;
-                            skel->rightHand.active[poseNum] = (value>0.5);
+    struct InputParserC * ipc = InputParser_Create(2048,3);
+    InputParser_SetDelimeter(ipc,0,',');
+    InputParser_SetDelimeter(ipc,1,',');
+
+    char * line = NULL;
+    size_t len = 0;
+    while ( (getline(&line, &len, fp) != -1) && (*numberOfPeople<maxPeople) )
+        {
+            //Every person of the people array starts with its pose keypoints, the hands that follow belong to it until the next person starts
+            char * person=strstr(line,"\"pose_keypoints_2d\":[");
+            while ( (person!=0) && (*numberOfPeople<maxPeople) )
+                {
+                    //Everything is found before any array is cut at its end, since that hides what follows from strstr
+                    char * nextPerson=strstr(person+1,"\"pose_keypoints_2d\":[");
+                    char * poseEnd, * handLeftEnd, * handRightEnd;
+                    char * poseStart      = findJsonCOCOArray(person,nextPerson,"\"pose_keypoints_2d\":[",&poseEnd);
+                    char * handLeftStart  = findJsonCOCOArray(person,nextPerson,"\"hand_left_keypoints_2d\":[",&handLeftEnd);
+                    char * handRightStart = findJsonCOCOArray(person,nextPerson,"\"hand_right_keypoints_2d\":[",&handRightEnd);
+                    if (poseEnd!=0)
+                        {
+                            *poseEnd=0;
                         }
+                    if (handLeftEnd!=0)
+                        {
+                            *handLeftEnd=0;
+                        }
+                    if (handRightEnd!=0)
+                        {
+                            *handRightEnd=0;
+                        }
+
+                    struct skeletonCOCO * skel = &skeletons[*numberOfPeople];
+                    memset(skel,0,sizeof(struct skeletonCOCO));
+                    parseJsonCOCOPerson(ipc,poseStart,handLeftStart,handRightStart,skel);
+                    ++*numberOfPeople;
+
+                    person=nextPerson;
                 }
-            InputParser_Destroy(ipc);
-            fclose(fp);
-            return 1;
         }
 
-    fprintf(stderr,"Could not find COCO 2D skeleton in %s \n",filename);
-    return 0;
+    if (line!=0)
+        {
+            free(line);
+        }
+    InputParser_Destroy(ipc);
+    fclose(fp);
+    return 1;
 }
@@ -302,6 +302,23 @@ int parseJsonCOCOSkeleton(
 );
 
 
+/**
+ * @brief Parse a JSON file and retrieve the skeletons of every person in it. Unlike parseJsonCOCOSkeleton every skeleton starts cleared
+ * and a file with an empty people array gives no skeletons instead of leaving the last one untouched.
+ * @param Path to JSON file
+ * @param Array of struct skeletonCOCO that will hold the people loaded
+ * @param Size of the array, people past it are ignored
+ * @param Output, number of people loaded, 0 for frames without people
+ * @retval 1=Success/0=Failure ( file could not be read )
+ */
+int parseJsonCOCOSkeletons(
+    const char * filename ,
+    struct skeletonCOCO * skeletons ,
+    unsigned int maxPeople ,
+    unsigned int * numberOfPeople
+);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -170,230 +170,205 @@ void addLeftFinger(
 }
 
 
-std::vector<float> flattenskeletonCOCOToVector(struct skeletonCOCO * sk,unsigned int width ,unsigned int height)
+/*
+ * Where every one of the 57 uncompressed MocapNET input joints comes from, in the order of MocapNETInputUncompressedJointNames
+ */
+static const struct MocapNETInputJointSource MocapNETInputJointSources[] =
 {
-    //Extra joints..
-    float hipX=0.0;
-    float hipY=0.0;
-    int hipExists=0;
-
-    float x,y,v;
-    std::vector<float> result;
-    //  MOCAPNET_UNCOMPRESSED_JOINT_HIP=0,        //0
-    x=(float) (sk->joint2D[BODY25_LHip].x + sk->joint2D[BODY25_RHip].x)/2;
-    y=(float) (sk->joint2D[BODY25_LHip].y + sk->joint2D[BODY25_RHip].y)/2;
-    if (
-        ( (sk->joint2D[BODY25_LHip].x==0.0)&&(sk->joint2D[BODY25_LHip].y==0.0) ) ||
-        ( (sk->joint2D[BODY25_RHip].x==0.0)&&(sk->joint2D[BODY25_RHip].y==0.0) )
-    )
+    { MNET_SOURCE_HIP,           0,                  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_HIP          0
+    { MNET_SOURCE_ABDOMEN,       0,                  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ABDOMEN      1
+    { MNET_SOURCE_CHEST,         0,                  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_CHEST        2
+    { MNET_SOURCE_BODY,          BODY25_Neck,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_NECK         3
+    { MNET_SOURCE_HEAD,          0,                  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_HEAD         4
+    { MNET_SOURCE_BODY,          BODY25_LEye,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LEFTEYE      5
+    { MNET_SOURCE_BODY,          BODY25_LEye,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_LEFTEYE   6
+    { MNET_SOURCE_BODY,          BODY25_REye,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RIGHTEYE     7
+    { MNET_SOURCE_BODY,          BODY25_REye,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_RIGHTEYE  8
+    { MNET_SOURCE_BODY_MIDPOINT, BODY25_Neck,        BODY25_RShoulder }, //MOCAPNET_UNCOMPRESSED_JOINT_RCOLLAR      9
+    { MNET_SOURCE_BODY,          BODY25_RShoulder,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER    10
+    { MNET_SOURCE_BODY,          BODY25_RElbow,      0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RELBOW       11
+    { MNET_SOURCE_BODY,          BODY25_RWrist,      0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RHAND        12
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Thumb_1,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RTHUMB1      13
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Thumb_2,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RTHUMB2      14
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Thumb_3,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_RTHUMB2   15
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Index_1,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RINDEX1      16
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Index_2,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RINDEX2      17
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Index_3,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_RINDEX2   18
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Middle_1, 0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RMID1        19
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Middle_2, 0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RMID2        20
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Middle_3, 0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_RMID2     21
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Ring_1,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RRING1       22
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Ring_2,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RRING2       23
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Ring_3,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_RRING2    24
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Pinky_1,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RPINKY1      25
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Pinky_2,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RPINKY2      26
+    { MNET_SOURCE_RIGHT_HAND,    COCO_Hand_Pinky_3,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_RPINKY2   27
+    { MNET_SOURCE_BODY_MIDPOINT, BODY25_Neck,        BODY25_LShoulder }, //MOCAPNET_UNCOMPRESSED_JOINT_LCOLLAR      28
+    { MNET_SOURCE_BODY,          BODY25_LShoulder,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER    29
+    { MNET_SOURCE_BODY,          BODY25_LElbow,      0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LELBOW       30
+    { MNET_SOURCE_BODY,          BODY25_LWrist,      0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LHAND        31
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Thumb_1,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LTHUMB1      32
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Thumb_2,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LTHUMB2      33
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Thumb_3,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_LTHUMB2   34
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Index_1,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LINDEX1      35
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Index_2,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LINDEX2      36
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Index_3,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_LINDEX2   37
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Middle_1, 0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LMID1        38
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Middle_2, 0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LMID2        39
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Middle_3, 0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_LMID2     40
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Ring_1,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LRING1       41
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Ring_2,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LRING2       42
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Ring_3,   0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_LRING2    43
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Pinky_1,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LPINKY1      44
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Pinky_2,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LPINKY2      45
+    { MNET_SOURCE_LEFT_HAND,     COCO_Hand_Pinky_3,  0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_LPINKY2   46
+    { MNET_SOURCE_BODY,          BODY25_RHip,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RBUTTOCK     47
+    { MNET_SOURCE_BODY,          BODY25_RHip,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RHIP         48
+    { MNET_SOURCE_BODY,          BODY25_RKnee,       0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RKNEE        49
+    { MNET_SOURCE_BODY,          BODY25_RAnkle,      0                }, //MOCAPNET_UNCOMPRESSED_JOINT_RFOOT        50
+    { MNET_SOURCE_BODY,          BODY25_RAnkle,      0                }, //MOCAPNET_UNCOMPRESSED_JOINT_ES_RFOOT     51
+    { MNET_SOURCE_BODY,          BODY25_LHip,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LBUTTOCK     52
+    { MNET_SOURCE_BODY,          BODY25_LHip,        0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LHIP         53
+    { MNET_SOURCE_BODY,          BODY25_LKnee,       0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LKNEE        54
+    { MNET_SOURCE_BODY,          BODY25_LAnkle,      0                }, //MOCAPNET_UNCOMPRESSED_JOINT_LFOOT        55
+    { MNET_SOURCE_BODY,          BODY25_LAnkle,      0                }  //MOCAPNET_UNCOMPRESSED_JOINT_ES_LFOOT     56
+};
+
+static const unsigned int MocapNETInputJointSourcesSize = sizeof(MocapNETInputJointSources) / sizeof(MocapNETInputJointSources[0]);
+
+
+static inline void emitPoint(float * output,unsigned int &written,float x,float y,float v,float width,float height)
+{
+    output[written+0]=x/width;
+    output[written+1]=y/height;
+    output[written+2]=v;
+    written+=3;
+}
+
+
+static inline void emitMidpoint(float * output,unsigned int &written,const struct point2D &a,const struct point2D &b,float width,float height)
+{
+    if ( bothZero(a.x,a.y) || bothZero(b.x,b.y) )
         {
-            v=0.0;
-            x=0.0;
-            y=0.0;
+            emitPoint(output,written,0.0,0.0,0.0,width,height);
         }
     else
         {
-            v=1.0;
-            hipX=x;
-            hipY=y;
-            hipExists=1;
+            emitPoint(output,written,(float) (a.x + b.x)/2,(float) (a.y + b.y)/2,1.0,width,height);
         }
-    result.push_back(x);
-    result.push_back(y);
-    result.push_back(v);
-    //------------------------------------
-
+}
 
-    float chestX= (float) (sk->joint2D[BODY25_Neck].x + hipX)/2;
-    float chestY= (float) (sk->joint2D[BODY25_Neck].y + hipY)/2;
-    int chestNotVisible= (( (sk->joint2D[BODY25_Neck].x==0.0)&&(sk->joint2D[BODY25_Neck].y==0.0) ) || ( (hipX==0.0)&&(hipY==0.0) ) );
 
+static inline void emitJoint(float * output,unsigned int &written,const struct point2D &a,float width,float height)
+{
+    emitPoint(output,written,a.x,a.y,(bothZero(a.x,a.y)) ? 0.0 : 1.0,width,height);
+}
 
 
-    //MOCAPNET_UNCOMPRESSED_JOINT_ABDOMEN,      //1
-    x=(float) (sk->joint2D[BODY25_Neck].x + chestX)/2;
-    y=(float) (sk->joint2D[BODY25_Neck].y + chestY)/2;
-    if ( (chestNotVisible) || ((sk->joint2D[BODY25_Neck].x==0.0)&&(sk->joint2D[BODY25_Neck].y==0.0))  )
-        {
-            v=0.0;
-            x=0.0;
-            y=0.0;
-        }
-    else
+unsigned int flattenskeletonCOCOToBuffer(struct skeletonCOCO * sk,unsigned int width,unsigned int height,float * output,unsigned int outputLength)
+{
+    if ( (output==0) || (outputLength<MOCAPNET_UNCOMPRESSED_INPUT_SIZE) )
         {
-            v=1.0;
+            fprintf(stderr,RED "flattenskeletonCOCOToBuffer: output buffer too small\n" NORMAL);
+            return 0;
         }
-    result.push_back(x);
-    result.push_back(y);
-    result.push_back(v);
-    //TODO:
-    //------------------------------------
 
-    //MOCAPNET_UNCOMPRESSED_JOINT_CHEST,        //2
-    x=chestX;
-    y=chestY;
-    if ( chestNotVisible )
-        {
-            v=0.0;
-            x=0.0;
-            y=0.0;
-        }
-    else
+    //The normalization divides by the float value of width/height exactly like the older two pass code
+    float fWidth=(float) width;
+    float fHeight=(float) height;
+
+    //The torso joints depend on each other so they are resolved once before walking the table
+    const struct point2D &neck = sk->joint2D[BODY25_Neck];
+    float hipX=0.0,hipY=0.0;
+    int hipVisible=bothJointAreNotZero(sk,BODY25_LHip,BODY25_RHip);
+    if (hipVisible)
         {
-            v=1.0;
+            hipX=(float) (sk->joint2D[BODY25_LHip].x + sk->joint2D[BODY25_RHip].x)/2;
+            hipY=(float) (sk->joint2D[BODY25_LHip].y + sk->joint2D[BODY25_RHip].y)/2;
         }
-    result.push_back(x);
-    result.push_back(y);
-    result.push_back(v);
-    //------------------------------------
-
+    float chestX= (float) (neck.x + hipX)/2;
+    float chestY= (float) (neck.y + hipY)/2;
+    int chestNotVisible= ( bothZero(neck.x,neck.y) || bothZero(hipX,hipY) );
 
-    //MOCAPNET_UNCOMPRESSED_JOINT_NECK,         //3
-    addSkeletonJoint(sk,result,COCO_Neck);
-    //------------------------------------
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_HEAD,         //4
-    //
-    int guessNose=1;
-    if (guessNose==1)
+    unsigned int written=0;
+    for (unsigned int jointID=0; jointID<MocapNETInputJointSourcesSize; jointID++)
         {
-            if (bothJointAreNotZero(sk,BODY25_LEar,BODY25_REar))
-                {
-                    addSkeletonJointFromTwoJoints(sk,result,BODY25_LEar,BODY25_REar);
-                }
-            else if (bothJointAreNotZero(sk,BODY25_LEye,BODY25_REye))
+            const struct MocapNETInputJointSource &source = MocapNETInputJointSources[jointID];
+            switch (source.type)
                 {
-                    addSkeletonJointFromTwoJoints(sk,result,BODY25_LEye,BODY25_REye);
+                case MNET_SOURCE_BODY :
+                    emitJoint(output,written,sk->joint2D[source.jointA],fWidth,fHeight);
+                    break;
+
+                case MNET_SOURCE_BODY_MIDPOINT :
+                    emitMidpoint(output,written,sk->joint2D[source.jointA],sk->joint2D[source.jointB],fWidth,fHeight);
+                    break;
+
+                case MNET_SOURCE_RIGHT_HAND :
+                    emitJoint(output,written,sk->rightHand.joint2D[source.jointA],fWidth,fHeight);
+                    break;
+
+                case MNET_SOURCE_LEFT_HAND :
+                    emitJoint(output,written,sk->leftHand.joint2D[source.jointA],fWidth,fHeight);
+                    break;
+
+                case MNET_SOURCE_HIP :
+                    if (hipVisible)
+                        {
+                            emitPoint(output,written,hipX,hipY,1.0,fWidth,fHeight);
+                        }
+                    else
+                        {
+                            emitPoint(output,written,0.0,0.0,0.0,fWidth,fHeight);
+                        }
+                    break;
+
+                case MNET_SOURCE_ABDOMEN :
+                    if (chestNotVisible)
+                        {
+                            emitPoint(output,written,0.0,0.0,0.0,fWidth,fHeight);
+                        }
+                    else
+                        {
+                            emitPoint(output,written,(float) (neck.x + chestX)/2,(float) (neck.y + chestY)/2,1.0,fWidth,fHeight);
+                        }
+                    break;
+
+                case MNET_SOURCE_CHEST :
+                    if (chestNotVisible)
+                        {
+                            emitPoint(output,written,0.0,0.0,0.0,fWidth,fHeight);
+                        }
+                    else
+                        {
+                            emitPoint(output,written,chestX,chestY,1.0,fWidth,fHeight);
+                        }
+                    break;
+
+                case MNET_SOURCE_HEAD :
+                    if (bothJointAreNotZero(sk,BODY25_LEar,BODY25_REar))
+                        {
+                            emitMidpoint(output,written,sk->joint2D[BODY25_LEar],sk->joint2D[BODY25_REar],fWidth,fHeight);
+                        }
+                    else if (bothJointAreNotZero(sk,BODY25_LEye,BODY25_REye))
+                        {
+                            emitMidpoint(output,written,sk->joint2D[BODY25_LEye],sk->joint2D[BODY25_REye],fWidth,fHeight);
+                        }
+                    //If neither pair is visible nothing is emitted, this is what the original code did as well..
+                    break;
                 }
         }
-    else
-        {
-            addSkeletonJoint(sk,result,BODY25_Nose);
-        }
-    //------------------------------------
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LEFTEYE,      //5
-    addSkeletonJoint(sk,result,BODY25_LEye);
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_LEFTEYE,   //6
-    addSkeletonJoint(sk,result,BODY25_LEye);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RIGHTEYE,     //7
-    addSkeletonJoint(sk,result,BODY25_REye);
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_RIGHTEYE,  //8
-    addSkeletonJoint(sk,result,BODY25_REye);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RCOLLAR,      //9
-    addSkeletonJointFromTwoJoints(sk,result,BODY25_Neck,BODY25_RShoulder);
-    //------------------------------
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER,    //10
-    addSkeletonJoint(sk,result,BODY25_RShoulder);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RELBOW,       //11
-    addSkeletonJoint(sk,result,BODY25_RElbow);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RHAND,        //12
-    addSkeletonJoint(sk,result,BODY25_RWrist);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RTHUMB1,      //13
-    //MOCAPNET_UNCOMPRESSED_JOINT_RTHUMB2,      //14
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_RTHUMB2,   //15
-    addRightFinger(sk,result,COCO_Hand_Thumb_1,COCO_Hand_Thumb_2,COCO_Hand_Thumb_3);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RINDEX1,      //16
-    //MOCAPNET_UNCOMPRESSED_JOINT_RINDEX2,      //17
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_RINDEX2,   //18
-    addRightFinger(sk,result,COCO_Hand_Index_1,COCO_Hand_Index_2,COCO_Hand_Index_3);
-
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RMID1,        //19
-    //MOCAPNET_UNCOMPRESSED_JOINT_RMID2,        //20
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_RMID2,     //21
-    addRightFinger(sk,result,COCO_Hand_Middle_1,COCO_Hand_Middle_2,COCO_Hand_Middle_3);
-
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RRING1,       //22
-    //MOCAPNET_UNCOMPRESSED_JOINT_RRING2,       //23
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_RRING2,    //24
-    addRightFinger(sk,result,COCO_Hand_Ring_1,COCO_Hand_Ring_2,COCO_Hand_Ring_3);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RPINKY1,      //25
-    //MOCAPNET_UNCOMPRESSED_JOINT_RPINKY2,      //26
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_RPINKY2,   //27
-    addRightFinger(sk,result,COCO_Hand_Pinky_1,COCO_Hand_Pinky_2,COCO_Hand_Pinky_3);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LCOLLAR,      //28
-    addSkeletonJointFromTwoJoints(sk,result,BODY25_Neck,BODY25_LShoulder);
 
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER,    //29
-    addSkeletonJoint(sk,result,BODY25_LShoulder);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LELBOW,       //30
-    addSkeletonJoint(sk,result,BODY25_LElbow);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LHAND,        //31
-    addSkeletonJoint(sk,result,BODY25_LWrist);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LTHUMB1,      //32
-    //MOCAPNET_UNCOMPRESSED_JOINT_LTHUMB2,      //33
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_LTHUMB2,   //34
-    addLeftFinger(sk,result,COCO_Hand_Thumb_1,COCO_Hand_Thumb_2,COCO_Hand_Thumb_3);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LINDEX1,      //35
-    //MOCAPNET_UNCOMPRESSED_JOINT_LINDEX2,      //36
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_LINDEX2,   //37
-    addLeftFinger(sk,result,COCO_Hand_Index_1,COCO_Hand_Index_2,COCO_Hand_Index_3);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LMID1,        //38
-    //MOCAPNET_UNCOMPRESSED_JOINT_LMID2,        //39
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_LMID2,     //40
-    addLeftFinger(sk,result,COCO_Hand_Middle_1,COCO_Hand_Middle_2,COCO_Hand_Middle_3);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LRING1,       //41
-    //MOCAPNET_UNCOMPRESSED_JOINT_LRING2,       //42
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_LRING2,    //43
-    addLeftFinger(sk,result,COCO_Hand_Ring_1,COCO_Hand_Ring_2,COCO_Hand_Ring_3);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LPINKY1,      //44
-    //MOCAPNET_UNCOMPRESSED_JOINT_LPINKY2,      //45
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_LPINKY2,   //46
-    addLeftFinger(sk,result,COCO_Hand_Pinky_1,COCO_Hand_Pinky_2,COCO_Hand_Pinky_3);
-
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RBUTTOCK,     //47
-    //MOCAPNET_UNCOMPRESSED_JOINT_RHIP,         //48
-    addSkeletonJoint(sk,result,BODY25_RHip);
-    addSkeletonJoint(sk,result,BODY25_RHip);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RKNEE,        //49
-    addSkeletonJoint(sk,result,BODY25_RKnee);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_RFOOT,        //50
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_RFOOT,     //51
-    addSkeletonJoint(sk,result,BODY25_RAnkle);
-    addSkeletonJoint(sk,result,BODY25_RAnkle);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LBUTTOCK,     //52
-    //MOCAPNET_UNCOMPRESSED_JOINT_LHIP,         //53
-    addSkeletonJoint(sk,result,BODY25_LHip);
-    addSkeletonJoint(sk,result,BODY25_LHip);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LKNEE,        //54
-    addSkeletonJoint(sk,result,BODY25_LKnee);
-
-    //MOCAPNET_UNCOMPRESSED_JOINT_LFOOT,        //55
-    //MOCAPNET_UNCOMPRESSED_JOINT_ES_LFOOT,     //56
-    addSkeletonJoint(sk,result,BODY25_LAnkle);
-    addSkeletonJoint(sk,result,BODY25_LAnkle);
+    return written;
+}
 
 
-    for (int i=0; i<result.size()/3; i++)
-        {
-            result[i*3+0]=(float) result[i*3+0]/width;
-            result[i*3+1]=(float) result[i*3+1]/height;
-        }
+std::vector<float> flattenskeletonCOCOToVector(struct skeletonCOCO * sk,unsigned int width ,unsigned int height)
+{
+    float buffer[MOCAPNET_UNCOMPRESSED_INPUT_SIZE];
+    unsigned int written = flattenskeletonCOCOToBuffer(sk,width,height,buffer,MOCAPNET_UNCOMPRESSED_INPUT_SIZE);
 
+    std::vector<float> result(buffer,buffer+written);
     if (result.size()==0)
         {
             fprintf(stderr,"Could not convert skeleton to vector..\n");
@@ -4,9 +4,37 @@
  *  @author Ammar Qammaz (AmmarkoV)
  */
 #include "jsonCocoSkeleton.h"
+#include "mocapnetRegistry.hpp"
 #include <vector>
 
 
+/**
+ * @brief The ways an uncompressed MocapNET input joint can be derived from a BODY25 skeleton and its hands
+ */
+enum MocapNETInputJointSourceType
+{
+    MNET_SOURCE_BODY=0,        //A single BODY25 joint ( jointA )
+    MNET_SOURCE_BODY_MIDPOINT, //The midpoint of two BODY25 joints ( jointA , jointB )
+    MNET_SOURCE_RIGHT_HAND,    //A single joint of the right hand ( jointA )
+    MNET_SOURCE_LEFT_HAND,     //A single joint of the left hand ( jointA )
+    MNET_SOURCE_HIP,           //Midpoint of the two hips
+    MNET_SOURCE_ABDOMEN,       //Midpoint of the neck and the chest
+    MNET_SOURCE_CHEST,         //Midpoint of the neck and the hip
+    MNET_SOURCE_HEAD           //Midpoint of the ears, or if they are not visible midpoint of the eyes
+};
+
+
+/**
+ * @brief An entry of the mapping table, one for every uncompressed MocapNET input joint
+ */
+struct MocapNETInputJointSource
+{
+    unsigned char type;
+    unsigned char jointA;
+    unsigned char jointB;
+};
+
+
 void addSkeletonJointFromTwoJoints(
     struct skeletonCOCO * sk,
     std::vector<float> &result,
@@ -40,3 +68,17 @@ void addLeftFinger(
 );
 
 std::vector<float> flattenskeletonCOCOToVector(struct skeletonCOCO * sk,unsigned int width ,unsigned int height);
+
+
+/**
+ * @brief Flatten a BODY25 skeleton to the uncompressed MocapNET input in a caller supplied buffer, it is driven by a mapping table
+ * and does the width/height normalization in the same pass. The output is identical to flattenskeletonCOCOToVector.
+ * @param Pointer to a populated struct skeletonCOCO
+ * @param Width of the image the skeleton was observed in
+ * @param Height of the image the skeleton was observed in
+ * @param Output buffer
+ * @param Size of the output buffer in floats, it should be at least MOCAPNET_UNCOMPRESSED_INPUT_SIZE
+ * @retval Number of floats written, this will be MOCAPNET_UNCOMPRESSED_INPUT_SIZE unless the head could not be resolved
+ * ( neither ears nor eyes visible ) in which case the head joint is left out just like flattenskeletonCOCOToVector does, 0=Failure
+ */
+unsigned int flattenskeletonCOCOToBuffer(struct skeletonCOCO * sk,unsigned int width,unsigned int height,float * output,unsigned int outputLength);
@@ -0,0 +1,323 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "keypointArchive.h"
+
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+
+/*
+ * Every person is stored as x,y,confidence triplets for the body followed by the left and right hand
+ */
+static unsigned int getFloatsPerPerson(unsigned int bodyJoints,unsigned int handJoints)
+{
+    return (bodyJoints + 2 * handJoints) * 3;
+}
+
+
+int createKeypointArchive(struct keypointArchiveWriter * writer,const char * filename)
+{
+    memset(writer,0,sizeof(struct keypointArchiveWriter));
+
+    writer->fp = fopen(filename,"wb");
+    if (writer->fp==0)
+        {
+            fprintf(stderr,RED "Could not create keypoint archive %s\n" NORMAL,filename);
+            return 0;
+        }
+
+    memcpy(writer->header.magic,KEYPOINT_ARCHIVE_MAGIC,4);
+    writer->header.version    = KEYPOINT_ARCHIVE_VERSION;
+    writer->header.bodyJoints = BODY25_PARTS;
+    writer->header.handJoints = COCO_HAND_PARTS;
+
+    //The header gets rewritten when the archive is closed and we know the number of frames and the index position
+    if (fwrite(&writer->header,sizeof(struct keypointArchiveHeader),1,writer->fp)!=1)
+        {
+            fclose(writer->fp);
+            writer->fp=0;
+            return 0;
+        }
+    return 1;
+}
+
+
+int appendKeypointArchiveFrame(struct keypointArchiveWriter * writer,struct skeletonCOCO * skeletons,unsigned int numberOfPeople)
+{
+    if (writer->fp==0)
+        {
+            return 0;
+        }
+
+    if (writer->header.numberOfFrames>=writer->indexAllocated)
+        {
+            unsigned int newSize = (writer->indexAllocated==0) ? 1024 : writer->indexAllocated*2;
+            unsigned long long * newIndex = (unsigned long long *) realloc(writer->index,sizeof(unsigned long long) * newSize);
+            if (newIndex==0)
+                {
+                    fprintf(stderr,RED "Could not grow keypoint archive index\n" NORMAL);
+                    return 0;
+                }
+            writer->index=newIndex;
+            writer->indexAllocated=newSize;
+        }
+
+    writer->index[writer->header.numberOfFrames] = (unsigned long long) ftell(writer->fp);
+
+    unsigned int floatsPerPerson = getFloatsPerPerson(writer->header.bodyJoints,writer->header.handJoints);
+    float record[ (BODY25_PARTS + 2 * COCO_HAND_PARTS) * 3 ];
+
+    if (fwrite(&numberOfPeople,sizeof(unsigned int),1,writer->fp)!=1)
+        {
+            return 0;
+        }
+
+    for (unsigned int personID=0; personID<numberOfPeople; personID++)
+        {
+            struct skeletonCOCO * sk = &skeletons[personID];
+            unsigned int i=0;
+            for (unsigned int jointID=0; jointID<BODY25_PARTS; jointID++)
+                {
+                    record[i++]=sk->joint2D[jointID].x;
+                    record[i++]=sk->joint2D[jointID].y;
+                    record[i++]=sk->jointAccuracy[jointID];
+                }
+            for (unsigned int jointID=0; jointID<COCO_HAND_PARTS; jointID++)
+                {
+                    record[i++]=sk->leftHand.joint2D[jointID].x;
+                    record[i++]=sk->leftHand.joint2D[jointID].y;
+                    record[i++]=sk->leftHand.jointAccuracy[jointID];
+                }
+            for (unsigned int jointID=0; jointID<COCO_HAND_PARTS; jointID++)
+                {
+                    record[i++]=sk->rightHand.joint2D[jointID].x;
+                    record[i++]=sk->rightHand.joint2D[jointID].y;
+                    record[i++]=sk->rightHand.jointAccuracy[jointID];
+                }
+
+            if (fwrite(record,sizeof(float),floatsPerPerson,writer->fp)!=floatsPerPerson)
+                {
+                    return 0;
+                }
+        }
+
+    ++writer->header.numberOfFrames;
+    return 1;
+}
+
+
+int closeKeypointArchiveWriter(struct keypointArchiveWriter * writer)
+{
+    int success=0;
+    if (writer->fp!=0)
+        {
+            writer->header.indexOffset = (unsigned long long) ftell(writer->fp);
+
+            if (
+                (fwrite(writer->index,sizeof(unsigned long long),writer->header.numberOfFrames,writer->fp)==writer->header.numberOfFrames) &&
+                (fseek(writer->fp,0,SEEK_SET)==0) &&
+                (fwrite(&writer->header,sizeof(struct keypointArchiveHeader),1,writer->fp)==1)
+            )
+                {
+                    success=1;
+                }
+            fclose(writer->fp);
+            writer->fp=0;
+        }
+
+    if (writer->index!=0)
+        {
+            free(writer->index);
+            writer->index=0;
+        }
+    writer->indexAllocated=0;
+    return success;
+}
+
+
+int openKeypointArchive(struct keypointArchive * archive,const char * filename)
+{
+    memset(archive,0,sizeof(struct keypointArchive));
+    archive->fd=-1;
+
+    int fd = open(filename,O_RDONLY);
+    if (fd<0)
+        {
+            fprintf(stderr,RED "Could not open keypoint archive %s\n" NORMAL,filename);
+            return 0;
+        }
+
+    struct stat st;
+    if ( (fstat(fd,&st)!=0) || ((unsigned long long) st.st_size<sizeof(struct keypointArchiveHeader)) )
+        {
+            fprintf(stderr,RED "Keypoint archive %s is too small\n" NORMAL,filename);
+            close(fd);
+            return 0;
+        }
+
+    void * data = mmap(0,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    if (data==MAP_FAILED)
+        {
+            fprintf(stderr,RED "Could not map keypoint archive %s\n" NORMAL,filename);
+            close(fd);
+            return 0;
+        }
+    //Frames are mostly consumed in order
+    madvise(data,st.st_size,MADV_SEQUENTIAL);
+
+    const struct keypointArchiveHeader * header = (const struct keypointArchiveHeader *) data;
+    unsigned long long size = (unsigned long long) st.st_size;
+
+    if (
+        (memcmp(header->magic,KEYPOINT_ARCHIVE_MAGIC,4)!=0) ||
+        (header->version!=KEYPOINT_ARCHIVE_VERSION) ||
+        (header->bodyJoints!=BODY25_PARTS) ||
+        (header->handJoints!=COCO_HAND_PARTS) ||
+        (header->indexOffset>size) ||
+        (header->indexOffset + (unsigned long long) header->numberOfFrames * sizeof(unsigned long long) > size)
+    )
+        {
+            fprintf(stderr,RED "%s is not a compatible keypoint archive\n" NORMAL,filename);
+            munmap(data,st.st_size);
+            close(fd);
+            return 0;
+        }
+
+    archive->fd     = fd;
+    archive->data   = data;
+    archive->size   = size;
+    archive->header = header;
+    archive->index  = (const unsigned long long *) ((const char *) data + header->indexOffset);
+
+    fprintf(stderr,"Keypoint archive %s has %u frames\n",filename,header->numberOfFrames);
+    return 1;
+}
+
+
+unsigned int getKeypointArchiveNumberOfFrames(const struct keypointArchive * archive)
+{
+    if (archive->header==0)
+        {
+            return 0;
+        }
+    return archive->header->numberOfFrames;
+}
+
+
+/*
+ * Returns a pointer to the record of a frame after checking that it lies inside the mapping
+ */
+static const char * getKeypointArchiveFrameRecord(const struct keypointArchive * archive,unsigned int frameID)
+{
+    if ( (archive->header==0) || (frameID>=archive->header->numberOfFrames) )
+        {
+            return 0;
+        }
+
+    unsigned long long offset = archive->index[frameID];
+    if (offset + sizeof(unsigned int) > archive->header->indexOffset)
+        {
+            return 0;
+        }
+    return (const char *) archive->data + offset;
+}
+
+
+unsigned int getKeypointArchiveNumberOfPeople(const struct keypointArchive * archive,unsigned int frameID)
+{
+    const char * record = getKeypointArchiveFrameRecord(archive,frameID);
+    if (record==0)
+        {
+            return 0;
+        }
+    unsigned int numberOfPeople;
+    memcpy(&numberOfPeople,record,sizeof(unsigned int));
+    return numberOfPeople;
+}
+
+
+int readKeypointArchiveSkeleton(const struct keypointArchive * archive,unsigned int frameID,unsigned int personID,struct skeletonCOCO * skel)
+{
+    const char * record = getKeypointArchiveFrameRecord(archive,frameID);
+    if (record==0)
+        {
+            return 0;
+        }
+
+    unsigned int numberOfPeople;
+    memcpy(&numberOfPeople,record,sizeof(unsigned int));
+    if (personID>=numberOfPeople)
+        {
+            //Frames without people leave the skeleton untouched just like parseJsonCOCOSkeleton does
+            return 1;
+        }
+
+    unsigned int floatsPerPerson = getFloatsPerPerson(archive->header->bodyJoints,archive->header->handJoints);
+    unsigned long long personOffset = sizeof(unsigned int) + (unsigned long long) personID * floatsPerPerson * sizeof(float);
+    if ( (record - (const char *) archive->data) + personOffset + floatsPerPerson * sizeof(float) > archive->header->indexOffset )
+        {
+            fprintf(stderr,RED "Keypoint archive frame %u is truncated\n" NORMAL,frameID);
+            return 0;
+        }
+
+    //Records are not guaranteed to be aligned so copy them out
+    float values[ (BODY25_PARTS + 2 * COCO_HAND_PARTS) * 3 ];
+    memcpy(values,record+personOffset,floatsPerPerson * sizeof(float));
+
+    unsigned int i=0;
+    for (unsigned int jointID=0; jointID<BODY25_PARTS; jointID++)
+        {
+            skel->joint2D[jointID].x      = values[i++];
+            skel->joint2D[jointID].y      = values[i++];
+            skel->jointAccuracy[jointID]  = values[i++];
+            skel->active[jointID]         = (skel->jointAccuracy[jointID]>0.5);
+        }
+
+    skel->leftHand.isRight=0;
+    skel->leftHand.isLeft=1;
+    for (unsigned int jointID=0; jointID<COCO_HAND_PARTS; jointID++)
+        {
+            skel->leftHand.joint2D[jointID].x      = values[i++];
+            skel->leftHand.joint2D[jointID].y      = values[i++];
+            skel->leftHand.jointAccuracy[jointID]  = values[i++];
+            skel->leftHand.active[jointID]         = (skel->leftHand.jointAccuracy[jointID]>0.5);
+        }
+
+    skel->rightHand.isRight=1;
+    skel->rightHand.isLeft=0;
+    for (unsigned int jointID=0; jointID<COCO_HAND_PARTS; jointID++)
+        {
+            skel->rightHand.joint2D[jointID].x      = values[i++];
+            skel->rightHand.joint2D[jointID].y      = values[i++];
+            skel->rightHand.jointAccuracy[jointID]  = values[i++];
+            skel->rightHand.active[jointID]         = (skel->rightHand.jointAccuracy[jointID]>0.5);
+        }
+
+    return 1;
+}
+
+
+int closeKeypointArchive(struct keypointArchive * archive)
+{
+    if (archive->data!=0)
+        {
+            munmap(archive->data,archive->size);
+        }
+    if (archive->fd>=0)
+        {
+            close(archive->fd);
+        }
+    memset(archive,0,sizeof(struct keypointArchive));
+    archive->fd=-1;
+    return 1;
+}
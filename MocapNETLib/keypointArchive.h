@@ -0,0 +1,149 @@
+#ifndef KEYPOINTARCHIVE_H_INCLUDED
+#define KEYPOINTARCHIVE_H_INCLUDED
+/** @file keypointArchive.h
+ *  @brief A packed binary archive of 2D keypoints. Re-running MocapNET over the same OpenPose output means re-parsing tens of thousands of
+ *  small JSON files every time, so they can be converted once to a single indexed file that is later accessed through mmap.
+ *  The file consists of a header, one record per frame ( number of people followed by body, left hand and right hand x,y,confidence float32 triplets for each person )
+ *  and an index with the offset of every frame record at the end of the file. Values are stored in the native byte order of the machine that wrote the archive.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include "jsonCocoSkeleton.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdio.h>
+
+
+/**
+ * @brief The first four bytes of every keypoint archive
+ */
+#define KEYPOINT_ARCHIVE_MAGIC "MNKA"
+
+/**
+ * @brief The version of the archive format written by this code
+ */
+#define KEYPOINT_ARCHIVE_VERSION 1
+
+
+/**
+ * @brief Header found in the start of a keypoint archive file
+ */
+struct keypointArchiveHeader
+{
+    char magic[4];
+    unsigned int version;
+    unsigned int numberOfFrames;
+    unsigned int bodyJoints;
+    unsigned int handJoints;
+    unsigned int reserved;
+    unsigned long long indexOffset;
+};
+
+
+/**
+ * @brief A keypoint archive that is being written, frames are appended one after the other and the index is written on close
+ */
+struct keypointArchiveWriter
+{
+    FILE * fp;
+    struct keypointArchiveHeader header;
+    unsigned long long * index;
+    unsigned int indexAllocated;
+};
+
+
+/**
+ * @brief A keypoint archive that has been mapped in memory for reading
+ */
+struct keypointArchive
+{
+    int fd;
+    void * data;
+    unsigned long long size;
+    const struct keypointArchiveHeader * header;
+    const unsigned long long * index;
+};
+
+
+/**
+ * @brief Create a new keypoint archive on disk
+ * @param Pointer to a struct keypointArchiveWriter that will hold the state of the writer
+ * @param Path to the output file
+ * @retval 1=Success/0=Failure
+ */
+int createKeypointArchive(struct keypointArchiveWriter * writer,const char * filename);
+
+
+/**
+ * @brief Append a frame to a keypoint archive that is being written
+ * @param Pointer to an open struct keypointArchiveWriter
+ * @param Array of skeletons that where observed in this frame
+ * @param Number of skeletons in the array, 0 is a valid value for frames without people
+ * @retval 1=Success/0=Failure
+ */
+int appendKeypointArchiveFrame(struct keypointArchiveWriter * writer,struct skeletonCOCO * skeletons,unsigned int numberOfPeople);
+
+
+/**
+ * @brief Write the index and header of a keypoint archive and close the file
+ * @param Pointer to an open struct keypointArchiveWriter
+ * @retval 1=Success/0=Failure
+ */
+int closeKeypointArchiveWriter(struct keypointArchiveWriter * writer);
+
+
+/**
+ * @brief Map an existing keypoint archive in memory
+ * @param Pointer to a struct keypointArchive that will hold the mapping
+ * @param Path to the archive file
+ * @retval 1=Success/0=Failure
+ */
+int openKeypointArchive(struct keypointArchive * archive,const char * filename);
+
+
+/**
+ * @brief Get the number of frames stored in an archive
+ * @param Pointer to an open struct keypointArchive
+ * @retval Number of frames
+ */
+unsigned int getKeypointArchiveNumberOfFrames(const struct keypointArchive * archive);
+
+
+/**
+ * @brief Get the number of people observed in a frame of an archive
+ * @param Pointer to an open struct keypointArchive
+ * @param Frame number
+ * @retval Number of people, 0 if the frame does not exist
+ */
+unsigned int getKeypointArchiveNumberOfPeople(const struct keypointArchive * archive,unsigned int frameID);
+
+
+/**
+ * @brief Retrieve a skeleton from a keypoint archive, the skeleton is populated the same way parseJsonCOCOSkeleton would populate it.
+ * If the frame has no people the skeleton is not touched, which is again what happens when parsing a JSON file without people.
+ * @param Pointer to an open struct keypointArchive
+ * @param Frame number
+ * @param Person number
+ * @param Pointer to a struct skeletonCOCO that will hold the information loaded
+ * @retval 1=Success/0=Failure ( frame does not exist )
+ */
+int readKeypointArchiveSkeleton(const struct keypointArchive * archive,unsigned int frameID,unsigned int personID,struct skeletonCOCO * skel);
+
+
+/**
+ * @brief Unmap and close a keypoint archive
+ * @param Pointer to an open struct keypointArchive
+ * @retval 1=Success/0=Failure
+ */
+int closeKeypointArchive(struct keypointArchive * archive);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KEYPOINTARCHIVE_H_INCLUDED
@@ -1,7 +1,10 @@
 #include "../Tensorflow/tf_utils.hpp"
 #include "mocapnet.hpp"
 #include "jsonCocoSkeleton.h"
+#include "jsonMocapNETHelpers.hpp"
+#include "instrumentation.hpp"
 #include <math.h>
+#include <algorithm>
 
 #define NORMAL   "\033[0m"
 #define BLACK   "\033[30m"      /* Black */
@@ -9,44 +12,6 @@
 #define GREEN   "\033[32m"      /* Green */
 #define YELLOW  "\033[33m"      /* Yellow */
 
-int writeBVHFile(
-    const char * filename,
-    const char * header,
-    std::vector<std::vector<float> > bvhFrames
-)
-{
-    FILE * fp = fopen(filename,"w");
-    if (fp!=0)
-        {
-            if (header==0)
-                {
-                    header=bvhHeader;
-                }
-            fprintf(fp,"%s",header);
-            fprintf(fp,"\nMOTION\n");
-            fprintf(fp,"Frames: %lu \n",bvhFrames.size());
-            fprintf(fp,"Frame Time: 0.04\n");
-
-            unsigned int i=0,j=0;
-            for (i=0; i< bvhFrames.size(); i++)
-                {
-                    std::vector<float> frame = bvhFrames[i];
-                    //fprintf(fp,"%lu joints",frame.size());
-
-                    //fprintf(fp,"0.0 0.0 0.0 ");
-                    for (j=0; j<frame.size(); j++)
-                        {
-                            fprintf(fp,"%0.4f ",frame[j]);
-                        }
-                    fprintf(fp,"\n");
-                }
-            fclose(fp);
-            return 1;
-        }
-    return 0;
-}
-
-
 int listNodesMN(const char * label , TF_Graph* graph)
 {
     size_t pos = 0;
@@ -85,264 +50,167 @@ int loadMocapNET(struct MocapNET * mnet,const char * filename,unsigned int force
 }
 
 
-float get2DPointsDistance(float x1,float y1,float x2,float y2)
+float undoOrientationTrickForBackOrientation(float orientation)
 {
-    return sqrt( (x1-x2)*(x1-x2) + (y1-y2)*(y1-y2));
+    if (orientation==180)
+        {
+            orientation=0;
+        }
+    else if (orientation<0)
+        {
+            orientation=180-orientation;
+        }
+    else
+        {
+            orientation=180-orientation;
+        }
+    return orientation;
 }
 
-
-std::vector<float> compressMocapNETInput(std::vector<float> mocapnetInput,int addSyntheticPoints,int doScaleCompensation)
-{ 
-    if ( (MOCAPNET_UNCOMPRESSED_JOINT_PARTS * 3!=mocapnetInput.size())||(mocapnetInput.size()!=171) )
+int runMocapNETWithResult(struct MocapNET * mnet,const std::vector<float> &input,struct MocapNETResult * result)
+{
+    if ( (mnet==0) || (result==0) )
         {
-            fprintf(stderr,RED "mocapNET: compressMocapNETInput : wrong input size , received %lu expected 171\n" NORMAL,mocapnetInput.size());
-
-            return mocapnetInput;
+            return 0;
         }
- 
 
-    //---------------------------------------------------
-    float rShoulderToHipDistance = get2DPointsDistance
-                                   (
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+0],
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+1],
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER*3+0],
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER*3+1]
-                                   );
-    //---------------------------------------------------
-    float lShoulderToHipDistance = get2DPointsDistance
-                                   (
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+0],
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+1],
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER*3+0],
-                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER*3+1]
-                                   );
+    //The clock is only read when the timings were asked for or the stage timers are recording
+    int doTimings = ( (result->fields & MOCAPNET_RESULT_TIMINGS)!=0 );
+    int doInstrumentation = stageTimersEnabled();
+    int measure = ( (doTimings) || (doInstrumentation) );
+    unsigned long startTime=0,directionStartTime=0,ensembleStartTime=0,endTime=0;
+    if (measure)
+        {
+            startTime=getStageTimerTime();
+        }
 
-    //std::cerr<<"rShoulderToHipDistance "<<rShoulderToHipDistance<<"\n";
-    //std::cerr<<"lShoulderToHipDistance "<<lShoulderToHipDistance<<"\n";
+    result->NSDM=0;
+    result->NSDMSize=0;
+    result->direction=0.0;
+    result->ensemble=MOCAPNET_ENSEMBLE_NONE;
+    result->output.clear();
+    result->inputPreparationTime=0;
+    result->directionTime=0;
+    result->ensembleTime=0;
+    result->totalTime=0;
 
+    //The input storage is reused, after the first call this does not allocate
+    result->input.resize(MOCAPNET_INPUT_SIZE);
+    float * mnetInput = result->input.data();
 
-    //---------------------------------------------------
-    float scaleDistance=1.0;
-    if ( (rShoulderToHipDistance!=0) && (lShoulderToHipDistance!=0) )
+    if (input.size()==MOCAPNET_INPUT_SIZE)
         {
-            scaleDistance=(rShoulderToHipDistance+lShoulderToHipDistance)/2;
+            std::copy(input.begin(),input.end(),mnetInput);
         }
-    else if (rShoulderToHipDistance!=0)
+    else if (input.size()==MOCAPNET_UNCOMPRESSED_INPUT_SIZE)
         {
-            scaleDistance=rShoulderToHipDistance;
+            std::copy(input.begin(),input.end(),mnetInput);
+            int addSyntheticPoints=1;
+            int doScaleCompensation=0;
+            if (
+                compressMocapNETInputToBuffer(
+                    mnetInput,
+                    MOCAPNET_UNCOMPRESSED_INPUT_SIZE,
+                    addSyntheticPoints,
+                    doScaleCompensation,
+                    mnetInput+MOCAPNET_UNCOMPRESSED_INPUT_SIZE
+                ) != MOCAPNET_COMPRESSED_INPUT_SIZE
+            )
+                {
+                    fprintf(stderr,"MocapNET: Incorrect size of MocapNET input .. \n");
+                    return 0;
+                }
         }
-    else if (lShoulderToHipDistance!=0)
+    else
         {
-            scaleDistance=lShoulderToHipDistance;
+            fprintf(stderr,"MocapNET: Incorrect size of COCO input  was %lu (but should be 171) \n",input.size());
+            return 0;
         }
+    result->NSDM = mnetInput+MOCAPNET_UNCOMPRESSED_INPUT_SIZE;
+    result->NSDMSize = MOCAPNET_COMPRESSED_INPUT_SIZE;
 
+    if (measure)
+        {
+            directionStartTime = getStageTimerTime();
+        }
+    std::vector<float> direction = predictTensorflow(&mnet->allModel,result->input);
+    if (measure)
+        {
+            ensembleStartTime = getStageTimerTime();
+        }
+    if (doInstrumentation)
+        {
+            recordStageTime(MOCAPNET_STAGE_NSDM,directionStartTime - startTime);
+            recordStageTime(MOCAPNET_STAGE_CLASSIFIER,ensembleStartTime - directionStartTime);
+        }
 
-    //std::cerr<<"mocapnetCompressed\n";
+    if (direction.size()==0)
+        {
+            fprintf(stderr,"Unable to predict pose direction..\n");
+            return 0;
+        }
+    result->direction = direction[0];
 
-    std::vector<float>  mocapnetCompressed;
-    for (unsigned int iI=0; iI<MocapNETInputCompressedArrayIndexesSize; iI++)
+    if ( (result->direction<-90) || (result->direction>90) )
         {
-            unsigned int i=MocapNETInputCompressedArrayIndexes[iI];
-            for (unsigned int jJ=0; jJ<MocapNETInputCompressedArrayIndexesSize; jJ++)
+            //Back ----------------------------------------------=
+            result->ensemble = MOCAPNET_ENSEMBLE_BACK;
+            result->output = predictTensorflow(&mnet->backModel,result->input);
+            if (result->output.size()>4)
                 {
-                    unsigned int j=MocapNETInputCompressedArrayIndexes[jJ];
-
-                    if (i>=MOCAPNET_UNCOMPRESSED_JOINT_PARTS)
-                        {
-                            fprintf(stderr,RED "\nERROR at i=%u for EDM element  [%u,%u]\n",i,iI,jJ);
-                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[i*3+0]);
-                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[i*3+1]);
-                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[i*3+2]);
-                            exit(0);
-                        }
-                    if (j>=MOCAPNET_UNCOMPRESSED_JOINT_PARTS)
-                        {
-                            fprintf(stderr,RED "\nERROR at j=%u for EDM element [%u,%u]\n",j,iI,jJ);
-                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[j*3+0]);
-                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[j*3+1]);
-                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[j*3+2]);
-                            exit(0);
-                        }
-
-                    float iX = mocapnetInput[i*3+0];
-                    float iY = mocapnetInput[i*3+1];
-                    float jX = mocapnetInput[j*3+0];
-                    float jY = mocapnetInput[j*3+1];
-
-                    if ( (iX>1.0) || (iY>1.0) || (jX>1.0) || (jY>1.0) )
-                        {
-                            //This should never happen
-                            fprintf(stderr,RED "\nBigger than 1.0 element at [%u,%u]\n",iI,jJ);
-                            mocapnetCompressed.push_back(666.0);
-                            mocapnetCompressed.push_back(666.0);
-                        }
-                    else if ( (iX==0) || (iY==0) || (jX==0) || (jY==0) )
-                        {
-                            mocapnetCompressed.push_back(0.0);
-                            mocapnetCompressed.push_back(0.0);
-                        }
-                    else
-                        {
-                            //#--------------------------
-                            //#     Synthetic Points
-                            //#--------------------------
-                            if (addSyntheticPoints)
-                                {
-                                    if (i==7)
-                                        {
-                                            iX=iX-0.3;
-                                        }
-                                    else if (i==8)
-                                        {
-                                            iX=iX+0.3;
-                                        }
-                                    //#--------------------------
-                                    if (j==7)
-                                        {
-                                            jX=jX-0.3;
-                                        }
-                                    else if (j==8)
-                                        {
-                                            jX=jX+0.3;
-                                        }
-                                }
-                            //#--------------------------
-
-                            float iXMinusjXPlus0_5=0.5+iX-jX;
-                            float iYMinusjYPlus0_5=0.5+iY-jY;
-
-                            if (iXMinusjXPlus0_5>10.0)
-                                {
-                                    fprintf(stderr,RED "\nERROR at (%0.2f,%0.2f)/(%0.2f,%0.2f)  for NSDM element [%u,%u]\n",iX,iY,jX,jY,iI,jJ);
-                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+0],MocapNETInputUncompressedArrayNames[j*3+0]);
-                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+1],MocapNETInputUncompressedArrayNames[j*3+1]);
-                                }
-                            if (iYMinusjYPlus0_5>10.0)
-                                {
-                                    fprintf(stderr,RED "\nERROR at (%0.2f,%0.2f)/(%0.2f,%0.2f)  for NSDM element [%u,%u]\n",iX,iY,jX,jY,iI,jJ);
-                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+0],MocapNETInputUncompressedArrayNames[j*3+0]);
-                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+1],MocapNETInputUncompressedArrayNames[j*3+1]);
-                                }
-
-                            if ( (doScaleCompensation) && (scaleDistance>0.0) )
-                                {
-                                    mocapnetCompressed.push_back( (float) iXMinusjXPlus0_5/scaleDistance );
-                                    mocapnetCompressed.push_back( (float) iYMinusjYPlus0_5/scaleDistance );
-                                }
-                            else
-                                {
-                                    mocapnetCompressed.push_back(iXMinusjXPlus0_5);
-                                    mocapnetCompressed.push_back(iYMinusjYPlus0_5);
-                                }
-                        }
+                    result->output[4]=undoOrientationTrickForBackOrientation(result->output[4]);
                 }
         }
-
- 
-    return  mocapnetCompressed;
-}
-
-
-
-
-
-std::vector<float> prepareMocapNETInputFromUncompressedInput(std::vector<float> mocapnetInput)
-{ 
-    std::vector<float> mocapnetUncompressedAndCompressed;
-    mocapnetUncompressedAndCompressed.clear();
-
-    if ( (MOCAPNET_UNCOMPRESSED_JOINT_PARTS * 3!=mocapnetInput.size())||(mocapnetInput.size()!=171) )
+    else
         {
-          fprintf(stderr,RED "mocapNET: prepareMocapNETInputFromUncompressedInput : wrong input size , received %lu expected 171\n" NORMAL,mocapnetInput.size());
-          return mocapnetUncompressedAndCompressed;
+            //Front ----------------------------------------------
+            result->ensemble = MOCAPNET_ENSEMBLE_FRONT;
+            result->output = predictTensorflow(&mnet->frontModel,result->input);
         }
-    
-    
-    int addSyntheticPoints=1;
-    int doScaleCompensation=0;
-    std::vector<float> mocapnetCompressed = compressMocapNETInput(mocapnetInput,addSyntheticPoints,doScaleCompensation);
-    
-
-    mocapnetUncompressedAndCompressed.insert(mocapnetUncompressedAndCompressed.end(), mocapnetInput.begin(), mocapnetInput.end());
-    mocapnetUncompressedAndCompressed.insert(mocapnetUncompressedAndCompressed.end(), mocapnetCompressed.begin(), mocapnetCompressed.end());
-    //mocapnetUncompressedAndCompressed.insert(mocapnetInput.end(), mocapnetCompressed.begin(), mocapnetCompressed.end());
-    //std::cerr<<"done \n";
-    return  mocapnetUncompressedAndCompressed;
-}
 
-
-
-float undoOrientationTrickForBackOrientation(float orientation)
-{
-    if (orientation==180)
+    if (measure)
         {
-            orientation=0;
+            endTime = getStageTimerTime();
         }
-    else if (orientation<0)
+    if (doInstrumentation)
         {
-            orientation=180-orientation;
+            recordStageTime(MOCAPNET_STAGE_ENSEMBLE,endTime - ensembleStartTime);
         }
-    else
+    if (doTimings)
         {
-            orientation=180-orientation;
+            result->inputPreparationTime = directionStartTime - startTime;
+            result->directionTime = ensembleStartTime - directionStartTime;
+            result->ensembleTime = endTime - ensembleStartTime;
+            result->totalTime = endTime - startTime;
         }
-    return orientation;
+
+    return (result->output.size()>0);
 }
 
+
 std::vector<float> runMocapNET(struct MocapNET * mnet,std::vector<float> input)
 {
     std::vector<float> emptyResult;
-    std::vector<float> mnetInput;
+    struct MocapNETResult result;
+    result.fields=0;
 
-    if (input.size()==749)
+    if (input.size()==MOCAPNET_INPUT_SIZE)
         {
             fprintf(stderr,"MocapNET: Input was given precompressed\n");
-            mnetInput = input;
-        }
-    else if (input.size()==171)
-        {
-            //This is the default case so dont issue any warnings..
-            //std::cerr<<"MocapNET: COCO input has "<<input.size()<<" elements (should be 171)\n";
-            mnetInput = prepareMocapNETInputFromUncompressedInput(input);
-            //std::cerr<<"MocapNET: COCO 171 input has been converted in to MocapNET input with "<<mnetInput.size()<<" elements (should be 749)\n";
-        }
-    else if (input.size()!=171)
-        {
-            fprintf(stderr,"MocapNET: Incorrect size of COCO input  was %lu (but should be 171) \n",input.size());
-            return emptyResult;
-        }
-
-    if (mnetInput.size()!=749)
-        {
-            fprintf(stderr,"MocapNET: Incorrect size of MocapNET input .. \n");
-            return emptyResult;
         }
 
-    std::vector<float> direction = predictTensorflow(&mnet->allModel,mnetInput);
-
-    if (direction.size()>0)
+    if (runMocapNETWithResult(mnet,input,&result))
         {
-            fprintf(stderr,NORMAL "Direction is : %0.2f " NORMAL , direction[0] );
-            if ( (direction[0]<-90) || (direction[0]>90) )
+            fprintf(stderr,NORMAL "Direction is : %0.2f " NORMAL , result.direction );
+            if (result.ensemble==MOCAPNET_ENSEMBLE_BACK)
                 {
-                    //Back ----------------------------------------------=
                     fprintf(stderr,"Back\n");
-                    std::vector<float> result = predictTensorflow(&mnet->backModel,mnetInput);
-                    result[4]=undoOrientationTrickForBackOrientation(result[4]);
-                    return result;
                 }
             else
                 {
-                    //Front ----------------------------------------------
                     fprintf(stderr,"Front\n");
-                    std::vector<float> result = predictTensorflow(&mnet->frontModel,mnetInput);
-                    return result;
                 }
-        }
-    else
-        {
-            fprintf(stderr,"Unable to predict pose direction..\n");
+            return std::move(result.output);
         }
 
 //-----------------
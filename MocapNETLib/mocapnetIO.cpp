@@ -0,0 +1,268 @@
+#include "mocapnetIO.hpp"
+#include "jsonCocoSkeleton.h"
+#include "jsonMocapNETHelpers.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+int writeBVHFile(
+    const char * filename,
+    const char * header,
+    std::vector<std::vector<float> > bvhFrames
+)
+{
+    FILE * fp = fopen(filename,"w");
+    if (fp!=0)
+        {
+            if (header==0)
+                {
+                    header=bvhHeader;
+                }
+            fprintf(fp,"%s",header);
+            fprintf(fp,"\nMOTION\n");
+            fprintf(fp,"Frames: %lu \n",bvhFrames.size());
+            fprintf(fp,"Frame Time: 0.04\n");
+
+            unsigned int i=0,j=0;
+            for (i=0; i< bvhFrames.size(); i++)
+                {
+                    std::vector<float> frame = bvhFrames[i];
+                    //fprintf(fp,"%lu joints",frame.size());
+
+                    //fprintf(fp,"0.0 0.0 0.0 ");
+                    for (j=0; j<frame.size(); j++)
+                        {
+                            fprintf(fp,"%0.4f ",frame[j]);
+                        }
+                    fprintf(fp,"\n");
+                }
+            fclose(fp);
+            return 1;
+        }
+    return 0;
+}
+
+
+float get2DPointsDistance(float x1,float y1,float x2,float y2)
+{
+    return sqrt( (x1-x2)*(x1-x2) + (y1-y2)*(y1-y2));
+}
+
+
+unsigned int compressMocapNETInputToBuffer(const float * mocapnetInput,unsigned int inputLength,int addSyntheticPoints,int doScaleCompensation,float * output)
+{
+    if ( (MOCAPNET_UNCOMPRESSED_JOINT_PARTS * 3!=inputLength)||(inputLength!=171) )
+        {
+            fprintf(stderr,RED "mocapNET: compressMocapNETInput : wrong input size , received %u expected 171\n" NORMAL,inputLength);
+            return 0;
+        }
+
+
+    //---------------------------------------------------
+    float rShoulderToHipDistance = get2DPointsDistance
+                                   (
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+0],
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+1],
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER*3+0],
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER*3+1]
+                                   );
+    //---------------------------------------------------
+    float lShoulderToHipDistance = get2DPointsDistance
+                                   (
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+0],
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+1],
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER*3+0],
+                                       mocapnetInput[MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER*3+1]
+                                   );
+
+    //std::cerr<<"rShoulderToHipDistance "<<rShoulderToHipDistance<<"\n";
+    //std::cerr<<"lShoulderToHipDistance "<<lShoulderToHipDistance<<"\n";
+
+
+    //---------------------------------------------------
+    float scaleDistance=1.0;
+    if ( (rShoulderToHipDistance!=0) && (lShoulderToHipDistance!=0) )
+        {
+            scaleDistance=(rShoulderToHipDistance+lShoulderToHipDistance)/2;
+        }
+    else if (rShoulderToHipDistance!=0)
+        {
+            scaleDistance=rShoulderToHipDistance;
+        }
+    else if (lShoulderToHipDistance!=0)
+        {
+            scaleDistance=lShoulderToHipDistance;
+        }
+
+
+    //std::cerr<<"mocapnetCompressed\n";
+
+    unsigned int written=0;
+    for (unsigned int iI=0; iI<MocapNETInputCompressedArrayIndexesSize; iI++)
+        {
+            unsigned int i=MocapNETInputCompressedArrayIndexes[iI];
+            for (unsigned int jJ=0; jJ<MocapNETInputCompressedArrayIndexesSize; jJ++)
+                {
+                    unsigned int j=MocapNETInputCompressedArrayIndexes[jJ];
+
+                    if (i>=MOCAPNET_UNCOMPRESSED_JOINT_PARTS)
+                        {
+                            fprintf(stderr,RED "\nERROR at i=%u for EDM element  [%u,%u]\n",i,iI,jJ);
+                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[i*3+0]);
+                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[i*3+1]);
+                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[i*3+2]);
+                            exit(0);
+                        }
+                    if (j>=MOCAPNET_UNCOMPRESSED_JOINT_PARTS)
+                        {
+                            fprintf(stderr,RED "\nERROR at j=%u for EDM element [%u,%u]\n",j,iI,jJ);
+                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[j*3+0]);
+                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[j*3+1]);
+                            fprintf(stderr,RED "%s\n",MocapNETInputUncompressedArrayNames[j*3+2]);
+                            exit(0);
+                        }
+
+                    float iX = mocapnetInput[i*3+0];
+                    float iY = mocapnetInput[i*3+1];
+                    float jX = mocapnetInput[j*3+0];
+                    float jY = mocapnetInput[j*3+1];
+
+                    if ( (iX>1.0) || (iY>1.0) || (jX>1.0) || (jY>1.0) )
+                        {
+                            //This should never happen
+                            fprintf(stderr,RED "\nBigger than 1.0 element at [%u,%u]\n",iI,jJ);
+                            output[written++]=666.0;
+                            output[written++]=666.0;
+                        }
+                    else if ( (iX==0) || (iY==0) || (jX==0) || (jY==0) )
+                        {
+                            output[written++]=0.0;
+                            output[written++]=0.0;
+                        }
+                    else
+                        {
+                            //#--------------------------
+                            //#     Synthetic Points
+                            //#--------------------------
+                            if (addSyntheticPoints)
+                                {
+                                    if (i==7)
+                                        {
+                                            iX=iX-0.3;
+                                        }
+                                    else if (i==8)
+                                        {
+                                            iX=iX+0.3;
+                                        }
+                                    //#--------------------------
+                                    if (j==7)
+                                        {
+                                            jX=jX-0.3;
+                                        }
+                                    else if (j==8)
+                                        {
+                                            jX=jX+0.3;
+                                        }
+                                }
+                            //#--------------------------
+
+                            float iXMinusjXPlus0_5=0.5+iX-jX;
+                            float iYMinusjYPlus0_5=0.5+iY-jY;
+
+                            if (iXMinusjXPlus0_5>10.0)
+                                {
+                                    fprintf(stderr,RED "\nERROR at (%0.2f,%0.2f)/(%0.2f,%0.2f)  for NSDM element [%u,%u]\n",iX,iY,jX,jY,iI,jJ);
+                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+0],MocapNETInputUncompressedArrayNames[j*3+0]);
+                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+1],MocapNETInputUncompressedArrayNames[j*3+1]);
+                                }
+                            if (iYMinusjYPlus0_5>10.0)
+                                {
+                                    fprintf(stderr,RED "\nERROR at (%0.2f,%0.2f)/(%0.2f,%0.2f)  for NSDM element [%u,%u]\n",iX,iY,jX,jY,iI,jJ);
+                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+0],MocapNETInputUncompressedArrayNames[j*3+0]);
+                                    fprintf(stderr,RED "%s-%s\n",MocapNETInputUncompressedArrayNames[i*3+1],MocapNETInputUncompressedArrayNames[j*3+1]);
+                                }
+
+                            if ( (doScaleCompensation) && (scaleDistance>0.0) )
+                                {
+                                    output[written++]=(float) iXMinusjXPlus0_5/scaleDistance;
+                                    output[written++]=(float) iYMinusjYPlus0_5/scaleDistance;
+                                }
+                            else
+                                {
+                                    output[written++]=iXMinusjXPlus0_5;
+                                    output[written++]=iYMinusjYPlus0_5;
+                                }
+                        }
+                }
+        }
+
+    return written;
+}
+
+
+std::vector<float> compressMocapNETInput(std::vector<float> mocapnetInput,int addSyntheticPoints,int doScaleCompensation)
+{
+    if ( (MOCAPNET_UNCOMPRESSED_JOINT_PARTS * 3!=mocapnetInput.size())||(mocapnetInput.size()!=171) )
+        {
+            fprintf(stderr,RED "mocapNET: compressMocapNETInput : wrong input size , received %lu expected 171\n" NORMAL,mocapnetInput.size());
+
+            return mocapnetInput;
+        }
+
+    float mocapnetCompressed[MOCAPNET_COMPRESSED_INPUT_SIZE];
+    unsigned int written = compressMocapNETInputToBuffer(mocapnetInput.data(),mocapnetInput.size(),addSyntheticPoints,doScaleCompensation,mocapnetCompressed);
+    return std::vector<float>(mocapnetCompressed,mocapnetCompressed+written);
+}
+
+
+
+int prepareMocapNETInputFromSkeletonCOCO(struct skeletonCOCO * skeleton,unsigned int width,unsigned int height,float * output)
+{
+    //The uncompressed part is written straight at the start of the network input and the NSDM is computed from it right after
+    unsigned int uncompressedSize = flattenskeletonCOCOToBuffer(skeleton,width,height,output,MOCAPNET_UNCOMPRESSED_INPUT_SIZE);
+    if (uncompressedSize!=MOCAPNET_UNCOMPRESSED_INPUT_SIZE)
+        {
+            fprintf(stderr,RED "mocapNET: prepareMocapNETInputFromSkeletonCOCO : could not resolve all joints of the skeleton\n" NORMAL);
+            return 0;
+        }
+
+    int addSyntheticPoints=1;
+    int doScaleCompensation=0;
+    unsigned int compressedSize = compressMocapNETInputToBuffer(output,uncompressedSize,addSyntheticPoints,doScaleCompensation,output+uncompressedSize);
+    return (uncompressedSize+compressedSize==MOCAPNET_INPUT_SIZE);
+}
+
+
+
+std::vector<float> prepareMocapNETInputFromUncompressedInput(const std::vector<float> & mocapnetInput)
+{
+    std::vector<float> mocapnetUncompressedAndCompressed;
+
+    if ( (MOCAPNET_UNCOMPRESSED_JOINT_PARTS * 3!=mocapnetInput.size())||(mocapnetInput.size()!=171) )
+        {
+          fprintf(stderr,RED "mocapNET: prepareMocapNETInputFromUncompressedInput : wrong input size , received %lu expected 171\n" NORMAL,mocapnetInput.size());
+          return mocapnetUncompressedAndCompressed;
+        }
+
+    //The returned vector is the only allocation, the NSDM is computed right after the uncompressed values in its storage
+    mocapnetUncompressedAndCompressed.resize(MOCAPNET_INPUT_SIZE);
+    std::copy(mocapnetInput.begin(),mocapnetInput.end(),mocapnetUncompressedAndCompressed.begin());
+
+    int addSyntheticPoints=1;
+    int doScaleCompensation=0;
+    unsigned int compressedSize = compressMocapNETInputToBuffer(
+                                                                 mocapnetInput.data(),
+                                                                 mocapnetInput.size(),
+                                                                 addSyntheticPoints,
+                                                                 doScaleCompensation,
+                                                                 mocapnetUncompressedAndCompressed.data()+mocapnetInput.size()
+                                                               );
+    mocapnetUncompressedAndCompressed.resize(mocapnetInput.size()+compressedSize);
+    return  mocapnetUncompressedAndCompressed;
+}
@@ -0,0 +1,66 @@
+#pragma once
+/** @file mocapnetIO.hpp
+ *  @brief Everything that happens around the MocapNET networks without involving them, preparing their input ( the uncompressed joints and
+ *  the NSDM matrices computed from them ) and writing their BVH output to disk. None of it needs Tensorflow so it can be used and measured
+ *  on its own, mocapnet.hpp includes this header so users of the library don't have to.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+#include "mocapnetRegistry.hpp"
+#include <vector>
+
+struct skeletonCOCO;
+
+
+/**
+ * @brief After collecting a vector of BVH output vectors this call can write them to disk in BVH format
+ * to make them accessible by third party 3D animation software like blender etc.
+ * @param Path to output file i.e. "output.bvh"
+ * @param Pointer to BVH header string, if set to null it will default to the bvhHeader found in mocapnetRegistry.hpp.
+ * @param Vector of BVH frame vectors.
+ * @retval 1=Success,0=Failure
+ */
+int writeBVHFile(
+                  const char * filename,
+                  const char * header,
+                   std::vector<std::vector<float> > bvhFrames
+                );
+
+
+std::vector<float> compressMocapNETInput(std::vector<float> mocapnetInput,int addSyntheticPoints,int doScaleCompensation);
+
+
+/**
+ * @brief Compute the NSDM part of the MocapNET input from the 171 uncompressed values into a caller supplied buffer, this is what
+ * compressMocapNETInput does without allocating any vectors.
+ * @ingroup mocapnet
+ * @param Pointer to the uncompressed input
+ * @param Number of uncompressed input values, it should be 171
+ * @param Add synthetic points
+ * @param Perform scale compensation
+ * @param Output buffer that must have room for MOCAPNET_COMPRESSED_INPUT_SIZE floats
+ * @retval Number of floats written, 0=Failure
+ */
+unsigned int compressMocapNETInputToBuffer(const float * mocapnetInput,unsigned int inputLength,int addSyntheticPoints,int doScaleCompensation,float * output);
+
+
+/**
+ * @brief Convert a Vector Of floats encoded in the COCO format to the MocapNET format
+ * @ingroup mocapnet
+ * @param Input vector of floats
+ * @retval Output vector of floats, Empty vector in case of failure
+ */
+std::vector<float> prepareMocapNETInputFromUncompressedInput(const std::vector<float> & input);
+
+
+/**
+ * @brief Fill the complete MocapNET input ( uncompressed joints followed by the NSDM ) straight from a BODY25 skeleton in a caller
+ * supplied buffer, the result is identical to prepareMocapNETInputFromUncompressedInput(flattenskeletonCOCOToVector(skeleton,width,height))
+ * but there are no intermediate vectors.
+ * @ingroup mocapnet
+ * @param Pointer to a populated struct skeletonCOCO
+ * @param Width of the image the skeleton was observed in
+ * @param Height of the image the skeleton was observed in
+ * @param Output buffer that must have room for MOCAPNET_INPUT_SIZE floats
+ * @retval 1=Success,0=Failure
+ */
+int prepareMocapNETInputFromSkeletonCOCO(struct skeletonCOCO * skeleton,unsigned int width,unsigned int height,float * output);
@@ -0,0 +1,1785 @@
+#include "mocapnetRegistry.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+
+// replace \n with \\n"\n" in header.bvh
+const char * const bvhHeader="HIERARCHY\n"
+"ROOT hip\n"
+"{\n"
+"  OFFSET 0 0 0\n"
+"  CHANNELS 6 Xposition Yposition Zposition Zrotation Yrotation Xrotation\n"
+"  JOINT abdomen\n"
+"  {\n"
+"    OFFSET 0 20.6881 -0.73152\n"
+"    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"    JOINT chest\n"
+"    {\n"
+"      OFFSET 0 11.7043 -0.48768\n"
+"      CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"      JOINT neck\n"
+"      {\n"
+"        OFFSET 0 22.1894 -2.19456\n"
+"        CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"        JOINT head\n"
+"        {\n"
+"          OFFSET -0.24384 7.07133 1.2192\n"
+"          CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"          JOINT leftEye\n"
+"          {\n"
+"            OFFSET 4.14528 8.04674 8.04672\n"
+"            CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"            End Site\n"
+"            {\n"
+"              OFFSET 1 0 0\n"
+"            }\n"
+"          }\n"
+"          JOINT rightEye\n"
+"          {\n"
+"            OFFSET -3.6576 8.04674 8.04672\n"
+"            CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"            End Site\n"
+"            {\n"
+"              OFFSET 1 0 0\n"
+"            }\n"
+"          }\n"
+"        }\n"
+"      }\n"
+"      JOINT rCollar\n"
+"      {\n"
+"        OFFSET -2.68224 19.2634 -4.8768\n"
+"        CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"        JOINT rShldr\n"
+"        {\n"
+"          OFFSET -8.77824 -1.95073 1.46304\n"
+"          CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"          JOINT rForeArm\n"
+"          {\n"
+"            OFFSET -28.1742 -1.7115 0.48768\n"
+"            CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"            JOINT rHand\n"
+"            {\n"
+"              OFFSET -22.5879 0.773209 7.07136\n"
+"              CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"              JOINT rThumb1\n"
+"              {\n"
+"                OFFSET -1.2192 -0.487915 3.41376\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT rThumb2\n"
+"                {\n"
+"                  OFFSET -3.37035 -0.52449 3.41376\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET -1.78271 -1.18214 1.43049\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT rIndex1\n"
+"              {\n"
+"                OFFSET -7.75947 0.938293 5.60832\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT rIndex2\n"
+"                {\n"
+"                  OFFSET -2.54057 -0.884171 1.56538\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET -1.62519 -0.234802 1.16502\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT rMid1\n"
+"              {\n"
+"                OFFSET -8.24714 1.18213 3.41376\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT rMid2\n"
+"                {\n"
+"                  OFFSET -3.10165 -0.590103 1.0647\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET -2.48547 -0.328903 0.83742\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT rRing1\n"
+"              {\n"
+"                OFFSET -8.82822 0.546677 1.51678\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT rRing2\n"
+"                {\n"
+"                  OFFSET -2.60934 -0.819778 -0.0198488\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET -2.33842 -0.294052 0.168128\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT rPinky1\n"
+"              {\n"
+"                OFFSET -8.27202 -0.0477905 -0.4584\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT rPinky2\n"
+"                {\n"
+"                  OFFSET -1.82734 -0.647385 -0.700984\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET -1.69225 -0.51767 -0.607171\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"            }\n"
+"          }\n"
+"        }\n"
+"      }\n"
+"      JOINT lCollar\n"
+"      {\n"
+"        OFFSET 2.68224 19.2634 -4.8768\n"
+"        CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"        JOINT lShldr\n"
+"        {\n"
+"          OFFSET 8.77824 -1.95073 1.46304\n"
+"          CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"          JOINT lForeArm\n"
+"          {\n"
+"            OFFSET 28.1742 -1.7115 0.48768\n"
+"            CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"            JOINT lHand\n"
+"            {\n"
+"              OFFSET 22.5879 0.773209 7.07136\n"
+"              CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"              JOINT lThumb1\n"
+"              {\n"
+"                OFFSET 1.2192 -0.487915 3.41376\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT lThumb2\n"
+"                {\n"
+"                  OFFSET 3.37035 -0.52449 3.41376\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET 1.78271 -1.18214 1.43049\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT lIndex1\n"
+"              {\n"
+"                OFFSET 7.75947 0.938293 5.60832\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT lIndex2\n"
+"                {\n"
+"                  OFFSET 2.54057 -0.884171 1.56538\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET 1.62519 -0.234802 1.16502\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT lMid1\n"
+"              {\n"
+"                OFFSET 8.24714 1.18213 3.41376\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT lMid2\n"
+"                {\n"
+"                  OFFSET 3.10165 -0.590103 1.0647\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET 2.48547 -0.328903 0.83742\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT lRing1\n"
+"              {\n"
+"                OFFSET 8.82822 0.546677 1.51678\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT lRing2\n"
+"                {\n"
+"                  OFFSET 2.60934 -0.819778 -0.0198488\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET 2.33842 -0.294052 0.168128\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"              JOINT lPinky1\n"
+"              {\n"
+"                OFFSET 8.27202 -0.0477905 -0.4584\n"
+"                CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                JOINT lPinky2\n"
+"                {\n"
+"                  OFFSET 1.82734 -0.647385 -0.700984\n"
+"                  CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"                  End Site\n"
+"                  {\n"
+"                    OFFSET 1.69225 -0.51767 -0.607171\n"
+"                  }\n"
+"                }\n"
+"              }\n"
+"            }\n"
+"          }\n"
+"        }\n"
+"      }\n"
+"    }\n"
+"  }\n"
+"  JOINT rButtock\n"
+"  {\n"
+"    OFFSET -8.77824 4.35084 1.2192\n"
+"    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"    JOINT rThigh\n"
+"    {\n"
+"      OFFSET 0 -1.70687 -2.19456\n"
+"      CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"      JOINT rShin\n"
+"      {\n"
+"        OFFSET 0 -36.8199 0.73152\n"
+"        CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"        JOINT rFoot\n"
+"        {\n"
+"          OFFSET 0.73152 -45.1104 -5.12064\n"
+"          CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"          End Site\n"
+"          {\n"
+"            OFFSET -1.1221 -3.69964 12.103\n"
+"          }\n"
+"        }\n"
+"      }\n"
+"    }\n"
+"  }\n"
+"  JOINT lButtock\n"
+"  {\n"
+"    OFFSET 8.77824 4.35084 1.2192\n"
+"    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"    JOINT lThigh\n"
+"    {\n"
+"      OFFSET 0 -1.70687 -2.19456\n"
+"      CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"      JOINT lShin\n"
+"      {\n"
+"        OFFSET 0 -36.8199 0.73152\n"
+"        CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"        JOINT lFoot\n"
+"        {\n"
+"          OFFSET -0.73152 -45.1104 -5.12064\n"
+"          CHANNELS 3 Zrotation Xrotation Yrotation\n"
+"          End Site\n"
+"          {\n"
+"            OFFSET 1.1221 -3.69964 12.103\n"
+"          }\n"
+"        }\n"
+"      }\n"
+"    }\n"
+"  }\n"
+"}";
+
+
+const char * const MocapNETInputUncompressedJointNames[MOCAPNET_UNCOMPRESSED_JOINT_PARTS+1] =
+{
+  "hip",          //0
+  "abdomen",      //1
+  "chest",        //2
+  "neck",         //3
+  "head",         //4
+  "lefteye",      //5
+  "es_lefteye",   //6
+  "righteye",     //7
+  "es_righteye",  //8
+  "rcollar",      //9
+  "rshoulder",    //10
+  "relbow",       //11
+  "rhand",        //12
+  "rthumb1",      //13
+  "rthumb2",      //14
+  "es_rthumb2",   //15
+  "rindex1",      //16
+  "rindex2",      //17
+  "es_rindex2",   //18
+  "rmid1",        //19
+  "rmid2",        //20
+  "es_rmid2",     //21
+  "rring1",       //22
+  "rring2",       //23
+  "es_rring2",    //24
+  "rpinky1",      //25
+  "rpinky2",      //26
+  "es_rpinky2",   //27
+  "lcollar",      //28
+  "lshoulder",    //29
+  "lelbow",       //30
+  "lhand",        //31
+  "lthumb1",      //32
+  "lthumb2",      //33
+  "es_lthumb2",   //34
+  "lindex1",      //35
+  "lindex2",      //36
+  "es_lindex2",   //37
+  "lmid1",        //38
+  "lmid2",        //39
+  "es_lmid2",     //40
+  "lring1",       //41
+  "lring2",       //42
+  "es_lring2",    //43
+  "lpinky1",      //44
+  "lpinky2",      //45
+  "es_lpinky2",   //46
+  "rbuttock",     //47
+  "rhip",         //48
+  "rknee",        //49
+  "rfoot",        //50
+  "es_rfoot",     //51
+  "lbuttock",     //52
+  "lhip",         //53
+  "lknee",        //54
+  "lfoot",        //55
+  "es_lfoot",     //56
+  "End of MocapNETUncompressedJointNames"
+};
+
+
+const char * const MocapNETInputUncompressedArrayNames[MOCAPNET_UNCOMPRESSED_INPUT_SIZE+1] =
+{
+  //Name               abs      jid
+  //------------------------------
+  "2D_X_hip",          //0   -   0
+  "2D_Y_hip",          //1   -   0
+  "2D_vis_hip",        //2   -   0
+  //------------------------------
+  "2D_X_abdomen",      //3   -   1
+  "2D_Y_abdomen",      //4   -   1
+  "2D_vis_abdomen",    //5   -   1
+  //------------------------------
+  "2D_X_chest",        //6   -   2
+  "2D_Y_chest",        //7   -   2
+  "2D_vis_chest",      //8   -   2
+  //------------------------------
+  "2D_X_neck",         //9   -   3
+  "2D_Y_neck",         //10  -   3
+  "2D_vis_neck",       //11  -   3
+  //------------------------------
+  "2D_X_head",         //12  -   4
+  "2D_Y_head",         //13  -   4
+  "2D_vis_head",       //14  -   4
+  //------------------------------
+  "2D_X_lefteye",      //15  -   5
+  "2D_Y_lefteye",      //16  -   5
+  "2D_vis_lefteye",    //17  -   5
+  //------------------------------
+  "2D_X_es_lefteye",   //18  -   6
+  "2D_Y_es_lefteye",   //19  -   6
+  "2D_vis_es_lefteye", //20  -   6
+  //------------------------------
+  "2D_X_righteye",     //21  -   7
+  "2D_Y_righteye",     //22  -   7
+  "2D_vis_righteye",   //23  -   7
+  //------------------------------
+  "2D_X_es_righteye",  //24  -   8
+  "2D_Y_es_righteye",  //25  -   8
+  "2D_vis_es_righteye",//26  -   8
+  //------------------------------
+
+  //------------------------------
+  "2D_X_rcollar",      //27  -   9
+  "2D_Y_rcollar",      //28  -   9
+  "2D_vis_rcollar",    //29  -   9
+  //------------------------------
+  "2D_X_rshoulder",    //30  -   10
+  "2D_Y_rshoulder",    //31  -   10
+  "2D_vis_rshoulder",  //32  -   10
+  //------------------------------
+  "2D_X_relbow",       //33  -   11
+  "2D_Y_relbow",       //34  -   11
+  "2D_vis_relbow",     //35  -   11
+  //------------------------------
+  "2D_X_rhand",        //36  -   12
+  "2D_Y_rhand",        //37  -   12
+  "2D_vis_rhand",      //38  -   12
+  //------------------------------
+  //------------------------------
+  "2D_X_rthumb1",      //39  -   13
+  "2D_Y_rthumb1",      //40  -   13
+  "2D_vis_rthumb1",    //41  -   13
+  //------------------------------
+  "2D_X_rthumb2",      //42  -   14
+  "2D_Y_rthumb2",      //43  -   14
+  "2D_vis_rthumb2",    //44  -   14
+  //------------------------------
+  "2D_X_es_rthumb2",   //45  -   15
+  "2D_Y_es_rthumb2",   //46  -   15
+  "2D_vis_es_rthumb2", //47  -   15
+  //------------------------------
+  "2D_X_rindex1",      //48  -   16
+  "2D_Y_rindex1",      //49  -   16
+  "2D_vis_rindex1",    //50  -   16
+  //------------------------------
+  "2D_X_rindex2",      //51  -   17
+  "2D_Y_rindex2",      //52  -   17
+  "2D_vis_rindex2",    //53  -   17
+  //------------------------------
+  "2D_X_es_rindex2",   //54  -   18
+  "2D_Y_es_rindex2",   //55  -   18
+  "2D_vis_es_rindex2", //56  -   18
+  //------------------------------
+  "2D_X_rmid1",        //57  -   19
+  "2D_Y_rmid1",        //58  -   19
+  "2D_vis_rmid1",      //59  -   19
+  //------------------------------
+  "2D_X_rmid2",        //60  -   20
+  "2D_Y_rmid2",        //61  -   20
+  "2D_vis_rmid2",      //62  -   20
+  //------------------------------
+  "2D_X_es_rmid2",     //63  -   21
+  "2D_Y_es_rmid2",     //64  -   21
+  "2D_vis_es_rmid2",   //65  -   21
+  //------------------------------
+  "2D_X_rring1",       //66  -   22
+  "2D_Y_rring1",       //67  -   22
+  "2D_vis_rring1",     //68  -   22
+  //------------------------------
+  "2D_X_rring2",       //69  -   23
+  "2D_Y_rring2",       //70  -   23
+  "2D_vis_rring2",     //71  -   23
+  //------------------------------
+  "2D_X_es_rring2",    //72  -   24
+  "2D_Y_es_rring2",    //73  -   24
+  "2D_vis_es_rring2",  //74  -   24
+  //------------------------------
+  "2D_X_rpinky1",      //75  -   25
+  "2D_Y_rpinky1",      //76  -   25
+  "2D_vis_rpinky1",    //77  -   25
+  //------------------------------
+  "2D_X_rpinky2",      //78  -   26
+  "2D_Y_rpinky2",      //79  -   26
+  "2D_vis_rpinky2",    //80  -   26
+  //------------------------------
+  "2D_X_es_rpinky2",   //81  -   27
+  "2D_Y_es_rpinky2",   //82  -   27
+  "2D_vis_es_rpinky2", //83  -   27
+  //------------------------------
+  //------------------------------
+
+
+    //------------------------------
+  "2D_X_lcollar",      //84  -   28
+  "2D_Y_lcollar",      //85  -   28
+  "2D_vis_lcollar",    //86  -   28
+  //------------------------------
+  "2D_X_lshoulder",    //87  -   29
+  "2D_Y_lshoulder",    //88  -   29
+  "2D_vis_lshoulder",  //89  -   29
+  //------------------------------
+  "2D_X_lelbow",       //90  -   30
+  "2D_Y_lelbow",       //91  -   30
+  "2D_vis_lelbow",     //92  -   30
+  //------------------------------
+  "2D_X_lhand",        //93  -   31
+  "2D_Y_lhand",        //94  -   31
+  "2D_vis_lhand",      //95  -   31
+  //------------------------------
+
+  //------------------------------
+  "2D_X_lthumb1",      //96    - 32
+  "2D_Y_lthumb1",      //97    - 32
+  "2D_vis_lthumb1",    //98    - 32
+  //------------------------------
+  "2D_X_lthumb2",      //99    - 33
+  "2D_Y_lthumb2",      //100   - 33
+  "2D_vis_lthumb2",    //101   - 33
+  //------------------------------
+  "2D_X_es_lthumb2",   //102   - 34
+  "2D_Y_es_lthumb2",   //103   - 34
+  "2D_vis_es_lthumb2", //104   - 34
+  //------------------------------
+  "2D_X_lindex1",      //105   - 35
+  "2D_Y_lindex1",      //106   - 35
+  "2D_vis_lindex1",    //107   - 35
+  //------------------------------
+  "2D_X_lindex2",      //108   - 36
+  "2D_Y_lindex2",      //109   - 36
+  "2D_vis_lindex2",    //110   - 36
+  //------------------------------
+  "2D_X_es_lindex2",   //111   - 37
+  "2D_Y_es_lindex2",   //112   - 37
+  "2D_vis_es_lindex2", //113   - 37
+  //------------------------------
+  "2D_X_lmid1",        //114   - 38
+  "2D_Y_lmid1",        //115   - 38
+  "2D_vis_lmid1",      //116   - 38
+  //------------------------------
+  "2D_X_lmid2",        //117   - 39
+  "2D_Y_lmid2",        //118   - 39
+  "2D_vis_lmid2",      //119   - 39
+  //------------------------------
+  "2D_X_es_lmid2",     //120   - 40
+  "2D_Y_es_lmid2",     //121   - 40
+  "2D_vis_es_lmid2",   //122   - 40
+  //------------------------------
+  "2D_X_lring1",       //123   - 41
+  "2D_Y_lring1",       //124   - 41
+  "2D_vis_lring1",     //125   - 41
+  //------------------------------
+  "2D_X_lring2",       //126   - 42
+  "2D_Y_lring2",       //127   - 42
+  "2D_vis_lring2",     //128   - 42
+  //------------------------------
+  "2D_X_es_lring2",    //129   - 43
+  "2D_Y_es_lring2",    //130   - 43
+  "2D_vis_es_lring2",  //131   - 43
+  //------------------------------
+  "2D_X_lpinky1",      //132   - 44
+  "2D_Y_lpinky1",      //133   - 44
+  "2D_vis_lpinky1",    //134   - 44
+  //------------------------------
+  "2D_X_lpinky2",      //135   - 45
+  "2D_Y_lpinky2",      //136   - 45
+  "2D_vis_lpinky2",    //137   - 45
+  //------------------------------
+  "2D_X_es_lpinky2",   //138   - 46
+  "2D_Y_es_lpinky2",   //139   - 46
+  "2D_vis_es_lpinky2", //140   - 46
+  //------------------------------
+  //------------------------------
+
+  //------------------------------
+  //------------------------------
+  "2D_X_rbuttock",      //141  - 47
+  "2D_Y_rbuttock",      //142  - 47
+  "2D_vis_rbuttock",    //143  - 47
+  //------------------------------
+  "2D_X_rhip",          //144  - 48
+  "2D_Y_rhip",          //145  - 48
+  "2D_vis_rhip",        //146  - 48
+  //------------------------------
+  "2D_X_rknee",         //147  - 49
+  "2D_Y_rknee",         //148  - 49
+  "2D_vis_rknee",       //149  - 49
+  //------------------------------
+  "2D_X_rfoot",         //150  - 50
+  "2D_Y_rfoot",         //151  - 50
+  "2D_vis_rfoot",       //152  - 50
+  //------------------------------
+  "2D_X_es_rfoot",      //153  - 51
+  "2D_Y_es_rfoot",      //154  - 51
+  "2D_vis_es_rfoot",    //155  - 51
+  //------------------------------
+
+  //------------------------------
+  "2D_X_lbuttock",      //156  - 52
+  "2D_Y_lbuttock",      //157  - 52
+  "2D_vis_lbuttock",    //158  - 52
+  //------------------------------
+  "2D_X_lhip",          //159  - 53
+  "2D_Y_lhip",          //160  - 53
+  "2D_vis_lhip",        //161  - 53
+  //------------------------------
+  "2D_X_lknee",         //162  - 54
+  "2D_Y_lknee",         //163  - 54
+  "2D_vis_lknee",       //164  - 54
+  //------------------------------
+  "2D_X_lfoot",         //165  - 55
+  "2D_Y_lfoot",         //166  - 55
+  "2D_vis_lfoot",       //167  - 55
+  //------------------------------
+  "2D_X_es_lfoot",      //168  - 56
+  "2D_Y_es_lfoot",      //169  - 56
+  "2D_vis_es_lfoot",    //170  - 56
+  //------------------------------
+//=================
+    "End of MocapNETUncompressedNames Names"
+};
+
+
+const char * const MocapNETInputUncompressedAndCompressedArrayNames[MOCAPNET_INPUT_SIZE] =
+{
+ "2DX_hip",
+ "2DY_hip",
+ "visible_hip",
+ "2DX_abdomen",
+ "2DY_abdomen",
+ "visible_abdomen",
+ "2DX_chest",
+ "2DY_chest",
+ "visible_chest",
+ "2DX_neck",
+ "2DY_neck",
+ "visible_neck",
+ "2DX_head",
+ "2DY_head",
+ "visible_head",
+ "2DX_lefteye",
+ "2DY_lefteye",
+ "visible_lefteye",
+ "2DX_EndSite_lefteye",
+ "2DY_EndSite_lefteye",
+ "visible_EndSite_lefteye",
+ "2DX_righteye",
+ "2DY_righteye",
+ "visible_righteye",
+ "2DX_EndSite_righteye",
+ "2DY_EndSite_righteye",
+ "visible_EndSite_righteye",
+ "2DX_rcollar",
+ "2DY_rcollar",
+ "visible_rcollar",
+ "2DX_rshoulder",
+ "2DY_rshoulder",
+ "visible_rshoulder",
+ "2DX_relbow",
+ "2DY_relbow",
+ "visible_relbow",
+ "2DX_rhand",
+ "2DY_rhand",
+ "visible_rhand",
+ "2DX_rthumb1",
+ "2DY_rthumb1",
+ "visible_rthumb1",
+ "2DX_rthumb2",
+ "2DY_rthumb2",
+ "visible_rthumb2",
+ "2DX_EndSite_rthumb2",
+ "2DY_EndSite_rthumb2",
+ "visible_EndSite_rthumb2",
+ "2DX_rindex1",
+ "2DY_rindex1",
+ "visible_rindex1",
+ "2DX_rindex2",
+ "2DY_rindex2",
+ "visible_rindex2",
+ "2DX_EndSite_rindex2",
+ "2DY_EndSite_rindex2",
+ "visible_EndSite_rindex2",
+ "2DX_rmid1",
+ "2DY_rmid1",
+ "visible_rmid1",
+ "2DX_rmid2",
+ "2DY_rmid2",
+ "visible_rmid2",
+ "2DX_EndSite_rmid2",
+ "2DY_EndSite_rmid2",
+ "visible_EndSite_rmid2",
+ "2DX_rring1",
+ "2DY_rring1",
+ "visible_rring1",
+ "2DX_rring2",
+ "2DY_rring2",
+ "visible_rring2",
+ "2DX_EndSite_rring2",
+ "2DY_EndSite_rring2",
+ "visible_EndSite_rring2",
+ "2DX_rpinky1",
+ "2DY_rpinky1",
+ "visible_rpinky1",
+ "2DX_rpinky2",
+ "2DY_rpinky2",
+ "visible_rpinky2",
+ "2DX_EndSite_rpinky2",
+ "2DY_EndSite_rpinky2",
+ "visible_EndSite_rpinky2",
+ "2DX_lcollar",
+ "2DY_lcollar",
+ "visible_lcollar",
+ "2DX_lshoulder",
+ "2DY_lshoulder",
+ "visible_lshoulder",
+ "2DX_lelbow",
+ "2DY_lelbow",
+ "visible_lelbow",
+ "2DX_lhand",
+ "2DY_lhand",
+ "visible_lhand",
+ "2DX_lthumb1",
+ "2DY_lthumb1",
+ "visible_lthumb1",
+ "2DX_lthumb2",
+ "2DY_lthumb2",
+ "visible_lthumb2",
+ "2DX_EndSite_lthumb2",
+ "2DY_EndSite_lthumb2",
+ "visible_EndSite_lthumb2",
+ "2DX_lindex1",
+ "2DY_lindex1",
+ "visible_lindex1",
+ "2DX_lindex2",
+ "2DY_lindex2",
+ "visible_lindex2",
+ "2DX_EndSite_lindex2",
+ "2DY_EndSite_lindex2",
+ "visible_EndSite_lindex2",
+ "2DX_lmid1",
+ "2DY_lmid1",
+ "visible_lmid1",
+ "2DX_lmid2",
+ "2DY_lmid2",
+ "visible_lmid2",
+ "2DX_EndSite_lmid2",
+ "2DY_EndSite_lmid2",
+ "visible_EndSite_lmid2",
+ "2DX_lring1",
+ "2DY_lring1",
+ "visible_lring1",
+ "2DX_lring2",
+ "2DY_lring2",
+ "visible_lring2",
+ "2DX_EndSite_lring2",
+ "2DY_EndSite_lring2",
+ "visible_EndSite_lring2",
+ "2DX_lpinky1",
+ "2DY_lpinky1",
+ "visible_lpinky1",
+ "2DX_lpinky2",
+ "2DY_lpinky2",
+ "visible_lpinky2",
+ "2DX_EndSite_lpinky2",
+ "2DY_EndSite_lpinky2",
+ "visible_EndSite_lpinky2",
+ "2DX_rbuttock",
+ "2DY_rbuttock",
+ "visible_rbuttock",
+ "2DX_rhip",
+ "2DY_rhip",
+ "visible_rhip",
+ "2DX_rknee",
+ "2DY_rknee",
+ "visible_rknee",
+ "2DX_rfoot",
+ "2DY_rfoot",
+ "visible_rfoot",
+ "2DX_EndSite_rfoot",
+ "2DY_EndSite_rfoot",
+ "visible_EndSite_rfoot",
+ "2DX_lbuttock",
+ "2DY_lbuttock",
+ "visible_lbuttock",
+ "2DX_lhip",
+ "2DY_lhip",
+ "visible_lhip",
+ "2DX_lknee",
+ "2DY_lknee",
+ "visible_lknee",
+ "2DX_lfoot",
+ "2DY_lfoot",
+ "visible_lfoot",
+ "2DX_EndSite_lfoot",
+ "2DY_EndSite_lfoot",
+ "visible_EndSite_lfoot",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_neck",
+ "2DY_hip-2DY_neck",
+ "2DX_hip-2DX_head",
+ "2DY_hip-2DY_head",
+ "2DX_hip-2DX_rshoulder",
+ "2DY_hip-2DY_rshoulder",
+ "2DX_hip-2DX_relbow",
+ "2DY_hip-2DY_relbow",
+ "2DX_hip-2DX_rhand",
+ "2DY_hip-2DY_rhand",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_lshoulder",
+ "2DY_hip-2DY_lshoulder",
+ "2DX_hip-2DX_lelbow",
+ "2DY_hip-2DY_lelbow",
+ "2DX_hip-2DX_lhand",
+ "2DY_hip-2DY_lhand",
+ "2DX_hip-2DX_rhip",
+ "2DY_hip-2DY_rhip",
+ "2DX_hip-2DX_rknee",
+ "2DY_hip-2DY_rknee",
+ "2DX_hip-2DX_rfoot",
+ "2DY_hip-2DY_rfoot",
+ "2DX_hip-2DX_lhip",
+ "2DY_hip-2DY_lhip",
+ "2DX_hip-2DX_lknee",
+ "2DY_hip-2DY_lknee",
+ "2DX_hip-2DX_lfoot",
+ "2DY_hip-2DY_lfoot",
+ "2DX_neck-2DX_hip",
+ "2DY_neck-2DY_hip",
+ "2DX_neck-2DX_neck",
+ "2DY_neck-2DY_neck",
+ "2DX_neck-2DX_head",
+ "2DY_neck-2DY_head",
+ "2DX_neck-2DX_rshoulder",
+ "2DY_neck-2DY_rshoulder",
+ "2DX_neck-2DX_relbow",
+ "2DY_neck-2DY_relbow",
+ "2DX_neck-2DX_rhand",
+ "2DY_neck-2DY_rhand",
+ "2DX_neck-2DX_hip",
+ "2DY_neck-2DY_hip",
+ "2DX_neck-2DX_hip",
+ "2DY_neck-2DY_hip",
+ "2DX_neck-2DX_lshoulder",
+ "2DY_neck-2DY_lshoulder",
+ "2DX_neck-2DX_lelbow",
+ "2DY_neck-2DY_lelbow",
+ "2DX_neck-2DX_lhand",
+ "2DY_neck-2DY_lhand",
+ "2DX_neck-2DX_rhip",
+ "2DY_neck-2DY_rhip",
+ "2DX_neck-2DX_rknee",
+ "2DY_neck-2DY_rknee",
+ "2DX_neck-2DX_rfoot",
+ "2DY_neck-2DY_rfoot",
+ "2DX_neck-2DX_lhip",
+ "2DY_neck-2DY_lhip",
+ "2DX_neck-2DX_lknee",
+ "2DY_neck-2DY_lknee",
+ "2DX_neck-2DX_lfoot",
+ "2DY_neck-2DY_lfoot",
+ "2DX_head-2DX_hip",
+ "2DY_head-2DY_hip",
+ "2DX_head-2DX_neck",
+ "2DY_head-2DY_neck",
+ "2DX_head-2DX_head",
+ "2DY_head-2DY_head",
+ "2DX_head-2DX_rshoulder",
+ "2DY_head-2DY_rshoulder",
+ "2DX_head-2DX_relbow",
+ "2DY_head-2DY_relbow",
+ "2DX_head-2DX_rhand",
+ "2DY_head-2DY_rhand",
+ "2DX_head-2DX_hip",
+ "2DY_head-2DY_hip",
+ "2DX_head-2DX_hip",
+ "2DY_head-2DY_hip",
+ "2DX_head-2DX_lshoulder",
+ "2DY_head-2DY_lshoulder",
+ "2DX_head-2DX_lelbow",
+ "2DY_head-2DY_lelbow",
+ "2DX_head-2DX_lhand",
+ "2DY_head-2DY_lhand",
+ "2DX_head-2DX_rhip",
+ "2DY_head-2DY_rhip",
+ "2DX_head-2DX_rknee",
+ "2DY_head-2DY_rknee",
+ "2DX_head-2DX_rfoot",
+ "2DY_head-2DY_rfoot",
+ "2DX_head-2DX_lhip",
+ "2DY_head-2DY_lhip",
+ "2DX_head-2DX_lknee",
+ "2DY_head-2DY_lknee",
+ "2DX_head-2DX_lfoot",
+ "2DY_head-2DY_lfoot",
+ "2DX_rshoulder-2DX_hip",
+ "2DY_rshoulder-2DY_hip",
+ "2DX_rshoulder-2DX_neck",
+ "2DY_rshoulder-2DY_neck",
+ "2DX_rshoulder-2DX_head",
+ "2DY_rshoulder-2DY_head",
+ "2DX_rshoulder-2DX_rshoulder",
+ "2DY_rshoulder-2DY_rshoulder",
+ "2DX_rshoulder-2DX_relbow",
+ "2DY_rshoulder-2DY_relbow",
+ "2DX_rshoulder-2DX_rhand",
+ "2DY_rshoulder-2DY_rhand",
+ "2DX_rshoulder-2DX_hip",
+ "2DY_rshoulder-2DY_hip",
+ "2DX_rshoulder-2DX_hip",
+ "2DY_rshoulder-2DY_hip",
+ "2DX_rshoulder-2DX_lshoulder",
+ "2DY_rshoulder-2DY_lshoulder",
+ "2DX_rshoulder-2DX_lelbow",
+ "2DY_rshoulder-2DY_lelbow",
+ "2DX_rshoulder-2DX_lhand",
+ "2DY_rshoulder-2DY_lhand",
+ "2DX_rshoulder-2DX_rhip",
+ "2DY_rshoulder-2DY_rhip",
+ "2DX_rshoulder-2DX_rknee",
+ "2DY_rshoulder-2DY_rknee",
+ "2DX_rshoulder-2DX_rfoot",
+ "2DY_rshoulder-2DY_rfoot",
+ "2DX_rshoulder-2DX_lhip",
+ "2DY_rshoulder-2DY_lhip",
+ "2DX_rshoulder-2DX_lknee",
+ "2DY_rshoulder-2DY_lknee",
+ "2DX_rshoulder-2DX_lfoot",
+ "2DY_rshoulder-2DY_lfoot",
+ "2DX_relbow-2DX_hip",
+ "2DY_relbow-2DY_hip",
+ "2DX_relbow-2DX_neck",
+ "2DY_relbow-2DY_neck",
+ "2DX_relbow-2DX_head",
+ "2DY_relbow-2DY_head",
+ "2DX_relbow-2DX_rshoulder",
+ "2DY_relbow-2DY_rshoulder",
+ "2DX_relbow-2DX_relbow",
+ "2DY_relbow-2DY_relbow",
+ "2DX_relbow-2DX_rhand",
+ "2DY_relbow-2DY_rhand",
+ "2DX_relbow-2DX_hip",
+ "2DY_relbow-2DY_hip",
+ "2DX_relbow-2DX_hip",
+ "2DY_relbow-2DY_hip",
+ "2DX_relbow-2DX_lshoulder",
+ "2DY_relbow-2DY_lshoulder",
+ "2DX_relbow-2DX_lelbow",
+ "2DY_relbow-2DY_lelbow",
+ "2DX_relbow-2DX_lhand",
+ "2DY_relbow-2DY_lhand",
+ "2DX_relbow-2DX_rhip",
+ "2DY_relbow-2DY_rhip",
+ "2DX_relbow-2DX_rknee",
+ "2DY_relbow-2DY_rknee",
+ "2DX_relbow-2DX_rfoot",
+ "2DY_relbow-2DY_rfoot",
+ "2DX_relbow-2DX_lhip",
+ "2DY_relbow-2DY_lhip",
+ "2DX_relbow-2DX_lknee",
+ "2DY_relbow-2DY_lknee",
+ "2DX_relbow-2DX_lfoot",
+ "2DY_relbow-2DY_lfoot",
+ "2DX_rhand-2DX_hip",
+ "2DY_rhand-2DY_hip",
+ "2DX_rhand-2DX_neck",
+ "2DY_rhand-2DY_neck",
+ "2DX_rhand-2DX_head",
+ "2DY_rhand-2DY_head",
+ "2DX_rhand-2DX_rshoulder",
+ "2DY_rhand-2DY_rshoulder",
+ "2DX_rhand-2DX_relbow",
+ "2DY_rhand-2DY_relbow",
+ "2DX_rhand-2DX_rhand",
+ "2DY_rhand-2DY_rhand",
+ "2DX_rhand-2DX_hip",
+ "2DY_rhand-2DY_hip",
+ "2DX_rhand-2DX_hip",
+ "2DY_rhand-2DY_hip",
+ "2DX_rhand-2DX_lshoulder",
+ "2DY_rhand-2DY_lshoulder",
+ "2DX_rhand-2DX_lelbow",
+ "2DY_rhand-2DY_lelbow",
+ "2DX_rhand-2DX_lhand",
+ "2DY_rhand-2DY_lhand",
+ "2DX_rhand-2DX_rhip",
+ "2DY_rhand-2DY_rhip",
+ "2DX_rhand-2DX_rknee",
+ "2DY_rhand-2DY_rknee",
+ "2DX_rhand-2DX_rfoot",
+ "2DY_rhand-2DY_rfoot",
+ "2DX_rhand-2DX_lhip",
+ "2DY_rhand-2DY_lhip",
+ "2DX_rhand-2DX_lknee",
+ "2DY_rhand-2DY_lknee",
+ "2DX_rhand-2DX_lfoot",
+ "2DY_rhand-2DY_lfoot",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_neck",
+ "2DY_hip-2DY_neck",
+ "2DX_hip-2DX_head",
+ "2DY_hip-2DY_head",
+ "2DX_hip-2DX_rshoulder",
+ "2DY_hip-2DY_rshoulder",
+ "2DX_hip-2DX_relbow",
+ "2DY_hip-2DY_relbow",
+ "2DX_hip-2DX_rhand",
+ "2DY_hip-2DY_rhand",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_lshoulder",
+ "2DY_hip-2DY_lshoulder",
+ "2DX_hip-2DX_lelbow",
+ "2DY_hip-2DY_lelbow",
+ "2DX_hip-2DX_lhand",
+ "2DY_hip-2DY_lhand",
+ "2DX_hip-2DX_rhip",
+ "2DY_hip-2DY_rhip",
+ "2DX_hip-2DX_rknee",
+ "2DY_hip-2DY_rknee",
+ "2DX_hip-2DX_rfoot",
+ "2DY_hip-2DY_rfoot",
+ "2DX_hip-2DX_lhip",
+ "2DY_hip-2DY_lhip",
+ "2DX_hip-2DX_lknee",
+ "2DY_hip-2DY_lknee",
+ "2DX_hip-2DX_lfoot",
+ "2DY_hip-2DY_lfoot",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_neck",
+ "2DY_hip-2DY_neck",
+ "2DX_hip-2DX_head",
+ "2DY_hip-2DY_head",
+ "2DX_hip-2DX_rshoulder",
+ "2DY_hip-2DY_rshoulder",
+ "2DX_hip-2DX_relbow",
+ "2DY_hip-2DY_relbow",
+ "2DX_hip-2DX_rhand",
+ "2DY_hip-2DY_rhand",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_hip",
+ "2DY_hip-2DY_hip",
+ "2DX_hip-2DX_lshoulder",
+ "2DY_hip-2DY_lshoulder",
+ "2DX_hip-2DX_lelbow",
+ "2DY_hip-2DY_lelbow",
+ "2DX_hip-2DX_lhand",
+ "2DY_hip-2DY_lhand",
+ "2DX_hip-2DX_rhip",
+ "2DY_hip-2DY_rhip",
+ "2DX_hip-2DX_rknee",
+ "2DY_hip-2DY_rknee",
+ "2DX_hip-2DX_rfoot",
+ "2DY_hip-2DY_rfoot",
+ "2DX_hip-2DX_lhip",
+ "2DY_hip-2DY_lhip",
+ "2DX_hip-2DX_lknee",
+ "2DY_hip-2DY_lknee",
+ "2DX_hip-2DX_lfoot",
+ "2DY_hip-2DY_lfoot",
+ "2DX_lshoulder-2DX_hip",
+ "2DY_lshoulder-2DY_hip",
+ "2DX_lshoulder-2DX_neck",
+ "2DY_lshoulder-2DY_neck",
+ "2DX_lshoulder-2DX_head",
+ "2DY_lshoulder-2DY_head",
+ "2DX_lshoulder-2DX_rshoulder",
+ "2DY_lshoulder-2DY_rshoulder",
+ "2DX_lshoulder-2DX_relbow",
+ "2DY_lshoulder-2DY_relbow",
+ "2DX_lshoulder-2DX_rhand",
+ "2DY_lshoulder-2DY_rhand",
+ "2DX_lshoulder-2DX_hip",
+ "2DY_lshoulder-2DY_hip",
+ "2DX_lshoulder-2DX_hip",
+ "2DY_lshoulder-2DY_hip",
+ "2DX_lshoulder-2DX_lshoulder",
+ "2DY_lshoulder-2DY_lshoulder",
+ "2DX_lshoulder-2DX_lelbow",
+ "2DY_lshoulder-2DY_lelbow",
+ "2DX_lshoulder-2DX_lhand",
+ "2DY_lshoulder-2DY_lhand",
+ "2DX_lshoulder-2DX_rhip",
+ "2DY_lshoulder-2DY_rhip",
+ "2DX_lshoulder-2DX_rknee",
+ "2DY_lshoulder-2DY_rknee",
+ "2DX_lshoulder-2DX_rfoot",
+ "2DY_lshoulder-2DY_rfoot",
+ "2DX_lshoulder-2DX_lhip",
+ "2DY_lshoulder-2DY_lhip",
+ "2DX_lshoulder-2DX_lknee",
+ "2DY_lshoulder-2DY_lknee",
+ "2DX_lshoulder-2DX_lfoot",
+ "2DY_lshoulder-2DY_lfoot",
+ "2DX_lelbow-2DX_hip",
+ "2DY_lelbow-2DY_hip",
+ "2DX_lelbow-2DX_neck",
+ "2DY_lelbow-2DY_neck",
+ "2DX_lelbow-2DX_head",
+ "2DY_lelbow-2DY_head",
+ "2DX_lelbow-2DX_rshoulder",
+ "2DY_lelbow-2DY_rshoulder",
+ "2DX_lelbow-2DX_relbow",
+ "2DY_lelbow-2DY_relbow",
+ "2DX_lelbow-2DX_rhand",
+ "2DY_lelbow-2DY_rhand",
+ "2DX_lelbow-2DX_hip",
+ "2DY_lelbow-2DY_hip",
+ "2DX_lelbow-2DX_hip",
+ "2DY_lelbow-2DY_hip",
+ "2DX_lelbow-2DX_lshoulder",
+ "2DY_lelbow-2DY_lshoulder",
+ "2DX_lelbow-2DX_lelbow",
+ "2DY_lelbow-2DY_lelbow",
+ "2DX_lelbow-2DX_lhand",
+ "2DY_lelbow-2DY_lhand",
+ "2DX_lelbow-2DX_rhip",
+ "2DY_lelbow-2DY_rhip",
+ "2DX_lelbow-2DX_rknee",
+ "2DY_lelbow-2DY_rknee",
+ "2DX_lelbow-2DX_rfoot",
+ "2DY_lelbow-2DY_rfoot",
+ "2DX_lelbow-2DX_lhip",
+ "2DY_lelbow-2DY_lhip",
+ "2DX_lelbow-2DX_lknee",
+ "2DY_lelbow-2DY_lknee",
+ "2DX_lelbow-2DX_lfoot",
+ "2DY_lelbow-2DY_lfoot",
+ "2DX_lhand-2DX_hip",
+ "2DY_lhand-2DY_hip",
+ "2DX_lhand-2DX_neck",
+ "2DY_lhand-2DY_neck",
+ "2DX_lhand-2DX_head",
+ "2DY_lhand-2DY_head",
+ "2DX_lhand-2DX_rshoulder",
+ "2DY_lhand-2DY_rshoulder",
+ "2DX_lhand-2DX_relbow",
+ "2DY_lhand-2DY_relbow",
+ "2DX_lhand-2DX_rhand",
+ "2DY_lhand-2DY_rhand",
+ "2DX_lhand-2DX_hip",
+ "2DY_lhand-2DY_hip",
+ "2DX_lhand-2DX_hip",
+ "2DY_lhand-2DY_hip",
+ "2DX_lhand-2DX_lshoulder",
+ "2DY_lhand-2DY_lshoulder",
+ "2DX_lhand-2DX_lelbow",
+ "2DY_lhand-2DY_lelbow",
+ "2DX_lhand-2DX_lhand",
+ "2DY_lhand-2DY_lhand",
+ "2DX_lhand-2DX_rhip",
+ "2DY_lhand-2DY_rhip",
+ "2DX_lhand-2DX_rknee",
+ "2DY_lhand-2DY_rknee",
+ "2DX_lhand-2DX_rfoot",
+ "2DY_lhand-2DY_rfoot",
+ "2DX_lhand-2DX_lhip",
+ "2DY_lhand-2DY_lhip",
+ "2DX_lhand-2DX_lknee",
+ "2DY_lhand-2DY_lknee",
+ "2DX_lhand-2DX_lfoot",
+ "2DY_lhand-2DY_lfoot",
+ "2DX_rhip-2DX_hip",
+ "2DY_rhip-2DY_hip",
+ "2DX_rhip-2DX_neck",
+ "2DY_rhip-2DY_neck",
+ "2DX_rhip-2DX_head",
+ "2DY_rhip-2DY_head",
+ "2DX_rhip-2DX_rshoulder",
+ "2DY_rhip-2DY_rshoulder",
+ "2DX_rhip-2DX_relbow",
+ "2DY_rhip-2DY_relbow",
+ "2DX_rhip-2DX_rhand",
+ "2DY_rhip-2DY_rhand",
+ "2DX_rhip-2DX_hip",
+ "2DY_rhip-2DY_hip",
+ "2DX_rhip-2DX_hip",
+ "2DY_rhip-2DY_hip",
+ "2DX_rhip-2DX_lshoulder",
+ "2DY_rhip-2DY_lshoulder",
+ "2DX_rhip-2DX_lelbow",
+ "2DY_rhip-2DY_lelbow",
+ "2DX_rhip-2DX_lhand",
+ "2DY_rhip-2DY_lhand",
+ "2DX_rhip-2DX_rhip",
+ "2DY_rhip-2DY_rhip",
+ "2DX_rhip-2DX_rknee",
+ "2DY_rhip-2DY_rknee",
+ "2DX_rhip-2DX_rfoot",
+ "2DY_rhip-2DY_rfoot",
+ "2DX_rhip-2DX_lhip",
+ "2DY_rhip-2DY_lhip",
+ "2DX_rhip-2DX_lknee",
+ "2DY_rhip-2DY_lknee",
+ "2DX_rhip-2DX_lfoot",
+ "2DY_rhip-2DY_lfoot",
+ "2DX_rknee-2DX_hip",
+ "2DY_rknee-2DY_hip",
+ "2DX_rknee-2DX_neck",
+ "2DY_rknee-2DY_neck",
+ "2DX_rknee-2DX_head",
+ "2DY_rknee-2DY_head",
+ "2DX_rknee-2DX_rshoulder",
+ "2DY_rknee-2DY_rshoulder",
+ "2DX_rknee-2DX_relbow",
+ "2DY_rknee-2DY_relbow",
+ "2DX_rknee-2DX_rhand",
+ "2DY_rknee-2DY_rhand",
+ "2DX_rknee-2DX_hip",
+ "2DY_rknee-2DY_hip",
+ "2DX_rknee-2DX_hip",
+ "2DY_rknee-2DY_hip",
+ "2DX_rknee-2DX_lshoulder",
+ "2DY_rknee-2DY_lshoulder",
+ "2DX_rknee-2DX_lelbow",
+ "2DY_rknee-2DY_lelbow",
+ "2DX_rknee-2DX_lhand",
+ "2DY_rknee-2DY_lhand",
+ "2DX_rknee-2DX_rhip",
+ "2DY_rknee-2DY_rhip",
+ "2DX_rknee-2DX_rknee",
+ "2DY_rknee-2DY_rknee",
+ "2DX_rknee-2DX_rfoot",
+ "2DY_rknee-2DY_rfoot",
+ "2DX_rknee-2DX_lhip",
+ "2DY_rknee-2DY_lhip",
+ "2DX_rknee-2DX_lknee",
+ "2DY_rknee-2DY_lknee",
+ "2DX_rknee-2DX_lfoot",
+ "2DY_rknee-2DY_lfoot",
+ "2DX_rfoot-2DX_hip",
+ "2DY_rfoot-2DY_hip",
+ "2DX_rfoot-2DX_neck",
+ "2DY_rfoot-2DY_neck",
+ "2DX_rfoot-2DX_head",
+ "2DY_rfoot-2DY_head",
+ "2DX_rfoot-2DX_rshoulder",
+ "2DY_rfoot-2DY_rshoulder",
+ "2DX_rfoot-2DX_relbow",
+ "2DY_rfoot-2DY_relbow",
+ "2DX_rfoot-2DX_rhand",
+ "2DY_rfoot-2DY_rhand",
+ "2DX_rfoot-2DX_hip",
+ "2DY_rfoot-2DY_hip",
+ "2DX_rfoot-2DX_hip",
+ "2DY_rfoot-2DY_hip",
+ "2DX_rfoot-2DX_lshoulder",
+ "2DY_rfoot-2DY_lshoulder",
+ "2DX_rfoot-2DX_lelbow",
+ "2DY_rfoot-2DY_lelbow",
+ "2DX_rfoot-2DX_lhand",
+ "2DY_rfoot-2DY_lhand",
+ "2DX_rfoot-2DX_rhip",
+ "2DY_rfoot-2DY_rhip",
+ "2DX_rfoot-2DX_rknee",
+ "2DY_rfoot-2DY_rknee",
+ "2DX_rfoot-2DX_rfoot",
+ "2DY_rfoot-2DY_rfoot",
+ "2DX_rfoot-2DX_lhip",
+ "2DY_rfoot-2DY_lhip",
+ "2DX_rfoot-2DX_lknee",
+ "2DY_rfoot-2DY_lknee",
+ "2DX_rfoot-2DX_lfoot",
+ "2DY_rfoot-2DY_lfoot",
+ "2DX_lhip-2DX_hip",
+ "2DY_lhip-2DY_hip",
+ "2DX_lhip-2DX_neck",
+ "2DY_lhip-2DY_neck",
+ "2DX_lhip-2DX_head",
+ "2DY_lhip-2DY_head",
+ "2DX_lhip-2DX_rshoulder",
+ "2DY_lhip-2DY_rshoulder",
+ "2DX_lhip-2DX_relbow",
+ "2DY_lhip-2DY_relbow",
+ "2DX_lhip-2DX_rhand",
+ "2DY_lhip-2DY_rhand",
+ "2DX_lhip-2DX_hip",
+ "2DY_lhip-2DY_hip",
+ "2DX_lhip-2DX_hip",
+ "2DY_lhip-2DY_hip",
+ "2DX_lhip-2DX_lshoulder",
+ "2DY_lhip-2DY_lshoulder",
+ "2DX_lhip-2DX_lelbow",
+ "2DY_lhip-2DY_lelbow",
+ "2DX_lhip-2DX_lhand",
+ "2DY_lhip-2DY_lhand",
+ "2DX_lhip-2DX_rhip",
+ "2DY_lhip-2DY_rhip",
+ "2DX_lhip-2DX_rknee",
+ "2DY_lhip-2DY_rknee",
+ "2DX_lhip-2DX_rfoot",
+ "2DY_lhip-2DY_rfoot",
+ "2DX_lhip-2DX_lhip",
+ "2DY_lhip-2DY_lhip",
+ "2DX_lhip-2DX_lknee",
+ "2DY_lhip-2DY_lknee",
+ "2DX_lhip-2DX_lfoot",
+ "2DY_lhip-2DY_lfoot",
+ "2DX_lknee-2DX_hip",
+ "2DY_lknee-2DY_hip",
+ "2DX_lknee-2DX_neck",
+ "2DY_lknee-2DY_neck",
+ "2DX_lknee-2DX_head",
+ "2DY_lknee-2DY_head",
+ "2DX_lknee-2DX_rshoulder",
+ "2DY_lknee-2DY_rshoulder",
+ "2DX_lknee-2DX_relbow",
+ "2DY_lknee-2DY_relbow",
+ "2DX_lknee-2DX_rhand",
+ "2DY_lknee-2DY_rhand",
+ "2DX_lknee-2DX_hip",
+ "2DY_lknee-2DY_hip",
+ "2DX_lknee-2DX_hip",
+ "2DY_lknee-2DY_hip",
+ "2DX_lknee-2DX_lshoulder",
+ "2DY_lknee-2DY_lshoulder",
+ "2DX_lknee-2DX_lelbow",
+ "2DY_lknee-2DY_lelbow",
+ "2DX_lknee-2DX_lhand",
+ "2DY_lknee-2DY_lhand",
+ "2DX_lknee-2DX_rhip",
+ "2DY_lknee-2DY_rhip",
+ "2DX_lknee-2DX_rknee",
+ "2DY_lknee-2DY_rknee",
+ "2DX_lknee-2DX_rfoot",
+ "2DY_lknee-2DY_rfoot",
+ "2DX_lknee-2DX_lhip",
+ "2DY_lknee-2DY_lhip",
+ "2DX_lknee-2DX_lknee",
+ "2DY_lknee-2DY_lknee",
+ "2DX_lknee-2DX_lfoot",
+ "2DY_lknee-2DY_lfoot",
+ "2DX_lfoot-2DX_hip",
+ "2DY_lfoot-2DY_hip",
+ "2DX_lfoot-2DX_neck",
+ "2DY_lfoot-2DY_neck",
+ "2DX_lfoot-2DX_head",
+ "2DY_lfoot-2DY_head",
+ "2DX_lfoot-2DX_rshoulder",
+ "2DY_lfoot-2DY_rshoulder",
+ "2DX_lfoot-2DX_relbow",
+ "2DY_lfoot-2DY_relbow",
+ "2DX_lfoot-2DX_rhand",
+ "2DY_lfoot-2DY_rhand",
+ "2DX_lfoot-2DX_hip",
+ "2DY_lfoot-2DY_hip",
+ "2DX_lfoot-2DX_hip",
+ "2DY_lfoot-2DY_hip",
+ "2DX_lfoot-2DX_lshoulder",
+ "2DY_lfoot-2DY_lshoulder",
+ "2DX_lfoot-2DX_lelbow",
+ "2DY_lfoot-2DY_lelbow",
+ "2DX_lfoot-2DX_lhand",
+ "2DY_lfoot-2DY_lhand",
+ "2DX_lfoot-2DX_rhip",
+ "2DY_lfoot-2DY_rhip",
+ "2DX_lfoot-2DX_rknee",
+ "2DY_lfoot-2DY_rknee",
+ "2DX_lfoot-2DX_rfoot",
+ "2DY_lfoot-2DY_rfoot",
+ "2DX_lfoot-2DX_lhip",
+ "2DY_lfoot-2DY_lhip",
+ "2DX_lfoot-2DX_lknee",
+ "2DY_lfoot-2DY_lknee",
+ "2DX_lfoot-2DX_lfoot",
+ "2DY_lfoot-2DY_lfoot"
+ };
+
+
+const char * const MocapNETOutputArrayNames[MOCAPNET_OUTPUT_NUMBER] =
+{
+ "hip_Xposition",
+ "hip_Yposition",
+ "hip_Zposition",
+ "hip_Zrotation",
+ "hip_Yrotation",
+ "hip_Xrotation",
+ "abdomen_Zrotation",
+ "abdomen_Xrotation",
+ "abdomen_Yrotation",
+ "chest_Zrotation",
+ "chest_Xrotation",
+ "chest_Yrotation",
+ "neck_Zrotation",
+ "neck_Xrotation",
+ "neck_Yrotation",
+ "head_Zrotation",
+ "head_Xrotation",
+ "head_Yrotation",
+ "lefteye_Zrotation",
+ "lefteye_Xrotation",
+ "lefteye_Yrotation",
+ "righteye_Zrotation",
+ "righteye_Xrotation",
+ "righteye_Yrotation",
+ "rcollar_Zrotation",
+ "rcollar_Xrotation",
+ "rcollar_Yrotation",
+ "rshoulder_Zrotation",
+ "rshoulder_Xrotation",
+ "rshoulder_Yrotation",
+ "relbow_Zrotation",
+ "relbow_Xrotation",
+ "relbow_Yrotation",
+ "rhand_Zrotation",
+ "rhand_Xrotation",
+ "rhand_Yrotation",
+ "rthumb1_Zrotation",
+ "rthumb1_Xrotation",
+ "rthumb1_Yrotation",
+ "rthumb2_Zrotation",
+ "rthumb2_Xrotation",
+ "rthumb2_Yrotation",
+ "rindex1_Zrotation",
+ "rindex1_Xrotation",
+ "rindex1_Yrotation",
+ "rindex2_Zrotation",
+ "rindex2_Xrotation",
+ "rindex2_Yrotation",
+ "rmid1_Zrotation",
+ "rmid1_Xrotation",
+ "rmid1_Yrotation",
+ "rmid2_Zrotation",
+ "rmid2_Xrotation",
+ "rmid2_Yrotation",
+ "rring1_Zrotation",
+ "rring1_Xrotation",
+ "rring1_Yrotation",
+ "rring2_Zrotation",
+ "rring2_Xrotation",
+ "rring2_Yrotation",
+ "rpinky1_Zrotation",
+ "rpinky1_Xrotation",
+ "rpinky1_Yrotation",
+ "rpinky2_Zrotation",
+ "rpinky2_Xrotation",
+ "rpinky2_Yrotation",
+ "lcollar_Zrotation",
+ "lcollar_Xrotation",
+ "lcollar_Yrotation",
+ "lshoulder_Zrotation",
+ "lshoulder_Xrotation",
+ "lshoulder_Yrotation",
+ "lelbow_Zrotation",
+ "lelbow_Xrotation",
+ "lelbow_Yrotation",
+ "lhand_Zrotation",
+ "lhand_Xrotation",
+ "lhand_Yrotation",
+ "lthumb1_Zrotation",
+ "lthumb1_Xrotation",
+ "lthumb1_Yrotation",
+ "lthumb2_Zrotation",
+ "lthumb2_Xrotation",
+ "lthumb2_Yrotation",
+ "lindex1_Zrotation",
+ "lindex1_Xrotation",
+ "lindex1_Yrotation",
+ "lindex2_Zrotation",
+ "lindex2_Xrotation",
+ "lindex2_Yrotation",
+ "lmid1_Zrotation",
+ "lmid1_Xrotation",
+ "lmid1_Yrotation",
+ "lmid2_Zrotation",
+ "lmid2_Xrotation",
+ "lmid2_Yrotation",
+ "lring1_Zrotation",
+ "lring1_Xrotation",
+ "lring1_Yrotation",
+ "lring2_Zrotation",
+ "lring2_Xrotation",
+ "lring2_Yrotation",
+ "lpinky1_Zrotation",
+ "lpinky1_Xrotation",
+ "lpinky1_Yrotation",
+ "lpinky2_Zrotation",
+ "lpinky2_Xrotation",
+ "lpinky2_Yrotation",
+ "rbuttock_Zrotation",
+ "rbuttock_Xrotation",
+ "rbuttock_Yrotation",
+ "rhip_Zrotation",
+ "rhip_Xrotation",
+ "rhip_Yrotation",
+ "rknee_Zrotation",
+ "rknee_Xrotation",
+ "rknee_Yrotation",
+ "rfoot_Zrotation",
+ "rfoot_Xrotation",
+ "rfoot_Yrotation",
+ "lbuttock_Zrotation",
+ "lbuttock_Xrotation",
+ "lbuttock_Yrotation",
+ "lhip_Zrotation",
+ "lhip_Xrotation",
+ "lhip_Yrotation",
+ "lknee_Zrotation",
+ "lknee_Xrotation",
+ "lknee_Yrotation",
+ "lfoot_Zrotation",
+ "lfoot_Xrotation",
+ "lfoot_Yrotation"
+};
+
+
+const char * const MocapNETBVHJointNames[MOCAPNET_BVH_JOINT_NUMBER] =
+{
+  "hip",              //0
+  "abdomen",          //1
+  "chest",            //2
+  "neck",             //3
+  "head",             //4
+  "leftEye",          //5
+  "EndSite_leftEye",  //6
+  "rightEye",         //7
+  "EndSite_rightEye", //8
+  "rCollar",          //9
+  "rShldr",           //10
+  "rForeArm",         //11
+  "rHand",            //12
+  "rThumb1",          //13
+  "rThumb2",          //14
+  "EndSite_rThumb2",  //15
+  "rIndex1",          //16
+  "rIndex2",          //17
+  "EndSite_rIndex2",  //18
+  "rMid1",            //19
+  "rMid2",            //20
+  "EndSite_rMid2",    //21
+  "rRing1",           //22
+  "rRing2",           //23
+  "EndSite_rRing2",   //24
+  "rPinky1",          //25
+  "rPinky2",          //26
+  "EndSite_rPinky2",  //27
+  "lCollar",          //28
+  "lShldr",           //29
+  "lForeArm",         //30
+  "lHand",            //31
+  "lThumb1",          //32
+  "lThumb2",          //33
+  "EndSite_lThumb2",  //34
+  "lIndex1",          //35
+  "lIndex2",          //36
+  "EndSite_lIndex2",  //37
+  "lMid1",            //38
+  "lMid2",            //39
+  "EndSite_lMid2",    //40
+  "lRing1",           //41
+  "lRing2",           //42
+  "EndSite_lRing2",   //43
+  "lPinky1",          //44
+  "lPinky2",          //45
+  "EndSite_lPinky2",  //46
+  "rButtock",         //47
+  "rThigh",           //48
+  "rShin",            //49
+  "rFoot",            //50
+  "EndSite_rFoot",    //51
+  "lButtock",         //52
+  "lThigh",           //53
+  "lShin",            //54
+  "lFoot",            //55
+  "EndSite_lFoot"    //56
+};
+
+
+
+
+/*
+ * Name lookups use a hash and displace perfect hash ( every key gets its own slot, so a lookup is one hash, one table read and one string comparison ).
+ * Tables are built once at runtime from the string tables above so they can never go out of sync with them.
+ */
+#define MOCAPNET_REGISTRY_MAX_TABLE_SIZE 2048
+#define MOCAPNET_REGISTRY_EMPTY_SLOT 0xFFFF
+
+struct MocapNETPerfectHash
+{
+    const char * const * keys;
+    unsigned int numberOfKeys;
+    unsigned int tableSize;
+    unsigned int numberOfBuckets;
+    int ready;
+    unsigned short displacement[MOCAPNET_REGISTRY_MAX_TABLE_SIZE];
+    unsigned short slot[MOCAPNET_REGISTRY_MAX_TABLE_SIZE];
+};
+
+//Static storage so every field of the tables starts zeroed ( not ready ) until buildPerfectHash fills them
+static struct MocapNETPerfectHash bvhJointHash;
+static struct MocapNETPerfectHash inputJointHash;
+static struct MocapNETPerfectHash inputHash;
+static struct MocapNETPerfectHash outputHash;
+static std::once_flag registryHashOnce;
+
+
+/*
+ * Case insensitive 64bit FNV-1a, the two halves give the bucket/initial slot and the displacement step ( which is kept odd so that
+ * stepping through a power of two table visits every slot )
+ */
+static inline void hashName(const char * name,unsigned int * h1,unsigned int * h2)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    while (*name!=0)
+        {
+            unsigned char c = (unsigned char) *name;
+            if ( (c>='A') && (c<='Z') )
+                {
+                    c = c - 'A' + 'a';
+                }
+            hash ^= c;
+            hash *= 1099511628211ULL;
+            ++name;
+        }
+    *h1 = (unsigned int) hash;
+    *h2 = ((unsigned int) (hash>>32)) | 1;
+}
+
+
+static int buildPerfectHash(struct MocapNETPerfectHash * table,const char * const * keys,unsigned int numberOfKeys)
+{
+    table->keys=keys;
+    table->numberOfKeys=numberOfKeys;
+    table->ready=0;
+
+    table->tableSize=16;
+    while (table->tableSize<numberOfKeys*2)
+        {
+            table->tableSize*=2;
+        }
+    if ( (table->tableSize>MOCAPNET_REGISTRY_MAX_TABLE_SIZE) || (numberOfKeys>=MOCAPNET_REGISTRY_EMPTY_SLOT) )
+        {
+            return 0;
+        }
+    table->numberOfBuckets = table->tableSize/4;
+    unsigned int mask = table->tableSize-1;
+
+    std::vector<unsigned int> h1(numberOfKeys),h2(numberOfKeys);
+    std::vector<std::vector<unsigned int> > buckets(table->numberOfBuckets);
+    for (unsigned int keyID=0; keyID<numberOfKeys; keyID++)
+        {
+            hashName(keys[keyID],&h1[keyID],&h2[keyID]);
+            std::vector<unsigned int> & bucket = buckets[h1[keyID] % table->numberOfBuckets];
+
+            //Some labels appear more than once ( the synthetic NSDM points ), like a linear scan they resolve to their first occurrence
+            int duplicate=0;
+            for (unsigned int k=0; k<bucket.size(); k++)
+                {
+                    if (strcasecmp(keys[bucket[k]],keys[keyID])==0)
+                        {
+                            duplicate=1;
+                            break;
+                        }
+                }
+            if (!duplicate)
+                {
+                    bucket.push_back(keyID);
+                }
+        }
+
+    //Place the most crowded buckets first while the table is still empty
+    std::vector<unsigned int> order(table->numberOfBuckets);
+    for (unsigned int bucketID=0; bucketID<table->numberOfBuckets; bucketID++)
+        {
+            order[bucketID]=bucketID;
+        }
+    std::stable_sort(order.begin(),order.end(),[&buckets](unsigned int a,unsigned int b)
+    {
+        return buckets[a].size()>buckets[b].size();
+    });
+
+    for (unsigned int i=0; i<table->tableSize; i++)
+        {
+            table->slot[i]=MOCAPNET_REGISTRY_EMPTY_SLOT;
+            table->displacement[i]=0;
+        }
+
+    for (unsigned int o=0; o<table->numberOfBuckets; o++)
+        {
+            unsigned int bucketID = order[o];
+            const std::vector<unsigned int> & bucket = buckets[bucketID];
+            if (bucket.size()==0)
+                {
+                    break;
+                }
+
+            int placed=0;
+            for (unsigned int d=0; (d<table->tableSize) && (!placed); d++)
+                {
+                    unsigned int k;
+                    for (k=0; k<bucket.size(); k++)
+                        {
+                            unsigned int position = (h1[bucket[k]] + d*h2[bucket[k]]) & mask;
+                            if (table->slot[position]!=MOCAPNET_REGISTRY_EMPTY_SLOT)
+                                {
+                                    break;
+                                }
+                            //Claim it now so that the other keys of the bucket see it, undone below if the bucket does not fit
+                            table->slot[position]=(unsigned short) bucket[k];
+                        }
+                    if (k==bucket.size())
+                        {
+                            table->displacement[bucketID]=(unsigned short) d;
+                            placed=1;
+                        }
+                    else
+                        {
+                            for (unsigned int u=0; u<k; u++)
+                                {
+                                    table->slot[(h1[bucket[u]] + d*h2[bucket[u]]) & mask]=MOCAPNET_REGISTRY_EMPTY_SLOT;
+                                }
+                        }
+                }
+            if (!placed)
+                {
+                    //Should not happen with tables this small, lookups will then fall back to a linear scan
+                    fprintf(stderr,YELLOW "mocapnetRegistry: could not build a perfect hash for a table of %u names\n" NORMAL,numberOfKeys);
+                    return 0;
+                }
+        }
+
+    table->ready=1;
+    return 1;
+}
+
+
+static void buildRegistryHashes()
+{
+    buildPerfectHash(&bvhJointHash,MocapNETBVHJointNames,MOCAPNET_BVH_JOINT_NUMBER);
+    buildPerfectHash(&inputJointHash,MocapNETInputUncompressedJointNames,MOCAPNET_UNCOMPRESSED_JOINT_PARTS);
+    buildPerfectHash(&inputHash,MocapNETInputUncompressedAndCompressedArrayNames,MOCAPNET_INPUT_SIZE);
+    buildPerfectHash(&outputHash,MocapNETOutputArrayNames,MOCAPNET_OUTPUT_NUMBER);
+}
+
+
+static int lookupPerfectHash(const struct MocapNETPerfectHash * table,const char * name,unsigned int * result)
+{
+    if (name==0)
+        {
+            return 0;
+        }
+
+    if (!table->ready)
+        {
+            for (unsigned int keyID=0; keyID<table->numberOfKeys; keyID++)
+                {
+                    if (strcasecmp(table->keys[keyID],name)==0)
+                        {
+                            *result=keyID;
+                            return 1;
+                        }
+                }
+            return 0;
+        }
+
+    unsigned int h1,h2;
+    hashName(name,&h1,&h2);
+    unsigned int d = table->displacement[h1 % table->numberOfBuckets];
+    unsigned short keyID = table->slot[(h1 + d*h2) & (table->tableSize-1)];
+    if ( (keyID!=MOCAPNET_REGISTRY_EMPTY_SLOT) && (strcasecmp(table->keys[keyID],name)==0) )
+        {
+            *result=keyID;
+            return 1;
+        }
+    return 0;
+}
+
+
+int mocapnetRegistryGetBVHJointID(const char * jointName,unsigned int * jointID)
+{
+    std::call_once(registryHashOnce,buildRegistryHashes);
+    return lookupPerfectHash(&bvhJointHash,jointName,jointID);
+}
+
+
+int mocapnetRegistryGetInputJointID(const char * jointName,unsigned int * jointID)
+{
+    std::call_once(registryHashOnce,buildRegistryHashes);
+    return lookupPerfectHash(&inputJointHash,jointName,jointID);
+}
+
+
+int mocapnetRegistryGetInputID(const char * inputName,unsigned int * inputID)
+{
+    std::call_once(registryHashOnce,buildRegistryHashes);
+    return lookupPerfectHash(&inputHash,inputName,inputID);
+}
+
+
+int mocapnetRegistryGetOutputChannelID(const char * channelName,unsigned int * channelID)
+{
+    std::call_once(registryHashOnce,buildRegistryHashes);
+    return lookupPerfectHash(&outputHash,channelName,channelID);
+}
@@ -0,0 +1,448 @@
+#pragma once
+/** @file mocapnetRegistry.hpp
+ *  @brief Names, indexes and hierarchy of the MocapNET input and output. Index tables are constexpr so they cost nothing at runtime,
+ *  string tables are defined once in mocapnetRegistry.cpp instead of being copied to every translation unit that includes mocapnet.hpp.
+ *  This header does not depend on Tensorflow so it can be used by tools that only need to address joints or channels by name.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+
+
+/**
+ * @brief This is a BVH header that can be easily injected in a file ( using just an fprintf call )
+ */
+extern const char * const bvhHeader;
+
+
+
+/**
+ * @brief This is a programmer friendly enumerator of joint names expected from MocapNET.
+ * Please notice that these 57 joints have actually result to three times the number of parameters since we require
+ * x,y,v ( v for visibility ) information for each joint.
+ * That gives us 57*3 = 171 input parameters. String Labels can be accessed using the MocapNETUncompressedJointNames array
+ * For a full list of the 171 input value labels see MocapNETUncompressedArrayNames
+ */
+enum MOCAPNET_Input_Uncompressed_Joints
+{
+  MOCAPNET_UNCOMPRESSED_JOINT_HIP=0,        //0
+  MOCAPNET_UNCOMPRESSED_JOINT_ABDOMEN,      //1
+  MOCAPNET_UNCOMPRESSED_JOINT_CHEST,        //2
+  MOCAPNET_UNCOMPRESSED_JOINT_NECK,         //3
+  MOCAPNET_UNCOMPRESSED_JOINT_HEAD,         //4
+  MOCAPNET_UNCOMPRESSED_JOINT_LEFTEYE,      //5
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_LEFTEYE,   //6
+  MOCAPNET_UNCOMPRESSED_JOINT_RIGHTEYE,     //7
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_RIGHTEYE,  //8
+  MOCAPNET_UNCOMPRESSED_JOINT_RCOLLAR,      //9
+  MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER,    //10
+  MOCAPNET_UNCOMPRESSED_JOINT_RELBOW,       //11
+  MOCAPNET_UNCOMPRESSED_JOINT_RHAND,        //12
+  MOCAPNET_UNCOMPRESSED_JOINT_RTHUMB1,      //13
+  MOCAPNET_UNCOMPRESSED_JOINT_RTHUMB2,      //14
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_RTHUMB2,   //15
+  MOCAPNET_UNCOMPRESSED_JOINT_RINDEX1,      //16
+  MOCAPNET_UNCOMPRESSED_JOINT_RINDEX2,      //17
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_RINDEX2,   //18
+  MOCAPNET_UNCOMPRESSED_JOINT_RMID1,        //19
+  MOCAPNET_UNCOMPRESSED_JOINT_RMID2,        //20
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_RMID2,     //21
+  MOCAPNET_UNCOMPRESSED_JOINT_RRING1,       //22
+  MOCAPNET_UNCOMPRESSED_JOINT_RRING2,       //23
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_RRING2,    //24
+  MOCAPNET_UNCOMPRESSED_JOINT_RPINKY1,      //25
+  MOCAPNET_UNCOMPRESSED_JOINT_RPINKY2,      //26
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_RPINKY2,   //27
+  MOCAPNET_UNCOMPRESSED_JOINT_LCOLLAR,      //28
+  MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER,    //29
+  MOCAPNET_UNCOMPRESSED_JOINT_LELBOW,       //30
+  MOCAPNET_UNCOMPRESSED_JOINT_LHAND,        //31
+  MOCAPNET_UNCOMPRESSED_JOINT_LTHUMB1,      //32
+  MOCAPNET_UNCOMPRESSED_JOINT_LTHUMB2,      //33
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_LTHUMB2,   //34
+  MOCAPNET_UNCOMPRESSED_JOINT_LINDEX1,      //35
+  MOCAPNET_UNCOMPRESSED_JOINT_LINDEX2,      //36
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_LINDEX2,   //37
+  MOCAPNET_UNCOMPRESSED_JOINT_LMID1,        //38
+  MOCAPNET_UNCOMPRESSED_JOINT_LMID2,        //39
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_LMID2,     //40
+  MOCAPNET_UNCOMPRESSED_JOINT_LRING1,       //41
+  MOCAPNET_UNCOMPRESSED_JOINT_LRING2,       //42
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_LRING2,    //43
+  MOCAPNET_UNCOMPRESSED_JOINT_LPINKY1,      //44
+  MOCAPNET_UNCOMPRESSED_JOINT_LPINKY2,      //45
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_LPINKY2,   //46
+  MOCAPNET_UNCOMPRESSED_JOINT_RBUTTOCK,     //47
+  MOCAPNET_UNCOMPRESSED_JOINT_RHIP,         //48
+  MOCAPNET_UNCOMPRESSED_JOINT_RKNEE,        //49
+  MOCAPNET_UNCOMPRESSED_JOINT_RFOOT,        //50
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_RFOOT,     //51
+  MOCAPNET_UNCOMPRESSED_JOINT_LBUTTOCK,     //52
+  MOCAPNET_UNCOMPRESSED_JOINT_LHIP,         //53
+  MOCAPNET_UNCOMPRESSED_JOINT_LKNEE,        //54
+  MOCAPNET_UNCOMPRESSED_JOINT_LFOOT,        //55
+  MOCAPNET_UNCOMPRESSED_JOINT_ES_LFOOT,     //56
+   //---------------------
+  MOCAPNET_UNCOMPRESSED_JOINT_PARTS
+};
+
+
+/**
+ * @brief This is an array of names for the input Joints expected from MocapNET.
+ * Please notice that these 57 joints have actually result to three times the number of parameters since we require
+ * x,y,v ( v for visibility ) information for each joint.
+ * That gives us 57*3 = 171 input parameters. The array is terminated by a label entry and values can be accessed using the enumerator MOCAPNET_Uncompressed_Joints
+ * For a full list of the 171 input value labels see MocapNETUncompressedArrayNames
+ */
+extern const char * const MocapNETInputUncompressedJointNames[MOCAPNET_UNCOMPRESSED_JOINT_PARTS+1];
+
+
+/**
+ * @brief Number of floats in the uncompressed MocapNET input, 57 joints with x,y,visibility each
+ */
+#define MOCAPNET_UNCOMPRESSED_INPUT_SIZE 171
+
+
+/**
+ * @brief This is an array of names for all uncompressed inputs expected from MocapNET.
+ * Please notice that these 171 values correspond to triplets of 57 x,y,v ( v for visibility ) information for each joint.
+ */
+extern const char * const MocapNETInputUncompressedArrayNames[MOCAPNET_UNCOMPRESSED_INPUT_SIZE+1];
+
+
+
+
+/**
+ * @brief This is the size of one dimension of the NSDM matrix. Please note that we create
+ * one NSDM matrix for X coordinates, one for Y coordinates and each matrix is 17x17 so we get
+ * a total number of 17x17x2 = 578 elements.
+ */
+constexpr unsigned int MocapNETInputCompressedArrayIndexesSize = 17;
+
+/**
+ * @brief Number of elements of the NSDM part of the input ( 17x17x2 )
+ */
+#define MOCAPNET_COMPRESSED_INPUT_SIZE 578
+
+/**
+ * @brief Number of elements of the complete MocapNET input, 171 uncompressed values followed by the 578 NSDM values
+ */
+#define MOCAPNET_INPUT_SIZE 749
+
+
+/**
+ * @brief An array of indexes for the construction of the NSDM matrices
+ */
+constexpr unsigned int MocapNETInputCompressedArrayIndexes[MocapNETInputCompressedArrayIndexesSize] =
+{
+  MOCAPNET_UNCOMPRESSED_JOINT_HIP,                        // element 0
+  MOCAPNET_UNCOMPRESSED_JOINT_NECK,                       // element 1
+  MOCAPNET_UNCOMPRESSED_JOINT_HEAD,                       // element 2
+  //--
+  MOCAPNET_UNCOMPRESSED_JOINT_RSHOULDER,                  // element 3
+  MOCAPNET_UNCOMPRESSED_JOINT_RELBOW,                     // element 4
+  MOCAPNET_UNCOMPRESSED_JOINT_RHAND,                      // element 5
+  //--
+  MOCAPNET_UNCOMPRESSED_JOINT_HIP, //SYNTHETIC POINT      // element 6
+  MOCAPNET_UNCOMPRESSED_JOINT_HIP, //SYNTHETIC POINT      // element 7
+  //--
+  MOCAPNET_UNCOMPRESSED_JOINT_LSHOULDER,                  // element 8
+  MOCAPNET_UNCOMPRESSED_JOINT_LELBOW,                     // element 9
+  MOCAPNET_UNCOMPRESSED_JOINT_LHAND,                      // element 10
+  //--
+  MOCAPNET_UNCOMPRESSED_JOINT_RHIP,                       // element 11
+  MOCAPNET_UNCOMPRESSED_JOINT_RKNEE,                      // element 12
+  MOCAPNET_UNCOMPRESSED_JOINT_RFOOT,                      // element 13
+  //--
+  MOCAPNET_UNCOMPRESSED_JOINT_LHIP,                       // element 14
+  MOCAPNET_UNCOMPRESSED_JOINT_LKNEE,                      // element 15
+  MOCAPNET_UNCOMPRESSED_JOINT_LFOOT                       // element 16
+
+};
+
+
+
+
+/**
+ * @brief An array with string labels for what each element of an input should be after concatenating uncompressed and compressed input.
+ */
+extern const char * const MocapNETInputUncompressedAndCompressedArrayNames[MOCAPNET_INPUT_SIZE];
+
+
+
+
+
+
+
+/**
+ * @brief This is a programmer friendly enumerator of joint output extracted from MocapNET.
+ */
+enum MOCAPNET_Output_Joints
+{
+ MOCAPNET_OUTPUT_HIP_XPOSITION=0,
+ MOCAPNET_OUTPUT_HIP_YPOSITION,
+ MOCAPNET_OUTPUT_HIP_ZPOSITION,
+ MOCAPNET_OUTPUT_HIP_ZROTATION,
+ MOCAPNET_OUTPUT_HIP_YROTATION,
+ MOCAPNET_OUTPUT_HIP_XROTATION,
+ MOCAPNET_OUTPUT_ABDOMEN_ZROTATION,
+ MOCAPNET_OUTPUT_ABDOMEN_XROTATION,
+ MOCAPNET_OUTPUT_ABDOMEN_YROTATION,
+ MOCAPNET_OUTPUT_CHEST_ZROTATION,
+ MOCAPNET_OUTPUT_CHEST_XROTATION,
+ MOCAPNET_OUTPUT_CHEST_YROTATION,
+ MOCAPNET_OUTPUT_NECK_ZROTATION,
+ MOCAPNET_OUTPUT_NECK_XROTATION,
+ MOCAPNET_OUTPUT_NECK_YROTATION,
+ MOCAPNET_OUTPUT_HEAD_ZROTATION,
+ MOCAPNET_OUTPUT_HEAD_XROTATION,
+ MOCAPNET_OUTPUT_HEAD_YROTATION,
+ MOCAPNET_OUTPUT_LEFTEYE_ZROTATION,
+ MOCAPNET_OUTPUT_LEFTEYE_XROTATION,
+ MOCAPNET_OUTPUT_LEFTEYE_YROTATION,
+ MOCAPNET_OUTPUT_RIGHTEYE_ZROTATION,
+ MOCAPNET_OUTPUT_RIGHTEYE_XROTATION,
+ MOCAPNET_OUTPUT_RIGHTEYE_YROTATION,
+ MOCAPNET_OUTPUT_RCOLLAR_ZROTATION,
+ MOCAPNET_OUTPUT_RCOLLAR_XROTATION,
+ MOCAPNET_OUTPUT_RCOLLAR_YROTATION,
+ MOCAPNET_OUTPUT_RSHOULDER_ZROTATION,
+ MOCAPNET_OUTPUT_RSHOULDER_XROTATION,
+ MOCAPNET_OUTPUT_RSHOULDER_YROTATION,
+ MOCAPNET_OUTPUT_RELBOW_ZROTATION,
+ MOCAPNET_OUTPUT_RELBOW_XROTATION,
+ MOCAPNET_OUTPUT_RELBOW_YROTATION,
+ MOCAPNET_OUTPUT_RHAND_ZROTATION,
+ MOCAPNET_OUTPUT_RHAND_XROTATION,
+ MOCAPNET_OUTPUT_RHAND_YROTATION,
+ MOCAPNET_OUTPUT_RTHUMB1_ZROTATION,
+ MOCAPNET_OUTPUT_RTHUMB1_XROTATION,
+ MOCAPNET_OUTPUT_RTHUMB1_YROTATION,
+ MOCAPNET_OUTPUT_RTHUMB2_ZROTATION,
+ MOCAPNET_OUTPUT_RTHUMB2_XROTATION,
+ MOCAPNET_OUTPUT_RTHUMB2_YROTATION,
+ MOCAPNET_OUTPUT_RINDEX1_ZROTATION,
+ MOCAPNET_OUTPUT_RINDEX1_XROTATION,
+ MOCAPNET_OUTPUT_RINDEX1_YROTATION,
+ MOCAPNET_OUTPUT_RINDEX2_ZROTATION,
+ MOCAPNET_OUTPUT_RINDEX2_XROTATION,
+ MOCAPNET_OUTPUT_RINDEX2_YROTATION,
+ MOCAPNET_OUTPUT_RMID1_ZROTATION,
+ MOCAPNET_OUTPUT_RMID1_XROTATION,
+ MOCAPNET_OUTPUT_RMID1_YROTATION,
+ MOCAPNET_OUTPUT_RMID2_ZROTATION,
+ MOCAPNET_OUTPUT_RMID2_XROTATION,
+ MOCAPNET_OUTPUT_RMID2_YROTATION,
+ MOCAPNET_OUTPUT_RRING1_ZROTATION,
+ MOCAPNET_OUTPUT_RRING1_XROTATION,
+ MOCAPNET_OUTPUT_RRING1_YROTATION,
+ MOCAPNET_OUTPUT_RRING2_ZROTATION,
+ MOCAPNET_OUTPUT_RRING2_XROTATION,
+ MOCAPNET_OUTPUT_RRING2_YROTATION,
+ MOCAPNET_OUTPUT_RPINKY1_ZROTATION,
+ MOCAPNET_OUTPUT_RPINKY1_XROTATION,
+ MOCAPNET_OUTPUT_RPINKY1_YROTATION,
+ MOCAPNET_OUTPUT_RPINKY2_ZROTATION,
+ MOCAPNET_OUTPUT_RPINKY2_XROTATION,
+ MOCAPNET_OUTPUT_RPINKY2_YROTATION,
+ MOCAPNET_OUTPUT_LCOLLAR_ZROTATION,
+ MOCAPNET_OUTPUT_LCOLLAR_XROTATION,
+ MOCAPNET_OUTPUT_LCOLLAR_YROTATION,
+ MOCAPNET_OUTPUT_LSHOULDER_ZROTATION,
+ MOCAPNET_OUTPUT_LSHOULDER_XROTATION,
+ MOCAPNET_OUTPUT_LSHOULDER_YROTATION,
+ MOCAPNET_OUTPUT_LELBOW_ZROTATION,
+ MOCAPNET_OUTPUT_LELBOW_XROTATION,
+ MOCAPNET_OUTPUT_LELBOW_YROTATION,
+ MOCAPNET_OUTPUT_LHAND_ZROTATION,
+ MOCAPNET_OUTPUT_LHAND_XROTATION,
+ MOCAPNET_OUTPUT_LHAND_YROTATION,
+ MOCAPNET_OUTPUT_LTHUMB1_ZROTATION,
+ MOCAPNET_OUTPUT_LTHUMB1_XROTATION,
+ MOCAPNET_OUTPUT_LTHUMB1_YROTATION,
+ MOCAPNET_OUTPUT_LTHUMB2_ZROTATION,
+ MOCAPNET_OUTPUT_LTHUMB2_XROTATION,
+ MOCAPNET_OUTPUT_LTHUMB2_YROTATION,
+ MOCAPNET_OUTPUT_LINDEX1_ZROTATION,
+ MOCAPNET_OUTPUT_LINDEX1_XROTATION,
+ MOCAPNET_OUTPUT_LINDEX1_YROTATION,
+ MOCAPNET_OUTPUT_LINDEX2_ZROTATION,
+ MOCAPNET_OUTPUT_LINDEX2_XROTATION,
+ MOCAPNET_OUTPUT_LINDEX2_YROTATION,
+ MOCAPNET_OUTPUT_LMID1_ZROTATION,
+ MOCAPNET_OUTPUT_LMID1_XROTATION,
+ MOCAPNET_OUTPUT_LMID1_YROTATION,
+ MOCAPNET_OUTPUT_LMID2_ZROTATION,
+ MOCAPNET_OUTPUT_LMID2_XROTATION,
+ MOCAPNET_OUTPUT_LMID2_YROTATION,
+ MOCAPNET_OUTPUT_LRING1_ZROTATION,
+ MOCAPNET_OUTPUT_LRING1_XROTATION,
+ MOCAPNET_OUTPUT_LRING1_YROTATION,
+ MOCAPNET_OUTPUT_LRING2_ZROTATION,
+ MOCAPNET_OUTPUT_LRING2_XROTATION,
+ MOCAPNET_OUTPUT_LRING2_YROTATION,
+ MOCAPNET_OUTPUT_LPINKY1_ZROTATION,
+ MOCAPNET_OUTPUT_LPINKY1_XROTATION,
+ MOCAPNET_OUTPUT_LPINKY1_YROTATION,
+ MOCAPNET_OUTPUT_LPINKY2_ZROTATION,
+ MOCAPNET_OUTPUT_LPINKY2_XROTATION,
+ MOCAPNET_OUTPUT_LPINKY2_YROTATION,
+ MOCAPNET_OUTPUT_RBUTTOCK_ZROTATION,
+ MOCAPNET_OUTPUT_RBUTTOCK_XROTATION,
+ MOCAPNET_OUTPUT_RBUTTOCK_YROTATION,
+ MOCAPNET_OUTPUT_RHIP_ZROTATION,
+ MOCAPNET_OUTPUT_RHIP_XROTATION,
+ MOCAPNET_OUTPUT_RHIP_YROTATION,
+ MOCAPNET_OUTPUT_RKNEE_ZROTATION,
+ MOCAPNET_OUTPUT_RKNEE_XROTATION,
+ MOCAPNET_OUTPUT_RKNEE_YROTATION,
+ MOCAPNET_OUTPUT_RFOOT_ZROTATION,
+ MOCAPNET_OUTPUT_RFOOT_XROTATION,
+ MOCAPNET_OUTPUT_RFOOT_YROTATION,
+ MOCAPNET_OUTPUT_LBUTTOCK_ZROTATION,
+ MOCAPNET_OUTPUT_LBUTTOCK_XROTATION,
+ MOCAPNET_OUTPUT_LBUTTOCK_YROTATION,
+ MOCAPNET_OUTPUT_LHIP_ZROTATION,
+ MOCAPNET_OUTPUT_LHIP_XROTATION,
+ MOCAPNET_OUTPUT_LHIP_YROTATION,
+ MOCAPNET_OUTPUT_LKNEE_ZROTATION,
+ MOCAPNET_OUTPUT_LKNEE_XROTATION,
+ MOCAPNET_OUTPUT_LKNEE_YROTATION,
+ MOCAPNET_OUTPUT_LFOOT_ZROTATION,
+ MOCAPNET_OUTPUT_LFOOT_XROTATION,
+ MOCAPNET_OUTPUT_LFOOT_YROTATION,
+ //---------------------
+ MOCAPNET_OUTPUT_NUMBER
+};
+
+
+/**
+ * @brief An array with string labels for what each element of an input should be after concatenating uncompressed and compressed input.
+ */
+extern const char * const MocapNETOutputArrayNames[MOCAPNET_OUTPUT_NUMBER];
+
+
+
+/**
+ * @brief Number of joints of the BVH skeleton produced by MocapNET ( including End Sites ), this is also the number of
+ * uncompressed input joints since both follow the same order
+ */
+#define MOCAPNET_BVH_JOINT_NUMBER 57
+
+/**
+ * @brief Number of values of a BVH frame produced by MocapNET
+ */
+#define MOCAPNET_BVH_VALUES_PER_FRAME 132
+
+
+/**
+ * @brief Names of the joints of bvhHeader in order of appearance, End Sites are named EndSite_<parent> like the BVH code does
+ */
+extern const char * const MocapNETBVHJointNames[MOCAPNET_BVH_JOINT_NUMBER];
+
+
+/**
+ * @brief Parent of every joint of bvhHeader, the root is its own parent
+ */
+constexpr unsigned char MocapNETBVHJointParent[MOCAPNET_BVH_JOINT_NUMBER] =
+{
+   0, 0, 1, 2, 3, 4, 5, 4, 7, 2,
+   9,10,11,12,13,14,12,16,17,12,
+  19,20,12,22,23,12,25,26, 2,28,
+  29,30,31,32,33,31,35,36,31,38,
+  39,31,41,42,31,44,45, 0,47,48,
+  49,50, 0,52,53,54,55
+};
+
+
+/**
+ * @brief Index of the first value of every joint in a BVH frame ( and in MocapNETOutputArrayNames )
+ */
+constexpr unsigned char MocapNETBVHJointFirstChannel[MOCAPNET_BVH_JOINT_NUMBER] =
+{
+   0, 6, 9,12,15,18,21,21,24,24,
+  27,30,33,36,39,42,42,45,48,48,
+  51,54,54,57,60,60,63,66,66,69,
+  72,75,78,81,84,84,87,90,90,93,
+  96,96,99,102,102,105,108,108,111,114,
+  117,120,120,123,126,129,132
+};
+
+
+/**
+ * @brief Number of values of every joint in a BVH frame, End Sites have none
+ */
+constexpr unsigned char MocapNETBVHJointNumberOfChannels[MOCAPNET_BVH_JOINT_NUMBER] =
+{
+   6, 3, 3, 3, 3, 3, 0, 3, 0, 3,
+   3, 3, 3, 3, 3, 0, 3, 3, 0, 3,
+   3, 0, 3, 3, 0, 3, 3, 0, 3, 3,
+   3, 3, 3, 3, 0, 3, 3, 0, 3, 3,
+   0, 3, 3, 0, 3, 3, 0, 3, 3, 3,
+   3, 0, 3, 3, 3, 3, 0
+};
+
+
+/**
+ * @brief The children of joint j are MocapNETBVHJointChildren[ MocapNETBVHJointFirstChild[j] ] up to ( excluding ) MocapNETBVHJointChildren[ MocapNETBVHJointFirstChild[j+1] ]
+ */
+constexpr unsigned char MocapNETBVHJointFirstChild[MOCAPNET_BVH_JOINT_NUMBER+1] =
+{
+   0, 3, 4, 7, 8,10,11,11,12,12,
+  13,14,15,20,21,22,22,23,24,24,
+  25,26,26,27,28,28,29,30,30,31,
+  32,33,38,39,40,40,41,42,42,43,
+  44,44,45,46,46,47,48,48,49,50,
+  51,52,52,53,54,55,56,56
+};
+
+
+/**
+ * @brief Children of every joint, grouped by parent, see MocapNETBVHJointFirstChild
+ */
+constexpr unsigned char MocapNETBVHJointChildren[MOCAPNET_BVH_JOINT_NUMBER-1] =
+{
+   1,47,52, 2, 3, 9,28, 4, 5, 7,
+   6, 8,10,11,12,13,16,19,22,25,
+  14,15,17,18,20,21,23,24,26,27,
+  29,30,31,32,35,38,41,44,33,34,
+  36,37,39,40,42,43,45,46,48,49,
+  50,51,53,54,55,56
+};
+
+
+/**
+ * @brief Get the joint ID of a joint of bvhHeader using its name ( as found in MocapNETBVHJointNames ), the comparison is case insensitive.
+ * Lookups use a perfect hash that is built the first time any of the mocapnetRegistryGet calls is used
+ * @param CString with the name of the joint
+ * @param Pointer to an unsigned int that will receive the joint ID
+ * @retval 1=Found/0=Not Found
+ */
+int mocapnetRegistryGetBVHJointID(const char * jointName,unsigned int * jointID);
+
+
+/**
+ * @brief Get the joint ID of an uncompressed input joint using its name ( as found in MocapNETInputUncompressedJointNames ), the comparison is case insensitive
+ * @param CString with the name of the joint
+ * @param Pointer to an unsigned int that will receive the joint ID
+ * @retval 1=Found/0=Not Found
+ */
+int mocapnetRegistryGetInputJointID(const char * jointName,unsigned int * jointID);
+
+
+/**
+ * @brief Get the index of a MocapNET input value using its name ( as found in MocapNETInputUncompressedAndCompressedArrayNames ), the comparison is case insensitive.
+ * Some NSDM labels appear more than once ( the synthetic points are labeled as the hip ), these resolve to their first occurrence
+ * @param CString with the name of the input value
+ * @param Pointer to an unsigned int that will receive the index
+ * @retval 1=Found/0=Not Found
+ */
+int mocapnetRegistryGetInputID(const char * inputName,unsigned int * inputID);
+
+
+/**
+ * @brief Get the index of a BVH channel of the MocapNET output using its name ( as found in MocapNETOutputArrayNames ), the comparison is case insensitive
+ * @param CString with the name of the channel, for example hip_Xrotation
+ * @param Pointer to an unsigned int that will receive the index
+ * @retval 1=Found/0=Not Found
+ */
+int mocapnetRegistryGetOutputChannelID(const char * channelName,unsigned int * channelID);
@@ -0,0 +1,280 @@
+#include "temporalFilter.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MOCAPNET_FILTER_USE_SSE 1
+#endif
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Cutoff frequency of the derivative of the One-Euro filter, the value suggested by its authors
+#define MOCAPNET_FILTER_DEFAULT_DERIVATIVE_CUTOFF 1.0
+#define MOCAPNET_FILTER_ANGLE_PERIOD 360.0
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+/*
+ * Shortest difference taking the period of the channel in to account, channels with no period have an inverse period of 0 and are left alone
+ */
+static inline float wrapDifference(float difference,float period,float inversePeriod)
+{
+    return difference - period * rintf(difference*inversePeriod);
+}
+
+#if MOCAPNET_FILTER_USE_SSE
+static inline __m128 wrapDifference4(__m128 difference,__m128 period,__m128 inversePeriod)
+{
+    //cvtps rounds to nearest just like rintf does with the default rounding mode
+    __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(difference,inversePeriod)));
+    return _mm_sub_ps(difference,_mm_mul_ps(period,turns));
+}
+#endif
+
+
+static int setupFilterBank(struct MocapNETFilterBank * bank,unsigned int type,unsigned int numberOfChannels,unsigned int firstAngleChannel,float framerate)
+{
+    if (bank==0)
+        {
+            return 0;
+        }
+    if ( (numberOfChannels==0) || (numberOfChannels>MOCAPNET_FILTER_MAX_CHANNELS) )
+        {
+            fprintf(stderr,RED "Filter bank cannot handle %u channels ( maximum is %u )\n" NORMAL,numberOfChannels,MOCAPNET_FILTER_MAX_CHANNELS);
+            return 0;
+        }
+    if (framerate<=0.0)
+        {
+            framerate=30.0;
+        }
+
+    memset(bank,0,sizeof(struct MocapNETFilterBank));
+    bank->type=type;
+    bank->numberOfChannels=numberOfChannels;
+    bank->defaultDeltaTime=1.0/framerate;
+    bank->derivativeCutoff=MOCAPNET_FILTER_DEFAULT_DERIVATIVE_CUTOFF;
+
+    for (unsigned int i=firstAngleChannel; i<numberOfChannels; i++)
+        {
+            bank->period[i]=MOCAPNET_FILTER_ANGLE_PERIOD;
+            bank->inversePeriod[i]=1.0/MOCAPNET_FILTER_ANGLE_PERIOD;
+        }
+    return 1;
+}
+
+
+int initializeOneEuroFilterBank(
+    struct MocapNETFilterBank * bank,
+    unsigned int numberOfChannels,
+    unsigned int firstAngleChannel,
+    float framerate,
+    float minCutoff,
+    float beta
+)
+{
+    if (!setupFilterBank(bank,MOCAPNET_FILTER_ONE_EURO,numberOfChannels,firstAngleChannel,framerate))
+        {
+            return 0;
+        }
+    bank->minCutoff = (minCutoff>0.0) ? minCutoff : 1.0;
+    bank->beta = (beta>0.0) ? beta : 0.0;
+    return 1;
+}
+
+
+int initializeCriticallyDampedFilterBank(
+    struct MocapNETFilterBank * bank,
+    unsigned int numberOfChannels,
+    unsigned int firstAngleChannel,
+    float framerate,
+    float smoothTime
+)
+{
+    if (!setupFilterBank(bank,MOCAPNET_FILTER_CRITICALLY_DAMPED,numberOfChannels,firstAngleChannel,framerate))
+        {
+            return 0;
+        }
+    bank->smoothTime = (smoothTime>0.0001) ? smoothTime : 0.0001;
+    return 1;
+}
+
+
+void resetFilterBank(struct MocapNETFilterBank * bank)
+{
+    if (bank!=0)
+        {
+            bank->initialized=0;
+        }
+}
+
+
+/*
+ * One-Euro filter, the smoothing factor of every channel depends on how fast its ( smoothed ) derivative is
+ */
+static void updateOneEuro(struct MocapNETFilterBank * bank,float * values,float deltaTime)
+{
+    const float twoPiDeltaTime = 2.0 * M_PI * deltaTime;
+    const float derivativeRate = twoPiDeltaTime * bank->derivativeCutoff;
+    const float derivativeAlpha = derivativeRate / (derivativeRate+1.0);
+    const float inverseDeltaTime = 1.0 / deltaTime;
+
+    unsigned int i=0;
+#if MOCAPNET_FILTER_USE_SSE
+    const __m128 one = _mm_set1_ps(1.0);
+    const __m128 signMask = _mm_set1_ps(-0.0);
+    const __m128 derivativeAlphaV = _mm_set1_ps(derivativeAlpha);
+    const __m128 inverseDeltaTimeV = _mm_set1_ps(inverseDeltaTime);
+    const __m128 twoPiDeltaTimeV = _mm_set1_ps(twoPiDeltaTime);
+    const __m128 minCutoffV = _mm_set1_ps(bank->minCutoff);
+    const __m128 betaV = _mm_set1_ps(bank->beta);
+    for (i=0; i+4<=bank->numberOfChannels; i+=4)
+        {
+            __m128 x = _mm_loadu_ps(values+i);
+            __m128 value = _mm_loadu_ps(bank->value+i);
+            __m128 derivative = _mm_loadu_ps(bank->derivative+i);
+            __m128 period = _mm_loadu_ps(bank->period+i);
+            __m128 inversePeriod = _mm_loadu_ps(bank->inversePeriod+i);
+
+            __m128 difference = wrapDifference4(_mm_sub_ps(x,value),period,inversePeriod);
+            __m128 rawDerivative = _mm_mul_ps(difference,inverseDeltaTimeV);
+            derivative = _mm_add_ps(derivative,_mm_mul_ps(derivativeAlphaV,_mm_sub_ps(rawDerivative,derivative)));
+
+            __m128 cutoff = _mm_add_ps(minCutoffV,_mm_mul_ps(betaV,_mm_andnot_ps(signMask,derivative)));
+            __m128 rate = _mm_mul_ps(twoPiDeltaTimeV,cutoff);
+            __m128 alpha = _mm_div_ps(rate,_mm_add_ps(rate,one));
+            value = _mm_add_ps(value,_mm_mul_ps(alpha,difference));
+            //Bring the result next to the input so angles wrap the same way
+            value = _mm_add_ps(x,wrapDifference4(_mm_sub_ps(value,x),period,inversePeriod));
+
+            _mm_storeu_ps(bank->derivative+i,derivative);
+            _mm_storeu_ps(bank->value+i,value);
+            _mm_storeu_ps(values+i,value);
+        }
+#endif
+    for (; i<bank->numberOfChannels; i++)
+        {
+            float x = values[i];
+            float difference = wrapDifference(x - bank->value[i],bank->period[i],bank->inversePeriod[i]);
+            bank->derivative[i] += derivativeAlpha * (difference*inverseDeltaTime - bank->derivative[i]);
+
+            float cutoff = bank->minCutoff + bank->beta * fabsf(bank->derivative[i]);
+            float rate = twoPiDeltaTime * cutoff;
+            float alpha = rate / (rate+1.0);
+            float value = bank->value[i] + alpha * difference;
+            value = x + wrapDifference(value - x,bank->period[i],bank->inversePeriod[i]);
+
+            bank->value[i]=value;
+            values[i]=value;
+        }
+}
+
+
+/*
+ * Critically damped spring following every channel, closed form step from Game Programming Gems 4 ( 1.10 )
+ */
+static void updateCriticallyDamped(struct MocapNETFilterBank * bank,float * values,float deltaTime)
+{
+    const float omega = 2.0 / bank->smoothTime;
+    const float omegaDeltaTime = omega * deltaTime;
+    const float decay = 1.0 / (1.0 + omegaDeltaTime + 0.48*omegaDeltaTime*omegaDeltaTime + 0.235*omegaDeltaTime*omegaDeltaTime*omegaDeltaTime);
+
+    unsigned int i=0;
+#if MOCAPNET_FILTER_USE_SSE
+    const __m128 omegaV = _mm_set1_ps(omega);
+    const __m128 deltaTimeV = _mm_set1_ps(deltaTime);
+    const __m128 decayV = _mm_set1_ps(decay);
+    for (i=0; i+4<=bank->numberOfChannels; i+=4)
+        {
+            __m128 x = _mm_loadu_ps(values+i);
+            __m128 value = _mm_loadu_ps(bank->value+i);
+            __m128 velocity = _mm_loadu_ps(bank->derivative+i);
+            __m128 period = _mm_loadu_ps(bank->period+i);
+            __m128 inversePeriod = _mm_loadu_ps(bank->inversePeriod+i);
+
+            __m128 change = wrapDifference4(_mm_sub_ps(value,x),period,inversePeriod);
+            __m128 temp = _mm_mul_ps(_mm_add_ps(velocity,_mm_mul_ps(omegaV,change)),deltaTimeV);
+            velocity = _mm_mul_ps(_mm_sub_ps(velocity,_mm_mul_ps(omegaV,temp)),decayV);
+            value = _mm_add_ps(x,_mm_mul_ps(_mm_add_ps(change,temp),decayV));
+
+            _mm_storeu_ps(bank->derivative+i,velocity);
+            _mm_storeu_ps(bank->value+i,value);
+            _mm_storeu_ps(values+i,value);
+        }
+#endif
+    for (; i<bank->numberOfChannels; i++)
+        {
+            float x = values[i];
+            float change = wrapDifference(bank->value[i] - x,bank->period[i],bank->inversePeriod[i]);
+            float temp = (bank->derivative[i] + omega*change) * deltaTime;
+            bank->derivative[i] = (bank->derivative[i] - omega*temp) * decay;
+            float value = x + (change + temp) * decay;
+
+            bank->value[i]=value;
+            values[i]=value;
+        }
+}
+
+
+int filterBankUpdate(struct MocapNETFilterBank * bank,float * values,unsigned int numberOfValues,float deltaTime)
+{
+    if ( (bank==0) || (values==0) )
+        {
+            return 0;
+        }
+    if (numberOfValues!=bank->numberOfChannels)
+        {
+            fprintf(stderr,YELLOW "Filter bank expects %u values and got %u, ignoring frame\n" NORMAL,bank->numberOfChannels,numberOfValues);
+            return 0;
+        }
+    if (bank->type==MOCAPNET_FILTER_NONE)
+        {
+            return 1;
+        }
+
+    if (!bank->initialized)
+        {
+            memcpy(bank->value,values,sizeof(float)*numberOfValues);
+            memset(bank->derivative,0,sizeof(float)*numberOfValues);
+            bank->initialized=1;
+            return 1;
+        }
+
+    if (deltaTime<=0.0)
+        {
+            deltaTime=bank->defaultDeltaTime;
+        }
+
+    switch (bank->type)
+        {
+        case MOCAPNET_FILTER_ONE_EURO:
+            updateOneEuro(bank,values,deltaTime);
+            break;
+        case MOCAPNET_FILTER_CRITICALLY_DAMPED:
+            updateCriticallyDamped(bank,values,deltaTime);
+            break;
+        default:
+            fprintf(stderr,RED "Unknown filter type %u\n" NORMAL,bank->type);
+            return 0;
+        }
+    return 1;
+}
+
+
+int filterBankUpdateVector(struct MocapNETFilterBank * bank,std::vector<float> & values,float deltaTime)
+{
+    if (values.size()==0)
+        {
+            return 0;
+        }
+    return filterBankUpdate(bank,values.data(),values.size(),deltaTime);
+}
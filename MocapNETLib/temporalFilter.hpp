@@ -0,0 +1,125 @@
+#pragma once
+/** @file temporalFilter.hpp
+ *  @brief A bank of streaming filters that smooth every channel of consecutive BVH frames ( or any other vector of values ) in place.
+ *  Two filters are available, the One-Euro filter ( Casiez et al. CHI 2012 ) that adapts its cutoff frequency to the speed of every channel so
+ *  slow motion is smoothed a lot while fast motion has little lag, and a critically damped spring that follows every channel without overshooting.
+ *  Rotation channels are treated as angles in degrees so a channel jumping from 179 to -179 is a 2 degree step and not a 358 degree one.
+ *  The state lives in fixed size arrays inside the structure so updating never allocates memory, and 4 channels are updated at a time using SSE
+ *  when it is available.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include <vector>
+
+/**
+ * @brief Maximum number of channels a filter bank can smooth
+ */
+#define MOCAPNET_FILTER_MAX_CHANNELS 512
+
+
+/**
+ * @brief The filters a filter bank can use
+ */
+enum MocapNETFilterType
+{
+    MOCAPNET_FILTER_NONE=0,
+    MOCAPNET_FILTER_ONE_EURO,
+    MOCAPNET_FILTER_CRITICALLY_DAMPED
+};
+
+
+/**
+ * @brief The state of a filter bank, all channels share the same filter and parameters
+ */
+struct MocapNETFilterBank
+{
+    unsigned int type;
+    unsigned int numberOfChannels;
+    //Default time between two updates in seconds ( 1 / framerate )
+    float defaultDeltaTime;
+
+    //One-Euro parameters
+    float minCutoff;
+    float beta;
+    float derivativeCutoff;
+    //Critically damped parameter, time in seconds it takes to catch up with a step
+    float smoothTime;
+
+    //0 until the first frame is seen, the first frame is passed through unchanged
+    int initialized;
+
+    //Period of every channel ( 360 for angles, 0 for everything else ) and its inverse
+    float period[MOCAPNET_FILTER_MAX_CHANNELS];
+    float inversePeriod[MOCAPNET_FILTER_MAX_CHANNELS];
+    //Filtered value of every channel, angles are kept next to the latest input so they wrap the same way it does
+    float value[MOCAPNET_FILTER_MAX_CHANNELS];
+    //Filtered derivative ( One-Euro ) or velocity ( critically damped ) of every channel
+    float derivative[MOCAPNET_FILTER_MAX_CHANNELS];
+};
+
+
+/**
+ * @brief Set up a One-Euro filter bank
+ * @ingroup mocapnet
+ * @param Pointer to the filter bank
+ * @param Number of channels, at most MOCAPNET_FILTER_MAX_CHANNELS
+ * @param Channels from this one onward are angles in degrees ( MOCAPNET_OUTPUT_HIP_ZROTATION for MocapNET output ), use numberOfChannels if there are none
+ * @param Expected framerate, used when an update does not give the time since the previous one
+ * @param Minimum cutoff frequency in Hz, smaller means smoother when still
+ * @param Speed coefficient, bigger means less lag when moving fast
+ * @retval 1 = Success , 0 = Failure
+ */
+int initializeOneEuroFilterBank(
+                                 struct MocapNETFilterBank * bank,
+                                 unsigned int numberOfChannels,
+                                 unsigned int firstAngleChannel,
+                                 float framerate,
+                                 float minCutoff,
+                                 float beta
+                               );
+
+/**
+ * @brief Set up a critically damped filter bank
+ * @ingroup mocapnet
+ * @param Pointer to the filter bank
+ * @param Number of channels, at most MOCAPNET_FILTER_MAX_CHANNELS
+ * @param Channels from this one onward are angles in degrees ( MOCAPNET_OUTPUT_HIP_ZROTATION for MocapNET output ), use numberOfChannels if there are none
+ * @param Expected framerate, used when an update does not give the time since the previous one
+ * @param Time in seconds the filter needs to catch up with a step, bigger means smoother
+ * @retval 1 = Success , 0 = Failure
+ */
+int initializeCriticallyDampedFilterBank(
+                                          struct MocapNETFilterBank * bank,
+                                          unsigned int numberOfChannels,
+                                          unsigned int firstAngleChannel,
+                                          float framerate,
+                                          float smoothTime
+                                        );
+
+/**
+ * @brief Forget the history of a filter bank, the next frame is passed through unchanged ( i.e. after a cut or when tracking was lost )
+ * @ingroup mocapnet
+ * @param Pointer to the filter bank
+ */
+void resetFilterBank(struct MocapNETFilterBank * bank);
+
+/**
+ * @brief Smooth a new frame in place
+ * @ingroup mocapnet
+ * @param Pointer to the filter bank
+ * @param The values of the new frame, they are replaced by the smoothed ones
+ * @param Number of values, has to be the number of channels of the bank
+ * @param Seconds since the previous frame, 0 uses the framerate given on initialization
+ * @retval 1 = Success , 0 = Failure ( nothing is changed )
+ */
+int filterBankUpdate(struct MocapNETFilterBank * bank,float * values,unsigned int numberOfValues,float deltaTime);
+
+/**
+ * @brief Same as filterBankUpdate for a std::vector, empty vectors ( failed frames ) are left alone and do not touch the filter state
+ * @ingroup mocapnet
+ * @param Pointer to the filter bank
+ * @param The values of the new frame, they are replaced by the smoothed ones
+ * @param Seconds since the previous frame, 0 uses the framerate given on initialization
+ * @retval 1 = Success , 0 = Failure ( nothing is changed )
+ */
+int filterBankUpdateVector(struct MocapNETFilterBank * bank,std::vector<float> & values,float deltaTime);
@@ -5,6 +5,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 
 unsigned long tickBaseMN = 0;
@@ -61,11 +62,229 @@ unsigned long GetTickCountMillisecondsMN()
 
 
 
+//Largest number of bytes we are willing to look through to find the dimensions of an image
+#define IMAGE_HEADER_PROBE_LIMIT 65536
+
+
+static unsigned int readBigEndian16(const unsigned char * data)
+{
+    return (data[0]<<8) | data[1];
+}
+
+static unsigned int readBigEndian32(const unsigned char * data)
+{
+    return ((unsigned int) data[0]<<24) | (data[1]<<16) | (data[2]<<8) | data[3];
+}
+
+static unsigned int readLittleEndian16(const unsigned char * data)
+{
+    return data[0] | (data[1]<<8);
+}
+
+static unsigned int readLittleEndian32(const unsigned char * data)
+{
+    return data[0] | (data[1]<<8) | (data[2]<<16) | ((unsigned int) data[3]<<24);
+}
+
+
+/**
+ * @brief Walk the markers of a JPEG file skipping their payload until a start of frame marker that holds the dimensions
+ * @retval 1=Success/0=Failure
+ */
+static int getJPEGWidthHeight(FILE * fp,unsigned int * width , unsigned int * height)
+{
+    unsigned char segment[7];
+    long position = 2; //After the SOI marker
+
+    while (position<IMAGE_HEADER_PROBE_LIMIT)
+        {
+            if ( (fseek(fp,position,SEEK_SET)!=0) || (fread(segment,1,2,fp)!=2) || (segment[0]!=0xFF) )
+                {
+                    return 0;
+                }
+            unsigned char marker = segment[1];
+            if (marker==0xFF)
+                {
+                    //Fill byte
+                    position+=1;
+                    continue;
+                }
+            if ( (marker==0x01) || ( (marker>=0xD0) && (marker<=0xD7) ) )
+                {
+                    //Markers without payload
+                    position+=2;
+                    continue;
+                }
+            if ( (marker==0xD9) || (marker==0xDA) )
+                {
+                    //End of image or start of scan without a frame header
+                    return 0;
+                }
+
+            unsigned int segmentBytes = fread(segment,1,7,fp);
+            if (segmentBytes<2)
+                {
+                    return 0;
+                }
+            unsigned int length = readBigEndian16(segment);
+            if (length<2)
+                {
+                    return 0;
+                }
+
+            //SOF0-SOF15 except DHT ( C4 ) , JPG ( C8 ) and DAC ( CC )
+            if ( (marker>=0xC0) && (marker<=0xCF) && (marker!=0xC4) && (marker!=0xC8) && (marker!=0xCC) )
+                {
+                    if ( (length<7) || (segmentBytes<7) )
+                        {
+                            return 0;
+                        }
+                    *height = readBigEndian16(segment+3);
+                    *width  = readBigEndian16(segment+5);
+                    return ( (*width!=0) && (*height!=0) );
+                }
+            position+=2+length;
+        }
+    return 0;
+}
+
+
+/**
+ * @brief Read the dimensions of a PPM/PGM/PBM file from its plain text header
+ * @retval 1=Success/0=Failure
+ */
+static int getPNMWidthHeight(const unsigned char * data,unsigned int length,unsigned int * width , unsigned int * height)
+{
+    unsigned int values[2]= {0};
+    unsigned int numberOfValues=0;
+    unsigned int i=2; //After the P1-P7 magic number
+
+    while ( (i<length) && (numberOfValues<2) )
+        {
+            if (data[i]=='#')
+                {
+                    while ( (i<length) && (data[i]!='\n') && (data[i]!='\r') )
+                        {
+                            ++i;
+                        }
+                }
+            else if ( (data[i]>='0') && (data[i]<='9') )
+                {
+                    unsigned long value=0;
+                    while ( (i<length) && (data[i]>='0') && (data[i]<='9') && (value<=0xFFFFFFFF) )
+                        {
+                            value = value*10 + (data[i]-'0');
+                            ++i;
+                        }
+                    //A number that runs to the end of what we read might be cut short
+                    if ( (i>=length) || (value>0xFFFFFFFF) )
+                        {
+                            return 0;
+                        }
+                    values[numberOfValues++] = (unsigned int) value;
+                }
+            else if ( (data[i]==' ') || (data[i]=='\t') || (data[i]=='\n') || (data[i]=='\r') )
+                {
+                    ++i;
+                }
+            else
+                {
+                    return 0;
+                }
+        }
+
+    if ( (numberOfValues==2) && (values[0]!=0) && (values[1]!=0) )
+        {
+            *width  = values[0];
+            *height = values[1];
+            return 1;
+        }
+    return 0;
+}
+
+
+/**
+ * @brief Get the dimensions of a JPEG, PNG, BMP or PPM/PGM/PBM image by reading its header
+ * @retval 1=Success/0=Failure ( including formats we don't understand )
+ */
+static int getImageWidthHeightFromHeader(FILE * fp,unsigned int * width , unsigned int * height)
+{
+    unsigned char header[512];
+    unsigned int length = fread(header,1,512,fp);
+    if (length<4)
+        {
+            return 0;
+        }
+
+    //JPEG
+    if ( (header[0]==0xFF) && (header[1]==0xD8) && (header[2]==0xFF) )
+        {
+            return getJPEGWidthHeight(fp,width,height);
+        }
+
+    //PNG, the IHDR chunk always comes first
+    if ( (length>=24) && (memcmp(header,"\x89PNG\r\n\x1a\n",8)==0) && (memcmp(header+12,"IHDR",4)==0) )
+        {
+            *width  = readBigEndian32(header+16);
+            *height = readBigEndian32(header+20);
+            return ( (*width!=0) && (*height!=0) );
+        }
+
+    //BMP, old OS/2 headers have 16 bit dimensions while the rest have 32 bit ones and a negative height for top-down images
+    if ( (length>=26) && (header[0]=='B') && (header[1]=='M') )
+        {
+            unsigned int headerSize = readLittleEndian32(header+14);
+            if (headerSize==12)
+                {
+                    *width  = readLittleEndian16(header+18);
+                    *height = readLittleEndian16(header+20);
+                }
+            else
+                {
+                    int signedWidth  = (int) readLittleEndian32(header+18);
+                    int signedHeight = (int) readLittleEndian32(header+22);
+                    if (signedWidth<=0)
+                        {
+                            return 0;
+                        }
+                    *width  = (unsigned int) signedWidth;
+                    *height = (signedHeight<0) ? (unsigned int) -signedHeight : (unsigned int) signedHeight;
+                }
+            return ( (*width!=0) && (*height!=0) );
+        }
+
+    //PPM/PGM/PBM
+    if ( (header[0]=='P') && (header[1]>='1') && (header[1]<='6') )
+        {
+            return getPNMWidthHeight(header,length,width,height);
+        }
+
+    return 0;
+}
+
+
 int getImageWidthHeight(const char * filename,unsigned int * width , unsigned int * height)
 {
     unsigned int retrievedWidth=0;
     unsigned int retrievedHeight=0;
 
+    //Reading the header ourselves avoids starting two processes and needing ImageMagick for the common formats
+    FILE * fp = fopen(filename,"rb");
+    if (fp==0)
+        {
+            return 0;
+        }
+    int recognized = getImageWidthHeightFromHeader(fp,&retrievedWidth,&retrievedHeight);
+    fclose(fp);
+
+    if (recognized)
+        {
+            *width  = retrievedWidth;
+            *height = retrievedHeight;
+            return 1;
+        }
+
+    //Anything else is left to the identify tool
     char commandToExecute[1024]= {0};
     char result[1024]= {0};
     int  results=0;
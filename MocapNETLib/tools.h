@@ -37,7 +37,7 @@ unsigned long GetTickCountMillisecondsMN();
 
 
 /**
- * @brief Get the dimensions of an image by relying on the identify tool
+ * @brief Get the dimensions of an image, JPEG, PNG, BMP and PPM/PGM/PBM headers are read directly and other formats rely on the identify tool
  * @ingroup tools
  * @param CString with path to the image file to get dimensions for
  * @param Pointer to an unsigned int that will hold the width of the image file we specified
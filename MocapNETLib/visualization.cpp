@@ -6,6 +6,7 @@ using namespace cv;
 #include "jsonCocoSkeleton.h"
 #include "visualization.hpp"
 #include "bvh.hpp"
+#include "instrumentation.hpp"
 #include "../MocapNETLib/mocapnet.hpp"
 
 
@@ -19,6 +20,56 @@ using namespace cv;
 
 
 #if USE_OPENCV
+/*
+ * Draw the NSDM color boxes, the matrices are interleaved X,Y values ( see compressMocapNETInput )
+ */
+static void drawNSDMBoxes(
+    cv::Mat &img,
+    const float * NSDM,
+    unsigned int NSDMSize,
+    unsigned int x,
+    unsigned int y,
+    unsigned int width,
+    unsigned int height
+)
+{
+    float thickness=1;
+    unsigned int xI,yI,item=0,dim=sqrt(NSDMSize/2);
+    if (dim==0)
+        {
+            return;
+        }
+    unsigned int boxX=width/dim,boxY=height/dim;
+    for (yI=0; yI<dim; yI++)
+        {
+            for (xI=0; xI<dim; xI++)
+                {
+                    cv::Point topLeft(x+xI*boxX,y+yI*boxY);
+                    cv::Point bottomRight(x+xI*boxX+boxX,y+yI*boxY+boxY);
+
+                    float blueChannel=(float) NSDM[item]*255.0;
+                    float greenChannel=(float) NSDM[item+1]*255.0;
+                    float redChannel=(float) 255.0 * ( (NSDM[item]==0.0) && (NSDM[item+1]==0.0) );
+
+                    cv::rectangle(
+                        img,
+                        topLeft,
+                        bottomRight,
+                        cv::Scalar(
+                            blueChannel,
+                            greenChannel,
+                            redChannel
+                        ),
+                        -1*thickness,
+                        8,
+                        0
+                    );
+                    item+=2;
+                }
+        }
+}
+
+
 int visualizeNSDM(
     cv::Mat &img,
     std::vector<float> mocapNETInput,
@@ -28,61 +79,80 @@ int visualizeNSDM(
     unsigned int height
 )
 {
-    float thickness=2.5;
-    cv::Point topLeft(x,y);
-    cv::Point bottomRight(x+width,y+height);
-    //cv::line(img,topLeft,bottomRight, cv::Scalar(0,255,0),thickness);
-    //cv::rectangle(img, topLeft,bottomRight, cv::Scalar(0,255,0),thickness, 8, 0);
-
     int addSyntheticPoints=1;
     int doScaleCompensation=0;
     std::vector<float> NSDM = compressMocapNETInput(mocapNETInput,addSyntheticPoints,doScaleCompensation);
 
     if (NSDM.size()>0)
         {
-
             float thickness=1;
             int fontUsed=cv::FONT_HERSHEY_SIMPLEX;
             cv::Scalar color= cv::Scalar(123,123,123,123 /*Transparency here , although if the cv::Mat does not have an alpha channel it is useless*/);
             cv::Point txtPosition(x,y-15);
             cv::putText(img,"NSDM",txtPosition,fontUsed,0.8,color,thickness,8);
 
-
-            unsigned int xI,yI,item=0,dim=sqrt(NSDM.size()/2);
-            unsigned int boxX=width/dim,boxY=height/dim;
-            for (yI=0; yI<dim; yI++)
-                {
-                    for (xI=0; xI<dim; xI++)
-                        {
-                            cv::Point topLeft(x+xI*boxX,y+yI*boxY);
-                            cv::Point bottomRight(x+xI*boxX+boxX,y+yI*boxY+boxY);
-
-                            float blueChannel=(float) NSDM[item]*255.0;
-                            float greenChannel=(float) NSDM[item+1]*255.0;
-                            float redChannel=(float) 255.0 * ( (NSDM[item]==0.0) && (NSDM[item+1]==0.0) );
-
-                            cv::rectangle(
-                                img,
-                                topLeft,
-                                bottomRight,
-                                cv::Scalar(
-                                    blueChannel,
-                                    greenChannel,
-                                    redChannel
-                                ),
-                                -1*thickness,
-                                8,
-                                0
-                            );
-                            item+=2;
-                        }
-                }
+            drawNSDMBoxes(img,NSDM.data(),NSDM.size(),x,y,width,height);
+            return 1;
         }
+    return 0;
 }
 
 
 
 
+/*
+ * The floor only depends on the trackbar controlled orientation and the window size which almost never change,
+ * so both its projected points and a rendered image of it are kept around until one of them changes
+ */
+struct FloorCache
+{
+    int valid;
+    float roll,pitch,yaw;
+    unsigned int floorDimension;
+    unsigned int width,height;
+    std::vector<std::vector<float> > gridPoints2D;
+    int haveLayer;
+    cv::Mat layer;
+};
+static thread_local struct FloorCache floorCache;
+
+
+static const std::vector<std::vector<float> > & getFloorGridPoints(
+    float roll,
+    float pitch,
+    float yaw,
+    unsigned int floorDimension,
+    unsigned int width,
+    unsigned int height
+)
+{
+    if (
+         (!floorCache.valid) ||
+         (floorCache.roll!=roll) || (floorCache.pitch!=pitch) || (floorCache.yaw!=yaw) ||
+         (floorCache.floorDimension!=floorDimension) || (floorCache.width!=width) || (floorCache.height!=height)
+       )
+        {
+            floorCache.gridPoints2D = convert3DGridTo2DPoints(
+                                          roll,
+                                          pitch,
+                                          yaw,
+                                          width,
+                                          height,
+                                          floorDimension
+                                      );
+            floorCache.roll=roll;
+            floorCache.pitch=pitch;
+            floorCache.yaw=yaw;
+            floorCache.floorDimension=floorDimension;
+            floorCache.width=width;
+            floorCache.height=height;
+            floorCache.valid=1;
+            floorCache.haveLayer=0;
+        }
+    return floorCache.gridPoints2D;
+}
+
+
 int drawFloorFromPrimitives(
     cv::Mat &img,
     float roll,
@@ -93,14 +163,20 @@ int drawFloorFromPrimitives(
     unsigned int height
 )
 {
-    std::vector<std::vector<float> > gridPoints2D = convert3DGridTo2DPoints(
+    const std::vector<std::vector<float> > & gridPoints2D = getFloorGridPoints(
                 roll,
                 pitch,
                 yaw,
+                floorDimension,
                 width,
-                height,
-                floorDimension
+                height
             );
+    if (gridPoints2D.size()==0)
+        {
+            //Nothing to draw ( i.e. the BVH code that projects the grid is not compiled in )
+            return 0;
+        }
+
     cv::Point parentPoint(gridPoints2D[0][0],gridPoints2D[0][1]);
     cv::Point verticalPoint(gridPoints2D[0][0],gridPoints2D[0][1]);
     for (int jointID=0; jointID<gridPoints2D.size(); jointID++)
@@ -138,6 +214,34 @@ int drawFloorFromPrimitives(
                 }
             parentPoint = jointPoint;
         }
+    return 1;
+}
+
+
+/*
+ * A black width x height image with the floor already drawn on it, copying it is much cheaper than drawing the ~800 floor primitives
+ * every frame. The returned image is shared, callers must copy it before drawing on it.
+ */
+static const cv::Mat & getFloorLayer(
+    float roll,
+    float pitch,
+    float yaw,
+    unsigned int floorDimension,
+    unsigned int width,
+    unsigned int height
+)
+{
+    //This also invalidates the layer if the grid has to be projected again
+    getFloorGridPoints(roll,pitch,yaw,floorDimension,width,height);
+
+    if ( (!floorCache.haveLayer) || (floorCache.layer.cols!=width) || (floorCache.layer.rows!=height) )
+        {
+            floorCache.layer.create(height,width,CV_8UC3);
+            floorCache.layer.setTo(Scalar(0,0,0));
+            drawFloorFromPrimitives(floorCache.layer,roll,pitch,yaw,floorDimension,width,height);
+            floorCache.haveLayer=1;
+        }
+    return floorCache.layer;
 }
 
 
@@ -218,101 +322,211 @@ int visualizeSkeletonCorrespondence(
 
 
 
-int visualizePoints(
-    const char* windowName,
-    unsigned int frameNumber,
-    unsigned int skippedFrames,
-    signed int totalNumberOfFrames,
-    unsigned int numberOfFramesToGrab,
-    int drawFloor,
-    int drawNSDM,
-    float fpsTotal,
-    float fpsAcquisition,
-    float joint2DEstimator,
-    float fpsMocapNET,
-    unsigned int width,
-    unsigned int height,
-    unsigned int handleMessages,
-    std::vector<float> mocapNETInput,
-    std::vector<float> mocapNETOutput,
-    std::vector<float> mocapNETOutputWithGUIForcedView,
-    std::vector<std::vector<float> > points2DInput,
-    std::vector<std::vector<float> > points2DOutput,
-    std::vector<std::vector<float> > points2DOutputGUIForcedView
-)
-{
 #if USE_OPENCV
-    if (mocapNETOutput.size()==0)
+/*
+ * Everything a visualizer keeps between frames. The canvas and background are allocated once, the background holds
+ * the parts of the picture that only change when the GUI settings change ( floor, static labels ) and is copied
+ * over the canvas at the start of every frame.
+ */
+struct MocapNETVisualizer
+{
+    char windowName[256];
+    unsigned int width;
+    unsigned int height;
+    cv::Mat canvas;
+    cv::Mat background;
+    //What the background was rendered for
+    int haveBackground;
+    int backgroundDrawFloor;
+    int backgroundDrawNSDM;
+    float backgroundRoll,backgroundPitch,backgroundYaw;
+    unsigned int backgroundNumberOfFramesToGrab;
+    //Joint labels are formatted once
+    unsigned int numberOfJointLabels;
+    char jointLabel[MOCAPNET_BVH_JOINT_NUMBER][64];
+    //Scratch space for the NSDM when it is not given precomputed
+    float NSDM[MOCAPNET_COMPRESSED_INPUT_SIZE];
+};
+
+
+struct MocapNETVisualizer * createVisualizer(const char * windowName,unsigned int width,unsigned int height)
+{
+    if ( (width==0) || (height==0) )
         {
-            fprintf(stderr,YELLOW "Won't visualize empty neural network output for frame %u\n" NORMAL,frameNumber);
             return 0;
         }
+    struct MocapNETVisualizer * vis = new struct MocapNETVisualizer;
+    snprintf(vis->windowName,256,"%s",(windowName!=0) ? windowName : "3D Points Output");
+    vis->width=width;
+    vis->height=height;
+    vis->canvas.create(height,width,CV_8UC3);
+    vis->background.create(height,width,CV_8UC3);
+    vis->haveBackground=0;
+    vis->numberOfJointLabels=0;
+    return vis;
+}
 
-    char textInfo[512];
 
-    //std::vector<std::vector<float> > points2D = convertBVHFrameTo2DPoints(mocapNETOutput,width,height);
-    cv::Mat img(height,width, CV_8UC3, Scalar(0,0,0));
+int destroyVisualizer(struct MocapNETVisualizer * vis)
+{
+    if (vis==0)
+        {
+            return 0;
+        }
+    delete vis;
+    return 1;
+}
 
 
+const cv::Mat * getVisualizerCanvas(struct MocapNETVisualizer * vis)
+{
+    if (vis==0)
+        {
+            return 0;
+        }
+    return &vis->canvas;
+}
+
+
+static void updateVisualizerBackground(
+    struct MocapNETVisualizer * vis,
+    int drawFloor,
+    int drawNSDM,
+    float roll,
+    float pitch,
+    float yaw,
+    unsigned int numberOfFramesToGrab
+)
+{
+    if (
+         (vis->haveBackground) &&
+         (vis->backgroundDrawFloor==drawFloor) && (vis->backgroundDrawNSDM==drawNSDM) &&
+         ( (!drawFloor) || ( (vis->backgroundRoll==roll) && (vis->backgroundPitch==pitch) && (vis->backgroundYaw==yaw) ) ) &&
+         (vis->backgroundNumberOfFramesToGrab==numberOfFramesToGrab)
+       )
+        {
+            return;
+        }
 
-//------------------------------------------------------------------------------------------
-//Draw floor
-//------------------------------------------------------------------------------------------
     if (drawFloor)
         {
             unsigned int floorDimension=20;
-            drawFloorFromPrimitives(
-                img,
-                mocapNETOutputWithGUIForcedView[3],
-                mocapNETOutputWithGUIForcedView[4],
-                mocapNETOutputWithGUIForcedView[5],
-                floorDimension,
-                width,
-                height
-            );
+            getFloorLayer(roll,pitch,yaw,floorDimension,vis->width,vis->height).copyTo(vis->background);
+        }
+    else
+        {
+            vis->background.setTo(Scalar(0,0,0));
         }
-//------------------------------------------------------------------------------------------
-
-
 
-//---------------------------------------------------------------------------------------------------------------------
-//   Draw correspondance, post processing step to see if output is good
-//---------------------------------------------------------------------------------------------------------------------
-    int visualizeCorrespondence=0;
+    char textInfo[512];
+    float thickness=1;
+    int fontUsed=cv::FONT_HERSHEY_SIMPLEX;
+    cv::Scalar color= cv::Scalar(123,123,123,123 /*Transparency here , although if the cv::Mat does not have an alpha channel it is useless*/);
+    cv::Point txtPosition(20,50);
+    if (numberOfFramesToGrab>0)
+        {
+            snprintf(textInfo,512,"Grabber will stop after collecting  %u frames",numberOfFramesToGrab);
+        }
+    else
+        {
+            snprintf(textInfo,512,"Live mode, looping forever will not produce a bvh file");
+        }
+    cv::putText(vis->background,textInfo,txtPosition,fontUsed,0.8,color,thickness,8);
 
-    if (visualizeCorrespondence)
+    if (drawNSDM)
         {
-            visualizeSkeletonCorrespondence(
-                img,
-                points2DInput,
-                points2DOutput,
-                0, //X
-                0, //Y
-                width,
-                height
-            );
+            cv::Point nsdmTitlePosition(20,400-15);
+            cv::putText(vis->background,"NSDM",nsdmTitlePosition,fontUsed,0.8,color,thickness,8);
         }
-//----------------------------------------------------------------------------------------------------------------------
+
+    vis->backgroundDrawFloor=drawFloor;
+    vis->backgroundDrawNSDM=drawNSDM;
+    vis->backgroundRoll=roll;
+    vis->backgroundPitch=pitch;
+    vis->backgroundYaw=yaw;
+    vis->backgroundNumberOfFramesToGrab=numberOfFramesToGrab;
+    vis->haveBackground=1;
+}
 
 
+int visualizerDrawFrame(
+    struct MocapNETVisualizer * vis,
+    unsigned int frameNumber,
+    unsigned int skippedFrames,
+    signed int totalNumberOfFrames,
+    unsigned int numberOfFramesToGrab,
+    int drawFloor,
+    int drawNSDM,
+    float fpsTotal,
+    float fpsAcquisition,
+    float joint2DEstimator,
+    float fpsMocapNET,
+    const std::vector<float> &mocapNETInput,
+    const std::vector<float> &mocapNETOutput,
+    const std::vector<float> &mocapNETOutputWithGUIForcedView,
+    const std::vector<std::vector<float> > &points2DOutputGUIForcedView,
+    const float * precomputedNSDM,
+    unsigned int precomputedNSDMSize
+)
+{
+    if (vis==0)
+        {
+            return 0;
+        }
+    if ( (mocapNETOutput.size()==0) || (mocapNETOutputWithGUIForcedView.size()<6) )
+        {
+            fprintf(stderr,YELLOW "Won't visualize empty neural network output for frame %u\n" NORMAL,frameNumber);
+            return 0;
+        }
     if (points2DOutputGUIForcedView.size()==0)
         {
             fprintf(stderr,"Can't visualize empty 2D projected points for frame %u ..\n",frameNumber);
             return 0;
         }
-//fprintf(stderr,"visualizePoints %u points\n",points2DOutputGUIForcedView.size());
+    unsigned long renderStart = startStageTimer();
+
+    //Static layer, only redrawn when the settings it depends on change
+    updateVisualizerBackground(
+        vis,
+        drawFloor,
+        drawNSDM,
+        mocapNETOutputWithGUIForcedView[3],
+        mocapNETOutputWithGUIForcedView[4],
+        mocapNETOutputWithGUIForcedView[5],
+        numberOfFramesToGrab
+    );
+    //Same size and type so this is a plain copy into the existing buffer
+    vis->background.copyTo(vis->canvas);
+    cv::Mat &img = vis->canvas;
+
+    if (vis->numberOfJointLabels==0)
+        {
+            for (unsigned int jointID=0; jointID<MOCAPNET_BVH_JOINT_NUMBER; jointID++)
+                {
+                    const char * jointName = getBVHJointName(jointID);
+                    if (jointName!=0)
+                        {
+                            snprintf(vis->jointLabel[jointID],64,"%s(%u)",jointName,jointID);
+                        }
+                    else
+                        {
+                            snprintf(vis->jointLabel[jointID],64,"-(%u)",jointID);
+                        }
+                }
+            vis->numberOfJointLabels=MOCAPNET_BVH_JOINT_NUMBER;
+        }
+
+    char textInfo[512];
+
 //Just the lines ( background layer)
     for (int jointID=0; jointID<points2DOutputGUIForcedView.size(); jointID++)
         {
             float jointPointX = points2DOutputGUIForcedView[jointID][0];
             float jointPointY = points2DOutputGUIForcedView[jointID][1];
             cv::Point jointPoint(jointPointX,jointPointY);
-            //fprintf(stderr,"L x,y %0.2f,%0.2f \n",jointPointX,jointPointY);
 
             if ( (jointPointX!=0) && (jointPointY!=0) )
                 {
-
-                    //unsigned int parentID = Body25SkeletonJointsParentRelationMap[jointID];
                     unsigned int parentID = getBVHParentJoint(jointID);
                     if (parentID!=jointID)
                         {
@@ -331,9 +545,7 @@ int visualizePoints(
                                 {
                                     fprintf(stderr,"Joint Out Of Bounds..");
                                 }
-
                         }
-
                 }
         }
 
@@ -343,47 +555,34 @@ int visualizePoints(
         {
             float jointPointX = points2DOutputGUIForcedView[jointID][0];
             float jointPointY = points2DOutputGUIForcedView[jointID][1];
-            //fprintf(stderr,"P x,y %0.2f,%0.2f \n",jointPointX,jointPointY);
-
 
             if ( (jointPointX!=0) && (jointPointY!=0) )
                 {
                     cv::Point jointPoint(jointPointX+10,jointPointY);
                     cv::circle(img,jointPoint,5,cv::Scalar(255,0,0),3,8,0);
 
-                    const char * jointName = getBVHJointName(jointID);
-                    if (jointName!=0)
+                    const char * label = textInfo;
+                    if (jointID<vis->numberOfJointLabels)
                         {
-                            snprintf(textInfo,512,"%s(%u)",jointName,jointID);
+                            label = vis->jointLabel[jointID];
                         }
                     else
                         {
                             snprintf(textInfo,512,"-(%u)",jointID);
                         }
-                    cv::putText(img, textInfo  , jointPoint, cv::FONT_HERSHEY_DUPLEX, 0.5, cv::Scalar::all(255), 0.2, 8 );
+                    cv::putText(img, label , jointPoint, cv::FONT_HERSHEY_DUPLEX, 0.5, cv::Scalar::all(255), 0.2, 8 );
                 }
         }
 
 
+    //The first line ( grabber mode ) is part of the background
     cv::Point txtPosition;
     txtPosition.x=20;
-    txtPosition.y=20;
+    txtPosition.y=50;
     float thickness=1;
     int fontUsed=cv::FONT_HERSHEY_SIMPLEX;
     cv::Scalar color= cv::Scalar(123,123,123,123 /*Transparency here , although if the cv::Mat does not have an alpha channel it is useless*/);
 
-    if (numberOfFramesToGrab>0)
-        {
-            snprintf(textInfo,512,"Grabber will stop after collecting  %u frames",numberOfFramesToGrab);
-        }
-    else
-        {
-            snprintf(textInfo,512,"Live mode, looping forever will not produce a bvh file");
-        }
-    txtPosition.y+=30;
-    cv::putText(img,textInfo,txtPosition,fontUsed,0.8,color,thickness,8);
-
-
     if (totalNumberOfFrames>0)
         {
             snprintf(textInfo,512,"Frame %u/%u",frameNumber,totalNumberOfFrames);
@@ -395,8 +594,6 @@ int visualizePoints(
     txtPosition.y+=30;
     cv::putText(img,textInfo,txtPosition,fontUsed,0.8,color,thickness,8);
 
-
-
     if (skippedFrames>0)
         {
             txtPosition.y+=30;
@@ -404,15 +601,10 @@ int visualizePoints(
             cv::putText(img,textInfo,txtPosition,fontUsed,0.8,color,thickness,8);
         }
 
-//  txtPosition.y+=40;
-//  snprintf(textInfo,512,"Input Quality : %s",fpsAcquisition);
-//  cv::putText(img,textInfo,txtPosition,fontUsed,0.8,color,4,8);
-
     txtPosition.y+=30;
     snprintf(textInfo,512,"Acquisition : %0.2f fps",fpsAcquisition);
     cv::putText(img,textInfo,txtPosition,fontUsed,0.8,color,thickness,8);
 
-
     txtPosition.y+=30;
     snprintf(textInfo,512,"2D Joint Detector : %0.2f fps",joint2DEstimator);
     cv::putText(img,textInfo,txtPosition,fontUsed,0.8,color,thickness,8);
@@ -427,15 +619,187 @@ int visualizePoints(
 
     if (drawNSDM)
         {
-            visualizeNSDM(
-                img,
-                mocapNETInput,
-                20,
-                400,
-                200,
-                200
+            const float * NSDM = precomputedNSDM;
+            unsigned int NSDMSize = precomputedNSDMSize;
+            if (NSDM==0)
+                {
+                    if (mocapNETInput.size()==MOCAPNET_INPUT_SIZE)
+                        {
+                            //A complete network input already carries its NSDM right after the uncompressed part
+                            NSDM = mocapNETInput.data() + MOCAPNET_UNCOMPRESSED_INPUT_SIZE;
+                            NSDMSize = MOCAPNET_COMPRESSED_INPUT_SIZE;
+                        }
+                    else if (mocapNETInput.size()==MOCAPNET_UNCOMPRESSED_INPUT_SIZE)
+                        {
+                            int addSyntheticPoints=1;
+                            int doScaleCompensation=0;
+                            NSDMSize = compressMocapNETInputToBuffer(mocapNETInput.data(),mocapNETInput.size(),addSyntheticPoints,doScaleCompensation,vis->NSDM);
+                            NSDM = vis->NSDM;
+                        }
+                }
+            if ( (NSDM!=0) && (NSDMSize>0) )
+                {
+                    drawNSDMBoxes(img,NSDM,NSDMSize,20,400,200,200);
+                }
+        }
+
+    stopStageTimer(MOCAPNET_STAGE_RENDER,renderStart);
+    return 1;
+}
+
+
+int visualizerShow(struct MocapNETVisualizer * vis,unsigned int handleMessages)
+{
+    if (vis==0)
+        {
+            return 0;
+        }
+    cv::imshow(vis->windowName,vis->canvas);
+    if (handleMessages)
+        {
+            cv::waitKey(1);
+        }
+    return 1;
+}
+
+
+int drawVisualization(
+    cv::Mat &img,
+    unsigned int frameNumber,
+    unsigned int skippedFrames,
+    signed int totalNumberOfFrames,
+    unsigned int numberOfFramesToGrab,
+    int drawFloor,
+    int drawNSDM,
+    float fpsTotal,
+    float fpsAcquisition,
+    float joint2DEstimator,
+    float fpsMocapNET,
+    unsigned int width,
+    unsigned int height,
+    const std::vector<float> &mocapNETInput,
+    const std::vector<float> &mocapNETOutput,
+    const std::vector<float> &mocapNETOutputWithGUIForcedView,
+    const std::vector<std::vector<float> > &points2DInput,
+    const std::vector<std::vector<float> > &points2DOutput,
+    const std::vector<std::vector<float> > &points2DOutputGUIForcedView
+)
+{
+    //Every thread gets a visualizer that is kept around as long as the requested size does not change
+    static thread_local struct MocapNETVisualizer * vis = 0;
+    if ( (vis!=0) && ( (vis->width!=width) || (vis->height!=height) ) )
+        {
+            destroyVisualizer(vis);
+            vis=0;
+        }
+    if (vis==0)
+        {
+            vis = createVisualizer(0,width,height);
+        }
+
+    if (
+        !visualizerDrawFrame(
+            vis,
+            frameNumber,
+            skippedFrames,
+            totalNumberOfFrames,
+            numberOfFramesToGrab,
+            drawFloor,
+            drawNSDM,
+            fpsTotal,
+            fpsAcquisition,
+            joint2DEstimator,
+            fpsMocapNET,
+            mocapNETInput,
+            mocapNETOutput,
+            mocapNETOutputWithGUIForcedView,
+            points2DOutputGUIForcedView,
+            0,
+            0
+        )
+    )
+        {
+            return 0;
+        }
+
+//---------------------------------------------------------------------------------------------------------------------
+//   Draw correspondance, post processing step to see if output is good
+//---------------------------------------------------------------------------------------------------------------------
+    int visualizeCorrespondence=0;
+
+    if (visualizeCorrespondence)
+        {
+            visualizeSkeletonCorrespondence(
+                vis->canvas,
+                points2DInput,
+                points2DOutput,
+                0, //X
+                0, //Y
+                width,
+                height
             );
         }
+//----------------------------------------------------------------------------------------------------------------------
+
+    //The canvas is reused by the next frame so img only shares it
+    img = vis->canvas;
+    return 1;
+}
+#endif
+
+
+
+int visualizePoints(
+    const char* windowName,
+    unsigned int frameNumber,
+    unsigned int skippedFrames,
+    signed int totalNumberOfFrames,
+    unsigned int numberOfFramesToGrab,
+    int drawFloor,
+    int drawNSDM,
+    float fpsTotal,
+    float fpsAcquisition,
+    float joint2DEstimator,
+    float fpsMocapNET,
+    unsigned int width,
+    unsigned int height,
+    unsigned int handleMessages,
+    const std::vector<float> &mocapNETInput,
+    const std::vector<float> &mocapNETOutput,
+    const std::vector<float> &mocapNETOutputWithGUIForcedView,
+    const std::vector<std::vector<float> > &points2DInput,
+    const std::vector<std::vector<float> > &points2DOutput,
+    const std::vector<std::vector<float> > &points2DOutputGUIForcedView
+)
+{
+#if USE_OPENCV
+    cv::Mat img;
+    if (
+        !drawVisualization(
+            img,
+            frameNumber,
+            skippedFrames,
+            totalNumberOfFrames,
+            numberOfFramesToGrab,
+            drawFloor,
+            drawNSDM,
+            fpsTotal,
+            fpsAcquisition,
+            joint2DEstimator,
+            fpsMocapNET,
+            width,
+            height,
+            mocapNETInput,
+            mocapNETOutput,
+            mocapNETOutputWithGUIForcedView,
+            points2DInput,
+            points2DOutput,
+            points2DOutputGUIForcedView
+        )
+    )
+        {
+            return 0;
+        }
 
     cv::imshow(windowName,img);
     if (handleMessages)
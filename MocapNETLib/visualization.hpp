@@ -36,10 +36,140 @@ int visualizePoints(
                      unsigned int width,
                      unsigned int height,
                      unsigned int handleMessages,
-                     std::vector<float> mocapNETInput,
-                     std::vector<float> mocapNETOutput,
-                     std::vector<float> mocapNETOutputWithGUIForcedView,
-                     std::vector<std::vector<float> > points2DInput,
-                     std::vector<std::vector<float> > points2DOutput,
-                     std::vector<std::vector<float> > points2DOutputGUIForcedView
+                     const std::vector<float> &mocapNETInput,
+                     const std::vector<float> &mocapNETOutput,
+                     const std::vector<float> &mocapNETOutputWithGUIForcedView,
+                     const std::vector<std::vector<float> > &points2DInput,
+                     const std::vector<std::vector<float> > &points2DOutput,
+                     const std::vector<std::vector<float> > &points2DOutputGUIForcedView
                    );
+
+
+
+#if USE_OPENCV
+namespace cv
+{
+class Mat;
+}
+
+/**
+ * @brief Draw the same picture visualizePoints shows on a cv::Mat without showing it, this does not touch any window so
+ * it can be called from any thread ( see asyncRenderer.hpp ). Every thread keeps a persistent visualizer behind this call
+ * ( see createVisualizer ), img shares its canvas and will be overwritten by the next call on the same thread
+ * @ingroup visualization
+ * @param cv::Mat that will receive a width x height BGR image
+ * @param Current frame number
+ * @param Framerate of Acquisition
+ * @param Framerate of 2D Joint estimator
+ * @param Framerate of MocapNET 3D Pose estimator
+ * @param Output image width
+ * @param Output image height
+ * @param MocapNET output BVH frame that we want to visualize
+ * @retval 1 = Success , 0 = Failure
+ */
+int drawVisualization(
+                       cv::Mat &img,
+                       unsigned int frameNumber,
+                       unsigned int skippedFrames,
+                       signed int totalNumberOfFrames,
+                       unsigned int numberOfFramesToGrab,
+                       int drawFloor,
+                       int drawNSDM,
+                       float fpsTotal,
+                       float fpsAcquisition,
+                       float joint2DEstimator,
+                       float fpsMocapNET,
+                       unsigned int width,
+                       unsigned int height,
+                       const std::vector<float> &mocapNETInput,
+                       const std::vector<float> &mocapNETOutput,
+                       const std::vector<float> &mocapNETOutputWithGUIForcedView,
+                       const std::vector<std::vector<float> > &points2DInput,
+                       const std::vector<std::vector<float> > &points2DOutput,
+                       const std::vector<std::vector<float> > &points2DOutputGUIForcedView
+                     );
+
+
+/**
+ * @brief Opaque handle of a persistent visualizer, it owns its canvas and a pre-rendered background ( floor, static labels )
+ * so drawing a frame with it does not allocate any memory once the first frame has been drawn
+ * @ingroup visualization
+ */
+struct MocapNETVisualizer;
+
+
+/**
+ * @brief Create a persistent visualizer
+ * @ingroup visualization
+ * @param CString with the title of the window used by visualizerShow, null for the default one
+ * @param Canvas width
+ * @param Canvas height
+ * @retval Pointer to a visualizer, 0 = Failure
+ */
+struct MocapNETVisualizer * createVisualizer(const char * windowName,unsigned int width,unsigned int height);
+
+
+/**
+ * @brief Draw a frame on the canvas of a visualizer, this does not touch any window so it can be called from any thread.
+ * The NSDM can be given precomputed, if it is not it is taken from the last MOCAPNET_COMPRESSED_INPUT_SIZE values of a complete
+ * MocapNET input or computed in the scratch space of the visualizer when only the uncompressed input is available
+ * @ingroup visualization
+ * @param Pointer to a visualizer
+ * @param Current frame number
+ * @param Framerate of Acquisition
+ * @param Framerate of 2D Joint estimator
+ * @param Framerate of MocapNET 3D Pose estimator
+ * @param MocapNET input ( MOCAPNET_UNCOMPRESSED_INPUT_SIZE or MOCAPNET_INPUT_SIZE values )
+ * @param MocapNET output BVH frame that we want to visualize
+ * @param Pointer to a precomputed NSDM, can be null
+ * @param Number of values of the precomputed NSDM
+ * @retval 1 = Success , 0 = Failure
+ */
+int visualizerDrawFrame(
+                         struct MocapNETVisualizer * vis,
+                         unsigned int frameNumber,
+                         unsigned int skippedFrames,
+                         signed int totalNumberOfFrames,
+                         unsigned int numberOfFramesToGrab,
+                         int drawFloor,
+                         int drawNSDM,
+                         float fpsTotal,
+                         float fpsAcquisition,
+                         float joint2DEstimator,
+                         float fpsMocapNET,
+                         const std::vector<float> &mocapNETInput,
+                         const std::vector<float> &mocapNETOutput,
+                         const std::vector<float> &mocapNETOutputWithGUIForcedView,
+                         const std::vector<std::vector<float> > &points2DOutputGUIForcedView,
+                         const float * precomputedNSDM,
+                         unsigned int precomputedNSDMSize
+                       );
+
+
+/**
+ * @brief Show the canvas of a visualizer on its window, this needs to happen on the thread that owns the window
+ * @ingroup visualization
+ * @param Pointer to a visualizer
+ * @param Also handle window messages
+ * @retval 1 = Success , 0 = Failure
+ */
+int visualizerShow(struct MocapNETVisualizer * vis,unsigned int handleMessages);
+
+
+/**
+ * @brief Get the canvas of a visualizer, it is overwritten by the next visualizerDrawFrame call
+ * @ingroup visualization
+ * @param Pointer to a visualizer
+ * @retval Pointer to the canvas, 0 = Failure
+ */
+const cv::Mat * getVisualizerCanvas(struct MocapNETVisualizer * vis);
+
+
+/**
+ * @brief Free a visualizer
+ * @ingroup visualization
+ * @param Pointer to a visualizer
+ * @retval 1 = Success , 0 = Failure
+ */
+int destroyVisualizer(struct MocapNETVisualizer * vis);
+#endif
@@ -0,0 +1,11 @@
+//Generated by MocapNETMicroBenchmark --writeFKReference using the RGBDAcquisition BVH code, do not edit
+//This copy has no poses yet, run ./MocapNETMicroBenchmark --writeFKReference on a build with the BVH code to fill it in
+
+static const int FKReferenceNumberOfPoses = 0;
+static const int FKReferenceNumberOfJoints = 0;
+static const int FKReferenceWidth = 1920;
+static const int FKReferenceHeight = 1080;
+static const float FKReference2D[] =
+{
+0.0
+};
@@ -0,0 +1,916 @@
+/** @file microbenchmark.cpp
+ *  @brief Microbenchmarks of the parts of MocapNET that run around the neural networks, JSON parsing, input flattening, NSDM compression,
+ *  BVH writing, projection of BVH frames to 2D, heatmap peak extraction and string tokenization. Every component is run on its own in a loop
+ *  that grows until it takes long enough to measure and is reported in nanoseconds, heap allocations and allocated bytes per operation.
+ *  The inputs are the hardcoded samples of MocapNETBenchmark and synthetic OpenPose JSON files and heatmaps so nothing has to be downloaded,
+ *  and since none of these components needs Tensorflow or OpenCV neither does this benchmark.
+ *  With --testFK it instead checks that the native forward kinematics agree with the RGBDAcquisition BVH code, live when the BVH code is
+ *  compiled in and against the 2D joints it gave once ( fkReference.hpp , written by --writeFKReference ) on every build.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../MocapNETLib/mocapnetIO.hpp"
+#include "../MocapNETLib/jsonCocoSkeleton.h"
+#include "../MocapNETLib/jsonMocapNETHelpers.hpp"
+#include "../MocapNETLib/InputParser_C.h"
+#include "../MocapNETLib/bvh.hpp"
+#include "../WebcamAndDeepJoint/peakExtractor.hpp"
+#include "../MocapNETSimpleBenchmark/testCodeInput.hpp"
+#include "../MocapNETSimpleBenchmark/testCodeOutput.hpp"
+#include "fkReference.hpp"
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Number of distinct synthetic JSON files / skeletons that are cycled through
+#define SYNTHETIC_FRAMES 16
+//Resolution of the synthetic heatmaps, the output of the live demo 2D joint estimator for a 368x368 input
+#define HEATMAP_SIZE 46
+#define HEATMAP_CHANNELS 19
+
+
+//-------------------------------------------------------------------------------------------------
+//                                    Allocation counting
+//-------------------------------------------------------------------------------------------------
+//Every allocation goes through malloc ( operator new included ), so on glibc wrapping it in this executable is enough to count
+//the allocations of the C and C++ code alike. Memory returned by realloc is counted as a new allocation of its full size.
+unsigned long countedAllocations=0;
+unsigned long countedBytes=0;
+int countAllocations=0;
+
+#ifdef __GLIBC__
+extern "C"
+{
+    void * __libc_malloc(size_t size);
+    void * __libc_calloc(size_t count,size_t size);
+    void * __libc_realloc(void * pointer,size_t size);
+
+    void * malloc(size_t size)
+    {
+        if (countAllocations)
+            {
+                ++countedAllocations;
+                countedBytes+=size;
+            }
+        return __libc_malloc(size);
+    }
+
+    void * calloc(size_t count,size_t size)
+    {
+        if (countAllocations)
+            {
+                ++countedAllocations;
+                countedBytes+=count*size;
+            }
+        return __libc_calloc(count,size);
+    }
+
+    void * realloc(void * pointer,size_t size)
+    {
+        if (countAllocations)
+            {
+                ++countedAllocations;
+                countedBytes+=size;
+            }
+        return __libc_realloc(pointer,size);
+    }
+}
+#else
+#warning "Allocations can only be counted with glibc, they will be reported as zero.."
+#endif // __GLIBC__
+
+
+//-------------------------------------------------------------------------------------------------
+//                                    Benchmark data
+//-------------------------------------------------------------------------------------------------
+struct microbenchmarkData
+{
+    char directory[256];
+    char jsonFiles[SYNTHETIC_FRAMES][512];
+    char bvhFile[512];
+    struct skeletonCOCO * parsedSkeleton;
+    struct skeletonCOCO * skeletons;
+    std::vector<std::vector<float> > inputs171;
+    std::vector<std::vector<float> > bvhFrames;
+    std::vector<float> heatmaps;
+    struct heatmapCandidates candidates[HEATMAP_CHANNELS];
+    struct InputParserC * ipc;
+    char keypointLine[4096];
+};
+
+struct microbenchmarkData data;
+
+//Results are accumulated here so that the compiler cannot throw away the work
+volatile float sink=0.0;
+
+
+/**
+ * @brief A BODY25 pose in 1920x1080 from an OpenPose run ( x,y,confidence triplets ), the synthetic frames are jittered copies of it
+ */
+static const float body25Template[25*3] =
+{
+    789.327,185.923,0.877001, 736.197,294.809,0.846233, 645.14,297.87,0.778431, 562.688,409.561,0.799173, 600.938,503.878,0.865556,
+    821.695,291.873,0.778329, 892.325,406.56,0.7665, 983.596,436.206,0.82181, 742.157,577.328,0.639119, 692.05,577.387,0.591021,
+    692.179,786.364,0.706035, 698.136,986.468,0.672194, 792.319,574.466,0.611536, 789.358,789.312,0.678118, 777.511,986.492,0.684245,
+    768.645,174.097,0.903252, 789.408,173.995,0.664033, 712.725,183.01,0.866464, 0,0,0, 786.353,1010.05,0.217574,
+    804,1007.09,0.278136, 762.876,1004.13,0.581561, 703.932,1018.88,0.579733, 689.16,1013.02,0.552471, 709.862,998.327,0.553658
+};
+
+
+float jitter(unsigned int * seed,float amplitude)
+{
+    return amplitude * ( ((float) rand_r(seed) / RAND_MAX) * 2.0 - 1.0 );
+}
+
+
+/**
+ * @brief Append the keypoints of a hand around its wrist to a JSON array
+ */
+int appendSyntheticHand(char * json,unsigned int size,unsigned int * seed,float wristX,float wristY)
+{
+    unsigned int length=strlen(json);
+    for (unsigned int i=0; i<21; i++)
+        {
+            float x = wristX + (i%5) * 6.0 + jitter(seed,2.0);
+            float y = wristY + (i/5) * 8.0 + jitter(seed,2.0);
+            length+=snprintf(json+length,size-length,"%s%0.3f,%0.3f,%0.5f",(i==0) ? "" : ",",x,y,0.3+jitter(seed,0.2));
+        }
+    return (length<size);
+}
+
+
+/**
+ * @brief Write an OpenPose style JSON file with a jittered copy of body25Template and two hands
+ */
+int writeSyntheticJSON(const char * filename,unsigned int frameID)
+{
+    unsigned int seed = 1337 + frameID;
+    char json[8192];
+    snprintf(json,8192,"{\"version\":1.2,\"people\":[{\"pose_keypoints_2d\":[");
+    unsigned int length=strlen(json);
+    for (unsigned int i=0; i<25; i++)
+        {
+            float x = body25Template[i*3+0];
+            float y = body25Template[i*3+1];
+            float confidence = body25Template[i*3+2];
+            if (confidence>0.0)
+                {
+                    x+=jitter(&seed,5.0);
+                    y+=jitter(&seed,5.0);
+                }
+            length+=snprintf(json+length,8192-length,"%s%0.3f,%0.3f,%0.6f",(i==0) ? "" : ",",x,y,confidence);
+        }
+    snprintf(json+length,8192-length,"],\"face_keypoints_2d\":[],\"hand_left_keypoints_2d\":[");
+    appendSyntheticHand(json,8192,&seed,body25Template[7*3+0],body25Template[7*3+1]);
+    length=strlen(json);
+    snprintf(json+length,8192-length,"],\"hand_right_keypoints_2d\":[");
+    appendSyntheticHand(json,8192,&seed,body25Template[4*3+0],body25Template[4*3+1]);
+    length=strlen(json);
+    snprintf(json+length,8192-length,"],\"pose_keypoints_3d\":[],\"face_keypoints_3d\":[],\"hand_left_keypoints_3d\":[],\"hand_right_keypoints_3d\":[]}]}\n");
+
+    FILE * fp = fopen(filename,"w");
+    if (fp==0)
+        {
+            return 0;
+        }
+    fputs(json,fp);
+    fclose(fp);
+    return 1;
+}
+
+
+/**
+ * @brief Heatmaps with a gaussian blob per joint on top of low noise, laid out NHWC like the output of the 2D joint estimator
+ */
+void createSyntheticHeatmaps(std::vector<float> &heatmaps)
+{
+    unsigned int seed=7;
+    heatmaps.resize(HEATMAP_SIZE*HEATMAP_SIZE*HEATMAP_CHANNELS);
+    for (unsigned int i=0; i<heatmaps.size(); i++)
+        {
+            heatmaps[i]=fabs(jitter(&seed,0.02));
+        }
+
+    //The last channel is the background
+    for (unsigned int channel=0; channel<HEATMAP_CHANNELS-1; channel++)
+        {
+            float centerX = (body25Template[channel*3+0] / 1920.0) * HEATMAP_SIZE;
+            float centerY = (body25Template[channel*3+1] / 1080.0) * HEATMAP_SIZE;
+            for (unsigned int y=0; y<HEATMAP_SIZE; y++)
+                {
+                    for (unsigned int x=0; x<HEATMAP_SIZE; x++)
+                        {
+                            float distanceSquared = (x-centerX)*(x-centerX) + (y-centerY)*(y-centerY);
+                            heatmaps[(y*HEATMAP_SIZE+x)*HEATMAP_CHANNELS+channel] += exp(-distanceSquared/4.0);
+                        }
+                }
+        }
+}
+
+
+int setupMicrobenchmarkData()
+{
+    snprintf(data.directory,256,"/tmp/mocapnetMicroBenchmarkXXXXXX");
+    if (mkdtemp(data.directory)==0)
+        {
+            fprintf(stderr,RED "Could not create a temporary directory for the synthetic files\n" NORMAL);
+            return 0;
+        }
+
+    data.parsedSkeleton = (struct skeletonCOCO *) malloc(sizeof(struct skeletonCOCO));
+    data.skeletons = (struct skeletonCOCO *) malloc(sizeof(struct skeletonCOCO) * SYNTHETIC_FRAMES);
+    if ( (data.parsedSkeleton==0) || (data.skeletons==0) )
+        {
+            return 0;
+        }
+
+    for (unsigned int i=0; i<SYNTHETIC_FRAMES; i++)
+        {
+            snprintf(data.jsonFiles[i],512,"%s/colorFrame_0_%05u_keypoints.json",data.directory,i);
+            memset(&data.skeletons[i],0,sizeof(struct skeletonCOCO));
+            if ( (!writeSyntheticJSON(data.jsonFiles[i],i)) || (!parseJsonCOCOSkeleton(data.jsonFiles[i],&data.skeletons[i])) )
+                {
+                    fprintf(stderr,RED "Could not create synthetic JSON file %s\n" NORMAL,data.jsonFiles[i]);
+                    return 0;
+                }
+        }
+    memset(data.parsedSkeleton,0,sizeof(struct skeletonCOCO));
+    snprintf(data.bvhFile,512,"%s/output.bvh",data.directory);
+
+    //The first 171 values of every hardcoded sample are the uncompressed input, the rest is the NSDM computed from them
+    data.inputs171.resize(MocapNETTestInputNumberOfSamples);
+    for (int i=0; i<MocapNETTestInputNumberOfSamples; i++)
+        {
+            const float * sample = &MocapNETTestInput[i*MocapNETTestInputElementsPerSample];
+            data.inputs171[i].assign(sample,sample+MOCAPNET_UNCOMPRESSED_INPUT_SIZE);
+        }
+    data.bvhFrames.resize(MocapNETTestOutputNumberOfSamples);
+    for (int i=0; i<MocapNETTestOutputNumberOfSamples; i++)
+        {
+            const float * sample = &MocapNETTestOutput[i*MocapNETTestOutputElementsPerSample];
+            data.bvhFrames[i].assign(sample,sample+MocapNETTestOutputElementsPerSample);
+        }
+
+    createSyntheticHeatmaps(data.heatmaps);
+
+    //Same settings parseJsonCOCOSkeleton uses, tokenizing the pose keypoints of one frame
+    data.ipc = InputParser_Create(2048,3);
+    InputParser_SetDelimeter(data.ipc,0,',');
+    InputParser_SetDelimeter(data.ipc,1,',');
+    unsigned int length=0;
+    for (unsigned int i=0; i<25*3; i++)
+        {
+            length+=snprintf(data.keypointLine+length,4096-length,"%s%g",(i==0) ? "" : ",",body25Template[i]);
+        }
+
+    return initializeBVHConverter();
+}
+
+
+void cleanupMicrobenchmarkData()
+{
+    for (unsigned int i=0; i<SYNTHETIC_FRAMES; i++)
+        {
+            unlink(data.jsonFiles[i]);
+        }
+    unlink(data.bvhFile);
+    rmdir(data.directory);
+    InputParser_Destroy(data.ipc);
+    free(data.parsedSkeleton);
+    free(data.skeletons);
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//                                    Benchmarked operations
+//-------------------------------------------------------------------------------------------------
+void benchmarkParseJSON(unsigned int i)
+{
+    parseJsonCOCOSkeleton(data.jsonFiles[i%SYNTHETIC_FRAMES],data.parsedSkeleton);
+    sink+=data.parsedSkeleton->joint2D[0].x;
+}
+
+void benchmarkFlatten(unsigned int i)
+{
+    std::vector<float> flat = flattenskeletonCOCOToVector(&data.skeletons[i%SYNTHETIC_FRAMES],1920,1080);
+    sink+=flat[0];
+}
+
+void benchmarkCompress(unsigned int i)
+{
+    std::vector<float> compressed = compressMocapNETInput(data.inputs171[i%data.inputs171.size()],1,0);
+    sink+=compressed[0];
+}
+
+void benchmarkCompressToBuffer(unsigned int i)
+{
+    float compressed[MOCAPNET_COMPRESSED_INPUT_SIZE];
+    const std::vector<float> &input = data.inputs171[i%data.inputs171.size()];
+    compressMocapNETInputToBuffer(input.data(),input.size(),1,0,compressed);
+    sink+=compressed[0];
+}
+
+void benchmarkPrepareInput(unsigned int i)
+{
+    std::vector<float> prepared = prepareMocapNETInputFromUncompressedInput(data.inputs171[i%data.inputs171.size()]);
+    sink+=prepared[0];
+}
+
+void benchmarkWriteBVH(unsigned int)
+{
+    sink+=writeBVHFile(data.bvhFile,0,data.bvhFrames);
+}
+
+void benchmarkProjection(unsigned int i)
+{
+    std::vector<std::vector<float> > points2D = convertBVHFrameTo2DPoints(data.bvhFrames[i%data.bvhFrames.size()],1920,1080);
+    sink+=points2D.size();
+}
+
+void benchmarkPeakExtraction(unsigned int)
+{
+    sink+=extractHeatmapPeaksNHWC(
+              data.heatmaps.data(),
+              HEATMAP_SIZE,
+              HEATMAP_SIZE,
+              HEATMAP_CHANNELS-1,
+              HEATMAP_CHANNELS,
+              0.4,
+              1920.0/HEATMAP_SIZE,
+              1080.0/HEATMAP_SIZE,
+              PEAK_EXTRACTOR_SINGLE_PERSON_CANDIDATES,
+              PEAK_EXTRACTOR_SUPPRESSION_RADIUS,
+              data.candidates
+          );
+}
+
+void benchmarkSeperateWords(unsigned int)
+{
+    sink+=InputParser_SeperateWords(data.ipc,data.keypointLine,1);
+}
+
+
+struct microbenchmark
+{
+    const char * name;
+    //What a single operation is
+    const char * operation;
+    void (*run)(unsigned int i);
+};
+
+static struct microbenchmark microbenchmarks[] =
+{
+    { "parseJsonCOCOSkeleton",                     "BODY25+hands JSON file",   benchmarkParseJSON },
+    { "flattenskeletonCOCOToVector",               "skeleton",                 benchmarkFlatten },
+    { "compressMocapNETInput",                     "171 values",               benchmarkCompress },
+    { "compressMocapNETInputToBuffer",             "171 values",               benchmarkCompressToBuffer },
+    { "prepareMocapNETInputFromUncompressedInput", "171 values",               benchmarkPrepareInput },
+    { "writeBVHFile",                              "file of 200 frames",       benchmarkWriteBVH },
+    { "convertBVHFrameTo2DPoints",                 "BVH frame",                benchmarkProjection },
+    { "extractHeatmapPeaksNHWC",                   "46x46x18 heatmaps",        benchmarkPeakExtraction },
+    { "InputParser_SeperateWords",                 "75 BODY25 values",         benchmarkSeperateWords }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+//                                    Measurement
+//-------------------------------------------------------------------------------------------------
+struct microbenchmarkResult
+{
+    unsigned long iterations;
+    double nanosecondsPerOperation;
+    double allocationsPerOperation;
+    double bytesPerOperation;
+};
+
+
+unsigned long getNanoseconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (unsigned long) ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+
+/**
+ * @brief Run an operation in a loop that is grown until it lasts at least the requested time, like Go's testing.B
+ * @ingroup microbenchmark
+ * @param The benchmark to run
+ * @param Minimum duration of the measured loop in seconds
+ * @param Output
+ */
+void runMicrobenchmark(struct microbenchmark * benchmark,float minimumSeconds,struct microbenchmarkResult * result)
+{
+    unsigned long target = (unsigned long) (minimumSeconds*1000000000);
+
+    //Warm-up so that files are in the page cache and lazily initialized state is there
+    for (unsigned int i=0; i<8; i++)
+        {
+            benchmark->run(i);
+        }
+
+    unsigned long iterations=1;
+    while (1)
+        {
+            countedAllocations=0;
+            countedBytes=0;
+            countAllocations=1;
+            unsigned long start = getNanoseconds();
+            for (unsigned long i=0; i<iterations; i++)
+                {
+                    benchmark->run(i);
+                }
+            unsigned long elapsed = getNanoseconds() - start;
+            countAllocations=0;
+
+            if ( (elapsed>=target) || (iterations>=1000000000) )
+                {
+                    result->iterations = iterations;
+                    result->nanosecondsPerOperation = (double) elapsed / iterations;
+                    result->allocationsPerOperation = (double) countedAllocations / iterations;
+                    result->bytesPerOperation = (double) countedBytes / iterations;
+                    return;
+                }
+
+            //Predict how many iterations reach the target, overshoot a little and never grow more than 100x at once
+            unsigned long next = iterations*100;
+            if (elapsed>0)
+                {
+                    double predicted = 1.2 * target * iterations / elapsed;
+                    if (predicted<next)
+                        {
+                            next = (unsigned long) predicted;
+                        }
+                }
+            iterations = (next>iterations) ? next : iterations+1;
+        }
+}
+
+
+//Some of the components print a line per call, that would be measured instead of them so stderr is muted while they run
+int devNull=-1;
+int savedStderr=-1;
+
+void muteStderr()
+{
+    if (devNull>=0)
+        {
+            fflush(stderr);
+            savedStderr=dup(STDERR_FILENO);
+            dup2(devNull,STDERR_FILENO);
+        }
+}
+
+void restoreStderr()
+{
+    if (savedStderr>=0)
+        {
+            fflush(stderr);
+            dup2(savedStderr,STDERR_FILENO);
+            close(savedStderr);
+            savedStderr=-1;
+        }
+}
+
+
+//-------------------------------------------------------------------------------------------------
+//                                    Self tests
+//-------------------------------------------------------------------------------------------------
+//Exit code of a self test that cannot run in this build, CTest reports it as skipped
+#define SELF_TEST_SKIPPED 77
+
+/**
+ * @brief Compare a set of 2D points against a reference and keep track of the largest difference
+ * @ingroup microbenchmark
+ * @param Reference points ( x,y pairs )
+ * @param Points to check ( x,y pairs )
+ * @param Number of points
+ * @param Largest accepted difference in pixels
+ * @param Pointer to the largest difference seen so far, it gets updated
+ * @retval Number of points that differ by more than the tolerance
+ */
+unsigned int compareProjectedPoints(const float * reference,const float * points,unsigned int numberOfPoints,float tolerance,float * maximumDifference)
+{
+    unsigned int mismatches=0;
+    for (unsigned int jID=0; jID<numberOfPoints; jID++)
+        {
+            float dX = fabs(reference[jID*2+0]-points[jID*2+0]);
+            float dY = fabs(reference[jID*2+1]-points[jID*2+1]);
+            float difference = (dX>dY) ? dX : dY;
+            if (difference>*maximumDifference)
+                {
+                    *maximumDifference=difference;
+                }
+            if (difference>tolerance)
+                {
+                    ++mismatches;
+                }
+        }
+    return mismatches;
+}
+
+/**
+ * @brief Get one of the poses the forward kinematics are checked on, every hardcoded MocapNETTestOutput frame followed by a forced view of it
+ * ( like the live demo shows ) that only changes the hip channels so the incremental path reuses its cache
+ * @ingroup microbenchmark
+ * @param Number of the pose, frame poseID/2 , even numbers are the frame itself and odd numbers its forced view
+ * @param Output, the BVH frame of the pose
+ */
+void getForwardKinematicsTestPose(unsigned int poseID,std::vector<float> &pose)
+{
+    unsigned int i = poseID/2;
+    pose = data.bvhFrames[i];
+    if (poseID%2==1)
+        {
+            pose[MOCAPNET_OUTPUT_HIP_XPOSITION]=0.0;
+            pose[MOCAPNET_OUTPUT_HIP_YPOSITION]=0.0;
+            pose[MOCAPNET_OUTPUT_HIP_ZPOSITION]=-160.0 - (float) (i%100);
+            pose[MOCAPNET_OUTPUT_HIP_ZROTATION]=(float) (i%7) * 10.0 - 30.0;
+            pose[MOCAPNET_OUTPUT_HIP_YROTATION]=(float) (i%36) * 10.0 - 180.0;
+            pose[MOCAPNET_OUTPUT_HIP_XROTATION]=(float) (i%5) * 10.0 - 20.0;
+        }
+}
+
+
+/**
+ * @brief Check that the native forward kinematics ( forwardKinematics.hpp ) give the same 2D joints as the RGBDAcquisition BVH code,
+ * that covers the rotation order and signs of every channel, the default intrinsics ( fx=582.18394, fy=582.52915 ) and the direction of the y axis.
+ * Every pose of getForwardKinematicsTestPose is projected to 1920x1080 by the BVH code, by mocapnetFKEvaluate and by the incremental path.
+ * @ingroup microbenchmark
+ * @param Largest accepted difference in pixels
+ * @retval 1=Success/0=Failure/-1=Built without the BVH code so there is nothing to compare against
+ */
+int testForwardKinematics(float tolerance)
+{
+#if USE_BVH
+    struct BVHProjectionContext bvhCode= {0};
+    struct BVHProjectionContext incremental= {0};
+    struct MocapNETFKSkeleton * skeleton = (struct MocapNETFKSkeleton *) malloc(sizeof(struct MocapNETFKSkeleton));
+    struct MocapNETFKState * state = (struct MocapNETFKState *) malloc(sizeof(struct MocapNETFKState));
+    if ( (skeleton==0) || (state==0) || (!mocapnetFKLoadSkeleton(skeleton,bvhHeader)) ||
+         (!createBVHProjectionContext(&bvhCode,1920,1080)) || (!createBVHProjectionContext(&incremental,1920,1080)) )
+        {
+            fprintf(stderr,RED "Could not set up the forward kinematics test\n" NORMAL);
+            free(skeleton);
+            free(state);
+            destroyBVHProjectionContext(&bvhCode);
+            destroyBVHProjectionContext(&incremental);
+            return 0;
+        }
+    struct MocapNETFKCamera camera;
+    mocapnetFKDefaultCamera(&camera,1920,1080);
+
+    unsigned int numberOfJoints = bvhCode.numberOfJoints;
+    if (numberOfJoints!=skeleton->numberOfJoints)
+        {
+            fprintf(stderr,RED "The BVH code has %u joints, the native forward kinematics %u\n" NORMAL,numberOfJoints,skeleton->numberOfJoints);
+            numberOfJoints=0;
+        }
+
+    float native[MOCAPNET_FK_MAX_JOINTS*2];
+    float maximumDifferenceNative=0.0,maximumDifferenceIncremental=0.0;
+    unsigned int mismatches=(numberOfJoints==0);
+    unsigned int comparedPoses=0;
+    std::vector<float> pose;
+
+    for (unsigned int poseID=0; (poseID<data.bvhFrames.size()*2) && (numberOfJoints>0); poseID++)
+        {
+            getForwardKinematicsTestPose(poseID,pose);
+            if (
+                 (!projectBVHFrameTo2DPoints(&bvhCode,pose.data(),pose.size())) ||
+                 (!mocapnetFKEvaluate(skeleton,state,pose.data(),pose.size())) ||
+                 (!projectBVHFrameTo2DPointsIncremental(&incremental,pose.data(),pose.size()))
+               )
+                {
+                    fprintf(stderr,RED "Could not project frame %u\n" NORMAL,poseID/2);
+                    ++mismatches;
+                    continue;
+                }
+            mocapnetFKProject(skeleton,state,&camera);
+            for (unsigned int jID=0; jID<numberOfJoints; jID++)
+                {
+                    native[jID*2+0]=state->pos2DX[jID];
+                    native[jID*2+1]=state->pos2DY[jID];
+                }
+
+            unsigned int nativeMismatches = compareProjectedPoints(bvhCode.points2D,native,numberOfJoints,tolerance,&maximumDifferenceNative);
+            unsigned int incrementalMismatches = compareProjectedPoints(bvhCode.points2D,incremental.points2D,numberOfJoints,tolerance,&maximumDifferenceIncremental);
+            if ( (nativeMismatches>0) || (incrementalMismatches>0) )
+                {
+                    fprintf(stderr,RED "Frame %u%s : %u joints of the native and %u joints of the incremental projection differ by more than %0.2f pixels\n" NORMAL,
+                            poseID/2,(poseID%2==0) ? "" : " ( forced view )",nativeMismatches,incrementalMismatches,tolerance);
+                    mismatches+=nativeMismatches+incrementalMismatches;
+                }
+            ++comparedPoses;
+        }
+
+    fprintf(stderr,"%u poses of %u joints compared with the BVH code, largest difference %0.4f pixels native / %0.4f pixels incremental\n",
+            comparedPoses,numberOfJoints,maximumDifferenceNative,maximumDifferenceIncremental);
+
+    free(skeleton);
+    free(state);
+    destroyBVHProjectionContext(&bvhCode);
+    destroyBVHProjectionContext(&incremental);
+    return (mismatches==0);
+#else
+    (void) tolerance;
+    fprintf(stderr,YELLOW "Built without the RGBDAcquisition BVH code, there is nothing to compare the native forward kinematics against\n" NORMAL);
+    return -1;
+#endif // USE_BVH
+}
+
+
+/**
+ * @brief Check the native forward kinematics against the 2D joints the RGBDAcquisition BVH code gave for the poses of getForwardKinematicsTestPose
+ * when fkReference.hpp was written ( see writeForwardKinematicsReference ), this needs no BVH code so it runs on every build
+ * @ingroup microbenchmark
+ * @param Largest accepted difference in pixels
+ * @retval 1=Success/0=Failure/-1=fkReference.hpp has no poses
+ */
+int testForwardKinematicsReference(float tolerance)
+{
+    if (FKReferenceNumberOfPoses==0)
+        {
+            fprintf(stderr,YELLOW "fkReference.hpp has no poses, write it with MocapNETMicroBenchmark --writeFKReference on a build with the BVH code\n" NORMAL);
+            return -1;
+        }
+
+    struct BVHProjectionContext incremental= {0};
+    struct MocapNETFKSkeleton * skeleton = (struct MocapNETFKSkeleton *) malloc(sizeof(struct MocapNETFKSkeleton));
+    struct MocapNETFKState * state = (struct MocapNETFKState *) malloc(sizeof(struct MocapNETFKState));
+    if ( (skeleton==0) || (state==0) || (!mocapnetFKLoadSkeleton(skeleton,bvhHeader)) || (!createBVHProjectionContext(&incremental,FKReferenceWidth,FKReferenceHeight)) )
+        {
+            fprintf(stderr,RED "Could not set up the forward kinematics test\n" NORMAL);
+            free(skeleton);
+            free(state);
+            destroyBVHProjectionContext(&incremental);
+            return 0;
+        }
+    struct MocapNETFKCamera camera;
+    mocapnetFKDefaultCamera(&camera,FKReferenceWidth,FKReferenceHeight);
+
+    unsigned int numberOfJoints = FKReferenceNumberOfJoints;
+    unsigned int numberOfPoses = FKReferenceNumberOfPoses;
+    unsigned int mismatches=0;
+    if ( (numberOfJoints!=skeleton->numberOfJoints) || (numberOfPoses>data.bvhFrames.size()*2) )
+        {
+            fprintf(stderr,RED "fkReference.hpp has %u poses of %u joints, the native forward kinematics have %u joints and there are %lu test poses\n" NORMAL,
+                    numberOfPoses,numberOfJoints,skeleton->numberOfJoints,data.bvhFrames.size()*2);
+            mismatches=1;
+            numberOfPoses=0;
+        }
+
+    float native[MOCAPNET_FK_MAX_JOINTS*2];
+    float maximumDifferenceNative=0.0,maximumDifferenceIncremental=0.0;
+    unsigned int comparedPoses=0;
+    std::vector<float> pose;
+    for (unsigned int poseID=0; poseID<numberOfPoses; poseID++)
+        {
+            getForwardKinematicsTestPose(poseID,pose);
+            if ( (!mocapnetFKEvaluate(skeleton,state,pose.data(),pose.size())) || (!projectBVHFrameTo2DPointsIncremental(&incremental,pose.data(),pose.size())) )
+                {
+                    fprintf(stderr,RED "Could not project frame %u\n" NORMAL,poseID/2);
+                    ++mismatches;
+                    continue;
+                }
+            mocapnetFKProject(skeleton,state,&camera);
+            for (unsigned int jID=0; jID<numberOfJoints; jID++)
+                {
+                    native[jID*2+0]=state->pos2DX[jID];
+                    native[jID*2+1]=state->pos2DY[jID];
+                }
+
+            const float * reference = &FKReference2D[poseID*numberOfJoints*2];
+            unsigned int nativeMismatches = compareProjectedPoints(reference,native,numberOfJoints,tolerance,&maximumDifferenceNative);
+            unsigned int incrementalMismatches = compareProjectedPoints(reference,incremental.points2D,numberOfJoints,tolerance,&maximumDifferenceIncremental);
+            if ( (nativeMismatches>0) || (incrementalMismatches>0) )
+                {
+                    fprintf(stderr,RED "Frame %u%s : %u joints of the native and %u joints of the incremental projection differ from fkReference.hpp by more than %0.2f pixels\n" NORMAL,
+                            poseID/2,(poseID%2==0) ? "" : " ( forced view )",nativeMismatches,incrementalMismatches,tolerance);
+                    mismatches+=nativeMismatches+incrementalMismatches;
+                }
+            ++comparedPoses;
+        }
+
+    fprintf(stderr,"%u poses of %u joints compared with fkReference.hpp, largest difference %0.4f pixels native / %0.4f pixels incremental\n",
+            comparedPoses,numberOfJoints,maximumDifferenceNative,maximumDifferenceIncremental);
+
+    free(skeleton);
+    free(state);
+    destroyBVHProjectionContext(&incremental);
+    return (mismatches==0);
+}
+
+
+/**
+ * @brief Write fkReference.hpp with the 2D joints the RGBDAcquisition BVH code gives for every pose of getForwardKinematicsTestPose at 1920x1080,
+ * so that testForwardKinematicsReference can check the native forward kinematics on builds without the BVH code
+ * @ingroup microbenchmark
+ * @param Path of the header to write
+ * @retval 1=Success/0=Failure
+ */
+int writeForwardKinematicsReference(const char * filename)
+{
+#if USE_BVH
+    struct BVHProjectionContext bvhCode= {0};
+    if (!createBVHProjectionContext(&bvhCode,1920,1080))
+        {
+            fprintf(stderr,RED "Could not initialize the BVH code\n" NORMAL);
+            return 0;
+        }
+    FILE * fp = fopen(filename,"w");
+    if (fp==0)
+        {
+            fprintf(stderr,RED "Could not write %s\n" NORMAL,filename);
+            destroyBVHProjectionContext(&bvhCode);
+            return 0;
+        }
+
+    unsigned int numberOfPoses = data.bvhFrames.size()*2;
+    unsigned int numberOfJoints = bvhCode.numberOfJoints;
+    fprintf(fp,"//Generated by MocapNETMicroBenchmark --writeFKReference using the RGBDAcquisition BVH code, do not edit\n\n");
+    fprintf(fp,"static const int FKReferenceNumberOfPoses = %u;\n",numberOfPoses);
+    fprintf(fp,"static const int FKReferenceNumberOfJoints = %u;\n",numberOfJoints);
+    fprintf(fp,"static const int FKReferenceWidth = 1920;\n");
+    fprintf(fp,"static const int FKReferenceHeight = 1080;\n");
+    fprintf(fp,"static const float FKReference2D[] =\n{\n");
+
+    int success=1;
+    std::vector<float> pose;
+    for (unsigned int poseID=0; poseID<numberOfPoses; poseID++)
+        {
+            getForwardKinematicsTestPose(poseID,pose);
+            if (!projectBVHFrameTo2DPoints(&bvhCode,pose.data(),pose.size()))
+                {
+                    fprintf(stderr,RED "Could not project frame %u\n" NORMAL,poseID/2);
+                    success=0;
+                    break;
+                }
+            for (unsigned int i=0; i<numberOfJoints*2; i++)
+                {
+                    fprintf(fp,"%0.4f%s",bvhCode.points2D[i],( (poseID+1==numberOfPoses) && (i+1==numberOfJoints*2) ) ? "\n" : ",");
+                }
+            fprintf(fp,"\n");
+        }
+    fprintf(fp,"};\n");
+    fclose(fp);
+    destroyBVHProjectionContext(&bvhCode);
+    if (success)
+        {
+            fprintf(stderr,GREEN "Wrote the 2D joints of %u poses to %s\n" NORMAL,numberOfPoses,filename);
+        }
+    return success;
+#else
+    fprintf(stderr,RED "Built without the RGBDAcquisition BVH code, %s can only be written by a build that has it\n" NORMAL,filename);
+    return 0;
+#endif // USE_BVH
+}
+
+
+int main(int argc, char *argv[])
+{
+    float minimumSeconds=1.0;
+    const char * filter=0;
+    const char * jsonPath=0;
+    int quiet=1;
+    float testFKTolerance=0.0;
+    const char * fkReferencePath=0;
+
+    for (int i=0; i<argc; i++)
+        {
+            if (strcmp(argv[i],"--time")==0)
+                {
+                    minimumSeconds=atof(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--filter")==0)
+                {
+                    //Only run benchmarks whose name contains this string
+                    filter=argv[i+1];
+                }
+            else if (strcmp(argv[i],"--json")==0)
+                {
+                    jsonPath=argv[i+1];
+                }
+            else if (strcmp(argv[i],"-v")==0)
+                {
+                    //Keep the messages the benchmarked code prints
+                    quiet=0;
+                }
+            else if (strcmp(argv[i],"--testFK")==0)
+                {
+                    //Instead of benchmarking check the native forward kinematics against the BVH code, optionally with a tolerance in pixels
+                    testFKTolerance = ( (i+1<argc) && (argv[i+1][0]!='-') ) ? atof(argv[i+1]) : 0.5;
+                }
+            else if (strcmp(argv[i],"--writeFKReference")==0)
+                {
+                    //Regenerate the reference of --testFK, needs a build with the BVH code
+                    fkReferencePath = ( (i+1<argc) && (argv[i+1][0]!='-') ) ? argv[i+1] : "MocapNETMicroBenchmark/fkReference.hpp";
+                }
+        }
+
+    if (quiet)
+        {
+            devNull = open("/dev/null",O_WRONLY);
+        }
+
+    muteStderr();
+    int ready = setupMicrobenchmarkData();
+    restoreStderr();
+    if (!ready)
+        {
+            fprintf(stderr,RED "Could not set up the microbenchmarks\n" NORMAL);
+            return 1;
+        }
+
+    if (fkReferencePath!=0)
+        {
+            int result = writeForwardKinematicsReference(fkReferencePath);
+            cleanupMicrobenchmarkData();
+            return (result) ? 0 : 1;
+        }
+
+    if (testFKTolerance>0.0)
+        {
+            int live = testForwardKinematics(testFKTolerance);
+            int reference = testForwardKinematicsReference(testFKTolerance);
+            cleanupMicrobenchmarkData();
+            if ( (live<0) && (reference<0) )
+                {
+                    return SELF_TEST_SKIPPED;
+                }
+            int result = ( (live!=0) && (reference!=0) );
+            fprintf(stderr,"%s\n",(result) ? GREEN "Native forward kinematics match the BVH code" NORMAL : RED "Native forward kinematics do not match the BVH code" NORMAL);
+            return (result) ? 0 : 1;
+        }
+
+    FILE * json=0;
+    if (jsonPath!=0)
+        {
+            json = (strcmp(jsonPath,"-")==0) ? stdout : fopen(jsonPath,"w");
+            if (json==0)
+                {
+                    fprintf(stderr,RED "Could not write results to %s\n" NORMAL,jsonPath);
+                }
+            else
+                {
+                    fprintf(json,"{\n  \"minimumSeconds\": %0.3f,\n  \"benchmarks\": [\n",minimumSeconds);
+                }
+        }
+
+    fprintf(stderr,"%-42s %-24s %14s %12s %12s %12s\n","Benchmark","Operation","ops","ns/op","allocs/op","bytes/op");
+    unsigned int numberOfBenchmarks = sizeof(microbenchmarks)/sizeof(struct microbenchmark);
+    unsigned int written=0;
+    for (unsigned int b=0; b<numberOfBenchmarks; b++)
+        {
+            struct microbenchmark * benchmark = &microbenchmarks[b];
+            if ( (filter!=0) && (strstr(benchmark->name,filter)==0) )
+                {
+                    continue;
+                }
+
+            struct microbenchmarkResult result;
+            muteStderr();
+            runMicrobenchmark(benchmark,minimumSeconds,&result);
+            restoreStderr();
+
+            fprintf(stderr,"%-42s %-24s %14lu %12.1f %12.2f %12.1f\n",
+                    benchmark->name,benchmark->operation,result.iterations,
+                    result.nanosecondsPerOperation,result.allocationsPerOperation,result.bytesPerOperation);
+
+            if (json!=0)
+                {
+                    fprintf(json,"%s    { \"name\": \"%s\", \"operation\": \"%s\", \"iterations\": %lu, \"nsPerOp\": %0.3f, \"allocsPerOp\": %0.3f, \"bytesPerOp\": %0.3f }",
+                            (written==0) ? "" : ",\n",
+                            benchmark->name,benchmark->operation,result.iterations,
+                            result.nanosecondsPerOperation,result.allocationsPerOperation,result.bytesPerOperation);
+                    ++written;
+                }
+        }
+
+    if (devNull>=0)
+        {
+            close(devNull);
+        }
+    if (json!=0)
+        {
+            fprintf(json,"\n  ]\n}\n");
+            if (json!=stdout)
+                {
+                    fclose(json);
+                }
+        }
+
+    cleanupMicrobenchmarkData();
+    return 0;
+}
@@ -0,0 +1,302 @@
+/** @file replay.cpp
+ *  @brief Replays a detection log recorded by the live demo ( WebcamJointBIN --recorddetections ) through the 3D stage, runMocapNET, temporal filtering
+ *  and projection, either as fast as possible to measure throughput or at the pace the frames were originally captured to measure latency and missed
+ *  deadlines. Since the 2D stage is not re-run this needs neither a camera nor a GPU and every run sees exactly the same input.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+#include "../MocapNETLib/mocapnet.hpp"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../MocapNETLib/tools.h"
+#include "../MocapNETLib/bvh.hpp"
+#include "../MocapNETLib/detectionLog.h"
+#include "../MocapNETLib/temporalFilter.hpp"
+#include "../MocapNETLib/instrumentation.hpp"
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+
+/**
+ * @brief Value below which a percentage of the sorted samples falls
+ * @ingroup replay
+ * @param Sorted samples
+ * @param Percentile ( 0-100 )
+ * @retval The percentile, 0 if there are no samples
+ */
+unsigned long getPercentile(const std::vector<unsigned long> &sortedSamples,float percentile)
+{
+    if (sortedSamples.size()==0)
+        {
+            return 0;
+        }
+    unsigned int position = (unsigned int) ceil(percentile/100.0 * sortedSamples.size());
+    if (position>0)
+        {
+            --position;
+        }
+    if (position>=sortedSamples.size())
+        {
+            position=sortedSamples.size()-1;
+        }
+    return sortedSamples[position];
+}
+
+
+int main(int argc, char *argv[])
+{
+    const char * logPath=0;
+    const char * bvhPath=0;
+    const char * statisticsPath=0;
+    unsigned int useCPUOnly=1,realtime=0,repetitions=1,project=1;
+    float speed=1.0;
+    //Optional temporal smoothing of the output
+    unsigned int filterType=MOCAPNET_FILTER_NONE;
+    float minCutoff=1.0,beta=0.01,smoothTime=0.1;
+
+    for (int i=0; i<argc; i++)
+        {
+            if (strcmp(argv[i],"--from")==0)
+                {
+                    logPath = argv[i+1];
+                }
+            else if (strcmp(argv[i],"--gpu")==0)
+                {
+                    useCPUOnly=0;
+                }
+            else if (strcmp(argv[i],"--realtime")==0)
+                {
+                    //Feed the frames at the pace they were captured
+                    realtime=1;
+                }
+            else if (strcmp(argv[i],"--speed")==0)
+                {
+                    //Pace multiplier for --realtime, 2.0 replays twice as fast as the frames were captured
+                    speed = atof(argv[i+1]);
+                    if (speed<=0.0)
+                        {
+                            speed=1.0;
+                        }
+                }
+            else if (strcmp(argv[i],"--repeat")==0)
+                {
+                    repetitions = atoi(argv[i+1]);
+                    if (repetitions==0)
+                        {
+                            repetitions=1;
+                        }
+                }
+            else if (strcmp(argv[i],"--noprojection")==0)
+                {
+                    project=0;
+                }
+            else if (strcmp(argv[i],"--oneeuro")==0)
+                {
+                    filterType=MOCAPNET_FILTER_ONE_EURO;
+                    minCutoff = atof(argv[i+1]);
+                    beta = atof(argv[i+2]);
+                }
+            else if (strcmp(argv[i],"--damped")==0)
+                {
+                    filterType=MOCAPNET_FILTER_CRITICALLY_DAMPED;
+                    smoothTime = atof(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--bvh")==0)
+                {
+                    bvhPath = argv[i+1];
+                }
+            else if (strcmp(argv[i],"--stats")==0)
+                {
+                    statisticsPath = argv[i+1];
+                }
+        }
+
+    if (logPath==0)
+        {
+            fprintf(stderr,"Please give a detection log to replay using --from, you can record one with WebcamJointBIN --recorddetections log.mndl\n");
+            return 1;
+        }
+
+    //The stage statistics are printed when we finish
+    enableStageTimers(1);
+    struct detectionLog log;
+    if (!openDetectionLog(&log,logPath))
+        {
+            return 1;
+        }
+    unsigned int numberOfFrames = getDetectionLogNumberOfFrames(&log);
+    if ( (numberOfFrames==0) || (log.header->valuesPerFrame!=MOCAPNET_UNCOMPRESSED_INPUT_SIZE) )
+        {
+            fprintf(stderr,RED "%s has no frames that MocapNET can use\n" NORMAL,logPath);
+            closeDetectionLog(&log);
+            return 1;
+        }
+    unsigned int width  = (log.header->frameWidth>0)  ? log.header->frameWidth  : 1920;
+    unsigned int height = (log.header->frameHeight>0) ? log.header->frameHeight : 1080;
+
+    if (initializeBVHConverter())
+        {
+            fprintf(stderr,"BVH code initalization successfull..\n");
+        }
+
+    struct MocapNET mnet= {0};
+    if (!loadMocapNET(&mnet,"test",useCPUOnly))
+        {
+            fprintf(stderr,RED "Was not able to load MocapNET, please make sure you have the appropriate models downloaded..\n" NORMAL);
+            closeDetectionLog(&log);
+            return 1;
+        }
+
+    struct MocapNETFilterBank filter;
+    if (filterType==MOCAPNET_FILTER_ONE_EURO)
+        {
+            initializeOneEuroFilterBank(&filter,MOCAPNET_OUTPUT_NUMBER,MOCAPNET_OUTPUT_HIP_ZROTATION,30.0,minCutoff,beta);
+        }
+    else if (filterType==MOCAPNET_FILTER_CRITICALLY_DAMPED)
+        {
+            initializeCriticallyDampedFilterBank(&filter,MOCAPNET_OUTPUT_NUMBER,MOCAPNET_OUTPUT_HIP_ZROTATION,30.0,smoothTime);
+        }
+
+    struct MocapNETResult result;
+    result.fields=0;
+    std::vector<float> input;
+    input.reserve(MOCAPNET_UNCOMPRESSED_INPUT_SIZE);
+    std::vector<std::vector<float> > bvhFrames;
+    //Lives across frames like the one of the live demo, so the projection result is not thrown away inside the loop
+    std::vector<std::vector<float> > points2DOutput;
+    std::vector<unsigned long> latencies;
+    latencies.reserve(numberOfFrames*repetitions);
+    unsigned int failedFrames=0,missedDeadlines=0;
+
+    unsigned long replayStart = GetTickCountMicrosecondsMN();
+    for (unsigned int repetition=0; repetition<repetitions; repetition++)
+        {
+            if (filterType!=MOCAPNET_FILTER_NONE)
+                {
+                    resetFilterBank(&filter);
+                }
+            unsigned long repetitionStart = GetTickCountMicrosecondsMN();
+            unsigned long long previousTimestamp=0;
+
+            for (unsigned int frameID=0; frameID<numberOfFrames; frameID++)
+                {
+                    struct detectionLogFrame frame;
+                    if (!readDetectionLogFrame(&log,frameID,&frame))
+                        {
+                            ++failedFrames;
+                            continue;
+                        }
+
+                    //In real time mode a frame arrives when it was originally captured, latency is counted from then
+                    unsigned long arrival = GetTickCountMicrosecondsMN();
+                    if (realtime)
+                        {
+                            unsigned long scheduled = repetitionStart + (unsigned long) (frame.timestamp/speed);
+                            if (scheduled>arrival)
+                                {
+                                    usleep(scheduled-arrival);
+                                }
+                            arrival = scheduled;
+                        }
+
+                    input.assign(frame.values,frame.values+frame.numberOfValues);
+                    if (!runMocapNETWithResult(&mnet,input,&result))
+                        {
+                            ++failedFrames;
+                            continue;
+                        }
+
+                    if (filterType!=MOCAPNET_FILTER_NONE)
+                        {
+                            float deltaTime = (frameID>0) ? (float) (frame.timestamp-previousTimestamp)/1000000 : 0.0;
+                            filterBankUpdateVector(&filter,result.output,deltaTime);
+                        }
+                    previousTimestamp=frame.timestamp;
+
+                    if (project)
+                        {
+                            points2DOutput = convertBVHFrameTo2DPointsIncremental(result.output,width,height);
+                        }
+
+                    unsigned long done = GetTickCountMicrosecondsMN();
+                    unsigned long latency = (done>arrival) ? done-arrival : 0;
+                    latencies.push_back(latency);
+
+                    //The output of a frame is late if the next frame was captured before it was ready
+                    if ( (realtime) && (frameID+1<numberOfFrames) )
+                        {
+                            struct detectionLogFrame nextFrame;
+                            if ( (readDetectionLogFrame(&log,frameID+1,&nextFrame)) && (done > repetitionStart + (unsigned long) (nextFrame.timestamp/speed)) )
+                                {
+                                    ++missedDeadlines;
+                                }
+                        }
+
+                    if ( (bvhPath!=0) && (repetition==0) )
+                        {
+                            bvhFrames.push_back(result.output);
+                        }
+                }
+        }
+    unsigned long replayEnd = GetTickCountMicrosecondsMN();
+
+    unloadMocapNET(&mnet);
+    closeDetectionLog(&log);
+
+    if (latencies.size()==0)
+        {
+            fprintf(stderr,RED "No frame of the log could be processed\n" NORMAL);
+            return 1;
+        }
+
+    std::sort(latencies.begin(),latencies.end());
+    unsigned long sum=0;
+    for (unsigned int i=0; i<latencies.size(); i++)
+        {
+            sum+=latencies[i];
+        }
+
+    float seconds = (float) (replayEnd-replayStart)/1000000;
+    fprintf(stderr,"\nReplayed %lu frames ( %u repetitions of %u ) in %0.2f seconds, %u failed\n",latencies.size(),repetitions,numberOfFrames,seconds,failedFrames);
+    if (realtime)
+        {
+            fprintf(stderr,"Paced at %0.2fx the original speed, %u outputs were not ready before the next frame arrived\n",speed,missedDeadlines);
+        }
+    else
+        {
+            fprintf(stderr,"Throughput %0.2f fps\n",(seconds>0.0) ? (float) latencies.size()/seconds : 0.0);
+        }
+    fprintf(stderr,"Latency average %0.2f ms , p50 %0.2f ms , p90 %0.2f ms , p99 %0.2f ms , max %0.2f ms\n",
+            (float) sum/latencies.size()/1000,
+            (float) getPercentile(latencies,50)/1000,
+            (float) getPercentile(latencies,90)/1000,
+            (float) getPercentile(latencies,99)/1000,
+            (float) latencies[latencies.size()-1]/1000);
+
+    printStageStatistics(stderr);
+    if (statisticsPath!=0)
+        {
+            dumpStageStatistics(statisticsPath);
+        }
+
+    if (bvhPath!=0)
+        {
+            if ( writeBVHFile(bvhPath,0,bvhFrames) )
+                {
+                    fprintf(stderr,GREEN "Successfully wrote %lu frames to %s\n" NORMAL,bvhFrames.size(),bvhPath);
+                }
+            else
+                {
+                    fprintf(stderr,RED "Failed to write %lu frames to %s\n" NORMAL,bvhFrames.size(),bvhPath);
+                }
+        }
+    return 0;
+}
@@ -16,11 +16,19 @@
 #include "../MocapNETLib/tools.h"
 #include "../MocapNETLib/jsonCocoSkeleton.h"
 #include "../MocapNETLib/jsonMocapNETHelpers.hpp"
+#include "../MocapNETLib/instrumentation.hpp"
+#include "../MocapNETLib/detectionLog.h"
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
 #include <math.h>
 #include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/utsname.h>
 
 #define NORMAL   "\033[0m"
 #define BLACK   "\033[30m"      /* Black */
@@ -159,20 +167,638 @@ int testMocapNETCompression()
 
 
 /**
- * @brief Simple way to cout our CPU model name..
+ * @brief Get the model name of our CPU from /proc/cpuinfo
+ * @param Output string
+ * @param Size of the output string
  * @retval 1=Success/0=Failure
  */
+int getCPUName(char * cpuName,unsigned int cpuNameLength)
+{
+  snprintf(cpuName,cpuNameLength,"unknown");
+  FILE * fp = fopen("/proc/cpuinfo","r");
+  if (fp==0) { return 0; }
+
+  int found=0;
+  char line[512];
+  while ( (!found) && (fgets(line,512,fp)!=0) )
+  {
+    if (strncmp(line,"model name",10)==0)
+    {
+      char * value = strchr(line,':');
+      if (value!=0)
+      {
+        value+=1;
+        while (*value==' ') { ++value; }
+        value[strcspn(value,"\r\n")]=0;
+        snprintf(cpuName,cpuNameLength,"%s",value);
+        found=1;
+      }
+    }
+  }
+  fclose(fp);
+  return found;
+}
+
+
+/**
+ * @brief Simple way to cout our CPU model name..
+ */
 void printCPUName()
 {
-     //Also printout the name of our CPU
-     int i=system("cat /proc/cpuinfo | grep \"model name\" | uniq");
-     if (i!=0)
-       {
-         fprintf(stderr,"Could not get our CPU model name\n");
-       }
+  char cpuName[256];
+  if (getCPUName(cpuName,256)) { fprintf(stderr,"model name\t: %s\n",cpuName); } else
+                               { fprintf(stderr,"Could not get our CPU model name\n"); }
+}
+
+
+/**
+ * @brief Restrict the process ( and every thread it spawns afterwards, Tensorflow included ) to a set of CPU cores
+ * @ingroup benchmark
+ * @param Comma separated list of core numbers, i.e. "2" or "0,2"
+ * @retval 1=Success/0=Failure
+ */
+int pinToCPUs(const char * cpuList)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  unsigned int numberOfCPUs=0;
+  const char * position = cpuList;
+  while (*position!=0)
+  {
+    char * end=0;
+    long cpu = strtol(position,&end,10);
+    if ( (end==position) || (cpu<0) || (cpu>=CPU_SETSIZE) )
+    {
+      fprintf(stderr,RED "Cannot understand CPU list %s\n" NORMAL,cpuList);
+      return 0;
+    }
+    CPU_SET(cpu,&set);
+    ++numberOfCPUs;
+    position = (*end==',') ? end+1 : end;
+    if ( (*end!=',') && (*end!=0) ) { fprintf(stderr,RED "Cannot understand CPU list %s\n" NORMAL,cpuList); return 0; }
+  }
+
+  if ( (numberOfCPUs==0) || (sched_setaffinity(0,sizeof(cpu_set_t),&set)!=0) )
+  {
+    fprintf(stderr,RED "Could not pin the benchmark to CPUs %s\n" NORMAL,cpuList);
+    return 0;
+  }
+  fprintf(stderr,"Benchmark pinned to CPUs %s\n",cpuList);
+  return 1;
+}
+
+
+/**
+ * @brief Summary of a series of timings in microseconds
+ */
+struct benchmarkSummary
+{
+  unsigned long samples;
+  double average;
+  double standardDeviation;
+  unsigned long minimum;
+  unsigned long p50;
+  unsigned long p90;
+  unsigned long p99;
+  unsigned long maximum;
+};
+
+
+/**
+ * @brief Summarize a series of timings, exact percentiles are computed from the sorted samples
+ * @ingroup benchmark
+ * @param Timings in microseconds, they get sorted
+ * @retval Summary, all zero if there are no samples
+ */
+struct benchmarkSummary summarizeTimings(std::vector<unsigned long> &timings)
+{
+  struct benchmarkSummary summary={0};
+  summary.samples = timings.size();
+  if (summary.samples==0) { return summary; }
+
+  std::sort(timings.begin(),timings.end());
+
+  double sum=0.0;
+  for (unsigned int i=0; i<timings.size(); i++) { sum+=timings[i]; }
+  summary.average = sum / summary.samples;
+
+  double squaredDifferences=0.0;
+  for (unsigned int i=0; i<timings.size(); i++)
+  {
+    double difference = timings[i] - summary.average;
+    squaredDifferences+=difference*difference;
+  }
+  if (summary.samples>1) { summary.standardDeviation = sqrt(squaredDifferences/(summary.samples-1)); }
+
+  summary.minimum = timings[0];
+  summary.p50 = timings[(summary.samples-1)*50/100];
+  summary.p90 = timings[(summary.samples-1)*90/100];
+  summary.p99 = timings[(summary.samples-1)*99/100];
+  summary.maximum = timings[summary.samples-1];
+  return summary;
+}
+
+
+/**
+ * @brief Print a summary as a human readable line
+ * @ingroup benchmark
+ */
+void printTimingSummary(FILE * stream,const char * name,struct benchmarkSummary * summary)
+{
+  if (summary->samples==0) { return; }
+  fprintf(stream,"%-12s %7lu samples - avg %8.3f ms - stddev %7.3f ms - min %7.3f - p50 %7.3f - p90 %7.3f - p99 %7.3f - max %7.3f ms\n",
+          name,summary->samples,
+          summary->average/1000,summary->standardDeviation/1000,
+          (float) summary->minimum/1000,(float) summary->p50/1000,(float) summary->p90/1000,(float) summary->p99/1000,(float) summary->maximum/1000);
+}
+
+
+/**
+ * @brief Write a summary as a JSON object member, times are in microseconds
+ * @ingroup benchmark
+ */
+void writeTimingSummaryJSON(FILE * fp,const char * name,struct benchmarkSummary * summary,int last)
+{
+  fprintf(fp,"    \"%s\": { \"samples\": %lu, \"average\": %0.3f, \"stddev\": %0.3f, \"min\": %lu, \"p50\": %lu, \"p90\": %lu, \"p99\": %lu, \"max\": %lu }%s\n",
+          name,summary->samples,summary->average,summary->standardDeviation,
+          summary->minimum,summary->p50,summary->p90,summary->p99,summary->maximum,
+          (last) ? "" : ",");
+}
+
+
+/**
+ * @brief The series of timings the benchmark keeps, front and back split the ensemble time based on the ensemble that was picked
+ */
+enum benchmarkSeriesID
+{
+  BENCHMARK_TOTAL=0,
+  BENCHMARK_NSDM,
+  BENCHMARK_CLASSIFIER,
+  BENCHMARK_ENSEMBLE,
+  BENCHMARK_ENSEMBLE_FRONT,
+  BENCHMARK_ENSEMBLE_BACK,
+  //--------------------
+  BENCHMARK_SERIES_NUMBER
+};
+
+static const char * benchmarkSeriesNames[] =
+{
+  "total",
+  "nsdm",
+  "classifier",
+  "ensemble",
+  "ensemble_front",
+  "ensemble_back",
+  //--------------------
+  "end"
+};
+
+
+/**
+ * @brief Write the machine and build a benchmark ran on as the first members of a JSON object
+ * @ingroup benchmark
+ * @param Open file
+ */
+void writeMachineJSON(FILE * fp)
+{
+  char cpuName[256];
+  getCPUName(cpuName,256);
+  char hostname[256]={0};
+  if (gethostname(hostname,255)!=0) { snprintf(hostname,256,"unknown"); }
+  struct utsname kernel;
+  if (uname(&kernel)!=0) { memset(&kernel,0,sizeof(struct utsname)); }
+
+  fprintf(fp,"  \"machine\": {\n");
+  fprintf(fp,"    \"hostname\": \"%s\",\n",hostname);
+  fprintf(fp,"    \"cpu\": \"%s\",\n",cpuName);
+  fprintf(fp,"    \"cores\": %ld,\n",sysconf(_SC_NPROCESSORS_ONLN));
+  fprintf(fp,"    \"kernel\": \"%s %s %s\"\n",kernel.sysname,kernel.release,kernel.machine);
+  fprintf(fp,"  },\n");
+  fprintf(fp,"  \"build\": {\n");
+  fprintf(fp,"    \"tensorflow\": \"%s\",\n",TF_Version());
+  fprintf(fp,"    \"compiled\": \"%s %s\"\n",__DATE__,__TIME__);
+  fprintf(fp,"  },\n");
+}
+
+
+/**
+ * @brief Write the results of a benchmark run as JSON, so runs on different machines and library versions can be compared by a script
+ * @ingroup benchmark
+ * @param Path to the output file, "-" writes to stdout
+ * @retval 1=Success/0=Failure
+ */
+int writeBenchmarkJSON(
+                        const char * filename,
+                        int useCPUOnly,
+                        const char * pinnedCPUs,
+                        const char * fixturePath,
+                        unsigned int warmupIterations,
+                        unsigned int iterations,
+                        float wallTimeSeconds,
+                        float averageMAE,
+                        unsigned int inaccurateSamples,
+                        struct benchmarkSummary * summaries
+                      )
+{
+  FILE * fp = (strcmp(filename,"-")==0) ? stdout : fopen(filename,"w");
+  if (fp==0)
+  {
+    fprintf(stderr,RED "Could not write benchmark results to %s\n" NORMAL,filename);
+    return 0;
+  }
+
+  fprintf(fp,"{\n");
+  writeMachineJSON(fp);
+  fprintf(fp,"  \"configuration\": {\n");
+  fprintf(fp,"    \"device\": \"%s\",\n",(useCPUOnly) ? "cpu" : "gpu");
+  fprintf(fp,"    \"pinnedCPUs\": \"%s\",\n",(pinnedCPUs!=0) ? pinnedCPUs : "");
+  fprintf(fp,"    \"fixture\": \"%s\",\n",(fixturePath!=0) ? fixturePath : "");
+  fprintf(fp,"    \"warmup\": %u,\n",warmupIterations);
+  fprintf(fp,"    \"iterations\": %u\n",iterations);
+  fprintf(fp,"  },\n");
+  fprintf(fp,"  \"results\": {\n");
+  fprintf(fp,"    \"wallTime\": %0.6f,\n",wallTimeSeconds);
+  fprintf(fp,"    \"fps\": %0.3f,\n",(wallTimeSeconds>0.0) ? (float) iterations/wallTimeSeconds : 0.0);
+  fprintf(fp,"    \"averageMAE\": %0.6f,\n",averageMAE);
+  fprintf(fp,"    \"inaccurateSamples\": %u\n",inaccurateSamples);
+  fprintf(fp,"  },\n");
+  fprintf(fp,"  \"timings\": {\n");
+  for (unsigned int i=0; i<BENCHMARK_SERIES_NUMBER; i++)
+  {
+    writeTimingSummaryJSON(fp,benchmarkSeriesNames[i],&summaries[i],(i+1==BENCHMARK_SERIES_NUMBER));
+  }
+  fprintf(fp,"  }\n");
+  fprintf(fp,"}\n");
+
+  if (fp!=stdout) { fclose(fp); } else { fflush(fp); }
+  return 1;
+}
+
+
+
+
+
+/**
+ * @brief Where the benchmark gets its input from, the hardcoded samples or a fixture file ( a detection log made by MocapNETSyntheticInput
+ * or recorded by WebcamJointBIN --recorddetections ) that is mapped in memory and read as it is needed
+ */
+struct benchmarkInputs
+{
+  std::vector<std::vector<float> > samples;
+  int haveFixture;
+  struct detectionLog fixture;
+};
+
+
+/**
+ * @brief Prepare the input of the benchmark
+ * @ingroup benchmark
+ * @param Output
+ * @param Path to a fixture file, 0 uses the hardcoded samples
+ * @retval 1=Success/0=Failure
+ */
+int loadBenchmarkInputs(struct benchmarkInputs * inputs,const char * fixturePath)
+{
+  inputs->haveFixture=0;
+  inputs->samples.clear();
+  if (fixturePath!=0)
+  {
+    if (!openDetectionLog(&inputs->fixture,fixturePath)) { return 0; }
+    if ( (getDetectionLogNumberOfFrames(&inputs->fixture)==0) || (inputs->fixture.header->valuesPerFrame!=MOCAPNET_UNCOMPRESSED_INPUT_SIZE) )
+    {
+      fprintf(stderr,RED "%s has no frames that MocapNET can use\n" NORMAL,fixturePath);
+      closeDetectionLog(&inputs->fixture);
+      return 0;
+    }
+    inputs->haveFixture=1;
+    return 1;
+  }
+
+  //Every sample is prepared once before measuring so that the timed loop does nothing but run MocapNET
+  inputs->samples.resize(MocapNETTestInputNumberOfSamples);
+  for (int i=0; i<MocapNETTestInputNumberOfSamples; i++)
+  {
+    const float * sample = &MocapNETTestInput[i*MocapNETTestInputElementsPerSample];
+    inputs->samples[i].assign(sample,sample+MocapNETTestInputElementsPerSample);
+  }
+  return 1;
 }
 
 
+unsigned long getNumberOfBenchmarkInputs(const struct benchmarkInputs * inputs)
+{
+  if (inputs->haveFixture) { return getDetectionLogNumberOfFrames(&inputs->fixture); }
+  return inputs->samples.size();
+}
+
+
+/**
+ * @brief Get an input of the benchmark, inputs of a fixture are copied to a vector of the caller that keeps its storage between calls
+ * @ingroup benchmark
+ * @param The inputs
+ * @param Number of the input, wraps around
+ * @param Vector that is reused to hold fixture inputs
+ * @retval The input
+ */
+const std::vector<float> & getBenchmarkInput(const struct benchmarkInputs * inputs,unsigned long inputID,std::vector<float> &scratch)
+{
+  inputID = inputID % getNumberOfBenchmarkInputs(inputs);
+  if (!inputs->haveFixture) { return inputs->samples[inputID]; }
+
+  struct detectionLogFrame frame;
+  if (readDetectionLogFrame(&inputs->fixture,inputID,&frame)) { scratch.assign(frame.values,frame.values+frame.numberOfValues); } else
+                                                              { scratch.clear(); }
+  return scratch;
+}
+
+
+void closeBenchmarkInputs(struct benchmarkInputs * inputs)
+{
+  if (inputs->haveFixture) { closeDetectionLog(&inputs->fixture); }
+  inputs->haveFixture=0;
+  inputs->samples.clear();
+}
+
+
+/**
+ * @brief State of a worker of the throughput benchmark, every worker owns a MocapNET instance
+ */
+struct throughputWorker
+{
+  unsigned int workerID;
+  unsigned int useCPUOnly;
+  unsigned int warmupIterations;
+  const struct benchmarkInputs * inputs;
+  std::atomic<unsigned int> * ready;
+  std::atomic<int> * running;
+  std::atomic<int> * stop;
+  //Results
+  int loaded;
+  unsigned int failedSamples;
+  std::vector<unsigned long> timings;
+};
+
+
+/**
+ * @brief Body of a worker thread, loads MocapNET, warms it up, then runs the test vectors from the moment it is told to start until it is told to stop
+ * @ingroup benchmark
+ */
+void runThroughputWorker(struct throughputWorker * worker)
+{
+  struct MocapNET mnet={0};
+  worker->loaded = loadMocapNET(&mnet,"test",worker->useCPUOnly);
+  worker->failedSamples=0;
+  worker->timings.clear();
+  //Enough room for a few minutes at a thousand frames per second so that the vector does not grow while measuring
+  worker->timings.reserve(200000);
+
+  struct MocapNETResult result;
+  result.fields=0;
+  std::vector<float> scratch;
+  scratch.reserve(MOCAPNET_UNCOMPRESSED_INPUT_SIZE);
+  unsigned long numberOfSamples = getNumberOfBenchmarkInputs(worker->inputs);
+  //Workers start on different samples so they don't all go through the front/back ensembles in lockstep
+  unsigned long sampleID = (worker->workerID * (numberOfSamples/64 + 37)) % numberOfSamples;
+
+  if (worker->loaded)
+  {
+    for (unsigned int i=0; i<worker->warmupIterations; i++)
+    {
+      runMocapNETWithResult(&mnet,getBenchmarkInput(worker->inputs,sampleID+i,scratch),&result);
+    }
+  }
+  worker->ready->fetch_add(1);
+
+  while ( (!worker->running->load()) && (!worker->stop->load()) ) { usleep(100); }
+
+  while ( (worker->loaded) && (!worker->stop->load()) )
+  {
+    const std::vector<float> &input = getBenchmarkInput(worker->inputs,sampleID,scratch);
+    unsigned long startTime = getStageTimerTime();
+    int success = runMocapNETWithResult(&mnet,input,&result);
+    unsigned long endTime = getStageTimerTime();
+
+    if (success) { worker->timings.push_back(endTime-startTime); } else
+                 { ++worker->failedSamples; }
+    sampleID = (sampleID+1) % numberOfSamples;
+  }
+
+  if (worker->loaded) { unloadMocapNET(&mnet); }
+}
+
+
+/**
+ * @brief Results of one run of the throughput benchmark
+ */
+struct throughputRun
+{
+  unsigned int numberOfThreads;
+  unsigned int intraOpThreads;
+  unsigned int interOpThreads;
+  float seconds;
+  unsigned long frames;
+  float fps;
+  float efficiency;
+  struct benchmarkSummary overall;
+  std::vector<struct benchmarkSummary> perThread;
+};
+
+
+/**
+ * @brief Parse the size of a Tensorflow thread pool given on the command-line
+ * @param A number, 0 for the Tensorflow default, or "split" to share the cores between the workers
+ * @param Number of worker threads
+ * @retval Number of threads, 0 means the Tensorflow default
+ */
+unsigned int resolveTensorflowThreads(const char * setting,unsigned int numberOfThreads)
+{
+  if (setting==0) { return 0; }
+  if (strcmp(setting,"split")==0)
+  {
+    unsigned int cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int share = cores / numberOfThreads;
+    return (share>0) ? share : 1;
+  }
+  return atoi(setting);
+}
+
+
+/**
+ * @brief Run T workers side by side for a fixed time and measure how many frames they process in total
+ * @ingroup benchmark
+ * @retval 1=Success/0=Failure
+ */
+int runThroughput(
+                   struct throughputRun * run,
+                   unsigned int numberOfThreads,
+                   const char * intraOpSetting,
+                   const char * interOpSetting,
+                   unsigned int useCPUOnly,
+                   unsigned int warmupIterations,
+                   float durationSeconds,
+                   const struct benchmarkInputs * inputs
+                 )
+{
+  run->numberOfThreads = numberOfThreads;
+  run->intraOpThreads  = resolveTensorflowThreads(intraOpSetting,numberOfThreads);
+  run->interOpThreads  = resolveTensorflowThreads(interOpSetting,numberOfThreads);
+  //Every session loaded from now on gets these pools
+  setTensorflowThreading(run->intraOpThreads,run->interOpThreads);
+
+  std::atomic<unsigned int> ready(0);
+  std::atomic<int> running(0);
+  std::atomic<int> stop(0);
+  std::vector<struct throughputWorker> workers(numberOfThreads);
+  std::vector<std::thread> threads;
+  for (unsigned int i=0; i<numberOfThreads; i++)
+  {
+    workers[i].workerID=i;
+    workers[i].useCPUOnly=useCPUOnly;
+    workers[i].warmupIterations=warmupIterations;
+    workers[i].inputs=inputs;
+    workers[i].ready=&ready;
+    workers[i].running=&running;
+    workers[i].stop=&stop;
+    workers[i].loaded=0;
+    threads.push_back(std::thread(runThroughputWorker,&workers[i]));
+  }
+
+  //Measure only while all of the workers are loaded and warmed up
+  while (ready.load()<numberOfThreads) { usleep(1000); }
+  unsigned long startTime = getStageTimerTime();
+  running.store(1);
+  usleep((useconds_t) (durationSeconds*1000000));
+  stop.store(1);
+  for (unsigned int i=0; i<numberOfThreads; i++) { threads[i].join(); }
+  unsigned long endTime = getStageTimerTime();
+
+  std::vector<unsigned long> allTimings;
+  run->perThread.clear();
+  run->frames=0;
+  int success=1;
+  for (unsigned int i=0; i<numberOfThreads; i++)
+  {
+    if (!workers[i].loaded) { fprintf(stderr,RED "Worker %u could not load MocapNET\n" NORMAL,i); success=0; }
+    run->frames+=workers[i].timings.size();
+    allTimings.insert(allTimings.end(),workers[i].timings.begin(),workers[i].timings.end());
+    run->perThread.push_back(summarizeTimings(workers[i].timings));
+  }
+  run->overall = summarizeTimings(allTimings);
+  //Frames that were in flight when stop was raised are counted, joining takes at most one frame longer than the duration
+  run->seconds = (float) (endTime-startTime)/1000000;
+  run->fps = (run->seconds>0.0) ? (float) run->frames/run->seconds : 0.0;
+  run->efficiency = 0.0;
+  return success;
+}
+
+
+/**
+ * @brief Write the results of the throughput scaling benchmark as JSON
+ * @ingroup benchmark
+ * @param Path to the output file, "-" writes to stdout
+ * @retval 1=Success/0=Failure
+ */
+int writeThroughputJSON(const char * filename,int useCPUOnly,const char * pinnedCPUs,unsigned int warmupIterations,float durationSeconds,std::vector<struct throughputRun> &runs)
+{
+  FILE * fp = (strcmp(filename,"-")==0) ? stdout : fopen(filename,"w");
+  if (fp==0)
+  {
+    fprintf(stderr,RED "Could not write benchmark results to %s\n" NORMAL,filename);
+    return 0;
+  }
+
+  fprintf(fp,"{\n");
+  writeMachineJSON(fp);
+  fprintf(fp,"  \"configuration\": {\n");
+  fprintf(fp,"    \"mode\": \"throughput\",\n");
+  fprintf(fp,"    \"device\": \"%s\",\n",(useCPUOnly) ? "cpu" : "gpu");
+  fprintf(fp,"    \"pinnedCPUs\": \"%s\",\n",(pinnedCPUs!=0) ? pinnedCPUs : "");
+  fprintf(fp,"    \"warmup\": %u,\n",warmupIterations);
+  fprintf(fp,"    \"duration\": %0.3f\n",durationSeconds);
+  fprintf(fp,"  },\n");
+  fprintf(fp,"  \"runs\": [\n");
+  for (unsigned int r=0; r<runs.size(); r++)
+  {
+    struct throughputRun * run = &runs[r];
+    fprintf(fp,"   {\n");
+    fprintf(fp,"    \"threads\": %u,\n",run->numberOfThreads);
+    fprintf(fp,"    \"intraOpThreads\": %u,\n",run->intraOpThreads);
+    fprintf(fp,"    \"interOpThreads\": %u,\n",run->interOpThreads);
+    fprintf(fp,"    \"seconds\": %0.6f,\n",run->seconds);
+    fprintf(fp,"    \"frames\": %lu,\n",run->frames);
+    fprintf(fp,"    \"fps\": %0.3f,\n",run->fps);
+    fprintf(fp,"    \"efficiency\": %0.4f,\n",run->efficiency);
+    writeTimingSummaryJSON(fp,"latency",&run->overall,0);
+    fprintf(fp,"    \"perThread\": [\n");
+    for (unsigned int i=0; i<run->perThread.size(); i++)
+    {
+      struct benchmarkSummary * summary = &run->perThread[i];
+      fprintf(fp,"      { \"samples\": %lu, \"average\": %0.3f, \"stddev\": %0.3f, \"min\": %lu, \"p50\": %lu, \"p90\": %lu, \"p99\": %lu, \"max\": %lu }%s\n",
+              summary->samples,summary->average,summary->standardDeviation,
+              summary->minimum,summary->p50,summary->p90,summary->p99,summary->maximum,
+              (i+1==run->perThread.size()) ? "" : ",");
+    }
+    fprintf(fp,"    ]\n");
+    fprintf(fp,"   }%s\n",(r+1==runs.size()) ? "" : ",");
+  }
+  fprintf(fp,"  ]\n");
+  fprintf(fp,"}\n");
+
+  if (fp!=stdout) { fclose(fp); } else { fflush(fp); }
+  return 1;
+}
+
+
+/**
+ * @brief Throughput scaling benchmark, runs 1,2,.. up to maximumThreads workers and reports how the aggregate framerate scales
+ * @ingroup benchmark
+ * @retval 1=Success/0=Failure
+ */
+int runThroughputScaling(
+                          unsigned int maximumThreads,
+                          const char * intraOpSetting,
+                          const char * interOpSetting,
+                          unsigned int useCPUOnly,
+                          unsigned int warmupIterations,
+                          float durationSeconds,
+                          const char * pinnedCPUs,
+                          const char * jsonPath,
+                          const struct benchmarkInputs * inputs
+                        )
+{
+  std::vector<struct throughputRun> runs;
+  for (unsigned int numberOfThreads=1; numberOfThreads<=maximumThreads; numberOfThreads++)
+  {
+    struct throughputRun run;
+    fprintf(stderr,"Running %u workers for %0.1f seconds..\n",numberOfThreads,durationSeconds);
+    if (!runThroughput(&run,numberOfThreads,intraOpSetting,interOpSetting,useCPUOnly,warmupIterations,durationSeconds,inputs)) { return 0; }
+    //Efficiency is the framerate we got compared to T times the framerate of a single worker
+    if ( (runs.size()>0) && (runs[0].fps>0.0) ) { run.efficiency = run.fps / (numberOfThreads * runs[0].fps); } else
+                                               { run.efficiency = 1.0; }
+    runs.push_back(run);
+  }
+
+  printCPUName();
+  fprintf(stderr,"\nThreads  intra  inter      fps  efficiency    p50 ms    p90 ms    p99 ms    max ms  slowest thread p99 ms\n");
+  for (unsigned int r=0; r<runs.size(); r++)
+  {
+    struct throughputRun * run = &runs[r];
+    unsigned long slowestP99=0;
+    for (unsigned int i=0; i<run->perThread.size(); i++)
+    {
+      if (run->perThread[i].p99>slowestP99) { slowestP99=run->perThread[i].p99; }
+    }
+    fprintf(stderr,"%7u  %5u  %5u  %7.1f  %9.1f%%  %8.3f  %8.3f  %8.3f  %8.3f  %8.3f\n",
+            run->numberOfThreads,run->intraOpThreads,run->interOpThreads,run->fps,run->efficiency*100,
+            (float) run->overall.p50/1000,(float) run->overall.p90/1000,(float) run->overall.p99/1000,(float) run->overall.maximum/1000,
+            (float) slowestP99/1000);
+  }
+
+  if (jsonPath!=0) { writeThroughputJSON(jsonPath,useCPUOnly,pinnedCPUs,warmupIterations,durationSeconds,runs); }
+  return 1;
+}
+
 
 
 
@@ -182,107 +808,178 @@ int main(int argc, char *argv[])
 //-------------------------------------------------------------------------------------------------
 //     Parse command-line options, switch CPU/GPU execution and pick which benchmark to run
 //-------------------------------------------------------------------------------------------------
-  int useCPUOnly=1;
+  int useCPUOnly=1,verbose=0;
+  const char * statisticsPath=0;
+  const char * jsonPath=0;
+  const char * pinnedCPUs=0;
+  const char * fixturePath=0;
+  int iterationsGiven=0;
+  //By default as many samples as the 5 repetitions of the 200 hardcoded samples that were always used, preceded by a warm-up that is not measured
+  unsigned int warmupIterations=100;
+  unsigned int iterations=5*MocapNETTestInputNumberOfSamples;
+  //Throughput mode, runs 1..maximumThreads workers each with its own MocapNET for a fixed time
+  int throughputMode=0;
+  unsigned int maximumThreads=std::thread::hardware_concurrency();
+  float durationSeconds=5.0;
+  //Size of the Tensorflow thread pools, a number or "split" to share the cores between the workers
+  const char * intraOpSetting=0;
+  const char * interOpSetting=0;
   for (int i=0; i<argc; i++)
   {
     //if (strcmp(argv[i],"--cpu")==0)      { setenv("CUDA_VISIBLE_DEVICES", "", 1);  } else
-    if (strcmp(argv[i],"--gpu")==0)      { useCPUOnly=0;  } else
-    if (strcmp(argv[i],"--test")==0)     { testMocapNETCompression(); exit(0);     } else
-    if (strcmp(argv[i],"--testJSON")==0) { testMocapNETJSONCompression(); exit(0); }
+    if (strcmp(argv[i],"--gpu")==0)        { useCPUOnly=0;  } else
+    if (strcmp(argv[i],"--stats")==0)      { statisticsPath=argv[i+1]; } else
+    if (strcmp(argv[i],"--json")==0)       { jsonPath=argv[i+1]; } else
+    if (strcmp(argv[i],"--warmup")==0)     { warmupIterations=atoi(argv[i+1]); } else
+    if (strcmp(argv[i],"--iterations")==0) { iterations=atoi(argv[i+1]); iterationsGiven=1; } else
+    if (strcmp(argv[i],"--fixture")==0)    { fixturePath=argv[i+1]; } else
+    if (strcmp(argv[i],"--pin")==0)        { pinnedCPUs=argv[i+1]; } else
+    if (strcmp(argv[i],"--throughput")==0) { throughputMode=1; } else
+    if (strcmp(argv[i],"--maxthreads")==0) { maximumThreads=atoi(argv[i+1]); } else
+    if (strcmp(argv[i],"--duration")==0)   { durationSeconds=atof(argv[i+1]); } else
+    if (strcmp(argv[i],"--intra")==0)      { intraOpSetting=argv[i+1]; } else
+    if (strcmp(argv[i],"--inter")==0)      { interOpSetting=argv[i+1]; } else
+    if (strcmp(argv[i],"-v")==0)           { verbose=1; } else
+    if (strcmp(argv[i],"--test")==0)       { testMocapNETCompression(); exit(0);     } else
+    if (strcmp(argv[i],"--testJSON")==0)   { testMocapNETJSONCompression(); exit(0); }
   }
+  if (iterations==0) { iterations=1; }
+  if (maximumThreads==0) { maximumThreads=1; }
+  if (durationSeconds<=0.0) { durationSeconds=1.0; }
 //-------------------------------------------------------------------------------------------------
 
-
-  struct MocapNET mnet={0};
-  if ( loadMocapNET(&mnet,"test",useCPUOnly) )
+  if (MocapNETTestInputNumberOfSamples!=MocapNETTestOutputNumberOfSamples)
   {
-   std::vector<float> inputValues;
-   std::vector<float> outputValuesExpected;
-   if (MocapNETTestInputNumberOfSamples!=MocapNETTestOutputNumberOfSamples)
-   {
      fprintf(stderr,"Wrong number of input/output samples.. \n");
      fprintf(stderr,"There has been a mistake during packaging of MocapNET or you have done something weird with the hardcoded input/output samples\n");
      fprintf(stderr,"Feel free to revert to master or open a ticket here https://github.com/FORTH-ModelBasedTracker/MocapNET/issues\n");
-   }
-     else
-   {
-    //Number of repetitions performed on the test to get a more representative average framerate
-    unsigned int numberOfRepetitions=5;
-
-
-    float totalTime=0.0; //This will count the total time elapsed for all samples
+     return 1;
+  }
 
-    //We repeat tests enough times to get a better average
-    for (int u=0; u<numberOfRepetitions; u++)
-     {
-      unsigned int inputCounter=0;
-      unsigned int outputCounter=0;
-      for (int i=0; i<MocapNETTestInputNumberOfSamples; i++)
-      {
-       inputValues.clear();
-       //--------------------------------------------------------
-       for (int z=0; z<MocapNETTestInputElementsPerSample; z++)
-       {
-         inputValues.push_back(MocapNETTestInput[inputCounter]);
-         ++inputCounter;
-       }
+  //Pinning has to happen before Tensorflow starts its thread pools so that they inherit it
+  if ( (pinnedCPUs!=0) && (!pinToCPUs(pinnedCPUs)) ) { return 1; }
 
-       outputValuesExpected.clear();
-       //--------------------------------------------------------
-       for (int z=0; z<MocapNETTestOutputElementsPerSample; z++)
-       {
-         outputValuesExpected.push_back(MocapNETTestOutput[outputCounter]);
-         ++outputCounter;
-       }
+  struct benchmarkInputs inputs;
+  if (!loadBenchmarkInputs(&inputs,fixturePath)) { return 1; }
+  //A fixture is run once through unless told otherwise
+  if ( (inputs.haveFixture) && (!iterationsGiven) ) { iterations=getNumberOfBenchmarkInputs(&inputs); }
 
+  if (throughputMode)
+  {
+    int success = runThroughputScaling(maximumThreads,intraOpSetting,interOpSetting,useCPUOnly,warmupIterations,durationSeconds,pinnedCPUs,jsonPath,&inputs);
+    closeBenchmarkInputs(&inputs);
+    return (success) ? 0 : 1;
+  }
+  setTensorflowThreading(resolveTensorflowThreads(intraOpSetting,1),resolveTensorflowThreads(interOpSetting,1));
 
+  struct MocapNET mnet={0};
+  if ( loadMocapNET(&mnet,"test",useCPUOnly) )
+  {
+   std::vector<float> scratch;
+   scratch.reserve(MOCAPNET_UNCOMPRESSED_INPUT_SIZE);
+   struct MocapNETResult result;
+   result.fields=MOCAPNET_RESULT_TIMINGS;
 
-       long startTime = GetTickCountMicrosecondsMN();
-       //--------------------------------------------------------
-        std::vector<float>  result = runMocapNET(&mnet,inputValues);
-       //--------------------------------------------------------
-       long endTime = GetTickCountMicrosecondsMN();
-       float sampleTime = (float) (endTime-startTime)/1000;
-       totalTime+=sampleTime; // Add the time needed to evaluate this sample to the total time
+   //Warm-up, lets Tensorflow allocate its buffers and the caches and branch predictors settle
+   for (unsigned int i=0; i<warmupIterations; i++)
+   {
+     runMocapNETWithResult(&mnet,getBenchmarkInput(&inputs,i,scratch),&result);
+   }
+   //Only this mode prints the stage statistics, the throughput mode leaves the timers off
+   enableStageTimers(1);
+   resetStageStatistics();
 
+   std::vector<unsigned long> timings[BENCHMARK_SERIES_NUMBER];
+   for (unsigned int i=0; i<BENCHMARK_SERIES_NUMBER; i++) { timings[i].reserve(iterations); }
 
+   float totalMAE=0.0;
+   unsigned int inaccurateSamples=0,failedSamples=0;
 
+   unsigned long benchmarkStart = getStageTimerTime();
+   for (unsigned int i=0; i<iterations; i++)
+   {
+     unsigned int sampleID = i%getNumberOfBenchmarkInputs(&inputs);
+     const std::vector<float> &input = getBenchmarkInput(&inputs,sampleID,scratch);
+
+     unsigned long startTime = getStageTimerTime();
+     //--------------------------------------------------------
+     int success = runMocapNETWithResult(&mnet,input,&result);
+     //--------------------------------------------------------
+     unsigned long endTime = getStageTimerTime();
+
+     if ( (!success) || (result.output.size()<(unsigned int) MocapNETTestOutputElementsPerSample) ) { ++failedSamples; continue; }
+
+     timings[BENCHMARK_TOTAL].push_back(endTime-startTime);
+     timings[BENCHMARK_NSDM].push_back(result.inputPreparationTime);
+     timings[BENCHMARK_CLASSIFIER].push_back(result.directionTime);
+     timings[BENCHMARK_ENSEMBLE].push_back(result.ensembleTime);
+     if (result.ensemble==MOCAPNET_ENSEMBLE_FRONT) { timings[BENCHMARK_ENSEMBLE_FRONT].push_back(result.ensembleTime); } else
+     if (result.ensemble==MOCAPNET_ENSEMBLE_BACK)  { timings[BENCHMARK_ENSEMBLE_BACK].push_back(result.ensembleTime);  }
+
+     //Fixtures have no expected output
+     if (inputs.haveFixture)
+     {
+       if (verbose) { fprintf(stderr,"Sample %u/%lu - %0.4fms\n", sampleID , getNumberOfBenchmarkInputs(&inputs) , (float) (endTime-startTime)/1000); }
+       continue;
+     }
 
-       float mae=0.0;
-       //--------------------------------------------------------
-        for (int z=0; z<MocapNETTestOutputElementsPerSample; z++)
-        {
-          float roundedExpected = round(outputValuesExpected[z]*1000)/1000;
-          float roundedResult = round(result[z]*1000)/1000;
-
-          if (z!=4) //Ignore 4th coordinate because it has the orientation trick, and there is no reason to rewrite all of the flip logic here..
-           {
-            float difference = roundedExpected-roundedResult;
-            difference = difference * difference;
-            mae+=difference;
-           }
-        }
-       mae/=MocapNETTestOutputElementsPerSample-1;
+     const float * expected = &MocapNETTestOutput[sampleID*MocapNETTestOutputElementsPerSample];
+     float mae=0.0;
+     //--------------------------------------------------------
+      for (int z=0; z<MocapNETTestOutputElementsPerSample; z++)
+      {
+        float roundedExpected = round(expected[z]*1000)/1000;
+        float roundedResult = round(result.output[z]*1000)/1000;
+
+        if (z!=4) //Ignore 4th coordinate because it has the orientation trick, and there is no reason to rewrite all of the flip logic here..
+         {
+          float difference = roundedExpected-roundedResult;
+          difference = difference * difference;
+          mae+=difference;
+         }
+      }
+     mae/=MocapNETTestOutputElementsPerSample-1;
+     totalMAE+=mae;
+     if (mae>=5) { ++inaccurateSamples; }
 
+     if (verbose)
+     {
        if (mae<3) { fprintf(stderr,GREEN);  } else
        if (mae<5) { fprintf(stderr,YELLOW); } else
                   { fprintf(stderr,RED);    }
-       fprintf(stderr,"Sample %u/%u - %0.4fms - mae %0.4f \n" NORMAL, i , MocapNETTestInputNumberOfSamples , sampleTime , mae);
-      }
+       fprintf(stderr,"Sample %u/%u - %0.4fms - mae %0.4f \n" NORMAL, sampleID , MocapNETTestInputNumberOfSamples , (float) (endTime-startTime)/1000 , mae);
      }
+   }
+   unsigned long benchmarkEnd = getStageTimerTime();
 
-     //Also Printout the name of our CPU
-     //---------------------------------
-     printCPUName();
-     //---------------------------------
+   unsigned int measuredSamples = timings[BENCHMARK_TOTAL].size();
+   float averageMAE = (measuredSamples>0) ? totalMAE/measuredSamples : 0.0;
+   float wallTime = (float) (benchmarkEnd-benchmarkStart)/1000000;
 
+   struct benchmarkSummary summaries[BENCHMARK_SERIES_NUMBER];
+   for (unsigned int i=0; i<BENCHMARK_SERIES_NUMBER; i++) { summaries[i]=summarizeTimings(timings[i]); }
 
-     //Do the final calculation for the average framerate
-     float averageTime=(float) totalTime/(numberOfRepetitions*MocapNETTestInputNumberOfSamples);
-     if (averageTime==0.0) { averageTime=0.000001; } //Take care of division by zero
-     fprintf(stderr,"\nTotal %0.2f ms for %u samples - Average %0.2f ms - %0.2f fps\n",totalTime,(numberOfRepetitions*MocapNETTestInputNumberOfSamples),averageTime,(float) 1000/averageTime);
-   }
+   //Also Printout the name of our CPU
+   //---------------------------------
+   printCPUName();
+   //---------------------------------
+
+   if (inputs.haveFixture) { fprintf(stderr,"\n%u samples of %s measured after %u warm-up samples, %u failed\n",measuredSamples,fixturePath,warmupIterations,failedSamples); } else
+                           { fprintf(stderr,"\n%u samples measured after %u warm-up samples, %u failed, average mae %0.4f, %u inaccurate\n",measuredSamples,warmupIterations,failedSamples,averageMAE,inaccurateSamples); }
+   for (unsigned int i=0; i<BENCHMARK_SERIES_NUMBER; i++) { printTimingSummary(stderr,benchmarkSeriesNames[i],&summaries[i]); }
+
+   //Do the final calculation for the average framerate
+   float averageTime=(float) summaries[BENCHMARK_TOTAL].average/1000;
+   if (averageTime==0.0) { averageTime=0.000001; } //Take care of division by zero
+   fprintf(stderr,"\nTotal %0.2f ms for %u samples - Average %0.2f ms - %0.2f fps\n",wallTime*1000,measuredSamples,averageTime,(float) 1000/averageTime);
+
+   //Where the time of every sample went
+   printStageStatistics(stderr);
+   if (statisticsPath!=0) { dumpStageStatistics(statisticsPath); }
+   if (jsonPath!=0)       { writeBenchmarkJSON(jsonPath,useCPUOnly,pinnedCPUs,fixturePath,warmupIterations,measuredSamples,wallTime,averageMAE,inaccurateSamples,summaries); }
 
    unloadMocapNET(&mnet);
   }
+  closeBenchmarkInputs(&inputs);
+  return 0;
 }
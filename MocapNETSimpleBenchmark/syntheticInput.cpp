@@ -0,0 +1,276 @@
+/** @file syntheticInput.cpp
+ *  @brief Generator of arbitrarily long sequences of plausible MocapNET inputs for benchmarks. The 200 hardcoded samples of testCodeInput.hpp are
+ *  played back slowly with interpolation between them, and every frame gets a seeded random scale and translation that drift over time, per joint
+ *  jitter and occlusions that last several frames. Frames are appended to a detection log ( see MocapNETLib/detectionLog.h ) one at a time and
+ *  the writer keeps their offsets in a temporary file, so the generator needs the same memory for any number of frames. MocapNETBenchmark --fixture
+ *  and MocapNETReplay map the file, so only the pages they touch are resident.
+ *  The same seed and settings always produce the same file.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../MocapNETLib/mocapnetRegistry.hpp"
+#include "../MocapNETLib/detectionLog.h"
+#include "testCodeInput.hpp"
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Occlusions last between 1 and this many frames
+#define MAXIMUM_OCCLUSION_LENGTH 15
+
+
+/**
+ * @brief Settings of the generator, the defaults give mildly noisy input
+ */
+struct syntheticInputSettings
+{
+    unsigned long numberOfFrames;
+    unsigned int seed;
+    float framerate;
+    //Samples of testCodeInput.hpp advanced per frame, values below 1 interpolate between them
+    float speed;
+    //Standard deviation of the noise added to every coordinate, in normalized image coordinates
+    float jitter;
+    //Probability of a visible joint getting occluded in a frame
+    float occlusion;
+    float minimumScale;
+    float maximumScale;
+    //Largest translation of the whole body, in normalized image coordinates
+    float maximumTranslation;
+};
+
+
+/**
+ * @brief State carried between frames so that scale, translation and occlusions change smoothly
+ */
+struct syntheticInputState
+{
+    unsigned int random;
+    float scale;
+    float translationX;
+    float translationY;
+    unsigned int occludedFrames[MOCAPNET_UNCOMPRESSED_JOINT_PARTS];
+};
+
+
+float uniformRandom(unsigned int * seed)
+{
+    return (float) rand_r(seed) / RAND_MAX;
+}
+
+
+float gaussianRandom(unsigned int * seed)
+{
+    //Box-Muller transform
+    float u1 = uniformRandom(seed);
+    float u2 = uniformRandom(seed);
+    if (u1<1e-7)
+        {
+            u1=1e-7;
+        }
+    return sqrt(-2.0*log(u1)) * cos(2.0*M_PI*u2);
+}
+
+
+float clampValue(float value,float minimum,float maximum)
+{
+    if (value<minimum)
+        {
+            return minimum;
+        }
+    if (value>maximum)
+        {
+            return maximum;
+        }
+    return value;
+}
+
+
+/**
+ * @brief Produce the next frame of the sequence
+ * @param Settings of the generator
+ * @param State of the generator, updated
+ * @param Number of the frame
+ * @param Output, MOCAPNET_UNCOMPRESSED_INPUT_SIZE floats
+ */
+void generateSyntheticInput(struct syntheticInputSettings * settings,struct syntheticInputState * state,unsigned long frameID,float * output)
+{
+    //Position in the hardcoded samples, consecutive samples are consecutive frames of a recording
+    double position = fmod(frameID * (double) settings->speed,(double) MocapNETTestInputNumberOfSamples);
+    unsigned int sampleA = (unsigned int) position;
+    unsigned int sampleB = (sampleA+1) % MocapNETTestInputNumberOfSamples;
+    float fraction = (float) (position - sampleA);
+    const float * a = &MocapNETTestInput[sampleA*MocapNETTestInputElementsPerSample];
+    const float * b = &MocapNETTestInput[sampleB*MocapNETTestInputElementsPerSample];
+
+    for (unsigned int i=0; i<MOCAPNET_UNCOMPRESSED_JOINT_PARTS; i++)
+        {
+            float visibleA = a[i*3+2];
+            float visibleB = b[i*3+2];
+            if ( (visibleA>0.0) && (visibleB>0.0) )
+                {
+                    output[i*3+0] = a[i*3+0] + (b[i*3+0]-a[i*3+0]) * fraction;
+                    output[i*3+1] = a[i*3+1] + (b[i*3+1]-a[i*3+1]) * fraction;
+                    output[i*3+2] = visibleA;
+                }
+            else
+                {
+                    const float * nearest = (fraction<0.5) ? a : b;
+                    output[i*3+0] = nearest[i*3+0];
+                    output[i*3+1] = nearest[i*3+1];
+                    output[i*3+2] = nearest[i*3+2];
+                }
+        }
+
+    //Scale and translation take a small random step every frame and stay inside their limits
+    state->scale = clampValue(state->scale + 0.005*gaussianRandom(&state->random),settings->minimumScale,settings->maximumScale);
+    state->translationX = clampValue(state->translationX + 0.002*gaussianRandom(&state->random),-settings->maximumTranslation,settings->maximumTranslation);
+    state->translationY = clampValue(state->translationY + 0.002*gaussianRandom(&state->random),-settings->maximumTranslation,settings->maximumTranslation);
+
+    //The body is scaled around its hip ( or the center of the image if the hip is missing )
+    float centerX=0.5,centerY=0.5;
+    if (output[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+2]>0.0)
+        {
+            centerX = output[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+0];
+            centerY = output[MOCAPNET_UNCOMPRESSED_JOINT_HIP*3+1];
+        }
+
+    for (unsigned int i=0; i<MOCAPNET_UNCOMPRESSED_JOINT_PARTS; i++)
+        {
+            if ( (state->occludedFrames[i]==0) && (settings->occlusion>0.0) && (uniformRandom(&state->random)<settings->occlusion) )
+                {
+                    state->occludedFrames[i] = 1 + rand_r(&state->random) % MAXIMUM_OCCLUSION_LENGTH;
+                }
+
+            if ( (state->occludedFrames[i]>0) || (output[i*3+2]<=0.0) )
+                {
+                    if (state->occludedFrames[i]>0)
+                        {
+                            --state->occludedFrames[i];
+                        }
+                    //Missing joints are all zero, like the ones OpenPose did not find
+                    output[i*3+0]=0.0;
+                    output[i*3+1]=0.0;
+                    output[i*3+2]=0.0;
+                    continue;
+                }
+
+            float x = centerX + (output[i*3+0]-centerX) * state->scale + state->translationX + settings->jitter * gaussianRandom(&state->random);
+            float y = centerY + (output[i*3+1]-centerY) * state->scale + state->translationY + settings->jitter * gaussianRandom(&state->random);
+            output[i*3+0] = clampValue(x,0.0,1.0);
+            output[i*3+1] = clampValue(y,0.0,1.0);
+        }
+}
+
+
+int main(int argc, char *argv[])
+{
+    const char * outputPath="synthetic.mndl";
+    struct syntheticInputSettings settings;
+    settings.numberOfFrames=100000;
+    settings.seed=1234;
+    settings.framerate=30.0;
+    settings.speed=0.25;
+    settings.jitter=0.002;
+    settings.occlusion=0.005;
+    settings.minimumScale=0.8;
+    settings.maximumScale=1.2;
+    settings.maximumTranslation=0.1;
+
+    for (int i=0; i<argc; i++)
+        {
+            if (strcmp(argv[i],"-o")==0)
+                {
+                    outputPath=argv[i+1];
+                }
+            else if (strcmp(argv[i],"--frames")==0)
+                {
+                    settings.numberOfFrames=strtoul(argv[i+1],0,10);
+                }
+            else if (strcmp(argv[i],"--seed")==0)
+                {
+                    settings.seed=atoi(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--fps")==0)
+                {
+                    settings.framerate=atof(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--speed")==0)
+                {
+                    settings.speed=atof(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--jitter")==0)
+                {
+                    settings.jitter=atof(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--occlusion")==0)
+                {
+                    settings.occlusion=atof(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--scale")==0)
+                {
+                    settings.minimumScale=atof(argv[i+1]);
+                    settings.maximumScale=atof(argv[i+2]);
+                }
+            else if (strcmp(argv[i],"--translation")==0)
+                {
+                    settings.maximumTranslation=atof(argv[i+1]);
+                }
+        }
+
+    if ( (settings.numberOfFrames==0) || (settings.framerate<=0.0) || (settings.minimumScale>settings.maximumScale) )
+        {
+            fprintf(stderr,RED "Invalid settings, need at least one frame, a positive framerate and a minimum scale that is not above the maximum\n" NORMAL);
+            return 1;
+        }
+    //A detection log can hold up to 4 billion frames
+    if (settings.numberOfFrames>0xFFFFFFFF)
+        {
+            settings.numberOfFrames=0xFFFFFFFF;
+        }
+
+    struct syntheticInputState state;
+    memset(&state,0,sizeof(struct syntheticInputState));
+    state.random=settings.seed;
+    state.scale=(settings.minimumScale+settings.maximumScale)/2;
+
+    struct detectionLogWriter writer;
+    if (!createDetectionLog(&writer,outputPath,MOCAPNET_UNCOMPRESSED_INPUT_SIZE,1920,1080,0,0))
+        {
+            return 1;
+        }
+
+    fprintf(stderr,"Generating %lu frames ( seed %u , jitter %0.4f , occlusion %0.4f , scale %0.2f-%0.2f ) in %s\n",
+            settings.numberOfFrames,settings.seed,settings.jitter,settings.occlusion,settings.minimumScale,settings.maximumScale,outputPath);
+
+    float frame[MOCAPNET_UNCOMPRESSED_INPUT_SIZE];
+    for (unsigned long frameID=0; frameID<settings.numberOfFrames; frameID++)
+        {
+            generateSyntheticInput(&settings,&state,frameID,frame);
+            unsigned long long timestamp = (unsigned long long) (frameID * 1000000.0 / settings.framerate);
+            if (!appendDetectionLogFrame(&writer,frameID,DETECTION_LOG_KEYFRAME,timestamp,0,frame,MOCAPNET_UNCOMPRESSED_INPUT_SIZE,0,0))
+                {
+                    closeDetectionLogWriter(&writer);
+                    return 1;
+                }
+            if ( (frameID>0) && (frameID%1000000==0) )
+                {
+                    fprintf(stderr,"%lu frames..\n",frameID);
+                }
+        }
+
+    if (!closeDetectionLogWriter(&writer))
+        {
+            fprintf(stderr,RED "Failed to finish %s\n" NORMAL,outputPath);
+            return 1;
+        }
+    fprintf(stderr,GREEN "Done, %lu frames written to %s\n" NORMAL,settings.numberOfFrames,outputPath);
+    return 0;
+}
@@ -39,6 +39,10 @@ std::vector<int> get_tensor_shape(tensorflow::Tensor& tensor)
 
 unsigned long tickBase = 0;
 
+//Thread pool sizes of sessions created by loadTensorflowInstance, 0 means the Tensorflow default
+unsigned int tensorflowIntraOpThreads = 0;
+unsigned int tensorflowInterOpThreads = 0;
+
 
 unsigned long GetTickCountMicroseconds()
 {
@@ -58,6 +62,31 @@ unsigned long GetTickCountMicroseconds()
 }
 
 
+void setTensorflowThreading(unsigned int intraOpThreads,unsigned int interOpThreads)
+{
+    tensorflowIntraOpThreads = intraOpThreads;
+    tensorflowInterOpThreads = interOpThreads;
+}
+
+
+/**
+ * @brief Append a field of a serialized ConfigProto that holds an unsigned integer
+ * @param Serialized ConfigProto
+ * @param Tag of the field ( field number << 3 , the wire type of integers is 0 )
+ * @param Value
+ */
+void appendConfigurationVarint(std::vector<uint8_t> &config,uint8_t tag,unsigned int value)
+{
+    config.push_back(tag);
+    while (value>=0x80)
+        {
+            config.push_back( (uint8_t) ( (value & 0x7F) | 0x80 ) );
+            value>>=7;
+        }
+    config.push_back( (uint8_t) value );
+}
+
+
 
 unsigned long GetTickCountMilliseconds()
 {
@@ -139,6 +168,7 @@ int loadTensorflowInstance(
     //--------------------------------------------------------------------------------------------------------------
     net->status      = TF_NewStatus();
     net->options     = TF_NewSessionOptions();
+    std::vector<uint8_t> config;
     if (forceCPU)
         {
             //How do you end up with this byte array you might ask ?
@@ -150,8 +180,22 @@ int loadTensorflowInstance(
                                                                                   log_device_placement=False
                                          );*/
 
-            uint8_t config[] = { 0xa,0x7,0xa,0x3,0x43,0x50,0x55,0x10,0x1,0xa,0x7,0xa,0x3,0x47,0x50,0x55,0x10,0x0,0x38,0x1};
-            TF_SetConfig(net->options, (void*)config,  20 , net->status);
+            uint8_t cpuConfig[] = { 0xa,0x7,0xa,0x3,0x43,0x50,0x55,0x10,0x1,0xa,0x7,0xa,0x3,0x47,0x50,0x55,0x10,0x0,0x38,0x1};
+            config.insert(config.end(),cpuConfig,cpuConfig+20);
+        }
+    //Fields of a ConfigProto can be serialized in any order so the thread pool sizes are simply appended
+    //intra_op_parallelism_threads is field 2 and inter_op_parallelism_threads is field 5
+    if (tensorflowIntraOpThreads>0)
+        {
+            appendConfigurationVarint(config,0x10,tensorflowIntraOpThreads);
+        }
+    if (tensorflowInterOpThreads>0)
+        {
+            appendConfigurationVarint(config,0x28,tensorflowInterOpThreads);
+        }
+    if (config.size()>0)
+        {
+            TF_SetConfig(net->options, (void*)config.data(), config.size(), net->status);
         }
 
     net->session     = TF_NewSession(net->graph,net->options,net->status);
@@ -190,6 +234,7 @@ int unloadTensorflow(struct TensorflowInstance * net)
     //------------------------------------
 
     TF_DeleteStatus(net->status);
+    return 1;
 }
 
 
@@ -434,3 +479,76 @@ std::vector<std::vector<float> > predictTensorflowOnArrayOfHeatmaps(
     tf_utils::DeleteTensor(input_tensor);
     return matrix;
 }
+
+
+
+unsigned int predictTensorflowOnArrayOfHeatmapsNHWC(
+    struct TensorflowInstance * net,
+    unsigned int width ,
+    unsigned int height ,
+    float * data,
+    unsigned int heatmapWidth,
+    unsigned int heatmapHeight,
+    unsigned int numberOfOutputTensors,
+    std::vector<float> &output
+)
+{
+    TF_Tensor* output_tensor = nullptr;
+    std::vector<std::int64_t> input_dims = {1,height,width,3};
+
+    TF_Tensor* input_tensor = tf_utils::CreateTensor(
+                                  TF_FLOAT,
+                                  input_dims.data(), 4,
+                                  data , width * height * 3 * sizeof(float)
+                              );
+
+    TF_SessionRun( net->session,
+                   nullptr, // Run options.
+                   &net->input_operation,    &input_tensor,  1, // Input tensors,  input tensor values,  number of inputs.
+                   &net->output_operation,   &output_tensor, 1, // Output tensors, output tensor values, number of outputs.
+                   nullptr, 0, // Target operations, number of targets.
+                   nullptr, // Run metadata.
+                   net->status // Output status.
+                 );
+    tf_utils::DeleteTensor(input_tensor);
+
+    if ( (TF_GetCode(net->status) != TF_OK) || (output_tensor==nullptr) )
+        {
+            fprintf(stderr,RED "Error running session\n"  NORMAL);
+            if (output_tensor!=nullptr)
+                {
+                    tf_utils::DeleteTensor(output_tensor);
+                }
+            return 0;
+        }
+
+    int64_t outputSizeA[32]= {0};
+    TF_GraphGetTensorShape(
+        net->graph,
+        net->output_operation,
+        outputSizeA, numberOfOutputTensors,
+        net->status
+    );
+    if (TF_GetCode(net->status) != TF_OK)
+        {
+            fprintf(stderr,RED "Error TF_GraphGetTensorShape for output, numberOfOutputTensors is probably wrong..! \n" NORMAL);
+            tf_utils::DeleteTensor(output_tensor);
+            return 0;
+        }
+
+    //Same as predictTensorflowOnArrayOfHeatmaps the spatial dimensions come from the caller since they are reported as -1
+    unsigned int hm = outputSizeA[numberOfOutputTensors-1];
+    size_t numberOfValues = (size_t) heatmapWidth * heatmapHeight * hm;
+    float * out_p = static_cast<float*>(TF_TensorData(output_tensor));
+    if ( (out_p==nullptr) || (hm==0) || (TF_TensorByteSize(output_tensor) < numberOfValues * sizeof(float)) )
+        {
+            fprintf(stderr,RED "Error retrieving output..\n"  NORMAL);
+            tf_utils::DeleteTensor(output_tensor);
+            return 0;
+        }
+
+    //One copy of the whole tensor, the vector keeps its storage between calls
+    output.assign(out_p,out_p+numberOfValues);
+    tf_utils::DeleteTensor(output_tensor);
+    return hm;
+}
@@ -60,6 +60,16 @@ unsigned long GetTickCountMilliseconds();
 void listNodes(const char * label , TF_Graph* graph);
 
 
+/**
+ * @brief Set the size of the thread pools of every tensorflow instance loaded after this call. Each session gets its own pools so
+ * when many instances run side by side the defaults ( as many threads as there are cores for each ) oversubscribe the CPU.
+ * @ingroup tensorflow
+ * @param Number of threads used to parallelize a single operation ( intra_op_parallelism_threads ), 0 lets Tensorflow decide
+ * @param Number of threads used to run independent operations in parallel ( inter_op_parallelism_threads ), 0 lets Tensorflow decide
+ */
+void setTensorflowThreading(unsigned int intraOpThreads,unsigned int interOpThreads);
+
+
 /**
  * @brief Load a tensorflow instance from a .pb file
  * @ingroup tensorflow
@@ -109,6 +119,32 @@ std::vector<std::vector<float> > predictTensorflowOnArrayOfHeatmaps(
                                                                    );
 
 
+/**
+ * @brief Evaluate an input image through a network that outputs heatmaps and keep its output as it is, heatmapHeight x heatmapWidth x heatmaps
+ * with the heatmaps changing fastest ( NHWC ). Unlike predictTensorflowOnArrayOfHeatmaps the heatmaps are not split in separate vectors.
+ * @ingroup tensorflow
+ * @param Pointer to a struct TensorflowInstance that holds a loaded tensorflow instance.
+ * @param Width of input image
+ * @param Height of input image
+ * @param Pixels of input image
+ * @param Width of the heatmaps
+ * @param Height of the heatmaps
+ * @param Number of dimensions of the output tensor
+ * @param Vector that will receive the output, it is resized as needed so reusing it avoids allocations
+ * @retval Number of heatmaps, 0 = Failure
+ */
+unsigned int predictTensorflowOnArrayOfHeatmapsNHWC(
+                                                     struct TensorflowInstance * net,
+                                                     unsigned int width ,
+                                                     unsigned int height ,
+                                                     float * data,
+                                                     unsigned int heatmapWidth,
+                                                     unsigned int heatmapHeight,
+                                                     unsigned int numberOfOutputTensors,
+                                                     std::vector<float> &output
+                                                   );
+
+
 /**
  * @brief Clean tensorflow instance from memory and deallocate it
  * @ingroup tensorflow
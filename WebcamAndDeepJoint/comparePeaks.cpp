@@ -0,0 +1,200 @@
+/** @file comparePeaks.cpp
+ *  @brief Runs the heatmaps stored in a detection log ( WebcamJointBIN --recorddetections log.mndl --recordheatmaps ) through both the original
+ *  peak extraction ( one cv::Mat per heatmap, dj_extractPeaksFromMap/dj_upscalePeakPosition ) and the single pass NHWC peak extractor that replaced it
+ *  ( peakExtractor.hpp ) and reports how well the 2D joints they give agree. The original refines peaks to the maximum of a blurred neighbourhood while
+ *  the new code fits a parabola, so positions are expected to differ by a fraction of a heatmap pixel, the joints that are found should be the same.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+#include "utilities.hpp"
+#include "peakExtractor.hpp"
+#include "../MocapNETLib/detectionLog.h"
+
+
+/**
+ * @brief Agreement of the two peak extraction paths accumulated over a log
+ */
+struct peakAgreement
+{
+    unsigned int frames;
+    unsigned int joints;
+    unsigned int foundByBoth;
+    unsigned int foundByNeither;
+    unsigned int onlyOriginal;
+    unsigned int onlyNHWC;
+    unsigned int withinTolerance;
+    double sumOfDifferences;
+    float maximumDifference;
+};
+
+
+/**
+ * @brief Compare the joints of one frame, a joint at 0,0 was not found
+ * @ingroup utilities
+ * @param Joints from dj_getNeuralNetworkDetectionsForColorImage
+ * @param Joints from dj_getNeuralNetworkDetectionsFromNHWC
+ * @param Width of a heatmap pixel in image pixels
+ * @param Height of a heatmap pixel in image pixels
+ * @param Largest accepted difference in heatmap pixels
+ * @param Agreement that gets updated
+ */
+void compareFramePeaks(
+    const std::vector<cv::Point_<float> > &original,
+    const std::vector<cv::Point_<float> > &nhwc,
+    float pixelWidth,
+    float pixelHeight,
+    float tolerance,
+    struct peakAgreement * agreement
+)
+{
+    for (unsigned int jID=0; (jID<original.size()) && (jID<nhwc.size()); jID++)
+        {
+            int foundOriginal = ( (original[jID].x!=0.0) || (original[jID].y!=0.0) );
+            int foundNHWC     = ( (nhwc[jID].x!=0.0) || (nhwc[jID].y!=0.0) );
+            ++agreement->joints;
+            if ( (!foundOriginal) && (!foundNHWC) )
+                {
+                    ++agreement->foundByNeither;
+                    ++agreement->withinTolerance;
+                }
+            else if (!foundNHWC)
+                {
+                    ++agreement->onlyOriginal;
+                }
+            else if (!foundOriginal)
+                {
+                    ++agreement->onlyNHWC;
+                }
+            else
+                {
+                    //Differences are measured in heatmap pixels so they do not depend on the resolution of the camera
+                    float dX = fabs(original[jID].x-nhwc[jID].x) / pixelWidth;
+                    float dY = fabs(original[jID].y-nhwc[jID].y) / pixelHeight;
+                    float difference = sqrt(dX*dX+dY*dY);
+                    ++agreement->foundByBoth;
+                    agreement->sumOfDifferences+=difference;
+                    if (difference>agreement->maximumDifference)
+                        {
+                            agreement->maximumDifference=difference;
+                        }
+                    if (difference<=tolerance)
+                        {
+                            ++agreement->withinTolerance;
+                        }
+                }
+        }
+}
+
+
+int main(int argc, char *argv[])
+{
+    const char * logPath=0;
+    float minThreshold=0.35; //The default joint2DSensitivity of WebcamJointBIN
+    float tolerance=1.0;
+
+    for (int i=0; i<argc; i++)
+        {
+            if (strcmp(argv[i],"--from")==0)
+                {
+                    logPath = argv[i+1];
+                }
+            else if (strcmp(argv[i],"--threshold")==0)
+                {
+                    minThreshold = atof(argv[i+1]);
+                }
+            else if (strcmp(argv[i],"--tolerance")==0)
+                {
+                    //Largest accepted difference between the two paths in heatmap pixels
+                    tolerance = atof(argv[i+1]);
+                }
+        }
+
+    if (logPath==0)
+        {
+            fprintf(stderr,"Please give a detection log with heatmaps using --from, you can record one with WebcamJointBIN --recorddetections log.mndl --recordheatmaps\n");
+            return 1;
+        }
+
+    struct detectionLog log;
+    if (!openDetectionLog(&log,logPath))
+        {
+            return 1;
+        }
+    unsigned int heatmapWidth  = log.header->heatmapWidth;
+    unsigned int heatmapHeight = log.header->heatmapHeight;
+    unsigned int width  = (log.header->frameWidth>0)  ? log.header->frameWidth  : 1920;
+    unsigned int height = (log.header->frameHeight>0) ? log.header->frameHeight : 1080;
+    if ( (heatmapWidth==0) || (heatmapHeight==0) )
+        {
+            fprintf(stderr,RED "%s was recorded without --recordheatmaps\n" NORMAL,logPath);
+            closeDetectionLog(&log);
+            return 1;
+        }
+
+    //Only the resolution of the color image is used when nothing is visualized
+    cv::Mat colorImage(height,width,CV_8UC3);
+    std::vector<cv::Mat> heatmaps;
+    struct peakAgreement agreement= {0};
+    struct detectionLogFrame frame;
+    unsigned int numberOfFrames = getDetectionLogNumberOfFrames(&log);
+
+    for (unsigned int frameID=0; frameID<numberOfFrames; frameID++)
+        {
+            if ( (!readDetectionLogFrame(&log,frameID,&frame)) || (frame.numberOfHeatmapValues==0) )
+                {
+                    continue;
+                }
+            //Networks that also output PAFs store them after the heatmaps, the original path always expects the background heatmap as well
+            unsigned int channels = frame.numberOfHeatmapValues / (heatmapWidth*heatmapHeight);
+            if (channels<UT_COCO_PARTS)
+                {
+                    fprintf(stderr,YELLOW "Frame %u has %u heatmaps, at least %u are needed\n" NORMAL,frame.frameNumber,channels,UT_COCO_PARTS);
+                    continue;
+                }
+
+            heatmaps.resize(UT_COCO_PARTS);
+            for (unsigned int hm=0; hm<UT_COCO_PARTS; hm++)
+                {
+                    heatmaps[hm].create(heatmapHeight,heatmapWidth,CV_32FC1);
+                    for (unsigned int y=0; y<heatmapHeight; y++)
+                        {
+                            float * line = heatmaps[hm].ptr<float>(y);
+                            for (unsigned int x=0; x<heatmapWidth; x++)
+                                {
+                                    line[x] = frame.heatmaps[ (y*heatmapWidth+x) * channels + hm ];
+                                }
+                        }
+                }
+
+            std::vector<cv::Point_<float> > original = dj_getNeuralNetworkDetectionsForColorImage(colorImage,colorImage,heatmaps,minThreshold,0,0);
+            std::vector<cv::Point_<float> > nhwc = dj_getNeuralNetworkDetectionsFromNHWC(colorImage,colorImage,frame.heatmaps,heatmapWidth,heatmapHeight,UT_COCO_PARTS,channels,minThreshold,0,0);
+            compareFramePeaks(original,nhwc,(float) width/heatmapWidth,(float) height/heatmapHeight,tolerance,&agreement);
+            ++agreement.frames;
+        }
+    closeDetectionLog(&log);
+
+    if (agreement.joints==0)
+        {
+            fprintf(stderr,RED "%s has no frames with heatmaps\n" NORMAL,logPath);
+            return 1;
+        }
+
+    unsigned int disagreements = agreement.joints - agreement.withinTolerance;
+    fprintf(stderr,"Frames with heatmaps : %u ( %u joints, threshold %0.2f )\n",agreement.frames,agreement.joints,minThreshold);
+    fprintf(stderr,"Found by both : %u , by neither : %u , only by the original : %u , only by the NHWC extractor : %u\n",
+            agreement.foundByBoth,agreement.foundByNeither,agreement.onlyOriginal,agreement.onlyNHWC);
+    if (agreement.foundByBoth>0)
+        {
+            fprintf(stderr,"Difference of joints found by both : mean %0.3f / max %0.3f heatmap pixels\n",
+                    agreement.sumOfDifferences/agreement.foundByBoth,agreement.maximumDifference);
+        }
+    fprintf(stderr,"%s%0.2f%% of the joints agree within %0.2f heatmap pixels\n" NORMAL,
+            (disagreements==0) ? GREEN : RED,100.0 * agreement.withinTolerance / agreement.joints,tolerance);
+
+    return (disagreements==0) ? 0 : 1;
+}
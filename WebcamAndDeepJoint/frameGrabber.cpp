@@ -0,0 +1,375 @@
+#include "frameGrabber.hpp"
+#include "../MocapNETLib/tools.h"
+
+#include <stdio.h>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <condition_variable>
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+
+enum FrameGrabberSlotState
+{
+    FRAME_GRABBER_SLOT_FREE=0,
+    FRAME_GRABBER_SLOT_WRITING,
+    FRAME_GRABBER_SLOT_READY
+};
+
+struct FrameGrabberSlot
+{
+    cv::Mat frame;
+    int state;
+    unsigned int frameNumber;
+    unsigned long timestamp;
+};
+
+struct FrameGrabber
+{
+    cv::VideoCapture * cap;
+    int latestFrameOnly;
+    signed int totalNumberOfFrames;
+    unsigned int quitAfterNSkippedFrames;
+
+    std::vector<struct FrameGrabberSlot> ring;
+    std::mutex lock;
+    std::condition_variable frameReady;
+    std::condition_variable slotFree;
+    int stop;
+    int ended;
+
+    unsigned int framesCaptured;
+    unsigned int framesDropped;
+    unsigned int framesSkipped;
+
+    unsigned long latencySum;
+    unsigned long latencyMaximum;
+    unsigned int latencySamples;
+
+    std::thread worker;
+};
+
+
+/*
+ * A Mat given back by the consumer may still be referenced somewhere else, reading in to it would overwrite an image that is still in use
+ */
+static int isShared(const cv::Mat & frame)
+{
+#if CV_MAJOR_VERSION >= 3
+    return ( (frame.u!=0) && (frame.u->refcount>1) );
+#else
+    return ( (frame.refcount!=0) && (*frame.refcount>1) );
+#endif
+}
+
+
+/*
+ * Ready slot to hand out, the newest one for live sources, the oldest one otherwise, -1 if there is none
+ */
+static int findReadySlot(struct FrameGrabber * grabber,int newest)
+{
+    int found=-1;
+    for (unsigned int i=0; i<grabber->ring.size(); i++)
+        {
+            if (grabber->ring[i].state==FRAME_GRABBER_SLOT_READY)
+                {
+                    if (
+                        (found==-1) ||
+                        ( (newest)  && (grabber->ring[i].frameNumber>grabber->ring[found].frameNumber) ) ||
+                        ( (!newest) && (grabber->ring[i].frameNumber<grabber->ring[found].frameNumber) )
+                    )
+                        {
+                            found=i;
+                        }
+                }
+        }
+    return found;
+}
+
+
+static int findFreeSlot(struct FrameGrabber * grabber)
+{
+    for (unsigned int i=0; i<grabber->ring.size(); i++)
+        {
+            if (grabber->ring[i].state==FRAME_GRABBER_SLOT_FREE)
+                {
+                    return i;
+                }
+        }
+    return -1;
+}
+
+
+static void frameGrabberThread(struct FrameGrabber * grabber)
+{
+    while (1)
+        {
+            int slot=-1;
+            {
+                std::unique_lock<std::mutex> guard(grabber->lock);
+                while (!grabber->stop)
+                    {
+                        slot=findFreeSlot(grabber);
+                        if (slot!=-1)
+                            {
+                                break;
+                            }
+                        //Files wait for the consumer, they cannot lose frames
+                        grabber->slotFree.wait(guard);
+                    }
+                if (grabber->stop)
+                    {
+                        break;
+                    }
+                grabber->ring[slot].state=FRAME_GRABBER_SLOT_WRITING;
+            }
+
+            struct FrameGrabberSlot * target = &grabber->ring[slot];
+            if (isShared(target->frame))
+                {
+                    target->frame.release();
+                }
+            int success = grabber->cap->read(target->frame);
+            unsigned long now = GetTickCountMicrosecondsMN();
+
+            int ended=0;
+            {
+                std::lock_guard<std::mutex> guard(grabber->lock);
+                if ( (success) && (!target->frame.empty()) )
+                    {
+                        if (grabber->latestFrameOnly)
+                            {
+                                //Nobody asked for the older frames in time, they are stale now
+                                for (unsigned int i=0; i<grabber->ring.size(); i++)
+                                    {
+                                        if (grabber->ring[i].state==FRAME_GRABBER_SLOT_READY)
+                                            {
+                                                grabber->ring[i].state=FRAME_GRABBER_SLOT_FREE;
+                                                ++grabber->framesDropped;
+                                            }
+                                    }
+                            }
+                        target->state=FRAME_GRABBER_SLOT_READY;
+                        target->frameNumber=grabber->framesCaptured;
+                        target->timestamp=now;
+                        ++grabber->framesCaptured;
+                    }
+                else
+                    {
+                        target->state=FRAME_GRABBER_SLOT_FREE;
+                        if ( (grabber->totalNumberOfFrames>0) && (grabber->framesSkipped+grabber->framesCaptured>=(unsigned int) grabber->totalNumberOfFrames) )
+                            {
+                                fprintf(stderr,GREEN "Stream appears to have ended..\n" NORMAL);
+                                ended=1;
+                            }
+                        else
+                            {
+                                ++grabber->framesSkipped;
+                                fprintf(stderr,YELLOW "OpenCV failed to snap frame %u from your input source\n" NORMAL,grabber->framesCaptured);
+                                fprintf(stderr,NORMAL "Skipped frames %u/%u\n" NORMAL,grabber->framesSkipped,grabber->framesCaptured);
+                                if (grabber->framesSkipped>grabber->quitAfterNSkippedFrames)
+                                    {
+                                        fprintf(stderr,RED "We have encountered %u skipped frames so quitting ..\n" NORMAL,grabber->quitAfterNSkippedFrames);
+                                        fprintf(stderr,RED "If you don't want this to happen consider using the flag --maxskippedframes and providing a bigger value ..\n" NORMAL);
+                                        ended=1;
+                                    }
+                            }
+                    }
+                if (ended)
+                    {
+                        grabber->ended=1;
+                    }
+            }
+            grabber->frameReady.notify_all();
+            if (ended)
+                {
+                    break;
+                }
+        }
+
+    {
+        std::lock_guard<std::mutex> guard(grabber->lock);
+        grabber->ended=1;
+    }
+    grabber->frameReady.notify_all();
+}
+
+
+struct FrameGrabber * createFrameGrabber(
+    cv::VideoCapture * cap,
+    unsigned int ringSize,
+    int latestFrameOnly,
+    signed int totalNumberOfFrames,
+    unsigned int quitAfterNSkippedFrames
+)
+{
+    if ( (cap==0) || (!cap->isOpened()) )
+        {
+            fprintf(stderr,RED "Cannot grab frames from a closed input\n" NORMAL);
+            return 0;
+        }
+    //One slot being written, one ready and one with the consumer
+    if (ringSize<3)
+        {
+            ringSize=3;
+        }
+
+    struct FrameGrabber * grabber = new FrameGrabber;
+    grabber->cap=cap;
+    grabber->latestFrameOnly=latestFrameOnly;
+    grabber->totalNumberOfFrames=totalNumberOfFrames;
+    grabber->quitAfterNSkippedFrames=quitAfterNSkippedFrames;
+    grabber->ring.resize(ringSize);
+    for (unsigned int i=0; i<ringSize; i++)
+        {
+            grabber->ring[i].state=FRAME_GRABBER_SLOT_FREE;
+            grabber->ring[i].frameNumber=0;
+            grabber->ring[i].timestamp=0;
+        }
+    grabber->stop=0;
+    grabber->ended=0;
+    grabber->framesCaptured=0;
+    grabber->framesDropped=0;
+    grabber->framesSkipped=0;
+    grabber->latencySum=0;
+    grabber->latencyMaximum=0;
+    grabber->latencySamples=0;
+
+    //Make sure the tick base is initialized before the thread asks for it
+    GetTickCountMicrosecondsMN();
+    grabber->worker = std::thread(frameGrabberThread,grabber);
+    return grabber;
+}
+
+
+int grabFrame(struct FrameGrabber * grabber,cv::Mat & frame,struct GrabbedFrameInfo * info)
+{
+    if (grabber==0)
+        {
+            return 0;
+        }
+
+    {
+        std::unique_lock<std::mutex> guard(grabber->lock);
+        int slot=-1;
+        while (1)
+            {
+                slot=findReadySlot(grabber,grabber->latestFrameOnly);
+                if ( (slot!=-1) || (grabber->ended) || (grabber->stop) )
+                    {
+                        break;
+                    }
+                grabber->frameReady.wait(guard);
+            }
+        if ( (slot==-1) || (grabber->stop) )
+            {
+                return 0;
+            }
+
+        //The previous buffer of the consumer goes back to the ring to be reused
+        struct FrameGrabberSlot * source = &grabber->ring[slot];
+        std::swap(frame,source->frame);
+        source->state=FRAME_GRABBER_SLOT_FREE;
+
+        if (info!=0)
+            {
+                info->frameNumber=source->frameNumber;
+                info->skippedFrames=grabber->framesSkipped;
+                info->droppedFrames=grabber->framesDropped;
+                info->ageMicroseconds=GetTickCountMicrosecondsMN()-source->timestamp;
+            }
+    }
+    grabber->slotFree.notify_one();
+    return 1;
+}
+
+
+void frameGrabberReportLatency(struct FrameGrabber * grabber,unsigned long microseconds)
+{
+    if (grabber==0)
+        {
+            return;
+        }
+    std::lock_guard<std::mutex> guard(grabber->lock);
+    grabber->latencySum+=microseconds;
+    ++grabber->latencySamples;
+    if (microseconds>grabber->latencyMaximum)
+        {
+            grabber->latencyMaximum=microseconds;
+        }
+}
+
+
+int getFrameGrabberStatistics(
+    struct FrameGrabber * grabber,
+    unsigned int * framesCaptured,
+    unsigned int * framesDropped,
+    unsigned int * framesSkipped,
+    float * averageLatency,
+    float * maximumLatency
+)
+{
+    if (grabber==0)
+        {
+            return 0;
+        }
+    std::lock_guard<std::mutex> guard(grabber->lock);
+    if (framesCaptured!=0)
+        {
+            *framesCaptured=grabber->framesCaptured;
+        }
+    if (framesDropped!=0)
+        {
+            *framesDropped=grabber->framesDropped;
+        }
+    if (framesSkipped!=0)
+        {
+            *framesSkipped=grabber->framesSkipped;
+        }
+    if (averageLatency!=0)
+        {
+            *averageLatency = (grabber->latencySamples>0) ? (float) grabber->latencySum/grabber->latencySamples/1000 : 0.0;
+        }
+    if (maximumLatency!=0)
+        {
+            *maximumLatency = (float) grabber->latencyMaximum/1000;
+        }
+    return 1;
+}
+
+
+void stopFrameGrabber(struct FrameGrabber * grabber)
+{
+    if (grabber==0)
+        {
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> guard(grabber->lock);
+        grabber->stop=1;
+    }
+    grabber->frameReady.notify_all();
+    grabber->slotFree.notify_all();
+}
+
+
+int destroyFrameGrabber(struct FrameGrabber * grabber)
+{
+    if (grabber==0)
+        {
+            return 0;
+        }
+    stopFrameGrabber(grabber);
+    if (grabber->worker.joinable())
+        {
+            grabber->worker.join();
+        }
+    delete grabber;
+    return 1;
+}
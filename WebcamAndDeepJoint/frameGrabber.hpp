@@ -0,0 +1,111 @@
+#pragma once
+/** @file frameGrabber.hpp
+ *  @brief A capture thread that keeps reading from a cv::VideoCapture in to a small ring of reusable cv::Mat so that the driver buffer never fills up
+ *  while the rest of the demo is busy. For live sources the consumer always gets the newest frame and older frames that were never asked for are dropped,
+ *  for files every frame is handed over in order and the thread just reads ahead. Frames are swapped in and out of the ring so after the first few frames
+ *  no image memory is allocated. Counters keep track of dropped/skipped frames and of the latency from the moment a frame was captured to the moment its
+ *  output was ready.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include "opencv2/opencv.hpp"
+
+/**
+ * @brief Default number of cv::Mat in the ring
+ */
+#define FRAME_GRABBER_DEFAULT_RING_SIZE 3
+
+
+/**
+ * @brief Information about a frame handed to the consumer
+ */
+struct GrabbedFrameInfo
+{
+    //Number of the frame among the ones successfully captured so far
+    unsigned int frameNumber;
+    //Reads that failed so far
+    unsigned int skippedFrames;
+    //Frames captured but never handed to the consumer because a newer one was available
+    unsigned int droppedFrames;
+    //How long ago the frame was captured
+    unsigned long ageMicroseconds;
+};
+
+
+/**
+ * @brief Opaque handle of a frame grabber
+ */
+struct FrameGrabber;
+
+
+/**
+ * @brief Start a capture thread
+ * @ingroup demo
+ * @param An opened cv::VideoCapture, it should not be used by anybody else until the grabber is destroyed
+ * @param Number of cv::Mat in the ring, at least 3 are used
+ * @param 1 = Live source, hand out the newest frame and drop older ones , 0 = Hand out every frame in order
+ * @param Number of frames the source has ( 0 if unknown ), when this many reads happened the stream is considered finished
+ * @param Number of failed reads after which the stream is considered finished
+ * @retval Pointer to a frame grabber, 0 = Failure
+ */
+struct FrameGrabber * createFrameGrabber(
+                                          cv::VideoCapture * cap,
+                                          unsigned int ringSize,
+                                          int latestFrameOnly,
+                                          signed int totalNumberOfFrames,
+                                          unsigned int quitAfterNSkippedFrames
+                                        );
+
+/**
+ * @brief Get the next frame, waits until one is available. The Mat given is swapped with the one of the ring so its buffer is reused by the capture thread,
+ * anything else still referencing the previous contents of frame keeps them alive and the ring simply allocates a new buffer in that case
+ * @ingroup demo
+ * @param Pointer to a frame grabber
+ * @param Mat that will receive the frame
+ * @param Pointer to a structure that will receive information about the frame, can be null
+ * @retval 1 = Got a frame , 0 = The stream ended or the grabber was stopped
+ */
+int grabFrame(struct FrameGrabber * grabber,cv::Mat & frame,struct GrabbedFrameInfo * info);
+
+/**
+ * @brief Add a measurement of the time between the capture of a frame and the moment its output was ready
+ * @ingroup demo
+ * @param Pointer to a frame grabber
+ * @param Latency in microseconds
+ */
+void frameGrabberReportLatency(struct FrameGrabber * grabber,unsigned long microseconds);
+
+/**
+ * @brief Get the counters of a frame grabber
+ * @ingroup demo
+ * @param Pointer to a frame grabber
+ * @param Pointer to an unsigned int that will receive the number of frames captured, can be null
+ * @param Pointer to an unsigned int that will receive the number of frames dropped, can be null
+ * @param Pointer to an unsigned int that will receive the number of failed reads, can be null
+ * @param Pointer to a float that will receive the average latency in milliseconds, can be null
+ * @param Pointer to a float that will receive the worst latency in milliseconds, can be null
+ * @retval 1 = Success , 0 = Failure
+ */
+int getFrameGrabberStatistics(
+                               struct FrameGrabber * grabber,
+                               unsigned int * framesCaptured,
+                               unsigned int * framesDropped,
+                               unsigned int * framesSkipped,
+                               float * averageLatency,
+                               float * maximumLatency
+                             );
+
+/**
+ * @brief Stop the capture thread and wake up anybody waiting for a frame, grabFrame fails from now on
+ * @ingroup demo
+ * @param Pointer to a frame grabber
+ */
+void stopFrameGrabber(struct FrameGrabber * grabber);
+
+/**
+ * @brief Stop the capture thread and free the grabber
+ * @ingroup demo
+ * @param Pointer to a frame grabber
+ * @retval 1 = Success , 0 = Failure
+ */
+int destroyFrameGrabber(struct FrameGrabber * grabber);
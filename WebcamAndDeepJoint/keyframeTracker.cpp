@@ -0,0 +1,277 @@
+#include "keyframeTracker.hpp"
+#include "../MocapNETLib/tools.h"
+
+#include <stdio.h>
+#include <math.h>
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Weight of the newest measurement in the running averages of the stage times
+#define KEYFRAME_TRACKER_TIME_SMOOTHING 0.2
+//A joint tracked forward and then back has to land this close ( in pixels ) to where it started
+#define KEYFRAME_TRACKER_MAX_FORWARD_BACKWARD_ERROR 2.0
+//Lucas-Kanade window size and pyramid levels
+#define KEYFRAME_TRACKER_WINDOW_SIZE 21
+#define KEYFRAME_TRACKER_PYRAMID_LEVELS 3
+
+
+static void toGray(const cv::Mat & frame,cv::Mat & gray)
+{
+    if (frame.channels()==1)
+        {
+            gray=frame.clone();
+        }
+    else
+        {
+            cv::cvtColor(frame,gray,cv::COLOR_BGR2GRAY);
+        }
+}
+
+
+static void updateAverage(float * average,float milliseconds)
+{
+    if (*average<=0.0)
+        {
+            *average=milliseconds;
+        }
+    else
+        {
+            *average = (1.0-KEYFRAME_TRACKER_TIME_SMOOTHING) * (*average) + KEYFRAME_TRACKER_TIME_SMOOTHING * milliseconds;
+        }
+}
+
+
+/*
+ * With an interval of K the 2D stage spends (D + (K-1)*T)/K per frame where D is the keyframe time and T the tracked frame time,
+ * the smallest K that fits in the budget of the target framerate is used
+ */
+static void updateInterval(struct KeyframeTracker * tracker)
+{
+    if (tracker->maxInterval<=1)
+        {
+            tracker->interval=1;
+            return;
+        }
+    if (tracker->targetFPS<=0.0)
+        {
+            tracker->interval=tracker->maxInterval;
+            return;
+        }
+
+    float budget = 1000.0 / tracker->targetFPS;
+    float D = tracker->keyframeMilliseconds;
+    float T = tracker->trackedFrameMilliseconds;
+
+    unsigned int interval;
+    if (D<=budget)
+        {
+            interval=1;
+        }
+    else if (T>=budget)
+        {
+            interval=tracker->maxInterval;
+        }
+    else
+        {
+            interval = (unsigned int) ceil( (D-T) / (budget-T) );
+        }
+
+    if (interval<1)
+        {
+            interval=1;
+        }
+    if (interval>tracker->maxInterval)
+        {
+            interval=tracker->maxInterval;
+        }
+    tracker->interval=interval;
+}
+
+
+void initializeKeyframeTracker(struct KeyframeTracker * tracker,unsigned int maxInterval,float targetFPS)
+{
+    tracker->maxInterval = (maxInterval>0) ? maxInterval : 1;
+    tracker->targetFPS = targetFPS;
+    tracker->minConfidence = KEYFRAME_TRACKER_MIN_CONFIDENCE;
+    tracker->interval = 1;
+    tracker->framesSinceKeyframe = 0;
+    tracker->confidence = 0.0;
+    tracker->keyframeMilliseconds = 0.0;
+    tracker->trackedFrameMilliseconds = 0.0;
+    tracker->keyframes = 0;
+    tracker->trackedFrames = 0;
+    tracker->previousGray.release();
+    tracker->previousJoints.clear();
+    tracker->velocity.clear();
+    tracker->jointValid.clear();
+}
+
+
+int keyframeTrackerNeedsKeyframe(struct KeyframeTracker * tracker)
+{
+    if ( (tracker->maxInterval<=1) || (tracker->previousJoints.size()==0) || (tracker->previousGray.empty()) )
+        {
+            return 1;
+        }
+    if (tracker->framesSinceKeyframe+1>=tracker->interval)
+        {
+            return 1;
+        }
+    //The last tracked frame lost too many joints
+    if ( (tracker->framesSinceKeyframe>0) && (tracker->confidence<tracker->minConfidence) )
+        {
+            return 1;
+        }
+    return 0;
+}
+
+
+void keyframeTrackerAddKeyframe(
+    struct KeyframeTracker * tracker,
+    const cv::Mat & frame,
+    const std::vector<std::vector<float> > & points2D,
+    unsigned long microseconds
+)
+{
+    updateAverage(&tracker->keyframeMilliseconds,(float) microseconds/1000);
+    updateInterval(tracker);
+    tracker->framesSinceKeyframe=0;
+    tracker->confidence=1.0;
+    ++tracker->keyframes;
+
+    if (points2D.size()==0)
+        {
+            //Nobody to track, the next frame will be a keyframe as well
+            tracker->previousJoints.clear();
+            tracker->velocity.clear();
+            tracker->jointValid.clear();
+            return;
+        }
+
+    int haveVelocity = (tracker->previousJoints.size()==points2D.size());
+    if (!haveVelocity)
+        {
+            tracker->previousJoints.resize(points2D.size());
+            tracker->jointValid.assign(points2D.size(),0);
+        }
+    tracker->velocity.resize(points2D.size());
+
+    for (unsigned int i=0; i<points2D.size(); i++)
+        {
+            cv::Point2f joint(0.0,0.0);
+            if (points2D[i].size()>=2)
+                {
+                    joint = cv::Point2f(points2D[i][0],points2D[i][1]);
+                }
+            int valid = ( (joint.x!=0.0) || (joint.y!=0.0) );
+
+            if ( (haveVelocity) && (valid) && (tracker->jointValid[i]) )
+                {
+                    tracker->velocity[i] = joint - tracker->previousJoints[i];
+                }
+            else
+                {
+                    tracker->velocity[i] = cv::Point2f(0.0,0.0);
+                }
+            tracker->previousJoints[i]=joint;
+            tracker->jointValid[i]=valid;
+        }
+
+    toGray(frame,tracker->previousGray);
+}
+
+
+int keyframeTrackerTrack(
+    struct KeyframeTracker * tracker,
+    const cv::Mat & frame,
+    std::vector<std::vector<float> > & points2D
+)
+{
+    if ( (tracker->previousJoints.size()==0) || (tracker->previousGray.empty()) )
+        {
+            return 0;
+        }
+    unsigned long startTime = GetTickCountMicrosecondsMN();
+
+    cv::Mat gray;
+    toGray(frame,gray);
+    if (gray.size()!=tracker->previousGray.size())
+        {
+            fprintf(stderr,YELLOW "Keyframe tracker: frame size changed, a keyframe is needed\n" NORMAL);
+            tracker->previousJoints.clear();
+            return 0;
+        }
+
+    //Only the joints that were seen are given to the optical flow
+    std::vector<cv::Point2f> seeds;
+    std::vector<unsigned int> seedJoint;
+    for (unsigned int i=0; i<tracker->previousJoints.size(); i++)
+        {
+            if (tracker->jointValid[i])
+                {
+                    seeds.push_back(tracker->previousJoints[i]);
+                    seedJoint.push_back(i);
+                }
+        }
+    if (seeds.size()==0)
+        {
+            tracker->previousJoints.clear();
+            return 0;
+        }
+
+    cv::Size window(KEYFRAME_TRACKER_WINDOW_SIZE,KEYFRAME_TRACKER_WINDOW_SIZE);
+    std::vector<cv::Point2f> forward,backward;
+    std::vector<unsigned char> forwardStatus,backwardStatus;
+    std::vector<float> forwardError,backwardError;
+    cv::calcOpticalFlowPyrLK(tracker->previousGray,gray,seeds,forward,forwardStatus,forwardError,window,KEYFRAME_TRACKER_PYRAMID_LEVELS);
+    cv::calcOpticalFlowPyrLK(gray,tracker->previousGray,forward,backward,backwardStatus,backwardError,window,KEYFRAME_TRACKER_PYRAMID_LEVELS);
+
+    unsigned int tracked=0;
+    for (unsigned int s=0; s<seeds.size(); s++)
+        {
+            unsigned int i = seedJoint[s];
+            cv::Point2f difference = backward[s] - seeds[s];
+            float forwardBackwardError = sqrt(difference.x*difference.x + difference.y*difference.y);
+            if ( (forwardStatus[s]) && (backwardStatus[s]) && (forwardBackwardError<=KEYFRAME_TRACKER_MAX_FORWARD_BACKWARD_ERROR) )
+                {
+                    tracker->velocity[i] = forward[s] - tracker->previousJoints[i];
+                    tracker->previousJoints[i] = forward[s];
+                    ++tracked;
+                }
+            else
+                {
+                    //Lost by the optical flow, keep it moving the way it did
+                    tracker->previousJoints[i] += tracker->velocity[i];
+                }
+        }
+
+    tracker->confidence = (float) tracked / seeds.size();
+    tracker->previousGray = gray;
+    ++tracker->framesSinceKeyframe;
+    ++tracker->trackedFrames;
+
+    points2D.resize(tracker->previousJoints.size());
+    for (unsigned int i=0; i<tracker->previousJoints.size(); i++)
+        {
+            points2D[i].resize(2);
+            if (tracker->jointValid[i])
+                {
+                    points2D[i][0]=tracker->previousJoints[i].x;
+                    points2D[i][1]=tracker->previousJoints[i].y;
+                }
+            else
+                {
+                    points2D[i][0]=0.0;
+                    points2D[i][1]=0.0;
+                }
+        }
+
+    unsigned long endTime = GetTickCountMicrosecondsMN();
+    updateAverage(&tracker->trackedFrameMilliseconds,(float) (endTime-startTime)/1000);
+    updateInterval(tracker);
+    return 1;
+}
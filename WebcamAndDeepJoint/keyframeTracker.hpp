@@ -0,0 +1,99 @@
+#pragma once
+/** @file keyframeTracker.hpp
+ *  @brief The 2D joint estimator is by far the slowest part of the live demo. The keyframe tracker lets it run only on some frames ( keyframes ),
+ *  in between them the 2D joints of the last frame are followed using sparse Lucas-Kanade optical flow seeded at the joints, with a constant
+ *  velocity prediction for joints the flow loses. Every tracked joint is checked by tracking it back to the previous frame, when too few joints
+ *  survive this check the next frame becomes a keyframe. The keyframe interval adapts to the measured 2D joint estimator and tracker times so that
+ *  the 2D stage keeps up with a target framerate, a fast machine keeps detecting on every frame while a slow one tracks more of them.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include <vector>
+#include "opencv2/opencv.hpp"
+
+
+/**
+ * @brief Default largest number of frames between two keyframes
+ */
+#define KEYFRAME_TRACKER_DEFAULT_MAX_INTERVAL 8
+
+/**
+ * @brief Fraction of the joints that have to be tracked successfully for the next frame to not be forced to be a keyframe
+ */
+#define KEYFRAME_TRACKER_MIN_CONFIDENCE 0.6
+
+
+/**
+ * @brief State of the keyframe tracker, one per video stream
+ */
+struct KeyframeTracker
+{
+    //Settings
+    unsigned int maxInterval;
+    float targetFPS;
+    float minConfidence;
+
+    //Keyframe interval currently used ( 1 = every frame is a keyframe )
+    unsigned int interval;
+    unsigned int framesSinceKeyframe;
+    //Fraction of the joints that the last tracked frame kept
+    float confidence;
+    //Running averages of the time spent on a keyframe and on a tracked frame
+    float keyframeMilliseconds;
+    float trackedFrameMilliseconds;
+
+    unsigned int keyframes;
+    unsigned int trackedFrames;
+
+    cv::Mat previousGray;
+    std::vector<cv::Point2f> previousJoints;
+    std::vector<cv::Point2f> velocity;
+    std::vector<unsigned char> jointValid;
+};
+
+
+/**
+ * @brief Set up a keyframe tracker
+ * @ingroup demo
+ * @param Pointer to the tracker
+ * @param Largest number of frames between two keyframes, 1 disables tracking
+ * @param Framerate the 2D stage should keep up with, 0 means always use the largest interval
+ */
+void initializeKeyframeTracker(struct KeyframeTracker * tracker,unsigned int maxInterval,float targetFPS);
+
+/**
+ * @brief Decide if the next frame has to go through the 2D joint estimator
+ * @ingroup demo
+ * @param Pointer to the tracker
+ * @retval 1 = Run the 2D joint estimator , 0 = Track the joints of the last frame
+ */
+int keyframeTrackerNeedsKeyframe(struct KeyframeTracker * tracker);
+
+/**
+ * @brief Give the tracker the result of the 2D joint estimator for a keyframe
+ * @ingroup demo
+ * @param Pointer to the tracker
+ * @param The full frame the joints were detected on
+ * @param The 2D joints ( x,y in full frame pixels, 0,0 means not detected ) as returned by returnMocapNETInputFrom2DDetectorOutput, empty if nobody was found
+ * @param Microseconds spent on the 2D joint estimator for this frame
+ */
+void keyframeTrackerAddKeyframe(
+                                struct KeyframeTracker * tracker,
+                                const cv::Mat & frame,
+                                const std::vector<std::vector<float> > & points2D,
+                                unsigned long microseconds
+                               );
+
+/**
+ * @brief Follow the joints of the last frame on a new frame
+ * @ingroup demo
+ * @param Pointer to the tracker
+ * @param The full new frame
+ * @param Output 2D joints in the same layout as the ones given to keyframeTrackerAddKeyframe
+ * @retval 1 = Joints were tracked , 0 = Nothing to track, a keyframe is needed
+ */
+int keyframeTrackerTrack(
+                          struct KeyframeTracker * tracker,
+                          const cv::Mat & frame,
+                          std::vector<std::vector<float> > & points2D
+                        );
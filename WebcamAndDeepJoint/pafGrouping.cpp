@@ -0,0 +1,326 @@
+#include "pafGrouping.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Points sampled along every candidate limb
+#define PAF_GROUPING_SAMPLES 10
+//A sample supports a limb if the PAF points along it at least this much
+#define PAF_GROUPING_SAMPLE_THRESHOLD 0.05
+//Fraction of the samples that has to support a limb
+#define PAF_GROUPING_SAMPLE_RATIO 0.8
+//Partial skeletons kept while chaining limbs
+#define PAF_GROUPING_MAX_PARTIAL_PERSONS 64
+//Skeletons with fewer joints or a smaller average score are thrown away
+#define PAF_GROUPING_MIN_JOINTS 4
+#define PAF_GROUPING_MIN_AVERAGE_SCORE 0.4
+
+
+/*
+ * Limbs of the COCO skeleton in the order the OpenPose COCO models output their PAFs, the x channel of a limb
+ * is relative to the start of the PAFs and its y channel follows it. The last two limbs ( ears to shoulders ) are redundant
+ * and only connect joints of skeletons that already exist.
+ */
+static const unsigned char pafLimbJointA[PAF_GROUPING_LIMBS]   = { 1, 1, 2, 3, 5, 6, 1, 8, 9, 1,11,12, 1, 0,14, 0,15, 2, 5};
+static const unsigned char pafLimbJointB[PAF_GROUPING_LIMBS]   = { 2, 5, 3, 4, 6, 7, 8, 9,10,11,12,13, 0,14,16,15,17,16,17};
+static const unsigned char pafLimbChannel[PAF_GROUPING_LIMBS]  = {12,20,14,16,22,24, 0, 2, 4, 6, 8,10,28,30,34,32,36,18,26};
+#define PAF_GROUPING_LIMBS_THAT_START_PERSONS 17
+
+
+struct pafConnection
+{
+    unsigned char candidateA;
+    unsigned char candidateB;
+    float score;
+};
+
+struct pafPartialPerson
+{
+    signed char candidate[PAF_GROUPING_JOINTS];
+    unsigned int numberOfJoints;
+    float score;
+};
+
+
+/*
+ * Average of the PAF projected on the direction of the limb, penalized for limbs longer than half the heatmap,
+ * returns 0 if the limb is not supported
+ */
+static int scoreLimb(
+    const float * nhwc,
+    unsigned int width,
+    unsigned int height,
+    unsigned int channelStride,
+    unsigned int channelX,
+    const struct heatmapPeak * a,
+    const struct heatmapPeak * b,
+    float * score
+)
+{
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    float norm = sqrt(dx*dx + dy*dy);
+    if (norm<0.0001)
+        {
+            return 0;
+        }
+    dx/=norm;
+    dy/=norm;
+
+    float sum=0.0;
+    unsigned int supporting=0;
+    for (unsigned int i=0; i<PAF_GROUPING_SAMPLES; i++)
+        {
+            float t = (float) i / (PAF_GROUPING_SAMPLES-1);
+            int x = (int) (a->x + t*(b->x - a->x) + 0.5);
+            int y = (int) (a->y + t*(b->y - a->y) + 0.5);
+            if (x<0)
+                {
+                    x=0;
+                }
+            else if (x>=(int) width)
+                {
+                    x=width-1;
+                }
+            if (y<0)
+                {
+                    y=0;
+                }
+            else if (y>=(int) height)
+                {
+                    y=height-1;
+                }
+
+            const float * paf = nhwc + (y*width+x)*channelStride + channelX;
+            float projection = paf[0]*dx + paf[1]*dy;
+            sum+=projection;
+            if (projection>PAF_GROUPING_SAMPLE_THRESHOLD)
+                {
+                    ++supporting;
+                }
+        }
+
+    float average = sum / PAF_GROUPING_SAMPLES;
+    float distancePenalty = 0.5 * height / norm - 1.0;
+    if (distancePenalty<0.0)
+        {
+            average+=distancePenalty;
+        }
+
+    if ( (supporting > PAF_GROUPING_SAMPLE_RATIO * PAF_GROUPING_SAMPLES) && (average>0.0) )
+        {
+            *score=average;
+            return 1;
+        }
+    return 0;
+}
+
+
+unsigned int groupHeatmapPeaksUsingPAFs(
+    const float * nhwc,
+    unsigned int width,
+    unsigned int height,
+    unsigned int channelStride,
+    unsigned int pafOffset,
+    const struct heatmapCandidates * candidates,
+    float scaleX,
+    float scaleY,
+    struct pafPerson * persons,
+    unsigned int maxPersons
+)
+{
+    if ( (nhwc==0) || (candidates==0) || (persons==0) || (maxPersons==0) )
+        {
+            return 0;
+        }
+    if (pafOffset+PAF_GROUPING_CHANNELS>channelStride)
+        {
+            fprintf(stderr,RED "groupHeatmapPeaksUsingPAFs: output has %u channels, not enough for PAFs starting at %u\n" NORMAL,channelStride,pafOffset);
+            return 0;
+        }
+
+    struct pafPartialPerson partial[PAF_GROUPING_MAX_PARTIAL_PERSONS];
+    unsigned int numberOfPartial=0;
+
+    struct pafConnection connections[PEAK_EXTRACTOR_MAX_CANDIDATES*PEAK_EXTRACTOR_MAX_CANDIDATES];
+    int usedA[PEAK_EXTRACTOR_MAX_CANDIDATES];
+    int usedB[PEAK_EXTRACTOR_MAX_CANDIDATES];
+
+    for (unsigned int limb=0; limb<PAF_GROUPING_LIMBS; limb++)
+        {
+            unsigned int jointA = pafLimbJointA[limb];
+            unsigned int jointB = pafLimbJointB[limb];
+            const struct heatmapCandidates * candA = &candidates[jointA];
+            const struct heatmapCandidates * candB = &candidates[jointB];
+            if ( (candA->numberOfCandidates==0) || (candB->numberOfCandidates==0) )
+                {
+                    continue;
+                }
+
+            //Score every pair, keeping them sorted from the best to the worst
+            unsigned int numberOfConnections=0;
+            for (unsigned int a=0; a<candA->numberOfCandidates; a++)
+                {
+                    for (unsigned int b=0; b<candB->numberOfCandidates; b++)
+                        {
+                            float score;
+                            if (scoreLimb(nhwc,width,height,channelStride,pafOffset+pafLimbChannel[limb],&candA->candidate[a],&candB->candidate[b],&score))
+                                {
+                                    int position = numberOfConnections;
+                                    while ( (position>0) && (connections[position-1].score<score) )
+                                        {
+                                            connections[position]=connections[position-1];
+                                            --position;
+                                        }
+                                    connections[position].candidateA=a;
+                                    connections[position].candidateB=b;
+                                    connections[position].score=score;
+                                    ++numberOfConnections;
+                                }
+                        }
+                }
+
+            //Greedy bipartite assignment, every candidate takes part in at most one limb of this type
+            memset(usedA,0,sizeof(usedA));
+            memset(usedB,0,sizeof(usedB));
+            for (unsigned int c=0; c<numberOfConnections; c++)
+                {
+                    unsigned int a = connections[c].candidateA;
+                    unsigned int b = connections[c].candidateB;
+                    if ( (usedA[a]) || (usedB[b]) )
+                        {
+                            continue;
+                        }
+                    usedA[a]=1;
+                    usedB[b]=1;
+                    float limbScore = connections[c].score;
+
+                    //Find the partial skeletons that already have one of the two joints
+                    int found[2]= {-1,-1};
+                    unsigned int numberFound=0;
+                    for (unsigned int p=0; (p<numberOfPartial) && (numberFound<2); p++)
+                        {
+                            if ( (partial[p].candidate[jointA]==(int) a) || (partial[p].candidate[jointB]==(int) b) )
+                                {
+                                    found[numberFound++]=p;
+                                }
+                        }
+
+                    if (numberFound==2)
+                        {
+                            struct pafPartialPerson * first  = &partial[found[0]];
+                            struct pafPartialPerson * second = &partial[found[1]];
+                            int overlap=0;
+                            for (unsigned int j=0; j<PAF_GROUPING_JOINTS; j++)
+                                {
+                                    if ( (first->candidate[j]>=0) && (second->candidate[j]>=0) )
+                                        {
+                                            overlap=1;
+                                            break;
+                                        }
+                                }
+                            if (!overlap)
+                                {
+                                    //Two pieces of the same person, merge them
+                                    for (unsigned int j=0; j<PAF_GROUPING_JOINTS; j++)
+                                        {
+                                            if (second->candidate[j]>=0)
+                                                {
+                                                    first->candidate[j]=second->candidate[j];
+                                                }
+                                        }
+                                    first->numberOfJoints+=second->numberOfJoints;
+                                    first->score+=second->score + limbScore;
+                                    partial[found[1]]=partial[numberOfPartial-1];
+                                    --numberOfPartial;
+                                    continue;
+                                }
+                            numberFound=1;
+                        }
+
+                    if (numberFound==1)
+                        {
+                            struct pafPartialPerson * person = &partial[found[0]];
+                            if (person->candidate[jointB]!=(int) b)
+                                {
+                                    if (person->candidate[jointB]<0)
+                                        {
+                                            ++person->numberOfJoints;
+                                        }
+                                    person->candidate[jointB]=b;
+                                    person->score+=candB->candidate[b].value + limbScore;
+                                }
+                        }
+                    else if ( (limb<PAF_GROUPING_LIMBS_THAT_START_PERSONS) && (numberOfPartial<PAF_GROUPING_MAX_PARTIAL_PERSONS) )
+                        {
+                            struct pafPartialPerson * person = &partial[numberOfPartial++];
+                            memset(person->candidate,-1,sizeof(person->candidate));
+                            person->candidate[jointA]=a;
+                            person->candidate[jointB]=b;
+                            person->numberOfJoints=2;
+                            person->score=candA->candidate[a].value + candB->candidate[b].value + limbScore;
+                        }
+                }
+        }
+
+    //Keep the convincing skeletons, best first
+    unsigned int numberOfPersons=0;
+    for (unsigned int p=0; p<numberOfPartial; p++)
+        {
+            struct pafPartialPerson * person = &partial[p];
+            if (
+                (person->numberOfJoints<PAF_GROUPING_MIN_JOINTS) ||
+                (person->score/person->numberOfJoints<PAF_GROUPING_MIN_AVERAGE_SCORE)
+            )
+                {
+                    continue;
+                }
+
+            unsigned int position = numberOfPersons;
+            while ( (position>0) && (persons[position-1].score<person->score) )
+                {
+                    if (position<maxPersons)
+                        {
+                            persons[position]=persons[position-1];
+                        }
+                    --position;
+                }
+            if (position>=maxPersons)
+                {
+                    continue;
+                }
+
+            struct pafPerson * output = &persons[position];
+            output->numberOfJoints=person->numberOfJoints;
+            output->score=person->score;
+            for (unsigned int j=0; j<PAF_GROUPING_JOINTS; j++)
+                {
+                    if (person->candidate[j]>=0)
+                        {
+                            const struct heatmapPeak * peak = &candidates[j].candidate[(int) person->candidate[j]];
+                            output->joint[j].x = scaleX * peak->x;
+                            output->joint[j].y = scaleY * peak->y;
+                            output->joint[j].value = peak->value;
+                        }
+                    else
+                        {
+                            output->joint[j].x = 0.0;
+                            output->joint[j].y = 0.0;
+                            output->joint[j].value = 0.0;
+                        }
+                }
+            if (numberOfPersons<maxPersons)
+                {
+                    ++numberOfPersons;
+                }
+        }
+
+    return numberOfPersons;
+}
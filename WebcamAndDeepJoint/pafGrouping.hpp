@@ -0,0 +1,72 @@
+#pragma once
+/** @file pafGrouping.hpp
+ *  @brief Grouping of heatmap peaks in to separate people using the part affinity fields ( PAFs ) that OpenPose style 2D joint estimators
+ *  output after their heatmaps. Every possible limb between two candidate joints is scored by integrating the PAF along it, limbs are assigned
+ *  greedily from the best score down so that each candidate joint is used once per limb type and the limbs are then chained in to skeletons.
+ *  Everything works on the candidates of peakExtractor.hpp and the NHWC output of the network, so telling apart more people only costs scoring
+ *  a few more candidate pairs. This code does not depend on OpenCV or Tensorflow.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+#include "peakExtractor.hpp"
+
+
+/**
+ * @brief Number of joints of a grouped skeleton ( COCO order, same as UT_COCOSkeletonJoints without the background )
+ */
+#define PAF_GROUPING_JOINTS 18
+
+/**
+ * @brief Number of limbs that have a PAF
+ */
+#define PAF_GROUPING_LIMBS 19
+
+/**
+ * @brief Number of PAF channels ( an x and a y channel for every limb )
+ */
+#define PAF_GROUPING_CHANNELS (PAF_GROUPING_LIMBS*2)
+
+/**
+ * @brief Maximum number of skeletons that can be returned
+ */
+#define PAF_GROUPING_MAX_PERSONS PEAK_EXTRACTOR_MAX_CANDIDATES
+
+
+/**
+ * @brief A skeleton made out of grouped peaks, joints that were not found have a value of 0 and are at 0,0
+ */
+struct pafPerson
+{
+    unsigned int numberOfJoints;
+    float score;
+    struct heatmapPeak joint[PAF_GROUPING_JOINTS];
+};
+
+
+/**
+ * @brief Group the candidates of the heatmaps in to skeletons
+ * @ingroup utilities
+ * @param Pointer to the NHWC output of the network
+ * @param Width of the heatmaps
+ * @param Height of the heatmaps
+ * @param Number of channels of every pixel of the output
+ * @param Channel of the output where the PAFs start ( usually right after the heatmaps )
+ * @param Candidates of the PAF_GROUPING_JOINTS heatmaps as returned by extractHeatmapPeaksNHWC with a scale of 1.0 ( heatmap coordinates )
+ * @param Scale applied to the x coordinate of the joints of the skeletons ( i.e. image width / heatmap width )
+ * @param Scale applied to the y coordinate of the joints of the skeletons ( i.e. image height / heatmap height )
+ * @param Output array for the skeletons, sorted from the best to the worst
+ * @param Size of the output array, at most PAF_GROUPING_MAX_PERSONS
+ * @retval Number of skeletons found
+ */
+unsigned int groupHeatmapPeaksUsingPAFs(
+                                         const float * nhwc,
+                                         unsigned int width,
+                                         unsigned int height,
+                                         unsigned int channelStride,
+                                         unsigned int pafOffset,
+                                         const struct heatmapCandidates * candidates,
+                                         float scaleX,
+                                         float scaleY,
+                                         struct pafPerson * persons,
+                                         unsigned int maxPersons
+                                       );
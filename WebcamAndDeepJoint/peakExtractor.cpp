@@ -0,0 +1,300 @@
+#include "peakExtractor.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define PEAK_EXTRACTOR_USE_SSE 1
+#endif
+
+#define NORMAL   "\033[0m"
+#define BLACK   "\033[30m"      /* Black */
+#define RED     "\033[31m"      /* Red */
+#define GREEN   "\033[32m"      /* Green */
+#define YELLOW  "\033[33m"      /* Yellow */
+
+//Local maxima kept per heatmap before non-maximum suppression, when there are more the weakest are forgotten
+#define PEAK_EXTRACTOR_MAX_RAW_PEAKS 32
+
+
+struct rawPeak
+{
+    float value;
+    unsigned int position; // y*width+x , also breaks ties in raster order like dj_extractPeaksFromMap does
+};
+
+struct rawPeakList
+{
+    unsigned int numberOfPeaks;
+    struct rawPeak peak[PEAK_EXTRACTOR_MAX_RAW_PEAKS];
+};
+
+
+static inline int isStrongerPeak(const struct rawPeak * a,const struct rawPeak * b)
+{
+    return ( (a->value>b->value) || ( (a->value==b->value) && (a->position<b->position) ) );
+}
+
+
+static inline void addRawPeak(struct rawPeakList * list,float value,unsigned int position)
+{
+    if (list->numberOfPeaks<PEAK_EXTRACTOR_MAX_RAW_PEAKS)
+        {
+            list->peak[list->numberOfPeaks].value=value;
+            list->peak[list->numberOfPeaks].position=position;
+            ++list->numberOfPeaks;
+            return;
+        }
+
+    //Full, replace the weakest one if this is stronger
+    struct rawPeak candidate;
+    candidate.value=value;
+    candidate.position=position;
+    unsigned int weakest=0;
+    for (unsigned int i=1; i<list->numberOfPeaks; i++)
+        {
+            if (isStrongerPeak(&list->peak[weakest],&list->peak[i]))
+                {
+                    weakest=i;
+                }
+        }
+    if (isStrongerPeak(&candidate,&list->peak[weakest]))
+        {
+            list->peak[weakest]=candidate;
+        }
+}
+
+
+/*
+ * Closed form vertex of the parabola through (-1,a) (0,b) (1,c), clamped to half a pixel
+ */
+static inline float quadraticOffset(float a,float b,float c)
+{
+    float denominator = a - 2*b + c;
+    if (denominator>=0.0)
+        {
+            //Not a maximum along this axis ( flat or border ), keep the integer position
+            return 0.0;
+        }
+    float offset = 0.5 * (a - c) / denominator;
+    if (offset>0.5)
+        {
+            offset=0.5;
+        }
+    else if (offset<-0.5)
+        {
+            offset=-0.5;
+        }
+    return offset;
+}
+
+
+/*
+ * A pixel of a channel is a local maximum when it is above the threshold, strictly greater than the neighbours that come before it
+ * in raster order and not smaller than the ones that come after it, so plateaus produce exactly one maximum at their first pixel.
+ * Neighbours outside of the heatmap point to a row of -FLT_MAX.
+ */
+static inline void scanPixel(
+    const float * center,
+    const float * const * before, // up-left, up, up-right, left
+    const float * const * after,  // right, down-left, down, down-right
+    unsigned int channels,
+    float threshold,
+    unsigned int position,
+    struct rawPeakList * lists
+)
+{
+    unsigned int c=0;
+#if PEAK_EXTRACTOR_USE_SSE
+    __m128 thresholdV = _mm_set1_ps(threshold);
+    for (c=0; c+4<=channels; c+=4)
+        {
+            __m128 v = _mm_loadu_ps(center+c);
+            __m128 mask = _mm_cmpge_ps(v,thresholdV);
+            //Almost every pixel is rejected here, before touching its neighbours
+            if (_mm_movemask_ps(mask)==0)
+                {
+                    continue;
+                }
+            mask = _mm_and_ps(mask,_mm_cmpgt_ps(v,_mm_loadu_ps(before[0]+c)));
+            mask = _mm_and_ps(mask,_mm_cmpgt_ps(v,_mm_loadu_ps(before[1]+c)));
+            mask = _mm_and_ps(mask,_mm_cmpgt_ps(v,_mm_loadu_ps(before[2]+c)));
+            mask = _mm_and_ps(mask,_mm_cmpgt_ps(v,_mm_loadu_ps(before[3]+c)));
+            mask = _mm_and_ps(mask,_mm_cmpge_ps(v,_mm_loadu_ps(after[0]+c)));
+            mask = _mm_and_ps(mask,_mm_cmpge_ps(v,_mm_loadu_ps(after[1]+c)));
+            mask = _mm_and_ps(mask,_mm_cmpge_ps(v,_mm_loadu_ps(after[2]+c)));
+            mask = _mm_and_ps(mask,_mm_cmpge_ps(v,_mm_loadu_ps(after[3]+c)));
+            int bits = _mm_movemask_ps(mask);
+            while (bits)
+                {
+                    int lane = __builtin_ctz(bits);
+                    addRawPeak(&lists[c+lane],center[c+lane],position);
+                    bits &= bits-1;
+                }
+        }
+#endif
+    for (; c<channels; c++)
+        {
+            float v = center[c];
+            if (v<threshold)
+                {
+                    continue;
+                }
+            if (
+                (v>before[0][c]) && (v>before[1][c]) && (v>before[2][c]) && (v>before[3][c]) &&
+                (v>=after[0][c]) && (v>=after[1][c]) && (v>=after[2][c]) && (v>=after[3][c])
+            )
+                {
+                    addRawPeak(&lists[c],v,position);
+                }
+        }
+}
+
+
+unsigned int extractHeatmapPeaksNHWC(
+    const float * nhwc,
+    unsigned int width,
+    unsigned int height,
+    unsigned int channels,
+    unsigned int channelStride,
+    float minThreshold,
+    float scaleX,
+    float scaleY,
+    unsigned int maxCandidates,
+    unsigned int suppressionRadius,
+    struct heatmapCandidates * output
+)
+{
+    if ( (nhwc==0) || (output==0) || (width==0) || (height==0) || (channels==0) || (channelStride<channels) )
+        {
+            return 0;
+        }
+    if (channels>PEAK_EXTRACTOR_MAX_CHANNELS)
+        {
+            fprintf(stderr,RED "extractHeatmapPeaksNHWC: %u heatmaps are more than the %u supported\n" NORMAL,channels,PEAK_EXTRACTOR_MAX_CHANNELS);
+            return 0;
+        }
+
+    if ( (maxCandidates==0) || (maxCandidates>PEAK_EXTRACTOR_MAX_CANDIDATES) )
+        {
+            maxCandidates=PEAK_EXTRACTOR_MAX_CANDIDATES;
+        }
+
+    //dj_extractPeaksFromMap only accepts values that are above the threshold and above 0
+    float threshold = minThreshold;
+    if (threshold<=0.0)
+        {
+            threshold=FLT_MIN;
+        }
+
+    float outside[PEAK_EXTRACTOR_MAX_CHANNELS];
+    for (unsigned int c=0; c<PEAK_EXTRACTOR_MAX_CHANNELS; c++)
+        {
+            outside[c]=-FLT_MAX;
+        }
+
+    struct rawPeakList lists[PEAK_EXTRACTOR_MAX_CHANNELS];
+    for (unsigned int c=0; c<channels; c++)
+        {
+            lists[c].numberOfPeaks=0;
+        }
+
+    //Single sweep over the output, every pixel checks all of its channels at once
+    const unsigned int rowStride = width*channelStride;
+    const float * before[4];
+    const float * after[4];
+    for (unsigned int y=0; y<height; y++)
+        {
+            const float * row  = nhwc + y*rowStride;
+            const float * up   = (y>0)        ? row - rowStride : 0;
+            const float * down = (y+1<height) ? row + rowStride : 0;
+            for (unsigned int x=0; x<width; x++)
+                {
+                    const unsigned int offset = x*channelStride;
+                    const int haveLeft  = (x>0);
+                    const int haveRight = (x+1<width);
+
+                    before[0] = ( (up!=0)   && (haveLeft) )  ? up + offset - channelStride   : outside;
+                    before[1] = (up!=0)                      ? up + offset              : outside;
+                    before[2] = ( (up!=0)   && (haveRight) ) ? up + offset + channelStride   : outside;
+                    before[3] = (haveLeft)                   ? row + offset - channelStride  : outside;
+                    after[0]  = (haveRight)                  ? row + offset + channelStride  : outside;
+                    after[1]  = ( (down!=0) && (haveLeft) )  ? down + offset - channelStride : outside;
+                    after[2]  = (down!=0)                    ? down + offset            : outside;
+                    after[3]  = ( (down!=0) && (haveRight) ) ? down + offset + channelStride : outside;
+
+                    scanPixel(row+offset,before,after,channels,threshold,y*width+x,lists);
+                }
+        }
+
+    //Non-maximum suppression and sub-pixel refinement of every heatmap
+    unsigned int totalPeaks=0;
+    const int radius = suppressionRadius;
+    for (unsigned int c=0; c<channels; c++)
+        {
+            struct rawPeakList * list = &lists[c];
+            struct heatmapCandidates * candidates = &output[c];
+            candidates->numberOfCandidates=0;
+
+            //Insertion sort, strongest first, there are only a handful of maxima
+            for (unsigned int i=1; i<list->numberOfPeaks; i++)
+                {
+                    struct rawPeak key = list->peak[i];
+                    int j=i-1;
+                    while ( (j>=0) && (isStrongerPeak(&key,&list->peak[j])) )
+                        {
+                            list->peak[j+1]=list->peak[j];
+                            --j;
+                        }
+                    list->peak[j+1]=key;
+                }
+
+            int acceptedX[PEAK_EXTRACTOR_MAX_CANDIDATES];
+            int acceptedY[PEAK_EXTRACTOR_MAX_CANDIDATES];
+            for (unsigned int i=0; (i<list->numberOfPeaks) && (candidates->numberOfCandidates<maxCandidates); i++)
+                {
+                    int px = list->peak[i].position % width;
+                    int py = list->peak[i].position / width;
+
+                    int suppressed=0;
+                    for (unsigned int k=0; k<candidates->numberOfCandidates; k++)
+                        {
+                            int dx = px-acceptedX[k];
+                            int dy = py-acceptedY[k];
+                            if ( (dx>=-radius) && (dx<=radius) && (dy>=-radius) && (dy<=radius) )
+                                {
+                                    suppressed=1;
+                                    break;
+                                }
+                        }
+                    if (suppressed)
+                        {
+                            continue;
+                        }
+
+                    const float * center = nhwc + (py*width+px)*channelStride + c;
+                    float subX=0.0,subY=0.0;
+                    if ( (px>0) && (px+1<(int) width) )
+                        {
+                            subX = quadraticOffset(center[-(int)channelStride],center[0],center[channelStride]);
+                        }
+                    if ( (py>0) && (py+1<(int) height) )
+                        {
+                            subY = quadraticOffset(center[-(int)rowStride],center[0],center[rowStride]);
+                        }
+
+                    unsigned int n = candidates->numberOfCandidates;
+                    acceptedX[n]=px;
+                    acceptedY[n]=py;
+                    candidates->candidate[n].x = scaleX * ((float) px + subX);
+                    candidates->candidate[n].y = scaleY * ((float) py + subY);
+                    candidates->candidate[n].value = list->peak[i].value;
+                    ++candidates->numberOfCandidates;
+                    ++totalPeaks;
+                }
+        }
+
+    return totalPeaks;
+}
@@ -0,0 +1,90 @@
+#pragma once
+/** @file peakExtractor.hpp
+ *  @brief Extraction of 2D joint candidates straight from the NHWC output of a 2D joint estimator. All heatmaps are scanned together
+ *  in a single sweep that finds local maxima above a threshold ( channels are compared in groups of 4 using SSE when available ), then
+ *  non-maximum suppression keeps the strongest peaks of every heatmap that are further than a radius apart and a closed form quadratic fit
+ *  of their neighbourhood gives their sub-pixel position. With the single person settings the joints found are the same as dj_extractPeaksFromMap/dj_upscalePeakPosition
+ *  ( utilities.hpp ) and lie within a heatmap pixel of them, except where blobs of the same joint overlap and the old code picks a pixel on the edge of its
+ *  suppression box ( CompareHeatmapPeaks measures this on recorded heatmaps ). The heatmaps are not cloned, resized or blurred and no memory is allocated.
+ *  This code does not depend on OpenCV or Tensorflow.
+ *  @author Ammar Qammaz (AmmarkoV)
+ */
+
+
+/**
+ * @brief Maximum number of heatmaps ( channels of the NHWC output ) that can be processed
+ */
+#define PEAK_EXTRACTOR_MAX_CHANNELS 64
+
+/**
+ * @brief Maximum number of candidates that can be kept for every heatmap, this is also the maximum number of people that can be told apart
+ */
+#define PEAK_EXTRACTOR_MAX_CANDIDATES 16
+
+/**
+ * @brief Candidates kept for every heatmap when looking for a single person, same as the maxPeakCount of dj_extractPeaksFromMap
+ */
+#define PEAK_EXTRACTOR_SINGLE_PERSON_CANDIDATES 3
+
+/**
+ * @brief Peaks closer than this ( in heatmap pixels, on both axis ) to a stronger peak of the same heatmap are suppressed,
+ * same as the peakRadius of dj_extractPeaksFromMap
+ */
+#define PEAK_EXTRACTOR_SUPPRESSION_RADIUS 5
+
+/**
+ * @brief Suppression radius used when looking for many people, joints of different people can be a couple of heatmap pixels apart
+ */
+#define PEAK_EXTRACTOR_MULTI_PERSON_SUPPRESSION_RADIUS 1
+
+
+/**
+ * @brief A peak of a heatmap, its position is already scaled to the coordinate system requested
+ */
+struct heatmapPeak
+{
+    float x;
+    float y;
+    float value;
+};
+
+
+/**
+ * @brief The candidates of one heatmap, sorted from the strongest to the weakest
+ */
+struct heatmapCandidates
+{
+    unsigned int numberOfCandidates;
+    struct heatmapPeak candidate[PEAK_EXTRACTOR_MAX_CANDIDATES];
+};
+
+
+/**
+ * @brief Find the peaks of all heatmaps of an NHWC ( height x width x channels , channels changing fastest ) detector output
+ * @ingroup utilities
+ * @param Pointer to the detector output
+ * @param Width of the heatmaps
+ * @param Height of the heatmaps
+ * @param Number of heatmaps to scan, at most PEAK_EXTRACTOR_MAX_CHANNELS
+ * @param Number of channels of every pixel of the output, networks that also output PAFs have more channels than heatmaps
+ * @param The minimum threshold for detections, smaller values mean more noisy input, more means less detections
+ * @param Scale applied to the x coordinate of the peaks ( i.e. image width / heatmap width )
+ * @param Scale applied to the y coordinate of the peaks ( i.e. image height / heatmap height )
+ * @param Maximum number of candidates kept for every heatmap, at most PEAK_EXTRACTOR_MAX_CANDIDATES
+ * @param Suppression radius in heatmap pixels ( PEAK_EXTRACTOR_SUPPRESSION_RADIUS or PEAK_EXTRACTOR_MULTI_PERSON_SUPPRESSION_RADIUS )
+ * @param Output array with room for one struct heatmapCandidates per heatmap
+ * @retval Total number of peaks found in all heatmaps
+ */
+unsigned int extractHeatmapPeaksNHWC(
+                                      const float * nhwc,
+                                      unsigned int width,
+                                      unsigned int height,
+                                      unsigned int channels,
+                                      unsigned int channelStride,
+                                      float minThreshold,
+                                      float scaleX,
+                                      float scaleY,
+                                      unsigned int maxCandidates,
+                                      unsigned int suppressionRadius,
+                                      struct heatmapCandidates * output
+                                    );
@@ -10,6 +10,8 @@ using namespace cv;
 
 #include <cstdlib>
 #include <unistd.h>
+#include <atomic>
+#include <thread>
 
 #include "../MocapNETLib/jsonCocoSkeleton.h"
 #include "../MocapNETLib/jsonMocapNETHelpers.cpp"
@@ -18,19 +20,35 @@ using namespace cv;
 #include "../MocapNETLib/mocapnet.hpp"
 #include "../MocapNETLib/bvh.hpp"
 #include "../MocapNETLib/visualization.hpp"
+#include "../MocapNETLib/asyncRenderer.hpp"
+#include "../MocapNETLib/boundedQueue.hpp"
+#include "../MocapNETLib/temporalFilter.hpp"
+#include "../MocapNETLib/instrumentation.hpp"
+#include "../MocapNETLib/detectionLog.h"
 
 #include "cameraControl.hpp"
 #include "utilities.hpp"
+#include "pafGrouping.hpp"
+#include "keyframeTracker.hpp"
+#include "frameGrabber.hpp"
 
 
 #define DISPLAY_ALL_HEATMAPS 0
 
+//When the 2D joint estimator also outputs PAFs the peaks are grouped in to people and the most confident one is used, --nopafs turns this off
+static int use2DJointEstimatorPAFs=1;
 
 
+
+//Output of the 2D joint estimator as it comes out of the network ( NHWC ), the storage is reused by the next frames of the same thread.
+//It is kept outside of predictAndReturnSingleSkeletonOf2DCOCOJoints so the heatmaps of the last keyframe can be recorded
+static thread_local std::vector<float> heatmapsNHWC;
+
 /**
  * @brief This function performs 2D estimation.. You give her a Tensorflow instance of a 2D estimator, a BGR image some thresholds and sizes and it will yield a vector of 2D points.
  * @ingroup demo
- * @bug This code is oriented to a single 2D skeleton detected, Multiple skeletons will confuse it and there is no logic to handle them
+ * @bug This code is oriented to a single 2D skeleton detected, when the estimator has no PAFs multiple skeletons will confuse it since their joints get mixed,
+ * with PAFs the people are told apart and only the most confident one is returned
  * @retval A 2D Skeleton detected in the bgr OpenCV image
  */
 std::vector<cv::Point_<float> > predictAndReturnSingleSkeletonOf2DCOCOJoints(
@@ -48,6 +66,7 @@ std::vector<cv::Point_<float> > predictAndReturnSingleSkeletonOf2DCOCOJoints(
 )
 {
     // preprocess image. Actually resize
+    unsigned long preprocessStart = startStageTimer();
     float scaleX = (float) inputWidth2DJointDetector/bgr.cols;
     float scaleY = (float) inputHeight2DJointDetector/bgr.rows;
     cv::Mat fr_res;
@@ -59,44 +78,34 @@ std::vector<cv::Point_<float> > predictAndReturnSingleSkeletonOf2DCOCOJoints(
             cv::imshow("BGR",fr_res);
         }
     fr_res.convertTo(fr_res,CV_32FC3);
+    stopStageTimer(MOCAPNET_STAGE_PREPROCESS,preprocessStart);
     // pass the frame to the Estimator
 
 
-    std::vector<std::vector<float> > result = predictTensorflowOnArrayOfHeatmaps(
-                net,
-                (unsigned int) fr_res.cols,
-                (unsigned int) fr_res.rows,
-                (float*) fr_res.data,
-                heatmapWidth2DJointDetector,
-                heatmapHeight2DJointDetector,
-                numberOfOutputTensors
-            );
-
-    if (result.size()<3)
+    //The output is kept as it comes out of the network ( NHWC ) and all heatmaps are scanned in one pass
+    unsigned long inferenceStart = startStageTimer();
+    unsigned int hm = predictTensorflowOnArrayOfHeatmapsNHWC(
+                          net,
+                          (unsigned int) fr_res.cols,
+                          (unsigned int) fr_res.rows,
+                          (float*) fr_res.data,
+                          heatmapWidth2DJointDetector,
+                          heatmapHeight2DJointDetector,
+                          numberOfOutputTensors,
+                          heatmapsNHWC
+                      );
+    stopStageTimer(MOCAPNET_STAGE_2D_INFERENCE,inferenceStart);
+
+    if (hm<3)
         {
             fprintf(stderr,"Our 2D neural network did not produce an array of 2D heatmaps..\n");
             fprintf(stderr,"Cannot continue with this output...\n");
             std::vector<cv::Point_<float> > emptyVectorOfPoints;
             return emptyVectorOfPoints;
         }
-
-
-    unsigned int rows = heatmapWidth2DJointDetector;
-    unsigned int cols = heatmapHeight2DJointDetector;
-    unsigned int hm = numberOfHeatmaps;
-    std::vector<cv::Mat> heatmaps;
-    for(int i=0; i<hm; ++i)
+    if (hm>numberOfHeatmaps)
         {
-            cv::Mat h(rows,cols, CV_32FC1);
-            for(int r=0; r<rows; ++r)
-                {
-                    for(int c=0; c<cols; ++c)
-                        {
-                            int pos = r*cols+c;
-                            h.at<float>(r,c) = result[i][pos];
-                        }
-                }
-            heatmaps.push_back(h);
+            hm=numberOfHeatmaps;
         }
 
 
@@ -104,18 +113,29 @@ std::vector<cv::Point_<float> > predictAndReturnSingleSkeletonOf2DCOCOJoints(
 #if DISPLAY_ALL_HEATMAPS
     if (visualize)
         {
+            unsigned int rows = heatmapHeight2DJointDetector;
+            unsigned int cols = heatmapWidth2DJointDetector;
+            unsigned int channels = heatmapsNHWC.size() / (rows*cols);
             unsigned int x=0;
             unsigned int y=0;
             char windowLabel[512];
-            for(int i=0; i<18; ++i)
+            for(int i=0; i<hm; ++i)
                 {
+                    cv::Mat h(rows,cols, CV_32FC1);
+                    for(int r=0; r<rows; ++r)
+                        {
+                            for(int c=0; c<cols; ++c)
+                                {
+                                    h.at<float>(r,c) = heatmapsNHWC[(r*cols+c)*channels+i];
+                                }
+                        }
                     snprintf(windowLabel,512,"Heatmap %u",i);
                     if (frameNumber==0)
                         {
                             cv::namedWindow(windowLabel,1);
                             cv::moveWindow(windowLabel, x,y);
                         }
-                    cv::imshow(windowLabel,heatmaps[i]);
+                    cv::imshow(windowLabel,h);
                     y=y+rows+30;
                     if (y>700)
                         {
@@ -126,7 +146,21 @@ std::vector<cv::Point_<float> > predictAndReturnSingleSkeletonOf2DCOCOJoints(
         }
 #endif // DISPLAY_ALL_HEATMAPS
 
-    return dj_getNeuralNetworkDetectionsForColorImage(bgr,smallBGR,heatmaps,minThreshold,visualize,0);
+    //Networks that also output PAFs have more channels than heatmaps, only the first numberOfHeatmaps are scanned
+    unsigned int channels = heatmapsNHWC.size() / (heatmapWidth2DJointDetector*heatmapHeight2DJointDetector);
+    unsigned long peakExtractionStart = startStageTimer();
+    if ( (use2DJointEstimatorPAFs) && (hm==numberOfHeatmaps) && (channels>=hm+PAF_GROUPING_CHANNELS) )
+        {
+            std::vector<std::vector<cv::Point_<float> > > people = dj_getNeuralNetworkMultiPersonDetectionsFromNHWC(bgr,smallBGR,heatmapsNHWC.data(),heatmapWidth2DJointDetector,heatmapHeight2DJointDetector,hm,channels,minThreshold,visualize,0);
+            if (people.size()>0)
+                {
+                    stopStageTimer(MOCAPNET_STAGE_PEAK_EXTRACTION,peakExtractionStart);
+                    return people[0];
+                }
+        }
+    std::vector<cv::Point_<float> > points = dj_getNeuralNetworkDetectionsFromNHWC(bgr,smallBGR,heatmapsNHWC.data(),heatmapWidth2DJointDetector,heatmapHeight2DJointDetector,hm,channels,minThreshold,visualize,0);
+    stopStageTimer(MOCAPNET_STAGE_PEAK_EXTRACTION,peakExtractionStart);
+    return points;
 }
 
 
@@ -162,6 +196,7 @@ std::vector<float> returnMocapNETInputFrom2DDetectorOutput(
     std::vector<std::vector<float> > & points2DInput,
     float minThreshold,
     int visualize ,
+    int printFramerate,
     float * fps,
     unsigned int frameNumber,
     unsigned int offsetX,
@@ -197,7 +232,7 @@ std::vector<float> returnMocapNETInputFrom2DDetectorOutput(
     unsigned long openPoseComputationTimeInMilliseconds = (unsigned long) (endTime-startTime)/1000;
     *fps = convertStartEndTimeFromMicrosecondsToFPS(startTime,endTime);
     
-    if (!visualize)
+    if (printFramerate)
         {
             //If we don't visualize using OpenCV output performance
             fprintf(stderr,"OpenPose 2DSkeleton @ %0.2f fps \n",*fps);
@@ -220,8 +255,12 @@ std::vector<float> returnMocapNETInputFrom2DDetectorOutput(
 
             for (i=0; i<pointsOf2DSkeleton.size()-1; i++)
                 {
-                    pointsOf2DSkeleton[i].x+=offsetX;
-                    pointsOf2DSkeleton[i].y+=offsetY;
+                    //Joints that were not detected stay at 0,0 so that they are still recognized as missing
+                    if ( (pointsOf2DSkeleton[i].x!=0.0) || (pointsOf2DSkeleton[i].y!=0.0) )
+                        {
+                            pointsOf2DSkeleton[i].x+=offsetX;
+                            pointsOf2DSkeleton[i].y+=offsetY;
+                        }
                 }
 
             convertUtilitiesSkeletonFormatToBODY25(&sk,pointsOf2DSkeleton);
@@ -253,6 +292,672 @@ std::vector<float> returnMocapNETInputFrom2DDetectorOutput(
 }
 
 
+/**
+ * @brief Retrieve MocapNET input for a frame between two keyframes by tracking the 2D joints of the previous frame instead of running the 2D joint estimator
+ * @ingroup demo
+ * @param Pointer to the keyframe tracker
+ * @param The full frame ( not cropped )
+ * @param Output 2D joints in the same layout as the ones returnMocapNETInputFrom2DDetectorOutput returns
+ * @param Switch to print the framerate of the tracker, used when it is not drawn by the visualization
+ * @param Output framerate of the tracker
+ * @retval Vector of MocapNET input, empty if there was nothing to track
+ */
+std::vector<float> returnMocapNETInputFromTrackedJoints(
+    struct KeyframeTracker * tracker,
+    const cv::Mat &bgr,
+    std::vector<std::vector<float> > & points2DInput,
+    int printFramerate,
+    float * fps
+)
+{
+    unsigned long startTime  = GetTickCountMicroseconds();
+    if (!keyframeTrackerTrack(tracker,bgr,points2DInput))
+        {
+            std::vector<float> emptyVector;
+            return emptyVector;
+        }
+
+    struct skeletonCOCO sk= {0};
+    for (unsigned int i=0; (i<points2DInput.size()) && (i<BODY25_PARTS-1); i++)
+        {
+            sk.joint2D[i].x = points2DInput[i][0];
+            sk.joint2D[i].y = points2DInput[i][1];
+        }
+    unsigned long endTime = GetTickCountMicroseconds();
+    *fps = convertStartEndTimeFromMicrosecondsToFPS(startTime,endTime);
+
+    if (printFramerate)
+        {
+            fprintf(stderr,"Tracked 2DSkeleton @ %0.2f fps ( keyframe every %u frames, %0.0f%% of joints tracked ) \n",*fps,tracker->interval,tracker->confidence*100);
+        }
+
+    return flattenskeletonCOCOToVector(&sk,bgr.size().width,bgr.size().height);
+}
+
+
+
+/**
+ * @brief Smooth a MocapNET output in place according to the "Smooth 3D Output" trackbar, the filter bank is set up again whenever the trackbar moves
+ * @ingroup demo
+ * @param Pointer to the filter bank
+ * @param Pointer to the strength the filter bank was last set up with
+ * @param Strength from the trackbar, 0 disables smoothing, 10 is the smoothest
+ * @param Filter to use ( MOCAPNET_FILTER_ONE_EURO or MOCAPNET_FILTER_CRITICALLY_DAMPED )
+ * @param MocapNET output to smooth, empty outputs are left alone
+ * @param Seconds since the previous frame, 0 for the nominal framerate
+ */
+void smoothMocapNETOutput(
+    struct MocapNETFilterBank * filter,
+    int * configuredStrength,
+    int strength,
+    unsigned int filterType,
+    std::vector<float> & bvhOutput,
+    float deltaTime
+)
+{
+    if (strength!=*configuredStrength)
+        {
+            if (filterType==MOCAPNET_FILTER_CRITICALLY_DAMPED)
+                {
+                    initializeCriticallyDampedFilterBank(filter,MOCAPNET_OUTPUT_NUMBER,MOCAPNET_OUTPUT_HIP_ZROTATION,30.0,0.03*strength);
+                }
+            else
+                {
+                    initializeOneEuroFilterBank(filter,MOCAPNET_OUTPUT_NUMBER,MOCAPNET_OUTPUT_HIP_ZROTATION,30.0,4.0/strength,0.01);
+                }
+            *configuredStrength=strength;
+        }
+    if (strength<=0)
+        {
+            return;
+        }
+    filterBankUpdateVector(filter,bvhOutput,deltaTime);
+}
+
+
+/**
+ * @brief Project a MocapNET output to 2D points for visualization using the incremental native forward kinematics, that only recompute
+ * the root when the body did not change, on every build. MocapNETMicroBenchmark --testFK checks that they agree with the RGBDAcquisition BVH code.
+ * @ingroup demo
+ * @param MocapNET output ( a BVH frame )
+ * @param The width of the 2D frame that will hold the 2D Points
+ * @param The height of the 2D frame that will hold the 2D Points
+ * @retval Vector of 2D points
+ */
+std::vector<std::vector<float> > projectMocapNETOutputTo2D(std::vector<float> & bvhOutput,unsigned int width,unsigned int height)
+{
+    return convertBVHFrameTo2DPointsIncremental(bvhOutput,width,height);
+}
+
+
+/**
+ * @brief Append the 2D stage output of a frame to a detection log so the 3D stage can be replayed later, frames without a detection are not logged
+ * @ingroup demo
+ * @param Pointer to an open detection log, null if nothing is recorded
+ * @param 1 = Also record the heatmaps of keyframes
+ * @param Frame number
+ * @param 1 = The joints came from the 2D joint estimator, 0 = from the joint tracker
+ * @param Capture time of the frame in microseconds
+ * @param Time the 2D stage spent on the frame in microseconds
+ * @param MocapNET input of the frame
+ */
+void recordDetections(
+    struct detectionLogWriter * detectionLog,
+    int recordHeatmaps,
+    unsigned int frameNumber,
+    int keyframe,
+    unsigned long captureTime,
+    unsigned long detectionTime,
+    const std::vector<float> & flatAndNormalizedPoints
+)
+{
+    if ( (detectionLog==0) || (flatAndNormalizedPoints.size()==0) )
+        {
+            return;
+        }
+    //The heatmaps of this thread belong to the last frame it ran the 2D joint estimator on
+    int withHeatmaps = ( (recordHeatmaps) && (keyframe) );
+    appendDetectionLogFrame(
+        detectionLog,
+        frameNumber,
+        (keyframe) ? DETECTION_LOG_KEYFRAME : 0,
+        captureTime,
+        detectionTime,
+        flatAndNormalizedPoints.data(),
+        flatAndNormalizedPoints.size(),
+        (withHeatmaps) ? heatmapsNHWC.data() : 0,
+        (withHeatmaps) ? heatmapsNHWC.size() : 0
+    );
+}
+
+
+/**
+ * @brief A frame as it leaves the capture stage of the pipeline
+ * @ingroup demo
+ */
+struct CapturedFrame
+{
+    unsigned int frameNumber;
+    unsigned int skippedFrames;
+    unsigned long acquisitionStart;
+    float fpsAcquisition;
+    cv::Mat frame;
+};
+
+/**
+ * @brief A frame as it leaves the 2D joint detector stage of the pipeline
+ * @ingroup demo
+ */
+struct DetectedFrame
+{
+    unsigned int frameNumber;
+    unsigned int skippedFrames;
+    unsigned long acquisitionStart;
+    float fpsAcquisition;
+    float fps2DJointDetector;
+    std::vector<float> flatAndNormalizedPoints;
+    std::vector<std::vector<float> > points2DInput;
+};
+
+/**
+ * @brief A frame as it leaves the MocapNET stage of the pipeline, it carries everything needed to draw it
+ * @ingroup demo
+ */
+struct EstimatedFrame
+{
+    unsigned long acquisitionStart;
+    struct MocapNETRenderRecord record;
+};
+
+
+/**
+ * @brief The settings of the 3D Control window, the GUI thread owns them and the trackbars write to them directly
+ * @ingroup demo
+ */
+struct LiveDemoSettings
+{
+    int stop;
+    int constrainPositionRotation;
+    int doCrop;
+    int tryForMaximumCrop;
+    int doSmoothing;
+    int drawFloor;
+    int drawNSDM;
+    int distance;
+    int rollValue;
+    int pitchValue;
+    int yawValue;
+};
+
+
+/**
+ * @brief Everything the threads of the pipelined live demo share. Capture, 2D joint detection and MocapNET run on their own threads
+ * connected with bounded queues, the calling thread draws the results and handles the GUI, so the achieved framerate is that of
+ * the slowest stage instead of the sum of all of them.
+ * @ingroup demo
+ */
+struct LiveDemoPipeline
+{
+    LiveDemoPipeline(unsigned int queueSize,int latestFrameWins) :
+        capturedFrames(latestFrameWins ? 1 : queueSize,latestFrameWins),
+        detectedFrames(queueSize,0),
+        estimatedFrames(queueSize,0)
+    {
+    }
+
+    //Written before the threads are started
+    cv::VideoCapture * cap;
+    struct TensorflowInstance * net;
+    struct MocapNET * mnet;
+    const char * webcam;
+    int live;
+    int visualize;
+    int latestFrameWins;
+    unsigned int frameLimit;
+    signed int totalNumberOfFrames;
+    unsigned int quitAfterNSkippedFrames;
+    float joint2DSensitivity;
+    unsigned int inputWidth2DJointDetector;
+    unsigned int inputHeight2DJointDetector;
+    unsigned int heatmapWidth2DJointDetector;
+    unsigned int heatmapHeight2DJointDetector;
+    unsigned int numberOfHeatmaps;
+    unsigned int numberOfOutputTensors;
+    unsigned int keyframeInterval;
+    float keyframeTargetFPS;
+    unsigned int filterType;
+    //Only touched by the 2D joint detector stage until it is joined
+    struct detectionLogWriter * detectionLog;
+    int recordHeatmaps;
+    unsigned int visWidth;
+    unsigned int visHeight;
+    //Only touched by the MocapNET stage until it is joined
+    std::vector<std::vector<float> > * bvhFrames;
+
+    //Copies of the GUI settings published by the GUI thread after every frame
+    std::atomic<int> stop;
+    std::atomic<int> constrainPositionRotation;
+    std::atomic<int> doCrop;
+    std::atomic<int> tryForMaximumCrop;
+    std::atomic<int> doSmoothing;
+    std::atomic<int> distance;
+    std::atomic<int> rollValue;
+    std::atomic<int> pitchValue;
+    std::atomic<int> yawValue;
+
+    //Reads frames on its own thread, created and destroyed by runPipelinedLiveDemo
+    struct FrameGrabber * grabber;
+
+    //Written by the capture stage when it is done
+    std::atomic<unsigned int> framesCaptured;
+    std::atomic<unsigned int> skippedFrames;
+
+    BoundedQueue<struct CapturedFrame> capturedFrames;
+    BoundedQueue<struct DetectedFrame> detectedFrames;
+    BoundedQueue<struct EstimatedFrame> estimatedFrames;
+};
+
+
+static void publishLiveDemoSettings(struct LiveDemoPipeline * pipeline,struct LiveDemoSettings * gui)
+{
+    pipeline->stop=gui->stop;
+    pipeline->constrainPositionRotation=gui->constrainPositionRotation;
+    pipeline->doCrop=gui->doCrop;
+    pipeline->tryForMaximumCrop=gui->tryForMaximumCrop;
+    pipeline->doSmoothing=gui->doSmoothing;
+    pipeline->distance=gui->distance;
+    pipeline->rollValue=gui->rollValue;
+    pipeline->pitchValue=gui->pitchValue;
+    pipeline->yawValue=gui->yawValue;
+}
+
+
+static void closeLiveDemoPipeline(struct LiveDemoPipeline * pipeline)
+{
+    pipeline->stop=1;
+    stopFrameGrabber(pipeline->grabber);
+    pipeline->capturedFrames.close();
+    pipeline->detectedFrames.close();
+    pipeline->estimatedFrames.close();
+}
+
+
+static void liveDemoCaptureStage(struct LiveDemoPipeline * pipeline)
+{
+    unsigned int frameNumber=0;
+
+    //Failed reads and the end of the stream are handled by the frame grabber
+    while ( ( (pipeline->live) || (frameNumber<pipeline->frameLimit) ) &&  (!pipeline->stop) )
+        {
+            struct CapturedFrame captured;
+            struct GrabbedFrameInfo grabbed;
+            unsigned long waitStart = GetTickCountMicroseconds();
+            //Every frame gets its own Mat since the previous one may still be in use by a later stage
+            if (!grabFrame(pipeline->grabber,captured.frame,&grabbed))
+                {
+                    break;
+                }
+            unsigned long waitEnd = GetTickCountMicroseconds();
+            recordStageTime(MOCAPNET_STAGE_CAPTURE,waitEnd-waitStart);
+
+            captured.acquisitionStart = waitEnd - grabbed.ageMicroseconds;
+            captured.fpsAcquisition = convertStartEndTimeFromMicrosecondsToFPS(waitStart,waitEnd);
+            captured.frameNumber=frameNumber;
+            captured.skippedFrames=grabbed.skippedFrames;
+            if (!pipeline->capturedFrames.push(captured))
+                {
+                    break;
+                }
+            ++frameNumber;
+        }
+
+    unsigned int skippedFrames=0;
+    getFrameGrabberStatistics(pipeline->grabber,0,0,&skippedFrames,0,0);
+    pipeline->framesCaptured=frameNumber;
+    pipeline->skippedFrames=skippedFrames;
+    pipeline->capturedFrames.close();
+}
+
+
+static void liveDemo2DJointDetectorStage(struct LiveDemoPipeline * pipeline)
+{
+    //Same state the sequential loop keeps between frames, the crop window of frame N comes from the detection of frame N-1
+    struct boundingBox cropBBox= {0};
+    unsigned int croppedDimensionWidth=0,croppedDimensionHeight=0,offsetX=0,offsetY=0;
+    int havePreviousDetection=0;
+    struct KeyframeTracker keyframeTracker;
+    initializeKeyframeTracker(&keyframeTracker,pipeline->keyframeInterval,pipeline->keyframeTargetFPS);
+
+    struct CapturedFrame captured;
+    while (pipeline->capturedFrames.pop(captured))
+        {
+            unsigned int frameWidth  =  captured.frame.size().width;
+            unsigned int frameHeight =  captured.frame.size().height;
+            cv::Mat frame = captured.frame;
+
+            struct DetectedFrame detected;
+            detected.frameNumber=captured.frameNumber;
+            detected.skippedFrames=captured.skippedFrames;
+            detected.acquisitionStart=captured.acquisitionStart;
+            detected.fpsAcquisition=captured.fpsAcquisition;
+            detected.fps2DJointDetector=0;
+
+            //Frames between keyframes follow the joints of the previous frame and skip the 2D joint estimator
+            unsigned long detectionStart = GetTickCountMicroseconds();
+            if (!keyframeTrackerNeedsKeyframe(&keyframeTracker))
+                {
+                    detected.flatAndNormalizedPoints = returnMocapNETInputFromTrackedJoints(
+                                                           &keyframeTracker,
+                                                           captured.frame,
+                                                           detected.points2DInput,
+                                                           !pipeline->visualize,
+                                                           &detected.fps2DJointDetector
+                                                       );
+                    recordDetections(pipeline->detectionLog,pipeline->recordHeatmaps,captured.frameNumber,0,captured.acquisitionStart,GetTickCountMicroseconds()-detectionStart,detected.flatAndNormalizedPoints);
+                    if (!pipeline->detectedFrames.push(detected))
+                        {
+                            break;
+                        }
+                    continue;
+                }
+
+            if ( (pipeline->doCrop) && (havePreviousDetection) )
+                {
+                    if (
+                        getBestCropWindow(
+                            pipeline->tryForMaximumCrop,
+                            &offsetX,
+                            &offsetY,
+                            &croppedDimensionWidth,
+                            &croppedDimensionHeight,
+                            &cropBBox,
+                            pipeline->inputWidth2DJointDetector,
+                            pipeline->inputHeight2DJointDetector,
+                            frameWidth,
+                            frameHeight
+                        )
+                    )
+                        {
+                            cv::Rect rectangleROI(offsetX,offsetY,croppedDimensionWidth,croppedDimensionHeight);
+                            frame = frame(rectangleROI);
+                            cropBBox.populated=0;
+                        }
+                }
+
+            //OpenCV windows can only be used from the GUI thread so the detector does not visualize anything here,
+            //the framerate is still only printed when there is no visualization to show it
+            detected.flatAndNormalizedPoints = returnMocapNETInputFrom2DDetectorOutput(
+                                                   pipeline->net,
+                                                   frame,
+                                                   &cropBBox,
+                                                   detected.points2DInput,
+                                                   pipeline->joint2DSensitivity,
+                                                   0,
+                                                   !pipeline->visualize,
+                                                   &detected.fps2DJointDetector,
+                                                   captured.frameNumber,
+                                                   offsetX,
+                                                   offsetY,
+                                                   frameWidth-croppedDimensionWidth,
+                                                   frameHeight-croppedDimensionHeight,
+                                                   pipeline->inputWidth2DJointDetector,
+                                                   pipeline->inputHeight2DJointDetector,
+                                                   pipeline->heatmapWidth2DJointDetector,
+                                                   pipeline->heatmapHeight2DJointDetector,
+                                                   pipeline->numberOfHeatmaps,
+                                                   pipeline->numberOfOutputTensors
+                                               );
+            havePreviousDetection = (detected.flatAndNormalizedPoints.size()>0);
+            keyframeTrackerAddKeyframe(&keyframeTracker,captured.frame,detected.points2DInput,GetTickCountMicroseconds()-detectionStart);
+            recordDetections(pipeline->detectionLog,pipeline->recordHeatmaps,captured.frameNumber,1,captured.acquisitionStart,GetTickCountMicroseconds()-detectionStart,detected.flatAndNormalizedPoints);
+
+            if (!pipeline->detectedFrames.push(detected))
+                {
+                    break;
+                }
+        }
+
+    pipeline->detectedFrames.close();
+}
+
+
+static void liveDemoMocapNETStage(struct LiveDemoPipeline * pipeline)
+{
+    struct MocapNETResult mocapNETResult;
+    mocapNETResult.fields=0;
+    struct MocapNETFilterBank filter;
+    int filterStrength=0;
+    unsigned long previousAcquisitionStart=0;
+
+    struct DetectedFrame detected;
+    while (pipeline->detectedFrames.pop(detected))
+        {
+            struct EstimatedFrame estimated;
+            struct MocapNETRenderRecord &record = estimated.record;
+            std::vector<float> &bvhOutput = record.mocapNETOutput;
+
+            unsigned long startTime = GetTickCountMicroseconds();
+            if (runMocapNETWithResult(pipeline->mnet,detected.flatAndNormalizedPoints,&mocapNETResult))
+                {
+                    bvhOutput = mocapNETResult.output;
+                }
+            unsigned long endTime = GetTickCountMicroseconds();
+
+            //Live sources are smoothed using the real time between frames, files using their nominal framerate
+            float deltaTime=0.0;
+            if ( (pipeline->live) && (previousAcquisitionStart!=0) )
+                {
+                    deltaTime = (float) (detected.acquisitionStart-previousAcquisitionStart)/1000000;
+                }
+            previousAcquisitionStart=detected.acquisitionStart;
+            smoothMocapNETOutput(&filter,&filterStrength,pipeline->doSmoothing,pipeline->filterType,bvhOutput,deltaTime);
+
+            if (!pipeline->live)
+                {
+                    pipeline->bvhFrames->push_back(bvhOutput);
+                }
+
+            std::vector<float> &bvhForcedViewOutput = record.mocapNETOutputWithGUIForcedView;
+            bvhForcedViewOutput=bvhOutput;
+            if ( (pipeline->constrainPositionRotation) && (bvhForcedViewOutput.size()>0) )
+                {
+                    bvhForcedViewOutput[MOCAPNET_OUTPUT_HIP_XPOSITION]=0.0;
+                    bvhForcedViewOutput[MOCAPNET_OUTPUT_HIP_YPOSITION]=0.0;
+                    bvhForcedViewOutput[MOCAPNET_OUTPUT_HIP_ZPOSITION]=-160.0 - (float) pipeline->distance;
+                    bvhForcedViewOutput[MOCAPNET_OUTPUT_HIP_ZROTATION]=(float) pipeline->rollValue;
+                    bvhForcedViewOutput[MOCAPNET_OUTPUT_HIP_YROTATION]=(float) pipeline->yawValue;
+                    bvhForcedViewOutput[MOCAPNET_OUTPUT_HIP_XROTATION]=(float) pipeline->pitchValue;
+                }
+
+            //The projection contexts are per thread so this stage keeps its own incremental forward kinematics cache
+            if (bvhForcedViewOutput.size()>0)
+                {
+                    record.points2DOutputGUIForcedView = projectMocapNETOutputTo2D(bvhForcedViewOutput,pipeline->visWidth,pipeline->visHeight);
+                }
+            if (bvhOutput.size()>0)
+                {
+                    record.points2DOutput = projectMocapNETOutputTo2D(bvhOutput,1920,1080);
+                }
+
+            estimated.acquisitionStart=detected.acquisitionStart;
+            record.frameNumber=detected.frameNumber;
+            record.skippedFrames=detected.skippedFrames;
+            record.totalNumberOfFrames=pipeline->totalNumberOfFrames;
+            record.numberOfFramesToGrab=pipeline->frameLimit;
+            record.drawFloor=0;
+            record.drawNSDM=0;
+            record.fpsTotal=0.0;
+            record.fpsAcquisition=detected.fpsAcquisition;
+            record.joint2DEstimator=detected.fps2DJointDetector;
+            record.fpsMocapNET=convertStartEndTimeFromMicrosecondsToFPS(startTime,endTime);
+            //The complete input also carries the NSDM so drawing does not compute it again
+            record.mocapNETInput=mocapNETResult.input;
+            record.points2DInput=std::move(detected.points2DInput);
+
+            if (!pipeline->estimatedFrames.push(estimated))
+                {
+                    break;
+                }
+        }
+
+    pipeline->estimatedFrames.close();
+}
+
+
+/**
+ * @brief Run the live demo as a pipeline, capture, 2D joint detection and MocapNET get their own threads and the calling thread
+ * draws the results and handles the GUI. Returns when the input ends or the user stops the demo.
+ * @ingroup demo
+ * @retval Number of frames shown
+ */
+unsigned int runPipelinedLiveDemo(
+    struct LiveDemoPipeline * pipeline,
+    struct LiveDemoSettings * gui,
+    int visualize,
+    cv::Mat &controlMat,
+    struct MocapNETVisualizer ** visualizer,
+    struct MocapNETAsyncRenderer * renderer,
+    unsigned int * frameNumber,
+    unsigned int * skippedFrames
+)
+{
+    //Live sources or a pipeline that prefers fresh frames always want the newest frame, files otherwise keep every frame
+    pipeline->grabber = createFrameGrabber(pipeline->cap,FRAME_GRABBER_DEFAULT_RING_SIZE,( (pipeline->live) || (pipeline->latestFrameWins) ),pipeline->totalNumberOfFrames,pipeline->quitAfterNSkippedFrames);
+    if (pipeline->grabber==0)
+        {
+            return 0;
+        }
+
+    publishLiveDemoSettings(pipeline,gui);
+    std::thread captureThread(liveDemoCaptureStage,pipeline);
+    std::thread detectorThread(liveDemo2DJointDetectorStage,pipeline);
+    std::thread mocapNETThread(liveDemoMocapNETStage,pipeline);
+
+    unsigned int framesShown=0;
+    unsigned long previousOutputTime=0;
+    struct EstimatedFrame estimated;
+    while (pipeline->estimatedFrames.pop(estimated))
+        {
+            struct MocapNETRenderRecord &record = estimated.record;
+            unsigned long outputTime = GetTickCountMicroseconds();
+
+            //The total framerate of a pipeline is the rate frames come out of it, the time a frame spent in it is its latency
+            if (previousOutputTime!=0)
+                {
+                    record.fpsTotal = convertStartEndTimeFromMicrosecondsToFPS(previousOutputTime,outputTime);
+                }
+            else
+                {
+                    record.fpsTotal = convertStartEndTimeFromMicrosecondsToFPS(estimated.acquisitionStart,outputTime);
+                }
+            previousOutputTime=outputTime;
+            frameGrabberReportLatency(pipeline->grabber,outputTime-estimated.acquisitionStart);
+            record.drawFloor=gui->drawFloor;
+            record.drawNSDM=gui->drawNSDM;
+
+            if (!visualize)
+                {
+                    fprintf(stderr,"Pipeline @ %0.2f fps , latency %0.2f ms \n",record.fpsTotal,(float) (outputTime-estimated.acquisitionStart)/1000);
+                }
+            else
+                {
+                    if (framesShown==0)
+                        {
+                            cv::imshow("3D Control",controlMat);
+                            createTrackbar("Stop Demo", "3D Control", &gui->stop, 1);
+                            createTrackbar("Constrain Position/Rotation", "3D Control", &gui->constrainPositionRotation, 1);
+                            createTrackbar("Automatic Crop", "3D Control", &gui->doCrop, 1);
+                            createTrackbar("Smooth 3D Output", "3D Control", &gui->doSmoothing, 10);
+                            createTrackbar("Maximize Crop", "3D Control", &gui->tryForMaximumCrop, 1);
+                            createTrackbar("Draw Floor", "3D Control", &gui->drawFloor, 1);
+                            createTrackbar("Draw NSDM", "3D Control", &gui->drawNSDM, 1);
+                            createTrackbar("Distance  ", "3D Control", &gui->distance,  150);
+                            createTrackbar("Yaw            ", "3D Control", &gui->yawValue,  360);
+                            createTrackbar("Pitch          ", "3D Control", &gui->pitchValue,360);
+                            createTrackbar("Roll            ", "3D Control", &gui->rollValue, 360);
+                            cv::namedWindow("3D Points Output");
+                        }
+                    cv::imshow("3D Control",controlMat);
+
+                    if (*visualizer==0)
+                        {
+                            *visualizer = createVisualizer("3D Points Output",pipeline->visWidth,pipeline->visHeight);
+                        }
+                    if (
+                        visualizerDrawFrame(
+                            *visualizer,
+                            record.frameNumber,
+                            record.skippedFrames,
+                            record.totalNumberOfFrames,
+                            record.numberOfFramesToGrab,
+                            record.drawFloor,
+                            record.drawNSDM,
+                            record.fpsTotal,
+                            record.fpsAcquisition,
+                            record.joint2DEstimator,
+                            record.fpsMocapNET,
+                            record.mocapNETInput,
+                            record.mocapNETOutput,
+                            record.mocapNETOutputWithGUIForcedView,
+                            record.points2DOutputGUIForcedView,
+                            0,
+                            0
+                        )
+                    )
+                        {
+                            visualizerShow(*visualizer,0);
+                        }
+
+                    if (framesShown==0)
+                        {
+                            cv::resizeWindow("3D Control",pipeline->inputWidth2DJointDetector,pipeline->inputHeight2DJointDetector);
+                            cv::moveWindow("3D Control",pipeline->inputWidth2DJointDetector,pipeline->inputHeight2DJointDetector);
+                            cv::moveWindow("3D Points Output",pipeline->inputWidth2DJointDetector*2,0);
+                        }
+
+                    int key = cv::waitKey(1) ;
+                    key = 0x000000FF & key;
+                    if ( (key == 113) || (key == 81) )
+                        {
+                            fprintf(stderr,"Stopping MocapNET after keypress..\n");
+                            gui->stop=1;
+                        } // stop capturing by pressing q
+                }
+
+            if (renderer!=0)
+                {
+                    submitFrameToAsyncRenderer(renderer,&record);
+                    presentAsyncRendererFrame(renderer);
+                }
+            ++framesShown;
+            dumpStageStatisticsIfDue();
+
+            publishLiveDemoSettings(pipeline,gui);
+            if (gui->stop)
+                {
+                    break;
+                }
+        }
+
+    //Whatever is still in flight is thrown away, every stage finishes its current frame and exits
+    closeLiveDemoPipeline(pipeline);
+    captureThread.join();
+    detectorThread.join();
+    mocapNETThread.join();
+
+    unsigned int framesDropped=0;
+    float averageLatency=0.0,maximumLatency=0.0;
+    getFrameGrabberStatistics(pipeline->grabber,0,&framesDropped,0,&averageLatency,&maximumLatency);
+    destroyFrameGrabber(pipeline->grabber);
+    pipeline->grabber=0;
+
+    *frameNumber=pipeline->framesCaptured;
+    *skippedFrames=pipeline->skippedFrames;
+    fprintf(stderr,"Pipeline finished, %u frames captured, %u shown, %u dropped to keep up with the input\n",*frameNumber,framesShown,framesDropped+pipeline->capturedFrames.getDropped());
+    fprintf(stderr,"Capture to output latency %0.2f ms average / %0.2f ms worst\n",averageLatency,maximumLatency);
+    return framesShown;
+}
+
 
 int main(int argc, char *argv[])
 {
@@ -267,7 +972,7 @@ int main(int argc, char *argv[])
 
     int live=0,stop=0;
     int constrainPositionRotation=1;
-    int doCrop=1,tryForMaximumCrop=0,doSmoothing=3,drawFloor=1,drawNSDM=1;
+    int doCrop=1,tryForMaximumCrop=0,doSmoothing=0,drawFloor=1,drawNSDM=1;
     int distance = 0,rollValue = 0,pitchValue = 0, yawValue = 0;
 
     unsigned int quitAfterNSkippedFrames = 10000;
@@ -287,6 +992,27 @@ int main(int argc, char *argv[])
     char   networkOutputLayer[]="k2tfout_0";
     unsigned int numberOfOutputTensors = 3;
     char * networkPath = (char*) networkPathFORTHStatic;
+    //Optional review render produced on a separate thread ( PNG directory or video file )
+    const char * renderPath = 0;
+    unsigned int renderQueueSize = 8;
+    struct MocapNETAsyncRenderer * renderer = 0;
+    struct MocapNETVisualizer * visualizer = 0;
+    //Run capture, 2D joint detection and MocapNET on separate threads
+    int pipelined=0,latestFrameWins=0;
+    unsigned int pipelineQueueSize=2;
+    //Run the 2D joint estimator only on keyframes, 1 means on every frame
+    unsigned int keyframeInterval=1;
+    float keyframeTargetFPS=30.0;
+    //Filter used by the "Smooth 3D Output" trackbar
+    unsigned int filterType=MOCAPNET_FILTER_ONE_EURO;
+    //Per stage timing statistics, .json files get a snapshot and .csv files a row per stage every interval
+    const char * statisticsPath = 0;
+    unsigned int statisticsInterval = 1000;
+    //Record the 2D stage output so the 3D stage can be replayed without a camera or GPU
+    const char * detectionLogPath = 0;
+    int recordHeatmaps=0;
+    struct detectionLogWriter detectionLogStorage;
+    struct detectionLogWriter * detectionLog = 0;
     //-------------------------------
 
     for (int i=0; i<argc; i++)
@@ -331,6 +1057,75 @@ int main(int argc, char *argv[])
                     {
                         visualize=0;
                     }
+                else if (strcmp(argv[i],"--render")==0)
+                    {
+                        renderPath=argv[i+1];
+                    }
+                else if (strcmp(argv[i],"--renderqueue")==0)
+                    {
+                        renderQueueSize=atoi(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--pipeline")==0)
+                    {
+                        pipelined=1;
+                    }
+                else if (strcmp(argv[i],"--latest")==0)
+                    {
+                        //Only the newest captured frame waits for the 2D joint detector, older ones are dropped
+                        pipelined=1;
+                        latestFrameWins=1;
+                    }
+                else if (strcmp(argv[i],"--keyframes")==0)
+                    {
+                        //Run the 2D joint estimator at most every n frames and track the joints in between
+                        keyframeInterval=atoi(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--targetfps")==0)
+                    {
+                        //The keyframe interval grows until the 2D stage keeps up with this framerate
+                        keyframeTargetFPS=atof(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--filter")==0)
+                    {
+                        //oneeuro or damped
+                        if (strcmp(argv[i+1],"damped")==0)
+                            {
+                                filterType=MOCAPNET_FILTER_CRITICALLY_DAMPED;
+                            }
+                        else
+                            {
+                                filterType=MOCAPNET_FILTER_ONE_EURO;
+                            }
+                    }
+                else if (strcmp(argv[i],"--smoothing")==0)
+                    {
+                        doSmoothing=atoi(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--nopafs")==0)
+                    {
+                        //Ignore the PAFs of the 2D joint estimator and use the strongest peak of every heatmap
+                        use2DJointEstimatorPAFs=0;
+                    }
+                else if (strcmp(argv[i],"--recorddetections")==0)
+                    {
+                        detectionLogPath=argv[i+1];
+                    }
+                else if (strcmp(argv[i],"--recordheatmaps")==0)
+                    {
+                        recordHeatmaps=1;
+                    }
+                else if (strcmp(argv[i],"--stats")==0)
+                    {
+                        statisticsPath=argv[i+1];
+                    }
+                else if (strcmp(argv[i],"--statsinterval")==0)
+                    {
+                        statisticsInterval=atoi(argv[i+1]);
+                    }
+                else if (strcmp(argv[i],"--pipelinequeue")==0)
+                    {
+                        pipelineQueueSize=atoi(argv[i+1]);
+                    }
                 else if (strcmp(argv[i],"--2dmodel")==0)
                     {
                         networkPath=argv[i+1];
@@ -388,9 +1183,22 @@ int main(int argc, char *argv[])
             fprintf(stderr,"BVH allocation happened we are going to have BVH visualization \n");
         }
 
+    if (renderPath!=0)
+        {
+            //Same size as the visualization window, the forced view is projected for it
+            renderer = createAsyncRenderer(getRenderSinkTypeFromPath(renderPath),renderPath,1024,768,renderQueueSize,30.0);
+        }
+
     fprintf(stderr,"Attempting to open input device\n");
     cv::Mat controlMat = Mat(Size(inputWidth2DJointDetector,2),CV_8UC3, Scalar(0,0,0));
 
+    //The stage statistics are printed when we finish
+    enableStageTimers(1);
+    if (statisticsPath!=0)
+        {
+            setStageStatisticsDump(statisticsPath,statisticsInterval);
+        }
+
     VideoCapture cap(webcam); // open the default camera
     if (webcam==0)
         {
@@ -416,6 +1224,24 @@ int main(int argc, char *argv[])
      frameLimit=totalNumberOfFrames;   
     }
 
+    if (detectionLogPath!=0)
+        {
+            if (
+                createDetectionLog(
+                    &detectionLogStorage,
+                    detectionLogPath,
+                    MOCAPNET_UNCOMPRESSED_INPUT_SIZE,
+                    (unsigned int) cap.get(CV_CAP_PROP_FRAME_WIDTH),
+                    (unsigned int) cap.get(CV_CAP_PROP_FRAME_HEIGHT),
+                    (recordHeatmaps) ? heatmapWidth2DJointDetector : 0,
+                    (recordHeatmaps) ? heatmapHeight2DJointDetector : 0
+                )
+            )
+                {
+                    detectionLog=&detectionLogStorage;
+                }
+        }
+
     cv::Mat frame;
     struct boundingBox cropBBox= {0};
     unsigned int croppedDimensionWidth=0,croppedDimensionHeight=0,offsetX=0,offsetY=0;
@@ -426,9 +1252,16 @@ int main(int argc, char *argv[])
 
 
     std::vector<float> flatAndNormalizedPoints;
+    struct KeyframeTracker keyframeTracker;
+    initializeKeyframeTracker(&keyframeTracker,keyframeInterval,keyframeTargetFPS);
     std::vector<std::vector<float> > bvhFrames;
-    std::vector<float> previousBvhOutput;
+    struct MocapNETFilterBank filter;
+    int filterStrength=0;
+    unsigned long previousAcquisitionStart=0;
     std::vector<float> bvhOutput;
+    //Reused between frames, keeps the complete network input/NSDM so visualization does not have to recompute them
+    struct MocapNETResult mocapNETResult;
+    mocapNETResult.fields=0;
     std::vector<std::vector<float> > points2DOutput;
     std::vector<std::vector<float> > points2DOutputGUIForcedView;
 
@@ -446,12 +1279,76 @@ int main(int argc, char *argv[])
             )
                 {
                     frameNumber=0;
-                    while ( ( (live) || (frameNumber<frameLimit) ) &&  (!stop) )
+                    if (pipelined)
+                        {
+                            struct LiveDemoPipeline pipeline(pipelineQueueSize,latestFrameWins);
+                            pipeline.cap=&cap;
+                            pipeline.net=&net;
+                            pipeline.mnet=&mnet;
+                            pipeline.webcam=webcam;
+                            pipeline.live=live;
+                            pipeline.visualize=visualize;
+                            pipeline.latestFrameWins=latestFrameWins;
+                            pipeline.frameLimit=frameLimit;
+                            pipeline.totalNumberOfFrames=totalNumberOfFrames;
+                            pipeline.quitAfterNSkippedFrames=quitAfterNSkippedFrames;
+                            pipeline.joint2DSensitivity=joint2DSensitivity;
+                            pipeline.inputWidth2DJointDetector=inputWidth2DJointDetector;
+                            pipeline.inputHeight2DJointDetector=inputHeight2DJointDetector;
+                            pipeline.heatmapWidth2DJointDetector=heatmapWidth2DJointDetector;
+                            pipeline.heatmapHeight2DJointDetector=heatmapHeight2DJointDetector;
+                            pipeline.numberOfHeatmaps=numberOfHeatmaps;
+                            pipeline.numberOfOutputTensors=numberOfOutputTensors;
+                            pipeline.keyframeInterval=keyframeInterval;
+                            pipeline.keyframeTargetFPS=keyframeTargetFPS;
+                            pipeline.filterType=filterType;
+                            pipeline.detectionLog=detectionLog;
+                            pipeline.recordHeatmaps=recordHeatmaps;
+                            pipeline.visWidth=1024;
+                            pipeline.visHeight=768;
+                            pipeline.bvhFrames=&bvhFrames;
+                            pipeline.grabber=0;
+                            pipeline.framesCaptured=0;
+                            pipeline.skippedFrames=0;
+
+                            struct LiveDemoSettings gui;
+                            gui.stop=stop;
+                            gui.constrainPositionRotation=constrainPositionRotation;
+                            gui.doCrop=doCrop;
+                            gui.tryForMaximumCrop=tryForMaximumCrop;
+                            gui.doSmoothing=doSmoothing;
+                            gui.drawFloor=drawFloor;
+                            gui.drawNSDM=drawNSDM;
+                            gui.distance=distance;
+                            gui.rollValue=rollValue;
+                            gui.pitchValue=pitchValue;
+                            gui.yawValue=yawValue;
+
+                            runPipelinedLiveDemo(&pipeline,&gui,visualize,controlMat,&visualizer,renderer,&frameNumber,&skippedFrames);
+                        }
+
+                    //The sequential loop, used when the pipeline is not requested
+                    //Frames are read on a thread of their own so the driver buffer never fills up while we are busy, live sources always give us the newest frame
+                    struct FrameGrabber * grabber = 0;
+                    if (!pipelined)
+                        {
+                            grabber = createFrameGrabber(&cap,FRAME_GRABBER_DEFAULT_RING_SIZE,live,totalNumberOfFrames,quitAfterNSkippedFrames);
+                        }
+                    while ( (grabber!=0) && ( (live) || (frameNumber<frameLimit) ) &&  (!stop) )
                         {
                             // Get Image
                             unsigned long acquisitionStart = GetTickCountMicroseconds();
 
-                            cap >> frame; // get a new frame from camera
+                            struct GrabbedFrameInfo grabbed;
+                            if (!grabFrame(grabber,frame,&grabbed))
+                                {
+                                    fprintf(stderr,GREEN "Stream appears to have ended..\n" NORMAL);
+                                    break;
+                                }
+                            skippedFrames=grabbed.skippedFrames;
+                            recordStageTime(MOCAPNET_STAGE_CAPTURE,GetTickCountMicroseconds()-acquisitionStart);
+                            //When the frame was actually captured, it may have waited in the ring for a while
+                            unsigned long captureTime = GetTickCountMicroseconds() - grabbed.ageMicroseconds;
                             cv::Mat frameOriginal = frame; //ECONOMY .clone();
 
                             unsigned int frameWidth  =  frame.size().width;  //frame.cols
@@ -481,9 +1378,12 @@ int main(int argc, char *argv[])
 
                                     float fpsAcquisition = convertStartEndTimeFromMicrosecondsToFPS(acquisitionStart,acquisitionEnd);
 
+                                    //Frames between keyframes skip the 2D joint estimator so they are not cropped either
+                                    int keyframe = keyframeTrackerNeedsKeyframe(&keyframeTracker);
+
                                     //------------------------------------------------------------------------
                                     // If cropping is enabled
-                                    if (doCrop)
+                                    if ( (doCrop) && (keyframe) )
                                         {
                                             //And there was some previous BVH output
                                             if (bvhOutput.size()>0)
@@ -527,44 +1427,65 @@ int main(int argc, char *argv[])
                                             
                                             // Get 2D Skeleton Input from Frame
                                             float fps2DJointDetector = 0;
-                                            flatAndNormalizedPoints = returnMocapNETInputFrom2DDetectorOutput(
-                                                                          &net,
-                                                                          frame,
-                                                                          &cropBBox,
-                                                                          points2DInput,
-                                                                          joint2DSensitivity,
-                                                                          visualize,
-                                                                          &fps2DJointDetector,
-                                                                          frameNumber,
-                                                                          offsetX,
-                                                                          offsetY,
-                                                                          frameWidth-croppedDimensionWidth,
-                                                                          frameHeight-croppedDimensionHeight,
-                                                                          inputWidth2DJointDetector,
-                                                                          inputHeight2DJointDetector,
-                                                                          heatmapWidth2DJointDetector,
-                                                                          heatmapHeight2DJointDetector,
-                                                                          numberOfHeatmaps,
-                                                                          numberOfOutputTensors
-                                                                      );
+                                            unsigned long detectionStart = GetTickCountMicroseconds();
+                                            if (!keyframe)
+                                                {
+                                                    flatAndNormalizedPoints = returnMocapNETInputFromTrackedJoints(
+                                                                                  &keyframeTracker,
+                                                                                  frameOriginal,
+                                                                                  points2DInput,
+                                                                                  !visualize,
+                                                                                  &fps2DJointDetector
+                                                                              );
+                                                }
+                                            else
+                                                {
+                                                    flatAndNormalizedPoints = returnMocapNETInputFrom2DDetectorOutput(
+                                                                                  &net,
+                                                                                  frame,
+                                                                                  &cropBBox,
+                                                                                  points2DInput,
+                                                                                  joint2DSensitivity,
+                                                                                  visualize,
+                                                                                  !visualize,
+                                                                                  &fps2DJointDetector,
+                                                                                  frameNumber,
+                                                                                  offsetX,
+                                                                                  offsetY,
+                                                                                  frameWidth-croppedDimensionWidth,
+                                                                                  frameHeight-croppedDimensionHeight,
+                                                                                  inputWidth2DJointDetector,
+                                                                                  inputHeight2DJointDetector,
+                                                                                  heatmapWidth2DJointDetector,
+                                                                                  heatmapHeight2DJointDetector,
+                                                                                  numberOfHeatmaps,
+                                                                                  numberOfOutputTensors
+                                                                              );
+                                                    keyframeTrackerAddKeyframe(&keyframeTracker,frameOriginal,points2DInput,GetTickCountMicroseconds()-detectionStart);
+                                                }
+                                            recordDetections(detectionLog,recordHeatmaps,frameNumber,keyframe,captureTime,GetTickCountMicroseconds()-detectionStart,flatAndNormalizedPoints);
 
                                             // Get MocapNET prediction
                                             unsigned long startTime = GetTickCountMicroseconds();
-                                            bvhOutput = runMocapNET(&mnet,flatAndNormalizedPoints);
+                                            bvhOutput.clear();
+                                            if (runMocapNETWithResult(&mnet,flatAndNormalizedPoints,&mocapNETResult))
+                                                {
+                                                    bvhOutput = mocapNETResult.output;
+                                                }
                                             unsigned long endTime = GetTickCountMicroseconds();
                                             
                                             //-------------------------------------------------------------------------------------------------------------------------
                                             // Adding a vary baseline smoothing after a project request, it should be noted
                                             // that no results during the original BMVC2019 used any smoothing of any kind 
                                             //-------------------------------------------------------------------------------------------------------------------------
-                                            if(doSmoothing)
-                                            {//-------------------------------------------------------------------------------------------------------------------------
-                                                 if ( (previousBvhOutput.size()>0) && (bvhOutput.size()>0) )
-                                                 {
-                                                     smoothVector(previousBvhOutput,bvhOutput,(float) doSmoothing/10);
-                                                    previousBvhOutput=bvhOutput;
-                                                 }
-                                            }//-------------------------------------------------------------------------------------------------------------------------
+                                            float deltaTime=0.0;
+                                            if ( (live) && (previousAcquisitionStart!=0) )
+                                                {
+                                                    deltaTime = (float) (captureTime-previousAcquisitionStart)/1000000;
+                                                }
+                                            previousAcquisitionStart=captureTime;
+                                            smoothMocapNETOutput(&filter,&filterStrength,doSmoothing,filterType,bvhOutput,deltaTime);
+                                            //-------------------------------------------------------------------------------------------------------------------------
                                             
 
                                             float fpsMocapNET = convertStartEndTimeFromMicrosecondsToFPS(startTime,endTime);
@@ -600,14 +1521,16 @@ int main(int argc, char *argv[])
                                                         }
                                                 }
 
+                                            //Both projections share the body transforms, the forced view only changes
+                                            //the hip channels so the second call only recomputes the root
                                             if (bvhForcedViewOutput.size()>0)
                                             { 
-                                              points2DOutputGUIForcedView = convertBVHFrameTo2DPoints(bvhForcedViewOutput,visWidth,visHeight);
+                                              points2DOutputGUIForcedView = projectMocapNETOutputTo2D(bvhForcedViewOutput,visWidth,visHeight);
                                             }
 
                                             if (bvhOutput.size()>0)
                                             { 
-                                              points2DOutput = convertBVHFrameTo2DPoints(
+                                              points2DOutput = projectMocapNETOutputTo2D(
                                                                                           bvhOutput,
                                                                                           1920,//visWidth,
                                                                                           1080//visHeight
@@ -673,28 +1596,35 @@ int main(int argc, char *argv[])
                                                     cv::imshow("3D Control",controlMat);
 
 
-                                                    visualizePoints(
-                                                        "3D Points Output",
-                                                        frameNumber,
-                                                        skippedFrames,
-                                                        totalNumberOfFrames,
-                                                        frameLimit,
-                                                        drawFloor,
-                                                        drawNSDM,
-                                                        fpsTotal,
-                                                        fpsAcquisition,
-                                                        fps2DJointDetector,
-                                                        fpsMocapNET,
-                                                        visWidth,
-                                                        visHeight,
-                                                        0,
-                                                        flatAndNormalizedPoints,
-                                                        bvhOutput,
-                                                        bvhForcedViewOutput,
-                                                        points2DInput,
-                                                        points2DOutput,
-                                                        points2DOutputGUIForcedView
-                                                    );
+                                                    //The visualizer keeps its canvas and background between frames
+                                                    if (visualizer==0)
+                                                        {
+                                                            visualizer = createVisualizer("3D Points Output",visWidth,visHeight);
+                                                        }
+                                                    if (
+                                                        visualizerDrawFrame(
+                                                            visualizer,
+                                                            frameNumber,
+                                                            skippedFrames,
+                                                            totalNumberOfFrames,
+                                                            frameLimit,
+                                                            drawFloor,
+                                                            drawNSDM,
+                                                            fpsTotal,
+                                                            fpsAcquisition,
+                                                            fps2DJointDetector,
+                                                            fpsMocapNET,
+                                                            flatAndNormalizedPoints,
+                                                            bvhOutput,
+                                                            bvhForcedViewOutput,
+                                                            points2DOutputGUIForcedView,
+                                                            mocapNETResult.NSDM,
+                                                            mocapNETResult.NSDMSize
+                                                        )
+                                                    )
+                                                        {
+                                                            visualizerShow(visualizer,0);
+                                                        }
 
 
                                                     if (frameNumber==0)
@@ -726,44 +1656,65 @@ int main(int argc, char *argv[])
 
                                                 }
                                             //---------------------------------------------------
-                                        }
-
 
 
-                                    ++frameNumber;
-                                }
-                            else
-                                {
-                                    if (totalNumberOfFrames>0)
-                                        {
-                                            if (skippedFrames+frameNumber>=totalNumberOfFrames)
+                                            //Review render, this only copies the data of the frame, drawing and encoding happen on the renderer thread
+                                            if (renderer!=0)
                                                 {
-                                                    fprintf(stderr,GREEN "Stream appears to have ended..\n" NORMAL);
-                                                    break;
+                                                    struct MocapNETRenderRecord record;
+                                                    record.frameNumber=frameNumber;
+                                                    record.skippedFrames=skippedFrames;
+                                                    record.totalNumberOfFrames=totalNumberOfFrames;
+                                                    record.numberOfFramesToGrab=frameLimit;
+                                                    record.drawFloor=drawFloor;
+                                                    record.drawNSDM=drawNSDM;
+                                                    record.fpsTotal=fpsTotal;
+                                                    record.fpsAcquisition=fpsAcquisition;
+                                                    record.joint2DEstimator=fps2DJointDetector;
+                                                    record.fpsMocapNET=fpsMocapNET;
+                                                    //The complete input also carries the NSDM so the renderer does not compute it again
+                                                    record.mocapNETInput=mocapNETResult.input;
+                                                    record.mocapNETOutput=bvhOutput;
+                                                    record.mocapNETOutputWithGUIForcedView=bvhForcedViewOutput;
+                                                    record.points2DInput=points2DInput;
+                                                    record.points2DOutput=points2DOutput;
+                                                    record.points2DOutputGUIForcedView=points2DOutputGUIForcedView;
+                                                    submitFrameToAsyncRenderer(renderer,&record);
+                                                    presentAsyncRendererFrame(renderer);
                                                 }
-                                            else
-                                                {
-                                                    ++skippedFrames;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            ++skippedFrames;
                                         }
 
-                                    fprintf(stderr,YELLOW "OpenCV failed to snap frame %u from your input source (%s)\n" NORMAL,frameNumber,webcam);
-                                    fprintf(stderr,NORMAL "Skipped frames %u/%u\n" NORMAL,skippedFrames,frameNumber);
 
-                                    if (skippedFrames>quitAfterNSkippedFrames)
-                                        {
-                                            fprintf(stderr,RED "We have encountered %u skipped frames so quitting ..\n" NORMAL,quitAfterNSkippedFrames);
-                                            fprintf(stderr,RED "If you don't want this to happen consider using the flag --maxskippedframes and providing a bigger value ..\n" NORMAL);
-                                            break;
-                                        }
+
+                                    ++frameNumber;
                                 }
 
+                            frameGrabberReportLatency(grabber,GetTickCountMicroseconds()-captureTime);
+                            dumpStageStatisticsIfDue();
                         } //Master While Frames Exist loop
 
+                    if (grabber!=0)
+                        {
+                            unsigned int framesDropped=0;
+                            float averageLatency=0.0,maximumLatency=0.0;
+                            getFrameGrabberStatistics(grabber,0,&framesDropped,&skippedFrames,&averageLatency,&maximumLatency);
+                            fprintf(stderr,"Capture to output latency %0.2f ms average / %0.2f ms worst , %u frames dropped to keep up with the input\n",averageLatency,maximumLatency,framesDropped);
+                            destroyFrameGrabber(grabber);
+                            grabber=0;
+                        }
+
+                    //Let the renderer finish whatever is still queued
+                    if (renderer!=0)
+                        {
+                            destroyAsyncRenderer(renderer);
+                            renderer=0;
+                        }
+                    if (visualizer!=0)
+                        {
+                            destroyVisualizer(visualizer);
+                            visualizer=0;
+                        }
+
                     //After beeing done with the frames gathered the bvhFrames vector should be full of our data, so maybe we want to write it to a file..!
                     if (!live)
                         {
@@ -799,6 +1750,22 @@ int main(int argc, char *argv[])
     // the camera will be deinitialized automatically in VideoCapture destructor
 
 
+    if (detectionLog!=0)
+        {
+            unsigned int recordedFrames = detectionLog->header.numberOfFrames;
+            if (closeDetectionLogWriter(detectionLog))
+                {
+                    fprintf(stderr,GREEN "Recorded the detections of %u frames to %s\n" NORMAL,recordedFrames,detectionLogPath);
+                }
+            detectionLog=0;
+        }
+
+    printStageStatistics(stderr);
+    if (statisticsPath!=0)
+        {
+            dumpStageStatistics(statisticsPath);
+        }
+
     fprintf(stderr,NORMAL "MocapNET Live Demo finished.\n" NORMAL);
     return 0;
 }
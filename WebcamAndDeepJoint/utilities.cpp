@@ -1,34 +1,16 @@
 /** @file utilities.cpp
  *  @brief This is a suite of utilities that facilitate extracting 2D points from heatmaps. This is needed since 2D estimators output heatmaps, while MocapNET operates on
- *  2D point input. This code does not utilize PAFs so although some care is taken to get subpixel accuracy from the heatmap maxima it is still less accurate than the
- *  original OpenPose implementation etc.
+ *  2D point input. Some care is taken to get subpixel accuracy from the heatmap maxima, networks that also output PAFs can have their peaks grouped in to separate
+ *  people ( pafGrouping.hpp ) but the heatmap only path is still less accurate than the original OpenPose implementation etc.
  *  @author Damien Michel, Pashalis Padeleris, Ammar Qammaz (AmmarkoV)
  */
 
 #include "utilities.hpp"
+#include "peakExtractor.hpp"
+#include "pafGrouping.hpp"
 #include "../MocapNETLib/jsonCocoSkeleton.h"
 
 
-std::vector <float> smoothVector(std::vector <float> previousVector,std::vector <float> currentVector,float magnitude)
-{
-    if (previousVector.size()==currentVector.size())
-    {
-        std::vector <float> smoothedVector;
-        int i=0;
-        for (i=0; i<previousVector.size(); i++)
-        {
-            float smoothedValue =  currentVector[i]+ ( currentVector[i]-previousVector[i] ) * magnitude;
-            
-            smoothedVector.push_back(smoothedValue);
-        }
-        return smoothedVector;    
-    }
-    
-    return currentVector;
-}
-
-
-
 /*=======================================================================================================*/
 cv::Rect dj_getImageRect( cv::Mat &im )
 {
@@ -313,6 +295,180 @@ std::vector<cv::Point_<float> > dj_getNeuralNetworkDetectionsForColorImage(
 
 
 
+std::vector<cv::Point_<float> > dj_getNeuralNetworkDetectionsFromNHWC(
+    cv::Mat colorImageOriginal ,
+    cv::Mat colorImageSmall,
+    const float * nhwc,
+    unsigned int heatmapWidth,
+    unsigned int heatmapHeight,
+    unsigned int numberOfHeatmaps,
+    unsigned int channelStride,
+    float minThreshold ,
+    int visualize,
+    unsigned int handleMessages
+)
+{
+    std::vector<cv::Point_<float> > skeletons;
+    if ( (nhwc==0) || (numberOfHeatmaps>PEAK_EXTRACTOR_MAX_CHANNELS) || (channelStride<numberOfHeatmaps) )
+        {
+            return skeletons;
+        }
+
+    struct heatmapCandidates candidates[PEAK_EXTRACTOR_MAX_CHANNELS];
+    extractHeatmapPeaksNHWC(
+        nhwc,
+        heatmapWidth,
+        heatmapHeight,
+        numberOfHeatmaps,
+        channelStride,
+        minThreshold,
+        (float) colorImageOriginal.cols/heatmapWidth,
+        (float) colorImageOriginal.rows/heatmapHeight,
+        PEAK_EXTRACTOR_SINGLE_PERSON_CANDIDATES,
+        PEAK_EXTRACTOR_SUPPRESSION_RADIUS,
+        candidates
+    );
+
+    //Same rule as dj_extractSkeletonsFromPeaks, the last peak found for a joint is the one used
+    skeletons.resize(18);
+    for (unsigned int i=0; (i<numberOfHeatmaps) && (i<18); i++)
+        {
+            if (candidates[i].numberOfCandidates>0)
+                {
+                    struct heatmapPeak * peak = &candidates[i].candidate[candidates[i].numberOfCandidates-1];
+                    skeletons[i] = cv::Point_<float>(peak->x,peak->y);
+                }
+        }
+
+    if ( (visualize) && (numberOfHeatmaps>UT_COCO_Bkg) )
+        {
+            //Only the background heatmap is needed for the visualization so it is the only one copied out of the tensor
+            cv::Mat bg(heatmapHeight,heatmapWidth,CV_32FC1);
+            for (unsigned int y=0; y<heatmapHeight; y++)
+                {
+                    float * bgLine = bg.ptr<float>(y);
+                    for (unsigned int x=0; x<heatmapWidth; x++)
+                        {
+                            bgLine[x] = nhwc[ (y*heatmapWidth+x) * channelStride + UT_COCO_Bkg ];
+                        }
+                }
+            cv::Mat bgNorm, bgRes;
+            cv::normalize(bg,bgNorm,0,255, CV_MINMAX, CV_8UC1);
+            cv::resize(bgNorm,bgRes,cv::Size(0,0),8,8);
+            cv::imshow("2D NN Heatmaps",bgRes);
+
+            cv::Mat visualizationImage2DSkeleton = colorImageSmall.clone();
+            float factorX =   (float) colorImageSmall.cols  / colorImageOriginal.cols ;
+            float factorY =   (float) colorImageSmall.rows / colorImageOriginal.rows ;
+            dj_drawExtractedSkeletons(
+                visualizationImage2DSkeleton,
+                skeletons,
+                factorX ,
+                factorY
+            );
+            cv::imshow("2D Detections",visualizationImage2DSkeleton);
+
+            cv::waitKey(1);
+        }
+
+    return skeletons;
+}
+
+
+std::vector<std::vector<cv::Point_<float> > > dj_getNeuralNetworkMultiPersonDetectionsFromNHWC(
+    cv::Mat colorImageOriginal ,
+    cv::Mat colorImageSmall,
+    const float * nhwc,
+    unsigned int heatmapWidth,
+    unsigned int heatmapHeight,
+    unsigned int numberOfHeatmaps,
+    unsigned int channelStride,
+    float minThreshold ,
+    int visualize,
+    unsigned int handleMessages
+)
+{
+    std::vector<std::vector<cv::Point_<float> > > skeletons;
+    if ( (nhwc==0) || (numberOfHeatmaps<PAF_GROUPING_JOINTS) || (numberOfHeatmaps>PEAK_EXTRACTOR_MAX_CHANNELS) )
+        {
+            return skeletons;
+        }
+    if (channelStride<numberOfHeatmaps+PAF_GROUPING_CHANNELS)
+        {
+            //This network does not output PAFs after its heatmaps
+            return skeletons;
+        }
+
+    //Candidates stay in heatmap coordinates so that they can be scored against the PAFs
+    struct heatmapCandidates candidates[PEAK_EXTRACTOR_MAX_CHANNELS];
+    extractHeatmapPeaksNHWC(
+        nhwc,
+        heatmapWidth,
+        heatmapHeight,
+        PAF_GROUPING_JOINTS,
+        channelStride,
+        minThreshold,
+        1.0,
+        1.0,
+        PEAK_EXTRACTOR_MAX_CANDIDATES,
+        PEAK_EXTRACTOR_MULTI_PERSON_SUPPRESSION_RADIUS,
+        candidates
+    );
+
+    struct pafPerson persons[PAF_GROUPING_MAX_PERSONS];
+    unsigned int numberOfPersons = groupHeatmapPeaksUsingPAFs(
+                                       nhwc,
+                                       heatmapWidth,
+                                       heatmapHeight,
+                                       channelStride,
+                                       numberOfHeatmaps,
+                                       candidates,
+                                       (float) colorImageOriginal.cols/heatmapWidth,
+                                       (float) colorImageOriginal.rows/heatmapHeight,
+                                       persons,
+                                       PAF_GROUPING_MAX_PERSONS
+                                   );
+
+    skeletons.resize(numberOfPersons);
+    for (unsigned int p=0; p<numberOfPersons; p++)
+        {
+            //Same layout as dj_getNeuralNetworkDetectionsFromNHWC, joints that were not found stay at 0,0
+            skeletons[p].resize(18);
+            for (unsigned int i=0; i<PAF_GROUPING_JOINTS; i++)
+                {
+                    if (persons[p].joint[i].value>0.0)
+                        {
+                            skeletons[p][i] = cv::Point_<float>(persons[p].joint[i].x,persons[p].joint[i].y);
+                        }
+                }
+        }
+
+    if (visualize)
+        {
+            cv::Mat visualizationImage2DSkeleton = colorImageSmall.clone();
+            float factorX =   (float) colorImageSmall.cols  / colorImageOriginal.cols ;
+            float factorY =   (float) colorImageSmall.rows / colorImageOriginal.rows ;
+            for (unsigned int p=0; p<numberOfPersons; p++)
+                {
+                    dj_drawExtractedSkeletons(
+                        visualizationImage2DSkeleton,
+                        skeletons[p],
+                        factorX ,
+                        factorY
+                    );
+                }
+            cv::imshow("2D Detections",visualizationImage2DSkeleton);
+
+            cv::waitKey(1);
+        }
+
+    return skeletons;
+}
+
+
+
+
+
 void convertUtilitiesSkeletonFormatToBODY25(struct skeletonCOCO * sk, std::vector<cv::Point_<float> > points)
 {
     sk->joint2D[BODY25_Nose].x = points[UT_COCO_Nose].x;
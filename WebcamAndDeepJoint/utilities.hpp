@@ -1,8 +1,8 @@
 #pragma once
 /** @file utilities.hpp
  *  @brief These are the headers of the utilities that facilitate extracting 2D points from heatmaps. This is needed since 2D estimators output heatmaps, while MocapNET operates on
- *  2D point input. This code does not utilize PAFs so although some care is taken to get subpixel accuracy from the heatmap maxima it is still less accurate than the
- *  original OpenPose implementation etc.
+ *  2D point input. Some care is taken to get subpixel accuracy from the heatmap maxima, networks that also output PAFs can have their peaks grouped in to separate
+ *  people ( pafGrouping.hpp ) but the heatmap only path is still less accurate than the original OpenPose implementation etc.
  *  @author Damien Michel, Pashalis Padeleris, Ammar Qammaz (AmmarkoV)
  */
 
@@ -111,7 +111,6 @@ static const int UT_COCOSkeletonJointsParentRelationMap[] =
 
 
 
-std::vector <float> smoothVector(std::vector <float> previousVector,std::vector <float> currentVector,float magnitude);
 
 
 /**
@@ -133,6 +132,66 @@ std::vector<cv::Point_<float> > dj_getNeuralNetworkDetectionsForColorImage(
                                                                                                                                                          );
 
 
+/**
+ * @brief Same as dj_getNeuralNetworkDetectionsForColorImage but works straight on the NHWC output of the 2D joint estimator
+ * using the single pass peak extractor of peakExtractor.hpp instead of a separate cv::Mat per heatmap
+ * @ingroup utilities
+ * @param An OpenCV RGB Color Image to give us the resolution and maybe used for visualization..
+ * @param The image given to the 2D joint estimator, used for visualization
+ * @param Pointer to the heatmapHeight x heatmapWidth x numberOfHeatmaps output of the 2D joint estimator
+ * @param Width of the heatmaps
+ * @param Height of the heatmaps
+ * @param Number of heatmaps
+ * @param Number of channels of every pixel of the output ( heatmaps and anything the network outputs after them )
+ * @param The minimum threshold for detections, smaller values mean more noisy input, more means less detections
+ * @param Flag that controls visualization
+ * @retval A vector of 2D Points that contains detections for each of the joints, A point marked as 0,0 means no detection
+ */
+std::vector<cv::Point_<float> > dj_getNeuralNetworkDetectionsFromNHWC(
+                                                                       cv::Mat colorImageOriginal ,
+                                                                       cv::Mat colorImageSmall,
+                                                                       const float * nhwc,
+                                                                       unsigned int heatmapWidth,
+                                                                       unsigned int heatmapHeight,
+                                                                       unsigned int numberOfHeatmaps,
+                                                                       unsigned int channelStride,
+                                                                       float minThreshold  ,
+                                                                       int visualize,
+                                                                       unsigned int handleMessages
+                                                                     );
+
+
+/**
+ * @brief Find every person seen by a 2D joint estimator that also outputs part affinity fields, its NHWC output has to hold
+ * the heatmaps followed by the 38 PAF channels of the OpenPose COCO models. The peaks of all heatmaps are extracted in one pass and
+ * grouped in to skeletons using the PAFs ( pafGrouping.hpp )
+ * @ingroup utilities
+ * @param An OpenCV RGB Color Image to give us the resolution and maybe used for visualization..
+ * @param The image given to the 2D joint estimator, used for visualization
+ * @param Pointer to the heatmapHeight x heatmapWidth x channelStride output of the 2D joint estimator
+ * @param Width of the heatmaps
+ * @param Height of the heatmaps
+ * @param Number of heatmaps, the PAFs start right after them
+ * @param Number of channels of every pixel of the output
+ * @param The minimum threshold for detections, smaller values mean more noisy input, more means less detections
+ * @param Flag that controls visualization
+ * @retval One vector of 2D Points per person ( same layout as dj_getNeuralNetworkDetectionsFromNHWC ) sorted from the most to the least
+ * confident, empty if nobody was found or the network has no PAFs
+ */
+std::vector<std::vector<cv::Point_<float> > > dj_getNeuralNetworkMultiPersonDetectionsFromNHWC(
+                                                                                              cv::Mat colorImageOriginal ,
+                                                                                              cv::Mat colorImageSmall,
+                                                                                              const float * nhwc,
+                                                                                              unsigned int heatmapWidth,
+                                                                                              unsigned int heatmapHeight,
+                                                                                              unsigned int numberOfHeatmaps,
+                                                                                              unsigned int channelStride,
+                                                                                              float minThreshold  ,
+                                                                                              int visualize,
+                                                                                              unsigned int handleMessages
+                                                                                            );
+
+
 void convertUtilitiesSkeletonFormatToBODY25(struct skeletonCOCO * sk, std::vector<cv::Point_<float> > points);
 
 